@@ -335,10 +335,14 @@ constant-time access to N-th element of the string any longer as to find the
 position of this character in the string we have to examine all the preceding
 ones. Usually this doesn't matter much because most algorithms used on the
 strings examine them sequentially anyhow and because wxString implements a
-cache for iterating over the string by index but it can have serious
-consequences for algorithms using random access to string elements as they
-typically acquire O(N^2) time complexity instead of O(N) where N is the length
-of the string.
+cache for iterating over the string by index, in either direction, but it can
+have serious consequences for algorithms using random access to string elements
+as they typically acquire O(N^2) time complexity instead of O(N) where N is the
+length of the string. The exception are strings containing only ASCII
+characters, or positions in the ASCII prefix of the string, for which wxString
+remembers that indices and byte offsets are the same and so provides constant
+time access to them, once the string has been examined (e.g. by calling its
+length() method).
 
 Even despite caching the index, indexed access should be replaced with
 sequential access using string iterators. For example a typical loop:
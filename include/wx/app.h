@@ -28,6 +28,7 @@ class WXDLLIMPEXP_FWD_BASE wxAppTraits;
 class WXDLLIMPEXP_FWD_BASE wxCmdLineParser;
 class WXDLLIMPEXP_FWD_BASE wxEventLoopBase;
 class WXDLLIMPEXP_FWD_BASE wxMessageOutput;
+class wxPendingEventHandlers;
 
 #if wxUSE_GUI
     struct WXDLLIMPEXP_FWD_CORE wxVideoMode;
@@ -545,18 +546,18 @@ protected:
 
     // pending events management vars:
 
-    // the array of the handlers with pending events which needs to be processed
-    // inside ProcessPendingEvents()
-    wxEvtHandlerArray m_handlersWithPendingEvents;
-
-    // helper array used by ProcessPendingEvents() to store the event handlers
-    // which have pending events but of these events none can be processed right now
-    // (because of a call to wxEventLoop::YieldFor() which asked to selectively process
+    // the set of the handlers with pending events which need to be processed
+    // inside ProcessPendingEvents(), including the ones which have pending
+    // events but of these events none can be processed right now (because of
+    // a call to wxEventLoop::YieldFor() which asked to selectively process
     // pending events)
-    wxEvtHandlerArray m_handlersWithPendingDelayedEvents;
+    //
+    // handlers can be added to it from any thread without locking
+    wxPendingEventHandlers* const m_handlersWithPendingEvents;
 
 #if wxUSE_THREADS
-    // this critical section protects both the lists above
+    // this critical section protects all the other operations on the set
+    // above and on the pending events of the handlers in it
     wxCriticalSection m_handlersWithPendingEventsLocker;
 #endif
 
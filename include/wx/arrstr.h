@@ -126,10 +126,14 @@ public:
     wxSortedArrayString(const wxArrayString& src)
         : wxSortedArrayStringBase(wxStringSortAscending)
     {
-        reserve(src.size());
-
-        for ( size_t n = 0; n < src.size(); n++ )
-            Add(src[n]);
+        assign(src.begin(), src.end());
+        DoSort();
+    }
+    wxSortedArrayString(wxArrayString&& src)
+        : wxSortedArrayStringBase(wxStringSortAscending)
+    {
+        wxVector<wxString>::swap(src);
+        DoSort();
     }
     explicit wxSortedArrayString(wxArrayString::CompareFunction compareFunction)
         : wxSortedArrayStringBase(compareFunction)
@@ -137,7 +141,15 @@ public:
 
     int Index(const wxString& str, bool bCase = true, bool bFromEnd = false) const;
 
+    void Merge(const wxSortedArrayString& other);
+    void Merge(wxSortedArrayString&& other);
+
+    size_t RemoveDuplicates();
+
 private:
+    // Sort all elements, used after adding them without preserving the order.
+    void DoSort();
+
     void Insert()
     {
         wxFAIL_MSG( "wxSortedArrayString::Insert() is not to be used" );
@@ -410,6 +422,14 @@ private:
   // (if the old buffer is big enough, just return nullptr).
   wxString *Grow(size_t nIncrement);
 
+  // Return true if the given string is one of the strings in this array.
+  bool IsOwnString(const wxString& str) const
+    { return &str >= m_pItems && &str < m_pItems + m_nCount; }
+
+  // Sort the array using the order appropriate for an auto sorted array,
+  // used after adding several items to it at once.
+  void RestoreAutoSortOrder();
+
   // Binary search in the sorted array: return the index of the string if it's
   // present, otherwise, if lowerBound is true, return the position at which
   // the string should be inserted and if it's false return wxNOT_FOUND.
@@ -421,6 +441,8 @@ private:
   wxString *m_pItems = nullptr; // pointer to data
 
   bool    m_autoSort = false; // if true, keep the array always sorted
+
+  friend class wxSortedArrayString;
 };
 
 class WXDLLIMPEXP_BASE wxSortedArrayString : public wxArrayString
@@ -430,10 +452,19 @@ public:
     { }
   wxSortedArrayString(const wxArrayString& array) : wxArrayString(true)
     { Copy(array); }
+  wxSortedArrayString(wxArrayString&& array);
 
   explicit wxSortedArrayString(CompareFunction compareFunction)
       : wxArrayString(true)
     { m_compareFunction = compareFunction; }
+
+    // merge the elements of another array sorted in the same order into this one
+  void Merge(const wxSortedArrayString& other);
+  void Merge(wxSortedArrayString&& other);
+
+    // remove all but the first element from each group of equal ones and
+    // return the number of removed elements
+  size_t RemoveDuplicates();
 };
 
 #endif // !wxUSE_STD_CONTAINERS
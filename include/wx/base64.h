@@ -118,6 +118,114 @@ wxBase64Decode(const wxString& src,
     return wxBase64Decode(src.ToAscii(), wxNO_LEN, mode, posErr);
 }
 
+// ----------------------------------------------------------------------------
+// stream classes
+// ----------------------------------------------------------------------------
+
+#if wxUSE_STREAMS
+
+#include "wx/stream.h"
+
+// Filter decoding base64 data read from another stream.
+class WXDLLIMPEXP_BASE wxBase64InputStream : public wxFilterInputStream
+{
+public:
+    explicit wxBase64InputStream(wxInputStream& stream,
+                                 wxBase64DecodeMode mode = wxBase64DecodeMode_SkipWS)
+        : wxFilterInputStream(stream)
+    {
+        Init(mode);
+    }
+
+    explicit wxBase64InputStream(wxInputStream* stream,
+                                 wxBase64DecodeMode mode = wxBase64DecodeMode_SkipWS)
+        : wxFilterInputStream(stream)
+    {
+        Init(mode);
+    }
+
+    char Peek() override { return wxInputStream::Peek(); }
+    wxFileOffset GetLength() const override { return wxInputStream::GetLength(); }
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init(wxBase64DecodeMode mode);
+
+    // Read more input from the parent stream and decode all complete groups
+    // of characters in it, return false on error or EOF.
+    bool ReadMore();
+
+    enum { BUF_SIZE = 4096 };
+
+    // Characters not decoded yet.
+    char m_chars[BUF_SIZE];
+    size_t m_charsLen;
+
+    // Decoded data not returned yet.
+    unsigned char m_decoded[3*BUF_SIZE/4];
+    size_t m_decodedPos,
+           m_decodedLen;
+
+    wxBase64DecodeMode m_mode;
+
+    // Set after decoding the padding at the end of data.
+    bool m_end;
+
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxBase64InputStream);
+};
+
+// Filter encoding the data written to it as base64 and writing it to another
+// stream.
+class WXDLLIMPEXP_BASE wxBase64OutputStream : public wxFilterOutputStream
+{
+public:
+    explicit wxBase64OutputStream(wxOutputStream& stream)
+        : wxFilterOutputStream(stream)
+    {
+        Init();
+    }
+
+    explicit wxBase64OutputStream(wxOutputStream* stream)
+        : wxFilterOutputStream(stream)
+    {
+        Init();
+    }
+
+    virtual ~wxBase64OutputStream() { Close(); }
+
+    bool Close() override;
+    wxFileOffset GetLength() const override { return m_pos; }
+
+protected:
+    size_t OnSysWrite(const void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init();
+
+    // Encode the given data and write it to the parent stream.
+    bool WriteEncoded(const void* data, size_t len);
+
+    enum { BUF_SIZE = 4096 };
+
+    char m_chars[BUF_SIZE];
+
+    // Bytes not forming a complete group of 3 which can be encoded yet.
+    unsigned char m_pending[3];
+    size_t m_pendingLen;
+
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxBase64OutputStream);
+};
+
+#endif // wxUSE_STREAMS
+
 #endif // wxUSE_BASE64
 
 #endif // _WX_BASE64_H_
@@ -36,6 +36,8 @@
 #include "wx/meta/convertible.h"
 #include "wx/meta/removeref.h"
 
+#include <atomic>
+
 // This is now always defined, but keep it for backwards compatibility.
 #define wxHAS_CALL_AFTER
 
@@ -74,6 +76,7 @@ class WXDLLIMPEXP_FWD_BASE wxEventFilter;
 
 class WXDLLIMPEXP_FWD_BASE wxMSVC_FWD_MULTIPLE_BASES wxEvtHandler;
 class wxEventConnectionRef;
+class wxPendingEventsQueue;
 
 // ----------------------------------------------------------------------------
 // Event types
@@ -3825,6 +3828,16 @@ public:
     // buffer as other wxString objects in this thread.
     virtual void QueueEvent(wxEvent *event);
 
+    // Schedule all the given events to be processed later, this is the same
+    // as calling QueueEvent() for each of them but more efficient.
+    void QueueEvents(const wxVector<wxEvent*>& events);
+
+    // Schedule the given event to be processed later, but replace the event
+    // queued by a previous call to this function if it's still pending and has
+    // the same type and id. This is useful for frequently posted events, e.g.
+    // progress updates, when only the last one of them is important.
+    void QueueOrReplaceEvent(wxEvent *event);
+
     // Add an event to be processed later: notice that this function is not
     // safe to call from threads other than main, use QueueEvent()
     virtual void AddPendingEvent(const wxEvent& event)
@@ -4153,22 +4166,33 @@ protected:
     wxEvtHandler*       m_nextHandler;
     wxEvtHandler*       m_previousHandler;
 
+    // index of the dynamic event table entries by event type and id, only
+    // created by SearchDynamicEventTable() if there are many of them
+    struct DynamicEventsIndex;
+
     struct DynamicEvents
     {
+        DynamicEvents() = default;
+        ~DynamicEvents();
+
         wxVector<wxDynamicEventTableEntry*> m_entries;
         wxRecursionGuardFlag m_flag = 0;
+
+        // number of null entries in m_entries, which must be pruned
+        size_t m_numDeleted = 0;
+
+        DynamicEventsIndex* m_index = nullptr;
+
+        wxDECLARE_NO_COPY_CLASS(DynamicEvents);
     };
     // use wxSharedPtr so that SearchDynamicEventTable() can use another
     // instance of wxSharedPtr to extend the life of the wxRecursionGuardFlag
     // to outlive wxRecursionGuard
     wxSharedPtr<DynamicEvents> m_dynamicEvents;
 
-    wxList*             m_pendingEvents;
-
-#if wxUSE_THREADS
-    // critical section protecting m_pendingEvents
-    wxCriticalSection m_pendingEventsLock;
-#endif // wxUSE_THREADS
+    // the events queued for this handler, only allocated when the first event
+    // is queued and may be accessed from any thread
+    std::atomic<wxPendingEventsQueue*> m_pendingEvents;
 
     // Is event handler enabled?
     bool                m_enabled;
@@ -4205,6 +4229,11 @@ private:
     // try to process events in all handlers chained to this one
     bool DoTryChain(wxEvent& event);
 
+    // get the queue of pending events, creating it if necessary
+    wxPendingEventsQueue* GetPendingEventsQueue();
+
+    friend class WXDLLIMPEXP_FWD_BASE wxAppConsoleBase;
+
     // Head of the event filter linked list.
     static wxEventFilter* ms_filterList;
 
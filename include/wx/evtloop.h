@@ -47,10 +47,9 @@
     if the pending events for that event handler can be processed.
     If all the pending events associated with that event handler result as "not processable",
     the event handler "delays" itself calling wxEventLoopBase::DelayPendingEventHandler
-    (so it's moved: m_handlersWithPendingEvents => m_handlersWithPendingDelayedEvents).
+    (so it's moved to the list of the handlers with delayed pending events).
     Last, wxEventLoopBase::ProcessPendingEvents() before exiting moves the delayed
-    event handlers back into the list of handlers with pending events
-    (m_handlersWithPendingDelayedEvents => m_handlersWithPendingEvents) so that
+    event handlers back into the list of handlers with pending events so that
     a later call to ProcessPendingEvents() (possibly outside the YieldFor() call)
     will process all pending events as usual.
 */
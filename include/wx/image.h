@@ -83,6 +83,27 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+// Pixel layouts of the external buffers which can be used with wxImageView.
+enum wxImagePixelFormat
+{
+    // 3 bytes per pixel: red, green, blue (the same as wxImage data).
+    wxIMAGE_FORMAT_RGB,
+
+    // 4 bytes per pixel: red, green, blue, alpha.
+    wxIMAGE_FORMAT_RGBA,
+
+    // 4 bytes per pixel: blue, green, red, alpha.
+    wxIMAGE_FORMAT_BGRA,
+
+    // 1 byte per pixel: grey level.
+    wxIMAGE_FORMAT_GRAY,
+
+    // 32-bit native endian integers with alpha in the most significant byte
+    // followed by red, green and blue premultiplied by alpha, as used by
+    // Cairo CAIRO_FORMAT_ARGB32 surfaces.
+    wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED
+};
+
 // alpha channel values: fully transparent, default threshold separating
 // transparent pixels from opaque for a few functions dealing with alpha and
 // fully opaque
@@ -97,6 +118,73 @@ const unsigned char wxIMAGE_ALPHA_OPAQUE = 0xff;
 class WXDLLIMPEXP_FWD_CORE wxImageHandler;
 class WXDLLIMPEXP_FWD_CORE wxImage;
 class WXDLLIMPEXP_FWD_CORE wxPalette;
+class WXDLLIMPEXP_FWD_CORE wxImageView;
+
+//-----------------------------------------------------------------------------
+// wxImageRowReader: decodes the image incrementally, a few rows at a time
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageRowReader
+{
+public:
+    virtual ~wxImageRowReader() = default;
+
+    // get the size of the image being read
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    // return true if the image may have non-opaque pixels, in which case the
+    // alpha values are returned by ReadRows() too
+    bool HasAlpha() const { return m_hasAlpha; }
+
+    // get the index of the next row to be read
+    int GetCurrentRow() const { return m_currentRow; }
+
+    // return false if an error occurred while reading the image
+    bool IsOk() const { return m_ok; }
+
+    // return true if all rows have been read or an error occurred
+    bool IsDone() const { return !m_ok || m_currentRow == m_height; }
+
+    // read up to numRows next rows into the provided buffers, which must be
+    // big enough to hold this number of rows of RGB data and alpha values (if
+    // alpha is non-null and HasAlpha() is true), and return the number of
+    // rows actually read which can be less than numRows at the end of the
+    // image or 0 if there are no more rows or an error occurred
+    int ReadRows(unsigned char* data, unsigned char* alpha, int numRows);
+
+    // same as above but return the rows as an image of GetWidth() width,
+    // which is invalid if no rows could be read
+    wxImage ReadImage(int numRows);
+
+protected:
+    wxImageRowReader() = default;
+
+    // must be called by the derived class once it knows the image parameters
+    void SetImageInfo(int width, int height, bool hasAlpha)
+    {
+        m_width = width;
+        m_height = height;
+        m_hasAlpha = hasAlpha;
+        m_ok = true;
+    }
+
+    // read exactly the given number of rows, which is guaranteed to be
+    // positive and not greater than the number of remaining rows, alpha is
+    // null if the alpha values are not needed
+    virtual bool DoReadRows(unsigned char* data,
+                            unsigned char* alpha,
+                            int numRows) = 0;
+
+private:
+    int m_width = 0,
+        m_height = 0,
+        m_currentRow = 0;
+    bool m_hasAlpha = false,
+         m_ok = false;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageRowReader);
+};
 
 //-----------------------------------------------------------------------------
 // wxImageHandler
@@ -128,6 +216,14 @@ public:
     int GetImageCount( wxInputStream& stream );
         // save the stream position, call DoGetImageCount() and restore the position
 
+    // create an object allowing to read the image incrementally, the caller
+    // must delete it and keep the stream alive while it's used, return null
+    // if not supported by this handler or if the image couldn't be read
+    virtual wxImageRowReader* CreateRowReader( wxInputStream& WXUNUSED(stream),
+                                               bool WXUNUSED(verbose)=true,
+                                               int WXUNUSED(index)=-1 )
+        { return nullptr; }
+
     bool CanRead( wxInputStream& stream ) { return CallDoCanRead(stream); }
     bool CanRead( const wxString& name );
 #endif // wxUSE_STREAMS
@@ -304,6 +400,9 @@ public:
     explicit wxImage( const char* const* xpmData )
         { Create(xpmData); }
 
+    // create an image with a copy of the pixels of the given view
+    explicit wxImage( const wxImageView& view );
+
 #if wxUSE_STREAMS
     wxImage( wxInputStream& stream, wxBitmapType type = wxBITMAP_TYPE_ANY, int index = -1 )
         { LoadFile( stream, type, index ); }
@@ -337,6 +436,11 @@ public:
     // return the new image with size width*height
     wxImage GetSubImage( const wxRect& rect) const;
 
+    // copy the pixels, including alpha if the format has it, to the given
+    // buffer using the specified format
+    bool CopyToBuffer( unsigned char* data, wxImagePixelFormat format,
+                       int stride = 0 ) const;
+
     // Paste the image or part of this image into an image of the given size at the pos
     //  any newly exposed areas will be filled with the rgb colour
     //  by default if r = g = b = -1 then fill with this image's mask colour or find and
@@ -369,6 +473,9 @@ public:
     wxImage BlurHorizontal(int radius) const;
     wxImage BlurVertical(int radius) const;
 
+    // blur the image using (an approximation of) Gaussian kernel
+    wxImage GaussianBlur(double sigma) const;
+
     wxImage ShrinkBy( int xFactor , int yFactor ) const ;
 
     // rescales the image in place
@@ -466,6 +573,12 @@ public:
     void SetLoadFlags(int flags);
     int GetLoadFlags() const;
 
+    // Set the maximal number of threads used by the functions processing the
+    // entire image, such as Rescale() or Blur(): 1 (default) means not to use
+    // any additional threads and 0 means to use as many as there are CPUs.
+    static void SetParallelism(int numThreads);
+    static int GetParallelism();
+
     static bool CanRead( const wxString& name );
     static int GetImageCount( const wxString& name, wxBitmapType type = wxBITMAP_TYPE_ANY );
     virtual bool LoadFile( const wxString& name, wxBitmapType type = wxBITMAP_TYPE_ANY, int index = -1 );
@@ -476,6 +589,11 @@ public:
     static int GetImageCount( wxInputStream& stream, wxBitmapType type = wxBITMAP_TYPE_ANY );
     virtual bool LoadFile( wxInputStream& stream, wxBitmapType type = wxBITMAP_TYPE_ANY, int index = -1 );
     virtual bool LoadFile( wxInputStream& stream, const wxString& mimetype, int index = -1 );
+
+    // create an object reading the image from the stream incrementally
+    static wxImageRowReader* CreateRowReader( wxInputStream& stream,
+                                              wxBitmapType type = wxBITMAP_TYPE_ANY,
+                                              int index = -1 );
 #endif
 
     virtual bool SaveFile( const wxString& name ) const;
@@ -653,10 +771,140 @@ private:
 };
 
 
+//-----------------------------------------------------------------------------
+// wxImageView: read-only view of pixels stored in an external buffer
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageView
+{
+public:
+    wxImageView() = default;
+
+    // The buffer must remain valid for as long as the view is used. If stride
+    // is 0, the rows are supposed to be packed without any padding.
+    wxImageView(const unsigned char* data,
+                int width,
+                int height,
+                wxImagePixelFormat format,
+                int stride = 0);
+
+    bool IsOk() const { return m_data != nullptr; }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    wxSize GetSize() const { return wxSize(m_width, m_height); }
+    wxImagePixelFormat GetFormat() const { return m_format; }
+    int GetStride() const { return m_stride; }
+    const unsigned char* GetData() const { return m_data; }
+    const unsigned char* GetRow(int y) const
+        { return m_data + static_cast<size_t>(y)*m_stride; }
+
+    bool HasAlpha() const
+    {
+        return m_format == wxIMAGE_FORMAT_RGBA ||
+               m_format == wxIMAGE_FORMAT_BGRA ||
+               m_format == wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED;
+    }
+
+    static int GetBytesPerPixel(wxImagePixelFormat format);
+
+    // Return a view of the given part of this one, without copying anything.
+    wxImageView GetSubView(const wxRect& rect) const;
+
+    // These functions work like the wxImage functions with the same names but
+    // read the pixels directly from the buffer, without making an intermediate
+    // copy of it. They always return a wxImage in RGB format, with alpha if
+    // the view has it.
+    wxImage Scale(int width, int height,
+                  wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL) const;
+    wxImage Mirror(bool horizontally = true) const;
+    wxImage Rotate90(bool clockwise = true) const;
+    wxImage Rotate180() const;
+
+private:
+    const unsigned char* m_data = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    int m_stride = 0;
+    wxImagePixelFormat m_format = wxIMAGE_FORMAT_RGB;
+};
+
 extern void WXDLLIMPEXP_CORE wxInitAllImageHandlers();
 
 extern WXDLLIMPEXP_DATA_CORE(wxImage)    wxNullImage;
 
+#if wxUSE_THREADS && wxUSE_STREAMS
+
+//-----------------------------------------------------------------------------
+// wxImageBatchLoader: loads several images in parallel
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_FWD_BASE wxEvtHandler;
+class wxImageBatchLoaderImpl;
+
+// Result of loading a single image by wxImageBatchLoader.
+struct wxImageBatchResult
+{
+    // Index of the image in the order in which it was added to the loader.
+    size_t index = 0;
+
+    // File name of the image, empty if it was loaded from a stream.
+    wxString filename;
+
+    // The image itself, invalid if loading it failed.
+    wxImage image;
+};
+
+class WXDLLIMPEXP_CORE wxImageBatchLoader
+{
+public:
+    // Use the given number of worker threads or as many as there are CPUs if
+    // it is 0.
+    explicit wxImageBatchLoader(int numThreads = 0);
+
+    // Stops loading any images that are still pending and waits until all
+    // worker threads terminate.
+    ~wxImageBatchLoader();
+
+    // Don't start loading more images while the total size of the images
+    // that have been loaded but not retrieved yet exceeds the given limit.
+    void SetMemoryLimit(size_t maxBytes);
+
+    // Queue a wxThreadEvent with the given id to this handler whenever a new
+    // image becomes available.
+    void SetNotifyHandler(wxEvtHandler* handler, int id = wxID_ANY);
+
+    // Add an image to load, return its index.
+    size_t AddFile(const wxString& filename,
+                   wxBitmapType type = wxBITMAP_TYPE_ANY,
+                   int index = -1);
+
+    // Same as AddFile() but loads the image from the stream, which is deleted
+    // by the loader.
+    size_t AddStream(wxInputStream* stream,
+                     wxBitmapType type = wxBITMAP_TYPE_ANY,
+                     int index = -1);
+
+    // Start loading the images, more of them can still be added after this.
+    bool Start();
+
+    // Retrieve the next loaded image in completion order, waiting up to the
+    // given number of milliseconds (or indefinitely if it is -1) for it.
+    //
+    // Returns false if there are no more images to retrieve or on timeout.
+    bool GetNext(wxImageBatchResult& result, long timeout = -1);
+
+    // Return the number of images added to the loader and not retrieved yet.
+    size_t GetPendingCount() const;
+
+private:
+    wxImageBatchLoaderImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageBatchLoader);
+};
+
+#endif // wxUSE_THREADS && wxUSE_STREAMS
+
 //-----------------------------------------------------------------------------
 // wxImage handlers
 //-----------------------------------------------------------------------------
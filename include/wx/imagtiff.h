@@ -43,6 +43,7 @@ public:
 #if wxUSE_STREAMS
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) override;
+    virtual wxImageRowReader* CreateRowReader( wxInputStream& stream, bool verbose=true, int index=-1 ) override;
 
 protected:
     virtual int DoGetImageCount( wxInputStream& stream ) override;
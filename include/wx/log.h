@@ -602,6 +602,12 @@ protected:
     // this one as the default implementation of it simply asserts
     virtual void DoLogText(const wxString& msg);
 
+    // override this method to return true if DoLogRecord() may be called
+    // concurrently from any thread: in this case the messages logged from
+    // the background threads are passed to it directly instead of being
+    // buffered until the main thread flushes them
+    virtual bool IsThreadSafe() const { return false; }
+
     // log a message indicating the number of times the previous message was
     // repeated if previous repetition counter is strictly positive, does
     // nothing otherwise; return the old value of repetition counter
@@ -877,6 +883,45 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxLogInterposerTemp);
 };
 
+// ----------------------------------------------------------------------------
+// asynchronous log target: messages logged from any thread are queued without
+// locking and passed to the real log target from a dedicated thread
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+class wxLogAsyncImpl;
+
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog
+{
+public:
+    // takes ownership of the target, which is only used from the background
+    // thread created by this object from now on; bufferSize is the maximal
+    // number of not yet output messages per logging thread
+    explicit wxLogAsync(wxLog *target, size_t bufferSize = 1024);
+    virtual ~wxLogAsync();
+
+    // return the log target to which the messages are forwarded
+    wxLog *GetTarget() const;
+
+    // wait until all messages logged so far are output and flush the target
+    virtual void Flush() override;
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+    virtual bool IsThreadSafe() const override { return true; }
+
+private:
+    wxLogAsyncImpl * const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_THREADS
+
 #if wxUSE_GUI
     // include GUI log targets:
     #include "wx/generic/logg.h"
@@ -1092,6 +1137,54 @@ public:
         DoCallOnLog(s);
     }
 
+#ifdef wxHAS_COMPILE_TIME_FORMAT_CHECK
+    // overloads of all the functions above for wxFORMAT() strings, which are
+    // checked at compile-time and don't need to be copied into a wxString
+    template <typename F, typename... Targs>
+    void Log(const wxFormatLiteral<F>& format, Targs... args)
+    {
+        DoCallOnLog(wxString::Format(format, args...));
+    }
+
+    template <typename F, typename... Targs>
+    void Log(long num, const wxFormatLiteral<F>& format, Targs... args)
+    {
+        Store(m_optKey, num);
+
+        DoCallOnLog(wxString::Format(format, args...));
+    }
+
+    template <typename F, typename... Targs>
+    void Log(wxObject* ptr, const wxFormatLiteral<F>& format, Targs... args)
+    {
+        Store(m_optKey, wxPtrToUInt(ptr));
+
+        DoCallOnLog(wxString::Format(format, args...));
+    }
+
+    template <typename F, typename... Targs>
+    void LogAtLevel(wxLogLevel level,
+                    const wxFormatLiteral<F>& format, Targs... args)
+    {
+        if ( !wxLog::IsLevelEnabled(level, wxASCII_STR(m_info.component)) )
+            return;
+
+        DoCallOnLog(level, wxString::Format(format, args...));
+    }
+
+    template <typename F, typename... Targs>
+    void LogTrace(const wxString& mask,
+                  const wxFormatLiteral<F>& format, Targs... args)
+    {
+        if ( !wxLog::IsAllowedTraceMask(mask) )
+            return;
+
+        Store(wxLOG_KEY_TRACE_MASK, mask);
+
+        DoCallOnLog(wxString::Format(format, args...));
+    }
+#endif // wxHAS_COMPILE_TIME_FORMAT_CHECK
+
 private:
     void DoCallOnLog(wxLogLevel level, const wxString& msg)
     {
@@ -1285,17 +1378,18 @@ WXDLLIMPEXP_BASE wxString wxSysErrorMsgStr(unsigned long nErrCode = 0);
 #undef wxUSE_LOG_TRACE
 #define wxUSE_LOG_TRACE 0
 
-// define macros for defining log functions which do nothing at all
+// define macros for defining log functions which do nothing at all (notice
+// that the format is a template parameter to accept wxFORMAT() strings too)
 #define wxDEFINE_EMPTY_LOG_FUNCTION(level)                                  \
-    template <typename... Targs>                                            \
-    void wxLog##level(const wxString& WXUNUSED(format), Targs...) { }       \
+    template <typename Format, typename... Targs>                           \
+    void wxLog##level(const Format& WXUNUSED(format), Targs...) { }         \
     inline void wxVLog##level(const wxString& WXUNUSED(format),             \
                               va_list WXUNUSED(argptr)) { }                 \
 
 #define wxDEFINE_EMPTY_LOG_FUNCTION2(level, argclass)                       \
-    template <typename... Targs>                                            \
+    template <typename Format, typename... Targs>                           \
     void wxLog##level(argclass WXUNUSED(arg),                               \
-                      const wxString& WXUNUSED(format), Targs...) { }       \
+                      const Format& WXUNUSED(format), Targs...) { }         \
     inline void wxVLog##level(argclass WXUNUSED(arg),                       \
                               const wxString& WXUNUSED(format),             \
                               va_list WXUNUSED(argptr)) {}
@@ -0,0 +1,24 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/image.h
+// Purpose:     Private helpers for wxImage and image handlers
+// Author:      wxWidgets team
+// Created:     2026-10-16
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IMAGE_H_
+#define _WX_PRIVATE_IMAGE_H_
+
+#include "wx/gdicmn.h"
+
+// Return the size to which the image of the given size must be scaled down
+// when loading it to respect wxIMAGE_OPTION_MAX_{WIDTH,HEIGHT} values, with 0
+// meaning that there is no limit in the corresponding direction.
+//
+// The returned size is the same as the image size if it already fits into
+// the limits, otherwise it is the biggest size fitting into them and
+// preserving the image aspect ratio.
+wxSize wxGetImageLoadSize(const wxSize& size, unsigned maxWidth, unsigned maxHeight);
+
+#endif // _WX_PRIVATE_IMAGE_H_
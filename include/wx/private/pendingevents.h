@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/pendingevents.h
+// Purpose:     Queues of the pending events used by wxEvtHandler and wxApp
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_PENDINGEVENTS_H_
+#define _WX_PRIVATE_PENDINGEVENTS_H_
+
+#include "wx/event.h"
+#include "wx/thread.h"
+
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// wxPendingEventNode: element of the list of pending events
+// ----------------------------------------------------------------------------
+
+struct wxPendingEventNode
+{
+    explicit wxPendingEventNode(wxEvent* event_, bool replaceable_ = false)
+        : event(event_),
+          category(event_->GetEventCategory()),
+          replaceable(replaceable_)
+    {
+    }
+
+    // The event may be replaced by another one with the same type and id if
+    // this node is replaceable, so it's only safe to access it without
+    // locking wxPendingEventsQueue::m_replaceableLock if it isn't.
+    wxEvent* event;
+
+    // The category of the event, which can be used without locking.
+    const wxEventCategory category;
+
+    // True if the node was added by PostOrReplace().
+    const bool replaceable;
+
+    wxPendingEventNode* next = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventNode);
+};
+
+// ----------------------------------------------------------------------------
+// wxPendingEventsQueue: the events pending for a single handler
+// ----------------------------------------------------------------------------
+
+// Events may be posted to this queue from any thread without locking: they
+// are pushed onto a lock-free stack, which is taken as a whole by the thread
+// processing the events and appended, in the order of posting, to the list of
+// the events ready to be processed. The only exception are the replaceable
+// events, which are also indexed by their type and id and so require locking.
+//
+// All the other functions may only be called while holding the lock which
+// protects the wxPendingEventHandlers containing this queue, i.e.
+// wxAppConsoleBase::m_handlersWithPendingEventsLocker.
+class wxPendingEventsQueue
+{
+public:
+    explicit wxPendingEventsQueue(wxEvtHandler* handler)
+        : m_handler(handler)
+    {
+    }
+
+    ~wxPendingEventsQueue() { DeleteAll(); }
+
+    wxEvtHandler* GetHandler() const { return m_handler; }
+
+    // Add a new event to the queue, taking ownership of it. This can be called
+    // from any thread.
+    void Post(wxEvent* event);
+
+    // Add all the events to the queue at once. This can be called from any
+    // thread.
+    void PostAll(const wxVector<wxEvent*>& events);
+
+    // Replace the pending event with the same type and id which was added by
+    // this function before, if there is one, or add the new event to the
+    // queue otherwise. Return true if the event was added.
+    //
+    // This can be called from any thread, but, unlike the functions above,
+    // does use locking.
+    bool PostOrReplace(wxEvent* event);
+
+    // Check if any events were posted since the last call to TakePosted().
+    bool HasPosted() const { return m_posted.load() != nullptr; }
+
+    // Move all the posted events to the list of events ready to be processed.
+    void TakePosted();
+
+    // Access the list of events ready to be processed.
+    wxPendingEventNode* GetFirst() const { return m_first; }
+    bool IsEmpty() const { return m_first == nullptr; }
+
+    // Remove the given node, which must be preceded by the given one (or be
+    // the first node if prev is null), from the list and return its event.
+    wxEvent* Remove(wxPendingEventNode* node, wxPendingEventNode* prev);
+
+    // Delete all the pending events, including the just posted ones.
+    void DeleteAll();
+
+private:
+    // Push the nodes linked together, from first to last, to the stack.
+    void Push(wxPendingEventNode* first, wxPendingEventNode* last);
+
+    wxEvtHandler* const m_handler;
+
+    // The stack of the events posted to this queue, in the reverse order.
+    std::atomic<wxPendingEventNode*> m_posted{nullptr};
+
+    // The still pending replaceable events indexed by their type and id.
+    typedef std::pair<wxEventType, int> ReplaceableKey;
+
+    struct ReplaceableKeyHash
+    {
+        size_t operator()(const ReplaceableKey& key) const
+        {
+            return std::hash<wxEventType>()(key.first) * 31 +
+                    std::hash<int>()(key.second);
+        }
+    };
+
+    std::unordered_map<ReplaceableKey,
+                       wxPendingEventNode*,
+                       ReplaceableKeyHash> m_replaceable;
+
+    // Protects m_replaceable and the events of the nodes in it.
+    wxCRIT_SECT_DECLARE_MEMBER(m_replaceableLock);
+
+    // The list of the events ready to be processed.
+    wxPendingEventNode* m_first = nullptr;
+    wxPendingEventNode* m_last = nullptr;
+
+
+    // The rest of the fields is only used by wxPendingEventHandlers.
+    friend class wxPendingEventHandlers;
+
+    // True if the queue has been added to wxPendingEventHandlers and not
+    // removed from it yet, may be modified by any thread.
+    std::atomic<bool> m_listed{false};
+
+    // Next queue in wxPendingEventHandlers stack of the newly added queues.
+    wxPendingEventsQueue* m_nextAdded = nullptr;
+
+    // The list of wxPendingEventHandlers this queue is in, if any, and the
+    // links in it.
+    enum class ListKind
+    {
+        None,
+        Main,
+        Delayed
+    };
+
+    ListKind m_listKind = ListKind::None;
+    wxPendingEventsQueue* m_prev = nullptr;
+    wxPendingEventsQueue* m_next = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventsQueue);
+};
+
+// ----------------------------------------------------------------------------
+// wxPendingEventHandlers: the set of the handlers with pending events
+// ----------------------------------------------------------------------------
+
+// The handlers are kept in the order in which they got their first pending
+// event. Just as wxPendingEventsQueue, this class allows adding handlers to
+// it from any thread without locking, but all the other functions must be
+// called while holding wxAppConsoleBase::m_handlersWithPendingEventsLocker.
+class wxPendingEventHandlers
+{
+public:
+    wxPendingEventHandlers() = default;
+    ~wxPendingEventHandlers();
+
+    // Add the queue to the set, if it's not already there. This can be called
+    // from any thread.
+    void Add(wxPendingEventsQueue* queue);
+
+    // Get the first handler with pending events which may be processed, if
+    // any, taking into account the handlers added since the last call.
+    wxPendingEventsQueue* GetFirst();
+
+    // Check if there are any handlers which may be processed.
+    bool IsEmpty() const
+    {
+        return !m_main.first && m_added.load() == nullptr;
+    }
+
+    // Check if there are any delayed handlers.
+    bool HasDelayed() const { return m_delayed.first != nullptr; }
+
+    // Remove the queue from the set if it doesn't have any pending events.
+    //
+    // Notice that it may be added back to it immediately if new events are
+    // posted to it concurrently.
+    void RemoveIfEmpty(wxPendingEventsQueue* queue);
+
+    // Remove the queue from the set unconditionally, this is only used when
+    // its handler is being destroyed.
+    void Remove(wxPendingEventsQueue* queue);
+
+    // Move the queue to the list of the handlers whose events can't be
+    // processed right now and must be processed later.
+    void Delay(wxPendingEventsQueue* queue);
+
+    // Move all the delayed handlers back to the main list.
+    void ResumeDelayed();
+
+    // Delete all pending events of all the handlers in the main list.
+    void DeleteAllEvents();
+
+private:
+    struct List
+    {
+        wxPendingEventsQueue* first = nullptr;
+        wxPendingEventsQueue* last = nullptr;
+    };
+
+    // Move the queues added since the last call to the main list.
+    void TakeAdded();
+
+    void Append(List& list,
+                wxPendingEventsQueue::ListKind kind,
+                wxPendingEventsQueue* queue);
+    void Unlink(wxPendingEventsQueue* queue);
+
+    // The stack of the newly added queues, in the reverse order.
+    std::atomic<wxPendingEventsQueue*> m_added{nullptr};
+
+    // The handlers with the events to process and the handlers whose events
+    // can't be processed right now because of a YieldFor() call in progress.
+    List m_main,
+         m_delayed;
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventHandlers);
+};
+
+#endif // _WX_PRIVATE_PENDINGEVENTS_H_
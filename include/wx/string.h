@@ -502,13 +502,15 @@ private:
           const wxString *str;  // the string to which this element applies
           size_t pos,           // the cached index in this string
                  impl,          // the corresponding position in its m_impl
-                 len;           // cached length or npos if unknown
+                 len,           // cached length or npos if unknown
+                 ascii;         // length of the known all-ASCII prefix
 
-          // reset cached index to 0
-          void ResetPos() { pos = impl = 0; }
+          // reset cached index to the end of the ASCII prefix, which is the
+          // last position whose index is known without iterating
+          void ResetPos() { pos = impl = ascii; }
 
-          // reset position and length
-          void Reset() { ResetPos(); len = npos; }
+          // reset everything, including the ASCII prefix
+          void Reset() { ascii = 0; ResetPos(); len = npos; }
       };
 
       // cache the indices mapping for the last few string used
@@ -647,6 +649,11 @@ private:
 
       Cache::Element * const cache = GetCacheElement();
 
+      // in the ASCII prefix of the string, which is the entire string in the
+      // common case of ASCII strings, indices are the same as byte offsets
+      if ( pos <= cache->ascii )
+          return pos;
+
       // cached position can't be 0 so if it is, it means that this entry was
       // used for length caching only so far, i.e. it doesn't count as a hit
       // from our point of view
@@ -658,13 +665,41 @@ private:
       if ( pos == cache->pos )
           return cache->impl;
 
-      // this seems to happen only rarely so just reset the cache in this case
-      // instead of complicating code even further by seeking backwards in this
-      // case
       if ( cache->pos > pos )
       {
           wxCACHE_PROFILE_FIELD_INC(mishits);
 
+          // iterate backwards if it's closer, as is the case when iterating
+          // over the string in reverse order, otherwise restart from the end
+          // of the ASCII prefix
+          if ( cache->pos - pos < pos - cache->ascii )
+          {
+              wxStringImpl::const_iterator i(m_impl.begin() + cache->impl);
+              for ( size_t n = cache->pos; n > pos; n-- )
+                  wxStringOperations::DecIter(i);
+
+              cache->pos = pos;
+              cache->impl = i - m_impl.begin();
+
+              return cache->impl;
+          }
+
+          cache->ResetPos();
+      }
+      else if ( cache->pos < cache->ascii )
+      {
+          // the ASCII prefix could have been extended by length()
+          cache->ResetPos();
+      }
+
+      // if we're at the end of the ASCII prefix, try extending it first as
+      // checking many bytes at once is much faster than iterating over them
+      if ( cache->pos == cache->ascii )
+      {
+          ExtendASCIIPrefix(cache, pos);
+          if ( pos <= cache->ascii )
+              return pos;
+
           cache->ResetPos();
       }
 
@@ -684,6 +719,25 @@ private:
       return cache->impl;
   }
 
+  // extend the known ASCII prefix of the string up to the given position
+  //
+  // notice that we must not look further than that: the functions modifying
+  // the string invalidate the cache before calling PosToImpl() for the
+  // position at which they modify it, so anything we learn about the part of
+  // the string after it would become stale
+  void ExtendASCIIPrefix(Cache::Element *cache, size_t pos) const
+  {
+      size_t end = pos;
+      if ( end > m_impl.length() )
+          end = m_impl.length();
+
+      cache->ascii += wxStringOperations::GetASCIIPrefixLength
+                      (
+                        m_impl.data() + cache->ascii,
+                        end - cache->ascii
+                      );
+  }
+
   void InvalidateCache()
   {
       Cache::Element * const cache = FindCacheElement();
@@ -704,7 +758,12 @@ private:
       // present in the cache before, this seems to do no harm and the
       // potential for avoiding length recomputation for long strings looks
       // interesting
-      GetCacheElement()->len = len;
+      //
+      // this is only called when the string contents is entirely replaced, so
+      // also forget everything else we knew about it
+      Cache::Element * const cache = GetCacheElement();
+      cache->Reset();
+      cache->len = len;
   }
 
   void UpdateCachedLength(ptrdiff_t delta)
@@ -753,7 +812,7 @@ private:
       if ( pos == 0 || pos == npos )
           return pos;
       else
-          return const_iterator(this, m_impl.begin() + pos) - begin();
+          return wxStringOperations::CountChars(m_impl.data(), pos);
   }
 #endif // wxUSE_UNICODE_WCHAR/wxUSE_UNICODE_UTF8
 
@@ -1434,8 +1493,16 @@ public:
       {
           // it's probably not worth trying to be clever and using cache->pos
           // here as it's probably 0 anyhow -- you usually call length() before
-          // starting to index the string
-          cache->len = end() - begin();
+          // starting to index the string, but do find out if it is entirely
+          // ASCII, as it will make indexing it much faster
+          ExtendASCIIPrefix(cache, m_impl.length());
+
+          cache->len = cache->ascii +
+                        wxStringOperations::CountChars
+                        (
+                          m_impl.data() + cache->ascii,
+                          m_impl.length() - cache->ascii
+                        );
       }
       else
       {
@@ -2502,6 +2569,8 @@ public:
   static wxString FromDouble(double val, int precision = -1);
     // in C locale
   static wxString FromCDouble(double val, int precision = -1);
+    // in C locale and using the shortest representation preserving the value
+  static wxString FromCDoubleShortest(double val);
 
   // formatted input/output
     // as sprintf(), returns the number of characters written or < 0 on error
@@ -2536,6 +2605,28 @@ public:
     // the same as above, but takes a va_list
   static wxString FormatV(const wxString& format, va_list argptr);
 
+#ifdef wxHAS_COMPILE_TIME_FORMAT_CHECK
+    // overloads for the format strings created by wxFORMAT() which check
+    // that the arguments match the format at compile-time
+  template <typename F, typename... Targs>
+  int Printf(const wxFormatLiteral<F>& format, Targs... args)
+  {
+      wxFormatLiteral<F>::template CheckArgs<Targs...>();
+
+      return Printf(wxFormatString(format), args...);
+  }
+
+  template <typename F, typename... Targs>
+  static wxString Format(const wxFormatLiteral<F>& format, Targs... args)
+  {
+      wxFormatLiteral<F>::template CheckArgs<Targs...>();
+
+      wxString s;
+      s.Printf(wxFormatString(format), args...);
+      return s;
+  }
+#endif // wxHAS_COMPILE_TIME_FORMAT_CHECK
+
   // raw access to string memory
     // ensure that string has space for at least nLen characters
     // only works if the data of this string is not shared
@@ -2957,7 +3048,7 @@ public:
     // insert n chars of str starting at nStart (in str)
   wxString& insert(size_t nPos, const wxString& str, size_t nStart, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_INVALIDATE_CACHE();
 
       size_t from, len;
       str.PosLenToImpl(nStart, n, &from, &len);
@@ -2988,7 +3079,7 @@ public:
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
   wxString& insert(size_t nPos, const char *sz, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_INVALIDATE_CACHE();
 
       SubstrBufFromMB str(ImplStr(sz, n));
       m_impl.insert(PosToImpl(nPos), str.data, str.len);
@@ -2999,7 +3090,7 @@ public:
 
   wxString& insert(size_t nPos, const wchar_t *sz, size_t n)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_INVALIDATE_CACHE();
 
       SubstrBufFromWC str(ImplStr(sz, n));
       m_impl.insert(PosToImpl(nPos), str.data, str.len);
@@ -3010,7 +3101,7 @@ public:
     // insert n copies of ch
   wxString& insert(size_t nPos, size_t n, wxUniChar ch)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_INVALIDATE_CACHE();
 
       if ( wxStringOperations::IsSingleCodeUnitCharacter(ch) )
           m_impl.insert(PosToImpl(nPos), n, (wxStringCharType)ch);
@@ -3022,7 +3113,7 @@ public:
 
   iterator insert(iterator it, wxUniChar ch)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(1);
+      wxSTRING_INVALIDATE_CACHE();
 
       if ( wxStringOperations::IsSingleCodeUnitCharacter(ch) )
           return iterator(this, m_impl.insert(it.impl(), (wxStringCharType)ch));
@@ -3054,7 +3145,7 @@ public:
 
   void insert(iterator it, size_type n, wxUniChar ch)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(n);
+      wxSTRING_INVALIDATE_CACHE();
 
       if ( wxStringOperations::IsSingleCodeUnitCharacter(ch) )
           m_impl.insert(it.impl(), n, (wxStringCharType)ch);
@@ -3084,7 +3175,7 @@ public:
 
   iterator erase(iterator first)
   {
-      wxSTRING_UPDATE_CACHED_LENGTH(-1);
+      wxSTRING_INVALIDATE_CACHE();
 
       return iterator(this, m_impl.erase(first.impl()));
   }
@@ -4121,7 +4212,8 @@ class wxUTF8StringBuffer : public wxPrivate::wxUTF8StringBufferBase
 {
 public:
     wxUTF8StringBuffer(wxString& str, size_t size)
-        : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size}
+        : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size},
+          m_string{str}
     {
     }
 
@@ -4130,9 +4222,17 @@ public:
         // This class works only with NUL-terminated strings, so we need to
         // resize the string to have the correct length.
         m_str.resize(strlen(m_str.c_str()));
+
+        // We modified the string behind its back, so it must forget what it
+        // knew about its contents.
+#if wxUSE_STRING_POS_CACHE
+        m_string.InvalidateCache();
+#endif // wxUSE_STRING_POS_CACHE
     }
 
 private:
+    wxString& m_string;
+
     wxDECLARE_NO_COPY_CLASS(wxUTF8StringBuffer);
 };
 
@@ -4140,7 +4240,8 @@ class wxUTF8StringBufferLength : public wxPrivate::wxUTF8StringBufferBase
 {
 public:
     wxUTF8StringBufferLength(wxString& str, size_t size)
-        : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size}
+        : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size},
+          m_string{str}
     {
     }
 
@@ -4149,11 +4250,16 @@ public:
         wxASSERT_MSG( m_lenSet, "forgot to call SetLength()" );
 
         m_str.resize(m_len);
+
+#if wxUSE_STRING_POS_CACHE
+        m_string.InvalidateCache();
+#endif // wxUSE_STRING_POS_CACHE
     }
 
     void SetLength(size_t length) { m_len = length; m_lenSet = true; }
 
 protected:
+    wxString& m_string;
     size_t m_len = 0;
     bool m_lenSet = false;
 
@@ -4265,6 +4371,98 @@ namespace std
     };
 } // namespace std
 
+// ----------------------------------------------------------------------------
+// wxStringAtom: interned string
+// ----------------------------------------------------------------------------
+
+// All atoms created from equal strings point to the same wxString stored in a
+// global table, so that atoms take the space of a single pointer, are copied
+// without allocating and compare in constant time. Interned strings are never
+// freed, so atoms should only be used for strings taking a limited number of
+// different values.
+//
+// Notice that the interned strings are shared by all threads, so only const
+// wxString methods not using its conversion cache, i.e. everything except the
+// narrow/wide conversions such as mb_str(), may be used with them concurrently.
+class WXDLLIMPEXP_BASE wxStringAtom
+{
+public:
+    // the default ctor creates the atom for the empty string without looking
+    // it up in the global table
+    wxStringAtom() : m_str(&ms_empty) { }
+
+    explicit wxStringAtom(const wxString& str) : m_str(Intern(str)) { }
+
+    const wxString& GetString() const { return *m_str; }
+    operator const wxString&() const { return GetString(); }
+
+    bool IsEmpty() const { return m_str == &ms_empty; }
+
+    // atoms for equal strings are always the same, so compare the pointers
+    bool operator==(const wxStringAtom& atom) const
+        { return m_str == atom.m_str; }
+    bool operator!=(const wxStringAtom& atom) const
+        { return m_str != atom.m_str; }
+
+    // return the number of strings interned so far
+    static size_t GetCount();
+
+private:
+    friend struct std::hash<wxStringAtom>;
+
+    // return the pointer to the interned copy of the given string, adding it
+    // to the table if necessary, or to ms_empty for the empty string
+    static const wxString* Intern(const wxString& str);
+
+    // the string used by all atoms for the empty string: notice that only its
+    // address is used by the default ctor, so it's fine to create global
+    // atoms even before it is initialized
+    static const wxString ms_empty;
+
+    const wxString* m_str;
+};
+
+inline bool operator==(const wxStringAtom& atom, const wxString& str)
+    { return atom.GetString() == str; }
+inline bool operator==(const wxString& str, const wxStringAtom& atom)
+    { return atom.GetString() == str; }
+inline bool operator!=(const wxStringAtom& atom, const wxString& str)
+    { return atom.GetString() != str; }
+inline bool operator!=(const wxString& str, const wxStringAtom& atom)
+    { return atom.GetString() != str; }
+
+// these overloads are needed to avoid ambiguities with wxString ones
+inline bool operator==(const wxStringAtom& atom, const wchar_t* str)
+    { return atom.GetString() == str; }
+inline bool operator==(const wchar_t* str, const wxStringAtom& atom)
+    { return atom.GetString() == str; }
+inline bool operator!=(const wxStringAtom& atom, const wchar_t* str)
+    { return atom.GetString() != str; }
+inline bool operator!=(const wchar_t* str, const wxStringAtom& atom)
+    { return atom.GetString() != str; }
+#ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
+inline bool operator==(const wxStringAtom& atom, const char* str)
+    { return atom.GetString() == str; }
+inline bool operator==(const char* str, const wxStringAtom& atom)
+    { return atom.GetString() == str; }
+inline bool operator!=(const wxStringAtom& atom, const char* str)
+    { return atom.GetString() != str; }
+inline bool operator!=(const char* str, const wxStringAtom& atom)
+    { return atom.GetString() != str; }
+#endif // wxNO_IMPLICIT_WXSTRING_ENCODING
+
+namespace std
+{
+    template<>
+    struct hash<wxStringAtom>
+    {
+        size_t operator()(const wxStringAtom& atom) const
+        {
+            return std::hash<const wxString*>()(atom.m_str);
+        }
+    };
+} // namespace std
+
 // ---------------------------------------------------------------------------
 // Implementation only from here until the end of file
 // ---------------------------------------------------------------------------
@@ -80,6 +80,11 @@ struct WXDLLIMPEXP_BASE wxStringOperationsWchar
 
     static wxUniChar DecodeChar(const std::wstring::const_iterator& i)
         { return *i; }
+
+    // returns the number of identical code units at the start of both buffers
+    static size_t GetCommonPrefixLength(const wchar_t *s1,
+                                        const wchar_t *s2,
+                                        size_t len);
 };
 #endif // wxUSE_UNICODE_WCHAR
 
@@ -98,6 +103,17 @@ struct WXDLLIMPEXP_BASE wxStringOperationsUtf8
     // returns offset to skip forward when iterating over UTF-8 sequence
     static unsigned char GetUTF8IterOffset(unsigned char c);
 
+    // returns the number of ASCII characters at the start of the buffer
+    static size_t GetASCIIPrefixLength(const char *str, size_t len);
+
+    // returns the number of characters in a valid UTF-8 buffer
+    static size_t CountChars(const char *str, size_t len);
+
+    // returns the number of identical bytes at the start of both buffers
+    static size_t GetCommonPrefixLength(const char *s1,
+                                        const char *s2,
+                                        size_t len);
+
 
     template<typename Iterator>
     static void IncIter(Iterator& i)
@@ -142,6 +142,8 @@ wxGCC_WARNING_SUPPRESS(ctor-dtor-privacy)
 // accounts for string changes done by wxArgNormalizer<>
 //
 // Note that this class can _only_ be used for function arguments!
+template <typename F> class wxFormatLiteral;
+
 class WXDLLIMPEXP_BASE wxFormatString
 {
 public:
@@ -162,6 +164,19 @@ public:
     wxFormatString(const wxScopedWCharBuffer& str)
         : m_wchar(str), m_str(nullptr), m_cstr(nullptr) {}
 
+    // This ctor is used for the strings created by wxFORMAT(), which were
+    // already parsed at compile-time.
+    template <typename F>
+    wxFormatString(const wxFormatLiteral<F>& fmt)
+        : wxFormatString(fmt.GetString())
+    {
+        if ( fmt.IsOk() )
+        {
+            m_argTypes = fmt.GetArgTypes();
+            m_numArgTypes = fmt.GetArgCount();
+        }
+    }
+
     // Possible argument types. These are or-combinable for wxASSERT_ARG_TYPE
     // convenience. Some of the values are or-combined with another value, this
     // expresses "supertypes" for use with wxASSERT_ARG_TYPE masks. For example,
@@ -254,6 +269,12 @@ private:
     const wxString * const m_str;
     const wxCStrData * const m_cstr;
 
+    // the types of the arguments, as ArgumentType values or 0 for the unused
+    // ones, computed at compile-time for wxFORMAT() strings, or null if the
+    // format string needs to be parsed to find them
+    const unsigned short* m_argTypes = nullptr;
+    unsigned m_numArgTypes = 0;
+
     wxDECLARE_NO_ASSIGN_CLASS(wxFormatString);
 };
 
@@ -467,6 +488,337 @@ wxFORMAT_STRING_SPECIFIER(std::nullptr_t, wxFormatString::Arg_Pointer)
 #undef wxFORMAT_STRING_SPECIFIER
 #undef wxDISABLED_FORMAT_STRING_SPECIFIER
 
+// ----------------------------------------------------------------------------
+// wxFormatLiteral: format string parsed at compile-time
+// ----------------------------------------------------------------------------
+
+// Parsing the format string at compile-time requires relaxed constexpr
+// functions support, which is only available since C++14 (and MSVC 2017).
+#if wxCHECK_CXX_STD(201402L) && (!defined(__VISUALC__) || __VISUALC__ >= 1910)
+    #define wxHAS_COMPILE_TIME_FORMAT_CHECK
+#endif
+
+#ifdef wxHAS_COMPILE_TIME_FORMAT_CHECK
+
+namespace wxPrivate
+{
+
+// The maximal number of arguments supported, this is the same as the limit
+// of wxPrintfConvSpecParser used at run-time.
+constexpr unsigned FormatMaxArgs = 64;
+
+// Result of parsing the format string.
+struct FormatArgTypes
+{
+    // the types of the arguments as wxFormatString::ArgumentType values
+    unsigned short types[FormatMaxArgs];
+    unsigned count;
+
+    // false if the format string is invalid, e.g. has a missing argument or
+    // uses the same positional argument with different types
+    bool ok;
+};
+
+// This function finds the types of the arguments in the same way as
+// wxPrintfConvSpecParser does at run-time.
+template <typename CharType>
+constexpr FormatArgTypes ParseFormatArgTypes(const CharType* fmt)
+{
+    FormatArgTypes res{};
+    res.ok = true;
+
+    bool posargPresent = false;
+
+    for ( const CharType* p = fmt; *p; ++p )
+    {
+        if ( *p != '%' )
+            continue;
+
+        if ( p[1] == '%' )
+        {
+            ++p;
+            continue;
+        }
+
+        int ilen = 0;
+        unsigned width = 0,
+                 pos = 0,
+                 numAsterisks = 0;
+        bool inPrec = false;
+        int type = 0;
+
+        const CharType* q = p + 1;
+        for ( ; !type; ++q )
+        {
+            const CharType ch = *q;
+            switch ( ch )
+            {
+                case '#':
+                case '0':
+                case ' ':
+                case '+':
+                case '\'':
+                case '-':
+                    continue;
+
+                case '.':
+                    inPrec = true;
+                    continue;
+
+                case 'h':
+                    ilen = -1;
+                    continue;
+
+                case 'l':
+                    ilen = q[-1] == 'l' ? 2 : 1;
+                    continue;
+
+                case 'q':
+                case 'L':
+                    ilen = 2;
+                    continue;
+
+#ifdef __WINDOWS__
+                case 'I':
+                    if ( q[1] == '6' && q[2] == '4' )
+                    {
+                        q += 2;
+                        ilen = 2;
+                        continue;
+                    }
+                    wxFALLTHROUGH;
+#endif // __WINDOWS__
+
+                case 'z':
+                case 'Z':
+                    ilen = 3;
+                    continue;
+
+                case '*':
+                    numAsterisks++;
+                    continue;
+
+                case '1': case '2': case '3':
+                case '4': case '5': case '6':
+                case '7': case '8': case '9':
+                    {
+                        unsigned len = 0;
+                        for ( ; *q >= '0' && *q <= '9'; ++q )
+                            len = len*10 + (*q - '0');
+                        --q;
+
+                        if ( !inPrec )
+                            width = len;
+                    }
+                    continue;
+
+                case '$':
+                    if ( width > 0 )
+                    {
+                        pos = width;
+                        width = 0;
+                    }
+                    continue;
+
+                case 'd':
+                case 'i':
+                case 'o':
+                case 'u':
+                case 'x':
+                case 'X':
+                    switch ( ilen )
+                    {
+                        case 1:
+                            type = wxFormatString::Arg_LongInt;
+                            break;
+
+                        case 2:
+                            type = wxFormatString::Arg_LongLongInt;
+                            break;
+
+                        case 3:
+                            type = wxFormatString::Arg_Size_t;
+                            break;
+
+                        default:
+                            type = wxFormatString::Arg_Int;
+                    }
+                    break;
+
+                case 'e':
+                case 'E':
+                case 'f':
+                case 'g':
+                case 'G':
+                    type = ilen == 2 ? wxFormatString::Arg_LongDouble
+                                     : wxFormatString::Arg_Double;
+                    break;
+
+                case 'p':
+                    type = wxFormatString::Arg_Pointer;
+                    break;
+
+                case 'c':
+                    type = wxFormatString::Arg_Char;
+                    break;
+
+                case 's':
+                    type = wxFormatString::Arg_String;
+                    break;
+
+                case 'n':
+                    type = ilen == 0 ? wxFormatString::Arg_IntPtr
+                                     : ilen == -1 ? wxFormatString::Arg_ShortIntPtr
+                                                  : wxFormatString::Arg_LongIntPtr;
+                    break;
+
+                default:
+                    // not a valid conversion specification, ignore it just
+                    // as wxPrintfConvSpecParser does
+                    type = -1;
+            }
+        }
+
+        if ( type == -1 )
+            continue;
+
+        p = q - 1;
+
+        // each asterisk takes an int argument preceding the value itself
+        for ( unsigned n = 0; n < numAsterisks; n++ )
+        {
+            // this is not supported by our printf() implementation
+            if ( posargPresent || res.count == FormatMaxArgs )
+            {
+                res.ok = false;
+                return res;
+            }
+
+            res.types[res.count++] = wxFormatString::Arg_Int;
+        }
+
+        unsigned index = 0;
+        if ( pos > 0 )
+        {
+            index = pos - 1;
+            if ( index >= FormatMaxArgs )
+            {
+                res.ok = false;
+                return res;
+            }
+
+            if ( index >= res.count )
+                res.count = index + 1;
+            else if ( res.types[index] && res.types[index] != type )
+                res.ok = false;
+
+            posargPresent = true;
+        }
+        else // not a positional argument
+        {
+            if ( res.count == FormatMaxArgs )
+            {
+                res.ok = false;
+                return res;
+            }
+
+            index = res.count++;
+        }
+
+        res.types[index] = static_cast<unsigned short>(type);
+    }
+
+    // all arguments must be used, as the missing ones would be invalid
+    for ( unsigned n = 0; n < res.count; n++ )
+    {
+        if ( !res.types[n] )
+            res.ok = false;
+    }
+
+    return res;
+}
+
+// Check that the arguments of the given types can be used with this format.
+constexpr bool
+FormatArgTypesMatch(const FormatArgTypes& fmt, const int* args, unsigned numArgs)
+{
+    // as with the run-time check, extra arguments are allowed
+    if ( !fmt.ok || fmt.count > numArgs )
+        return false;
+
+    for ( unsigned n = 0; n < fmt.count; n++ )
+    {
+        if ( (fmt.types[n] & args[n]) != fmt.types[n] )
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace wxPrivate
+
+// This class is used for the format strings created by wxFORMAT() macro: its
+// template parameter provides the static Get() function returning the string
+// literal, which is parsed at compile-time.
+template <typename F>
+class wxFormatLiteral
+{
+public:
+    static constexpr const wxStringCharType* GetString() { return F::Get(); }
+
+    static constexpr bool IsOk() { return ms_argTypes.ok; }
+    static constexpr unsigned GetArgCount() { return ms_argTypes.count; }
+    static constexpr const unsigned short* GetArgTypes() { return ms_argTypes.types; }
+
+    // Check that the arguments of the given types can be used with this
+    // format string, this is used by the functions taking wxFormatLiteral.
+    template <typename... Targs>
+    static void CheckArgs()
+    {
+        static_assert( IsOk(), "invalid format string" );
+        static_assert( ArgsMatch<Targs...>(),
+                       "format specifiers don't match the arguments" );
+    }
+
+private:
+    template <typename... Targs>
+    static constexpr bool ArgsMatch()
+    {
+        // the extra element avoids having an empty array without arguments
+        constexpr int argTypes[] = { wxFormatStringSpecifier<Targs>::value..., 0 };
+
+        return wxPrivate::FormatArgTypesMatch(ms_argTypes, argTypes,
+                                              sizeof...(Targs));
+    }
+
+    static constexpr wxPrivate::FormatArgTypes
+        ms_argTypes = wxPrivate::ParseFormatArgTypes(F::Get());
+};
+
+template <typename F>
+constexpr wxPrivate::FormatArgTypes wxFormatLiteral<F>::ms_argTypes;
+
+// Use this macro for the format string literal to check it and the arguments
+// types at compile-time instead of doing it at run-time: this both detects
+// the errors earlier and makes formatting faster.
+#define wxFORMAT(s)                                                           \
+    ([]()                                                                     \
+    {                                                                         \
+        struct wxFormatLiteralString                                          \
+        {                                                                     \
+            static constexpr const wxStringCharType* Get() { return wxS(s); } \
+        };                                                                    \
+        return wxFormatLiteral<wxFormatLiteralString>();                      \
+    }())
+
+#else // !wxHAS_COMPILE_TIME_FORMAT_CHECK
+
+// Without compile-time checks, just use the string as is.
+#define wxFORMAT(s) wxS(s)
+
+#endif // wxHAS_COMPILE_TIME_FORMAT_CHECK/!wxHAS_COMPILE_TIME_FORMAT_CHECK
+
+
 
 // Converts an argument passed to wxPrint etc. into standard form expected,
 // by wxXXX functions, e.g. all strings (wxString, char*, wchar_t*) are
@@ -0,0 +1,451 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool and related classes
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+
+#include "wx/event.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#if wxUSE_EXCEPTIONS
+    #include <exception>
+#endif // wxUSE_EXCEPTIONS
+
+class wxThreadPool;
+class wxThreadPoolWorker;
+
+// ----------------------------------------------------------------------------
+// wxTask: a unit of work executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxTask
+{
+public:
+    wxTask() = default;
+    virtual ~wxTask() = default;
+
+    // Called by one of the pool threads to execute the task.
+    virtual void Run() = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxTask);
+};
+
+// ----------------------------------------------------------------------------
+// wxCancellationToken: allows cancelling the tasks
+// ----------------------------------------------------------------------------
+
+// All copies of the token share the same state, so cancelling any of them
+// cancels all the tasks using any copy of it.
+class wxCancellationToken
+{
+public:
+    wxCancellationToken()
+        : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    void Cancel() { *m_cancelled = true; }
+
+    bool IsCancelled() const { return *m_cancelled; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+// ----------------------------------------------------------------------------
+// wxFutureStateBase and wxFutureState: implementation of wxFuture
+// ----------------------------------------------------------------------------
+
+// This class is used by wxFuture and its template subclass below and
+// shouldn't be used directly.
+class WXDLLIMPEXP_BASE wxFutureStateBase
+{
+public:
+    wxFutureStateBase();
+    virtual ~wxFutureStateBase();
+
+    bool IsReady() const { return m_ready.load(); }
+
+    // Can only be called once the state is ready.
+    bool IsCancelled() const { return m_cancelled; }
+
+    // Block until the state becomes ready. If called from a pool thread,
+    // other tasks are executed while waiting.
+    void Wait();
+
+    // Call the given function from the thread making this state ready or
+    // immediately if it's already ready.
+    void OnReady(const std::function<void()>& func);
+
+    // Call the given function in the main thread, using wxTheApp, once this
+    // state is ready.
+    void CallAfterReady(const std::function<void()>& func);
+
+    void SetCancelled();
+
+#if wxUSE_EXCEPTIONS
+    void SetException(std::exception_ptr exception);
+
+    void RethrowIfFailed() const;
+#endif // wxUSE_EXCEPTIONS
+
+protected:
+    // Must be called by the derived class once it has stored the value.
+    void SetReady();
+
+private:
+    std::atomic<bool> m_ready;
+    bool m_cancelled = false;
+
+#if wxUSE_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif // wxUSE_EXCEPTIONS
+
+    wxMutex m_mutex;
+    wxCondition m_condition;
+
+    // Functions to call once the state becomes ready, protected by m_mutex.
+    wxVector<std::function<void()>> m_onReady;
+
+    // Pools whose worker threads are waiting for this state, which must be
+    // woken up when it becomes ready, also protected by m_mutex.
+    wxVector<wxThreadPool*> m_waitingPools;
+
+    wxDECLARE_NO_COPY_CLASS(wxFutureStateBase);
+};
+
+template <typename T>
+class wxFutureState : public wxFutureStateBase
+{
+public:
+    wxFutureState() = default;
+
+    template <typename F>
+    void SetFromResultOf(F& func)
+    {
+        m_value.reset(new T(func()));
+        SetReady();
+    }
+
+    T GetValue() const
+    {
+        // We can't return anything if T is not default-constructible.
+        if ( !m_value )
+        {
+            wxFAIL_MSG( "no value in a cancelled wxFuture" );
+            wxAbort();
+        }
+
+        return *m_value;
+    }
+
+private:
+    std::unique_ptr<T> m_value;
+};
+
+template <>
+class wxFutureState<void> : public wxFutureStateBase
+{
+public:
+    wxFutureState() = default;
+
+    template <typename F>
+    void SetFromResultOf(F& func)
+    {
+        func();
+        SetReady();
+    }
+
+    void GetValue() const
+    {
+    }
+};
+
+// ----------------------------------------------------------------------------
+// wxFuture: result of a task executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+template <typename T>
+class wxFuture
+{
+public:
+    // Default constructor creates an invalid future.
+    wxFuture() = default;
+
+    // For internal use by wxThreadPool only.
+    explicit wxFuture(const std::shared_ptr<wxFutureState<T>>& state)
+        : m_state(state)
+    {
+    }
+
+    bool IsValid() const { return m_state != nullptr; }
+
+    bool IsReady() const
+    {
+        wxCHECK_MSG( m_state, false, "invalid wxFuture" );
+
+        return m_state->IsReady();
+    }
+
+    // Wait until the task completes.
+    void Wait() const
+    {
+        wxCHECK_RET( m_state, "invalid wxFuture" );
+
+        m_state->Wait();
+    }
+
+    // Wait until the task completes and return true if it was cancelled.
+    bool IsCancelled() const
+    {
+        wxCHECK_MSG( m_state, false, "invalid wxFuture" );
+
+        m_state->Wait();
+
+        return m_state->IsCancelled();
+    }
+
+    // Wait until the task completes and return its result. If the task threw
+    // an exception, it is rethrown by this function. The task must not have
+    // been cancelled.
+    T Get() const
+    {
+        if ( !m_state )
+        {
+            wxFAIL_MSG( "invalid wxFuture" );
+            wxAbort();
+        }
+
+        m_state->Wait();
+
+#if wxUSE_EXCEPTIONS
+        m_state->RethrowIfFailed();
+#endif // wxUSE_EXCEPTIONS
+
+        return m_state->GetValue();
+    }
+
+    // Call the given function taking this future as argument in the main
+    // thread once the task completes, using handler->CallAfter(). The handler
+    // must not be destroyed before the task completes.
+    template <typename F>
+    void Then(wxEvtHandler* handler, F func) const
+    {
+        wxCHECK_RET( m_state, "invalid wxFuture" );
+
+        const wxFuture<T> self(*this);
+        m_state->OnReady([handler, self, func]()
+            {
+                handler->CallAfter([self, func]() { func(self); });
+            });
+    }
+
+    // Same as above, but uses wxTheApp->CallAfter().
+    template <typename F>
+    void Then(F func) const
+    {
+        wxCHECK_RET( m_state, "invalid wxFuture" );
+
+        const wxFuture<T> self(*this);
+        m_state->CallAfterReady([self, func]() { func(self); });
+    }
+
+private:
+    std::shared_ptr<wxFutureState<T>> m_state;
+};
+
+// ----------------------------------------------------------------------------
+// wxFutureTask: task computing the value of a wxFuture
+// ----------------------------------------------------------------------------
+
+template <typename T, typename F>
+class wxFutureTask : public wxTask
+{
+public:
+    wxFutureTask(const F& func,
+                 const std::shared_ptr<wxFutureState<T>>& state,
+                 const wxCancellationToken* token)
+        : m_func(func),
+          m_state(state)
+    {
+        if ( token )
+            m_token.reset(new wxCancellationToken(*token));
+    }
+
+    virtual void Run() override
+    {
+        if ( m_token && m_token->IsCancelled() )
+        {
+            m_state->SetCancelled();
+            return;
+        }
+
+#if wxUSE_EXCEPTIONS
+        try
+        {
+            m_state->SetFromResultOf(m_func);
+        }
+        catch ( ... )
+        {
+            m_state->SetException(std::current_exception());
+        }
+#else // !wxUSE_EXCEPTIONS
+        m_state->SetFromResultOf(m_func);
+#endif // wxUSE_EXCEPTIONS/!wxUSE_EXCEPTIONS
+    }
+
+private:
+    F m_func;
+    const std::shared_ptr<wxFutureState<T>> m_state;
+    std::unique_ptr<wxCancellationToken> m_token;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: a pool of threads executing tasks
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of threads or, by default, with as
+    // many threads as there are CPUs.
+    explicit wxThreadPool(unsigned numThreads = 0);
+
+    // Waits until all the tasks complete.
+    ~wxThreadPool();
+
+    // Get the global pool, creating it on first use.
+    static wxThreadPool& Get();
+
+    unsigned GetThreadCount() const;
+
+    // Execute the task, taking ownership of it, in one of the pool threads.
+    void Post(wxTask* task);
+
+    // Execute the given function in one of the pool threads, optionally only
+    // if the token is not cancelled before it starts running.
+    template <typename F>
+    auto Submit(F func) -> wxFuture<decltype(func())>
+    {
+        return DoSubmit(func, nullptr);
+    }
+
+    template <typename F>
+    auto Submit(F func, const wxCancellationToken& token)
+        -> wxFuture<decltype(func())>
+    {
+        return DoSubmit(func, &token);
+    }
+
+    // Call func(i) for all i in [begin, end) range using all pool threads and
+    // the current one and return when all calls complete.
+    //
+    // If grainSize is 0, the range is split in the reasonable number of
+    // chunks, otherwise the calls for grainSize consecutive values of i are
+    // never split between threads.
+    template <typename F>
+    void ParallelFor(size_t begin, size_t end, F func, size_t grainSize = 0)
+    {
+        DoParallelFor(begin, end, grainSize,
+                      [&func](size_t from, size_t to)
+                      {
+                          for ( size_t n = from; n < to; ++n )
+                              func(n);
+                      });
+    }
+
+    // Execute one of the pending tasks in the current thread, if any, and
+    // return true or return false if there are no pending tasks.
+    bool RunPendingTask();
+
+private:
+    // Create the pool without any threads, executing all tasks synchronously.
+    struct NoThreadsTag { };
+    explicit wxThreadPool(NoThreadsTag);
+
+    template <typename F>
+    auto DoSubmit(F& func, const wxCancellationToken* token)
+        -> wxFuture<decltype(func())>
+    {
+        typedef decltype(func()) T;
+
+        std::shared_ptr<wxFutureState<T>> state(new wxFutureState<T>);
+        Post(new wxFutureTask<T, F>(func, state, token));
+
+        return wxFuture<T>(state);
+    }
+
+    void DoParallelFor(size_t begin,
+                       size_t end,
+                       size_t grainSize,
+                       const std::function<void (size_t, size_t)>& func);
+
+    // Get the next task to execute by the given worker, which may be null if
+    // this is called from outside of the pool.
+    wxTask* GetTaskFor(wxThreadPoolWorker* worker);
+
+    // Execute the task and delete it.
+    void RunTask(wxTask* task);
+
+    // Wake up a sleeping worker, if any.
+    void WakeUpWorker();
+
+    // Wake up all workers, including the ones waiting for a future.
+    void WakeUpAll();
+
+    // Execute the pending tasks in the current worker thread until the given
+    // state becomes ready.
+    void WaitExecutingTasks(const wxFutureStateBase& state);
+
+    // The main function of the worker threads.
+    void WorkerMain(wxThreadPoolWorker* worker);
+
+
+    wxVector<wxThreadPoolWorker*> m_workers;
+
+    // The number of workers which were successfully started.
+    unsigned m_numRunning = 0;
+
+    // The queue of the tasks posted from outside of the pool threads, which
+    // are posted to the posting worker own queue otherwise.
+    struct Queue;
+    Queue* const m_injected;
+
+    // The number of the tasks in all the queues.
+    std::atomic<size_t> m_numQueued;
+
+    // The number of workers, including the ones waiting for a future in
+    // WaitExecutingTasks(), waiting for m_wakeUpCondition.
+    std::atomic<unsigned> m_numSleeping;
+
+    // Set when the pool is being destroyed.
+    std::atomic<bool> m_stopping;
+
+    wxMutex m_wakeUpMutex;
+    wxCondition m_wakeUpCondition;
+
+    friend class wxThreadPoolWorker;
+    friend class wxFutureStateBase;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
@@ -138,6 +138,129 @@ protected:
     wxChar   m_lastDelim;           // delimiter after last token or '\0'
 };
 
+// ----------------------------------------------------------------------------
+// wxStringTokenView: non-owning reference to a part of a string
+// ----------------------------------------------------------------------------
+
+// Notice that the data referenced by this object is not NUL-terminated and its
+// size is in wxStringCharType units, i.e. bytes in UTF-8 build.
+class wxStringTokenView
+{
+public:
+    wxStringTokenView() : m_data(nullptr), m_len(0) { }
+    wxStringTokenView(const wxStringCharType* data, size_t len)
+        : m_data(data), m_len(len) { }
+
+    const wxStringCharType* data() const { return m_data; }
+    size_t size() const { return m_len; }
+    bool empty() const { return m_len == 0; }
+
+    // create a new string with the contents of this token
+    wxString ToString() const
+    {
+#if wxUSE_UNICODE_UTF8
+        return wxString::FromUTF8Unchecked(m_data, m_len);
+#else
+        return wxString(m_data, m_len);
+#endif
+    }
+
+    bool IsSameAs(const wxString& str) const
+    {
+#if wxUSE_UNICODE_UTF8
+        const size_t len = str.utf8_length();
+#else
+        const size_t len = str.length();
+#endif
+        return len == m_len &&
+                std::char_traits<wxStringCharType>::compare(m_data,
+                                                            str.wx_str(),
+                                                            len) == 0;
+    }
+
+#ifdef wxHAS_STD_STRING_VIEW
+    std::basic_string_view<wxStringCharType> ToStdStringView() const
+        { return std::basic_string_view<wxStringCharType>(m_data, m_len); }
+#endif // wxHAS_STD_STRING_VIEW
+
+    friend bool operator==(const wxStringTokenView& t, const wxString& s)
+        { return t.IsSameAs(s); }
+    friend bool operator==(const wxString& s, const wxStringTokenView& t)
+        { return t.IsSameAs(s); }
+    friend bool operator!=(const wxStringTokenView& t, const wxString& s)
+        { return !t.IsSameAs(s); }
+    friend bool operator!=(const wxString& s, const wxStringTokenView& t)
+        { return !t.IsSameAs(s); }
+
+private:
+    const wxStringCharType* m_data;
+    size_t m_len;
+};
+
+// ----------------------------------------------------------------------------
+// wxStringViewTokenizer: tokenizer returning views into the original string
+// ----------------------------------------------------------------------------
+
+// This class works in the same way as wxStringTokenizer but doesn't copy the
+// string being tokenized nor the tokens, so the string must not be modified
+// nor destroyed while it is used.
+class WXDLLIMPEXP_BASE wxStringViewTokenizer
+{
+public:
+    wxStringViewTokenizer(const wxString& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT);
+    wxStringViewTokenizer(const wxStringTokenView& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT);
+
+    // the tokens would refer to the already destroyed string if this were
+    // allowed
+    wxStringViewTokenizer(wxString&& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT) = delete;
+
+    // same as wxStringTokenizer methods with the same names
+    size_t CountTokens() const;
+    bool HasMoreTokens() const;
+    wxStringTokenView GetNextToken();
+    wxChar GetLastDelimiter() const { return m_lastDelim; }
+    wxStringTokenizerMode GetMode() const { return m_mode; }
+    bool AllowEmpty() const { return m_mode != wxTOKEN_STRTOK; }
+
+    // returns the part of the string which remains to tokenize
+    wxStringTokenView GetString() const
+        { return wxStringTokenView(m_pos, m_end - m_pos); }
+
+private:
+    void Init(const wxStringCharType* str, size_t len,
+              const wxString& delims, wxStringTokenizerMode mode);
+
+    // returns the length of the delimiter at the given position or 0
+    size_t GetDelimLength(const wxStringCharType* p) const;
+
+    const wxStringCharType* FindDelim(const wxStringCharType* from) const;
+    const wxStringCharType* FindNonDelim(const wxStringCharType* from) const;
+
+    const wxStringCharType* m_start;    // the string we tokenize
+    const wxStringCharType* m_end;
+    const wxStringCharType* m_pos;      // the current position in it
+
+    // the first non-delimiter character at or after m_pos or nullptr if not
+    // computed yet, this is used to avoid rescanning the string in
+    // HasMoreTokens() when it is called repeatedly
+    mutable const wxStringCharType* m_nonDelim;
+
+    wxStringImpl m_delims;              // all possible delimiters
+    wxUint32 m_asciiDelims[4];          // bit mask of ASCII delimiters
+    bool m_hasNonASCIIDelims;
+    wxStringCharType m_singleDelim;     // the only delimiter or NUL
+
+    wxStringTokenizerMode m_mode;       // never wxTOKEN_DEFAULT
+
+    wxChar m_lastDelim;                 // delimiter after last token or '\0'
+};
+
 // ----------------------------------------------------------------------------
 // convenience function which returns all tokens at once
 // ----------------------------------------------------------------------------
@@ -14,7 +14,7 @@
 
 #include "wx/private/timer.h"
 
-#include <list>
+#include <vector>
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -45,8 +45,16 @@ public:
         m_isRunning = false;
     }
 
+    // for wxTimerScheduler only: the position of this timer in its heap
+    static const size_t NOT_SCHEDULED = static_cast<size_t>(-1);
+
+    size_t GetScheduleIndex() const { return m_scheduleIndex; }
+    void SetScheduleIndex(size_t index) { m_scheduleIndex = index; }
+
 private:
     bool m_isRunning;
+
+    size_t m_scheduleIndex;
 };
 
 // ----------------------------------------------------------------------------
@@ -55,21 +63,40 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    wxUint64 order)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_order(order)
     {
     }
 
+    // return true if this timer must be notified before the other one
+    bool IsBefore(const wxTimerSchedule& other) const
+    {
+        if ( m_expiration != other.m_expiration )
+            return m_expiration < other.m_expiration;
+
+        // timers expiring at the same time are notified in the order in which
+        // they were added
+        return m_order < other.m_order;
+    }
+
     // the timer itself (we don't own this pointer)
     wxUnixTimerImpl *m_timer;
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
+
+    // the sequential number of this schedule
+    wxUint64 m_order;
 };
 
-// the linked list of all active timers, we keep it sorted by expiration time
-using wxTimerList = std::list<wxTimerSchedule>;
+// all active timers are kept in a binary heap ordered by expiration time: its
+// first element is the timer expiring first and each timer knows its index in
+// it, so that it can be both added and removed in logarithmic time
+using wxTimerHeap = std::vector<wxTimerSchedule>;
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -123,12 +150,30 @@ private:
     wxTimerScheduler() = default;
     ~wxTimerScheduler() = default;
 
-    // add the given timer schedule to the list in the right place
-    void DoAddTimer(const wxTimerSchedule& s);
+    // add the given timer schedule to the heap in the right place
+    void DoAddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration);
+
+    // remove the element at the given index from the heap
+    void DoRemoveAt(size_t index);
+
+    // move the element at the given index up or down the heap until it is
+    // at the right place
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+
+    // put the given schedule at the given index in the heap
+    void PlaceAt(size_t index, const wxTimerSchedule& s)
+    {
+        m_timers[index] = s;
+        s.m_timer->SetScheduleIndex(index);
+    }
+
 
+    // the heap of all currently active timers
+    wxTimerHeap m_timers;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // the order of the next added timer, see wxTimerSchedule::m_order
+    wxUint64 m_nextOrder = 0;
 
     static wxTimerScheduler *ms_instance;
 };
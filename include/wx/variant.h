@@ -230,6 +230,15 @@ public:
     inline operator wxString () const {  return MakeString(); }
     wxString GetString() const;
 
+    // wxStringAtom: the atom itself is stored, without copying the string
+    wxVariant(const wxStringAtom& val, const wxString& name = wxEmptyString);
+    bool operator==(const wxStringAtom& value) const
+        { return operator==(value.GetString()); }
+    bool operator!=(const wxStringAtom& value) const
+        { return operator!=(value.GetString()); }
+    wxVariant& operator=(const wxStringAtom& value);
+    wxStringAtom GetStringAtom() const;
+
 #ifndef wxNO_IMPLICIT_WXSTRING_ENCODING
     wxVariant(const std::string& val, const wxString& name = wxEmptyString);
     bool operator==(const std::string& value) const
@@ -273,6 +273,27 @@ int wxFprintf(FILE* fp, const wxFormatString& format, Targs... args)
 #endif // !wxUSE_UTF8_LOCALE_ONLY
 }
 
+#ifdef wxHAS_COMPILE_TIME_FORMAT_CHECK
+
+// overloads checking the arguments of wxFORMAT() strings at compile-time
+template <typename F, typename... Targs>
+int wxPrintf(const wxFormatLiteral<F>& format, Targs... args)
+{
+    wxFormatLiteral<F>::template CheckArgs<Targs...>();
+
+    return wxPrintf(wxFormatString(format), args...);
+}
+
+template <typename F, typename... Targs>
+int wxFprintf(FILE* fp, const wxFormatLiteral<F>& format, Targs... args)
+{
+    wxFormatLiteral<F>::template CheckArgs<Targs...>();
+
+    return wxFprintf(fp, wxFormatString(format), args...);
+}
+
+#endif // wxHAS_COMPILE_TIME_FORMAT_CHECK
+
 wxGCC_ONLY_WARNING_RESTORE(format-security)
 wxGCC_ONLY_WARNING_RESTORE(format-nonliteral)
 
@@ -379,9 +379,23 @@ public:
 
         Constructs a sorted array with the same contents as the (possibly
         unsorted) @a array argument.
+
+        Note that, since wxWidgets 3.3.3, the elements are sorted only once
+        after copying all of them, which is much faster than adding them to
+        the sorted array one by one for big arrays.
     */
     wxSortedArrayString(const wxArrayString& array);
 
+    /**
+        Constructs a sorted array by taking the strings from the given array.
+
+        This is similar to the constructor taking a const reference, but
+        avoids copying the strings. The @a array argument is left empty.
+
+        @since 3.3.3
+    */
+    wxSortedArrayString(wxArrayString&& array);
+
     /**
         @copydoc wxArrayString::Add()
 
@@ -402,6 +416,41 @@ public:
     int Index(const wxString& str, bool bCase = true,
               bool bFromEnd = false) const;
 
+    /**
+        Adds all elements of another sorted array to this one.
+
+        This function is much more efficient than calling Add() for all
+        elements of @a other, as it only needs linear time to merge two sorted
+        arrays together.
+
+        Both arrays must use the same comparison function and merging an array
+        with itself is not allowed.
+
+        The overload taking an rvalue reference moves the strings from @a other
+        instead of copying them and leaves it empty.
+
+        @since 3.3.3
+    */
+    void Merge(const wxSortedArrayString& other);
+
+    /// @overload
+    void Merge(wxSortedArrayString&& other);
+
+    /**
+        Removes duplicate elements from the array.
+
+        Only the first element of each group of consecutive equal elements is
+        kept, with equality defined by the comparison function used by this
+        array. This function can be used after Merge() or after constructing
+        the array from an unsorted wxArrayString to get a sorted array of
+        unique strings.
+
+        @return The number of removed elements.
+
+        @since 3.3.3
+    */
+    size_t RemoveDuplicates();
+
     /**
         @warning This function should not be used with sorted arrays because it
                  could break the order of items and, for example, subsequent calls
@@ -189,3 +189,107 @@ wxMemoryBuffer wxBase64Decode(const wxString& src,
 
 ///@}
 
+
+/**
+    @class wxBase64InputStream
+
+    This filter stream decodes base64 data read from another stream.
+
+    Decoding is done chunk by chunk, so this class can be used for decoding
+    data of any size without having to keep all of it in memory, e.g.:
+    @code
+    wxFFileInputStream fin("image.b64");
+    wxBase64InputStream b64in(fin);
+    wxImage image(b64in, wxBITMAP_TYPE_PNG);
+    @endcode
+
+    Notice that by default white space in the input is ignored, as base64
+    data is often split into multiple lines, unlike with wxBase64Decode()
+    which uses ::wxBase64DecodeMode_Strict by default. An error is returned
+    if the input ends in the middle of an encoded group of characters, i.e.
+    if its length, not counting any skipped characters, is not a multiple of
+    4.
+
+    @library{wxbase}
+    @category{streams}
+
+    @see wxBase64OutputStream, wxBase64Decode()
+
+    @since 3.3.3
+*/
+class wxBase64InputStream : public wxFilterInputStream
+{
+public:
+    /**
+        Create decoding stream associated with the given underlying stream.
+
+        This overload does not take ownership of the @a stream.
+
+        @param stream
+            The stream to read base64 data from.
+        @param mode
+            Specifies how to handle the characters which can't occur in
+            base64 data, see ::wxBase64DecodeMode.
+    */
+    wxBase64InputStream(wxInputStream& stream,
+                        wxBase64DecodeMode mode = wxBase64DecodeMode_SkipWS);
+
+    /**
+        Create decoding stream associated with the given underlying stream
+        and takes ownership of it.
+
+        As with the base wxFilterInputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+    */
+    wxBase64InputStream(wxInputStream* stream,
+                        wxBase64DecodeMode mode = wxBase64DecodeMode_SkipWS);
+};
+
+/**
+    @class wxBase64OutputStream
+
+    This filter stream encodes the data written to it using base64 and writes
+    the result to another stream.
+
+    As base64 encodes groups of 3 bytes, up to 2 last bytes written to this
+    stream are only encoded, with the appropriate padding, when it is closed,
+    so Close() must be called, either explicitly or by destroying this
+    object, to ensure that all data is written to the underlying stream.
+
+    No line breaks are inserted into the output.
+
+    @library{wxbase}
+    @category{streams}
+
+    @see wxBase64InputStream, wxBase64Encode()
+
+    @since 3.3.3
+*/
+class wxBase64OutputStream : public wxFilterOutputStream
+{
+public:
+    /**
+        Create encoding stream associated with the given underlying stream.
+
+        This overload does not take ownership of the @a stream.
+    */
+    wxBase64OutputStream(wxOutputStream& stream);
+
+    /**
+        Create encoding stream associated with the given underlying stream
+        and takes ownership of it.
+
+        As with the base wxFilterOutputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+    */
+    wxBase64OutputStream(wxOutputStream* stream);
+
+    /**
+        Encode any remaining data and close the stream.
+
+        This also closes the underlying stream if this object owns it.
+    */
+    bool Close();
+};
@@ -265,6 +265,11 @@ public:
         It is also possible to not return any value, in which case nothing will
         be shown in the corresponding cell, in the same way as if HasValue()
         returned @false.
+
+        For text columns with many repeated values, the model can store them
+        as wxStringAtom and assign them to @a variant directly, which avoids
+        both keeping a separate copy of the string for each item and copying
+        it every time this function is called.
     */
     virtual void GetValue(wxVariant& variant, const wxDataViewItem& item,
                           unsigned int col) const = 0;
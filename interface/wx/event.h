@@ -423,10 +423,11 @@ public:
         moment).
 
         QueueEvent() can be used for inter-thread communication from the worker
-        threads to the main thread. It is safe in the sense that it uses
-        locking internally and avoids the problem mentioned in AddPendingEvent()
-        documentation by ensuring that the @a event object is not used by the
-        calling thread any more.
+        threads to the main thread. It is safe in the sense that it can be
+        called from several threads at once and avoids the problem mentioned
+        in AddPendingEvent() documentation by ensuring that the @a event object
+        is not used by the calling thread any more. Notice that it doesn't
+        use any locks, so threads queuing events don't block each other.
 
         Example:
         @code
@@ -465,6 +466,63 @@ public:
      */
     virtual void QueueEvent(wxEvent *event);
 
+    /**
+        Queue several events for a later processing at once.
+
+        This function is equivalent to calling QueueEvent() for all elements
+        of @a events, in order, but is more efficient, as the event loop is
+        woken up only once for all of them.
+
+        Notice that, unlike QueueEvent(), this function is not virtual, so it
+        doesn't call QueueEvent() overridden in the derived classes.
+
+        @since 3.3.3
+
+        @param events
+            Heap-allocated events to be queued, the function takes ownership
+            of all of them. None of them may be @NULL.
+     */
+    void QueueEvents(const wxVector<wxEvent*>& events);
+
+    /**
+        Queue event for a later processing, replacing the previous one.
+
+        This function is similar to QueueEvent(), but if an event with the
+        same type and ID was queued by a previous call to this function and
+        is still pending, it is replaced by the new @a event instead of
+        adding another event to the queue. The new event takes the place of
+        the old one in the queue, i.e. it's processed before all the events
+        queued after the old one, and the old event is deleted. The event
+        loop is not woken up again in this case.
+
+        This is useful for the events which can be posted very frequently,
+        e.g. progress updates sent from a worker thread, and when only the last
+        of them is important: in this case, no more than one event with the
+        given type and ID is processed during each event loop iteration, no
+        matter how many of them were queued.
+
+        Example:
+        @code
+            void FunctionInAWorkerThread(wxEvtHandler* handler, int progress)
+            {
+                wxThreadEvent* evt = new wxThreadEvent(wxEVT_THREAD, ID_PROGRESS);
+                evt->SetInt(progress);
+
+                handler->QueueOrReplaceEvent( evt );
+            }
+        @endcode
+
+        Notice that this function can be safely called from any thread, just
+        as QueueEvent(), but it uses a lock to find the event to replace.
+
+        @since 3.3.3
+
+        @param event
+            A heap-allocated event to be queued, the function takes ownership
+            of it. This parameter shouldn't be @NULL.
+     */
+    void QueueOrReplaceEvent(wxEvent *event);
+
     /**
         Post an event to be processed later.
 
@@ -104,6 +104,38 @@ enum wxImageAlphaBlendMode
     wxIMAGE_ALPHA_BLEND_COMPOSE = 1
 };
 
+/**
+    Layouts of the pixels in the external buffers used with wxImageView.
+
+    @since 3.3.3
+*/
+enum wxImagePixelFormat
+{
+    /// 3 bytes per pixel: red, green and blue, as used by wxImage itself.
+    wxIMAGE_FORMAT_RGB,
+
+    /// 4 bytes per pixel: red, green, blue and non-premultiplied alpha.
+    wxIMAGE_FORMAT_RGBA,
+
+    /// 4 bytes per pixel: blue, green, red and non-premultiplied alpha.
+    wxIMAGE_FORMAT_BGRA,
+
+    /// 1 byte per pixel: grey level.
+    wxIMAGE_FORMAT_GRAY,
+
+    /**
+        32-bit integers in native byte order, with alpha in the most
+        significant byte followed by red, green and blue premultiplied by
+        alpha.
+
+        This is the format used by Cairo @c CAIRO_FORMAT_ARGB32 surfaces and
+        by many other graphics APIs, so the buffers in this format can be
+        passed to them directly. Both the pointer to the data and the stride
+        must be multiples of 4 when using it.
+    */
+    wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED
+};
+
 /**
     Possible values for PNG image type option.
 
@@ -175,6 +207,161 @@ enum
 };
 
 
+/**
+    @class wxImageRowReader
+
+    Object allowing to decode an image incrementally.
+
+    Objects of this class are returned by wxImage::CreateRowReader() and
+    wxImageHandler::CreateRowReader() and can be used to read the image a few
+    rows at a time instead of loading all of it in memory at once, as
+    wxImage::LoadFile() does. This is useful for processing images which are
+    too big to be loaded entirely, e.g. to create a thumbnail for them by
+    scaling down each group of rows as soon as it's read, or to split them
+    in several smaller images.
+
+    Currently this is supported by wxPNGHandler, wxJPEGHandler and
+    wxTIFFHandler. Note that the memory needed for decoding some kinds of
+    images still depends on the total image size: this is the case for
+    interlaced PNG images and TIFF images which are not stored in the usual
+    top to bottom order, which need to be decoded entirely before the first
+    row can be returned, and, more generally, TIFF images are decoded one
+    strip or tile at a time, so the memory used depends on their size.
+
+    Example of using this class:
+    @code
+    wxFileInputStream stream("huge.png");
+    std::unique_ptr<wxImageRowReader> reader(wxImage::CreateRowReader(stream));
+    if ( !reader )
+        return false; // the error was already logged
+
+    while ( !reader->IsDone() )
+    {
+        wxImage strip = reader->ReadImage(64);
+        if ( !strip.IsOk() )
+            return false;
+
+        ... process the rows from reader->GetCurrentRow() - strip.GetHeight() ...
+    }
+    @endcode
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.3
+*/
+class wxImageRowReader
+{
+public:
+    /**
+        Destroys the reader.
+
+        The reader doesn't own the stream it reads from, so it is not
+        destroyed, but it must not be destroyed before the reader.
+    */
+    virtual ~wxImageRowReader();
+
+    /// Returns the width of the image.
+    int GetWidth() const;
+
+    /// Returns the height of the image, i.e. the total number of rows.
+    int GetHeight() const;
+
+    /**
+        Returns @true if the image may contain non-opaque pixels.
+
+        If this function returns @true, ReadRows() returns the alpha values
+        of the image too. Note that it doesn't mean that the image has any
+        pixels which are not fully opaque: this can't be known before reading
+        all of it.
+    */
+    bool HasAlpha() const;
+
+    /**
+        Returns the index of the next row to be read.
+
+        This is 0 initially and GetHeight() after reading all rows.
+    */
+    int GetCurrentRow() const;
+
+    /**
+        Returns @false if an error occurred while reading the image.
+
+        Once an error occurs, no more rows can be read.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns @true if all the rows have been read or an error occurred.
+    */
+    bool IsDone() const;
+
+    /**
+        Reads the next rows of the image into the provided buffers.
+
+        @param data
+            Buffer for RGB data, in the same format as returned by
+            wxImage::GetData(), which must be big enough to hold
+            @c 3*GetWidth()*numRows bytes. It must not be @NULL.
+        @param alpha
+            Buffer for alpha values, in the same format as returned by
+            wxImage::GetAlpha(), which must be big enough to hold
+            @c GetWidth()*numRows bytes. May be @NULL to ignore the alpha
+            values and is not used if HasAlpha() returns @false.
+        @param numRows
+            The maximal number of rows to read.
+        @return
+            The number of rows read, which may be less than @a numRows if
+            there are not enough remaining rows in the image, or 0 if all of
+            them were already read or an error occurred.
+    */
+    int ReadRows(unsigned char* data, unsigned char* alpha, int numRows);
+
+    /**
+        Reads the next rows of the image and returns them as an image.
+
+        The returned image has GetWidth() width, its height is the number of
+        rows actually read and it has alpha channel if HasAlpha() returns
+        @true.
+
+        @return
+            The image containing the rows read or an invalid image if there
+            are no more rows to read or an error occurred.
+    */
+    wxImage ReadImage(int numRows);
+
+protected:
+    /**
+        Default constructor.
+
+        SetImageInfo() must be called by the derived class once the image
+        parameters are known.
+    */
+    wxImageRowReader();
+
+    /**
+        Initializes the image parameters.
+
+        This function must be called by the derived class before the object
+        is returned to the caller.
+    */
+    void SetImageInfo(int width, int height, bool hasAlpha);
+
+    /**
+        Reads exactly @a numRows rows.
+
+        This function must be implemented in the derived class. It is only
+        called with positive @a numRows not greater than the number of
+        remaining rows, and with @a alpha being non-@NULL only if the image
+        has alpha and the caller needs it.
+
+        @return @true on success or @false if an error occurred.
+    */
+    virtual bool DoReadRows(unsigned char* data,
+                            unsigned char* alpha,
+                            int numRows) = 0;
+};
+
 /**
     @class wxImageHandler
 
@@ -330,6 +517,34 @@ public:
     virtual bool LoadFile(wxImage* image, wxInputStream& stream,
                           bool verbose = true, int index = -1);
 
+    /**
+        Creates an object allowing to read the image incrementally.
+
+        The default implementation returns @NULL, meaning that incremental
+        reading is not supported. Handlers supporting it override this
+        function to return a new reader.
+
+        @param stream
+            Opened input stream for reading image data, it must remain alive
+            while the returned reader is used.
+        @param verbose
+            If set to @true, errors reported by the image handler will produce
+            wxLogMessages.
+        @param index
+            The index of the image in the file (starting from zero).
+        @return
+            New reader object which must be deleted by the caller or @NULL
+            if incremental reading is not supported or the image header
+            couldn't be read.
+
+        @see wxImage::CreateRowReader()
+
+        @since 3.3.3
+    */
+    virtual wxImageRowReader* CreateRowReader(wxInputStream& stream,
+                                              bool verbose = true,
+                                              int index = -1);
+
     /**
         Saves an image in the output stream.
 
@@ -666,6 +881,23 @@ public:
     */
     explicit wxImage(const char* const* xpmData);
 
+    /**
+        Creates an image with a copy of the pixels of the given view.
+
+        The pixels are converted to the RGB format used by wxImage and, if
+        the view format has alpha, the image has an alpha channel too. Notice
+        that wxImage never uses premultiplied alpha, so the pixels of the
+        views using @c wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED are converted to
+        straight alpha, which is lossy for the partially transparent ones.
+
+        This constructor can also be used to create a wxBitmap from the pixels
+        in an external buffer, i.e. @c wxBitmap(wxImage(view)), without any
+        other intermediate copies.
+
+        @since 3.3.3
+    */
+    explicit wxImage(const wxImageView& view);
+
     /**
         Creates an image from a file.
 
@@ -843,7 +1075,9 @@ public:
         specified pixel @a blurRadius. This should not be used when using
         a single mask colour for transparency.
 
-        @see BlurHorizontal(), BlurVertical()
+        The time taken by this function doesn't depend on @a blurRadius.
+
+        @see BlurHorizontal(), BlurVertical(), GaussianBlur()
     */
     wxImage Blur(int blurRadius) const;
 
@@ -863,6 +1097,32 @@ public:
     */
     wxImage BlurVertical(int blurRadius) const;
 
+    /**
+        Blurs the image using Gaussian kernel with the given standard
+        deviation.
+
+        Gaussian blur results in a smoother and more natural looking image
+        than Blur(), which averages all pixels in a square box with equal
+        weights. This function approximates it by applying three successive
+        box blurs of appropriately chosen sizes in each direction, so, just as
+        Blur(), it takes the same time whatever the value of @a sigma is.
+
+        As with the other blur functions, the pixels outside of the image are
+        considered to be the same as the closest edge pixel and alpha channel,
+        if present, is blurred independently of the colour channels. This
+        function should not be used when using a single mask colour for
+        transparency.
+
+        @param sigma
+            Standard deviation of the Gaussian kernel in pixels, must be
+            non-negative. Passing 0 returns an unchanged copy of the image.
+
+        @see Blur()
+
+        @since 3.3.3
+    */
+    wxImage GaussianBlur(double sigma) const;
+
     /**
         Returns a mirrored copy of the image.
         The parameter @a horizontally indicates the orientation.
@@ -936,6 +1196,8 @@ public:
         Rotates the image about the given point, by @a angle radians.
 
         Passing @true to @a interpolating results in better image quality, but is slower.
+        In this case bilinear interpolation between the nearest source pixels
+        is used, otherwise the colour of the nearest pixel is taken.
 
         If the image has a mask, then the mask colour is used for the uncovered
         pixels in the rotated image background. Else, black (rgb 0, 0, 0) will be used.
@@ -1266,6 +1528,36 @@ public:
     */
     unsigned char* GetData() const;
 
+    /**
+        Copies the image pixels to the given buffer in the specified format.
+
+        This function converts the image data, and its alpha channel if the
+        format has alpha, to the interleaved layout expected by many
+        graphics APIs, using multiple threads for big images if enabled by
+        SetParallelism(). If the image has no alpha, all pixels are opaque
+        in the formats with alpha. The mask, if any, is ignored.
+
+        When copying to @c wxIMAGE_FORMAT_GRAY, the pixels are converted to
+        grey using the same weights as ConvertToGreyscale() by default.
+
+        @param data
+            Pointer to the buffer of at least @a stride multiplied by the
+            image height bytes.
+        @param format
+            Format of the pixels in the buffer.
+        @param stride
+            Offset in bytes between the starts of the consecutive rows in the
+            buffer. The default value of 0 means that the rows are packed.
+        @return @true if the data was copied or @false if the arguments
+            were invalid.
+
+        @see wxImageView
+
+        @since 3.3.3
+    */
+    bool CopyToBuffer(unsigned char* data, wxImagePixelFormat format,
+                      int stride = 0) const;
+
     /**
         Return alpha value at given pixel location.
     */
@@ -1369,14 +1661,21 @@ public:
             of these options is specified, the loaded image will be scaled down
             (preserving its aspect ratio) so that its width is less than the
             max width given if it is not 0 @em and its height is less than the
-            max height given if it is not 0. This is typically used for loading
-            thumbnails and the advantage of using these options compared to
-            calling Rescale() after loading is that some handlers (only JPEG
-            one right now) support rescaling the image during loading which is
-            vastly more efficient than loading the entire huge image and
-            rescaling it later (if these options are not supported by the
-            handler, this is still what happens however). These options must be
-            set before calling LoadFile() to have any effect.
+            max height given if it is not 0. Since wxWidgets 3.3.3, the image
+            is scaled to the biggest size satisfying these conditions, i.e.
+            its width or height is equal to the corresponding maximum, while
+            previously it was only scaled down by a power of 2. This is
+            typically used for loading thumbnails and the advantage of using
+            these options compared to calling Rescale() after loading is that
+            some handlers (only JPEG one right now) support rescaling the image
+            during loading which is vastly more efficient than loading the
+            entire huge image and rescaling it later (if these options are not
+            supported by the handler, this is still what happens however). Note
+            that such handlers only decode the image at the smallest size at
+            least as big as the requested one, so the image returned by
+            wxImageHandler::LoadFile() may be bigger than it and is only scaled
+            to the final size by LoadFile(). These options must be set before
+            calling LoadFile() to have any effect.
 
         @li @c wxIMAGE_OPTION_ORIGINAL_WIDTH and @c wxIMAGE_OPTION_ORIGINAL_HEIGHT:
             These options will return the original size of the image if either
@@ -1664,6 +1963,38 @@ public:
     virtual bool LoadFile(wxInputStream& stream, const wxString& mimetype,
                           int index = -1);
 
+    /**
+        Creates an object allowing to read the image from the stream
+        incrementally.
+
+        This function finds the handler for the image format in the same way
+        as LoadFile() does and calls its wxImageHandler::CreateRowReader().
+        It allows to process images too big to be loaded in memory entirely,
+        see wxImageRowReader for more details.
+
+        Errors are logged if the default load flags, returned by
+        GetDefaultLoadFlags(), include @c Load_Verbose.
+
+        @param stream
+            Opened input stream for reading image data, it must remain alive
+            while the returned reader is used. It must be seekable if @a type
+            is @c wxBITMAP_TYPE_ANY.
+        @param type
+            The type of the image or @c wxBITMAP_TYPE_ANY to determine it
+            automatically.
+        @param index
+            The index of the image in the file (starting from zero).
+        @return
+            New reader object which must be deleted by the caller or @NULL
+            if the image couldn't be read or its handler doesn't support
+            incremental reading.
+
+        @since 3.3.3
+    */
+    static wxImageRowReader* CreateRowReader(wxInputStream& stream,
+                                             wxBitmapType type = wxBITMAP_TYPE_ANY,
+                                             int index = -1);
+
     /**
         Saves an image in the given stream.
 
@@ -1837,6 +2168,43 @@ public:
      */
     static void SetDefaultLoadFlags(int flags);
 
+    /**
+        Sets the maximal number of threads used for processing images.
+
+        By default, all image operations are performed in the calling thread
+        only. Calling this function with @a numThreads greater than 1 allows
+        the functions processing all pixels of a (sufficiently big) image to
+        split it in bands of rows or columns and process them in parallel
+        using a shared pool of worker threads, in addition to the calling one.
+        Passing 0 uses as many threads as there are CPUs in the system.
+
+        This currently affects Scale() and Rescale(), Blur() and its
+        horizontal and vertical variants, GaussianBlur(), ConvertToGreyscale(),
+        ConvertToMono(), ConvertToDisabled(), ChangeLightness(), RotateHue(),
+        ChangeSaturation(), ChangeBrightness() and ChangeHSV(). The results
+        of these functions are exactly the same whether multiple threads are
+        used or not.
+
+        If wxWidgets was built with @c wxUSE_THREADS set to 0, this function
+        doesn't do anything.
+
+        @see GetParallelism()
+
+        @since 3.3.3
+     */
+    static void SetParallelism(int numThreads);
+
+    /**
+        Returns the maximal number of threads used for processing images.
+
+        The returned value is always at least 1.
+
+        @see SetParallelism()
+
+        @since 3.3.3
+     */
+    static int GetParallelism();
+
     /**
         Sets the flags used for loading image files by this object.
 
@@ -2226,6 +2594,334 @@ public:
 */
 wxImage wxNullImage;
 
+/**
+    @class wxImageView
+
+    Read-only view of the pixels stored in an external buffer.
+
+    This class allows to use the pixels in a buffer owned by the application,
+    e.g. a frame returned by a camera or a video decoder, or the pixels of an
+    image from another library, without copying them into a wxImage first.
+    The buffer may use any of wxImagePixelFormat layouts and its rows may be
+    separated by padding bytes, whose number is determined by the stride,
+    i.e. the offset between the starts of the consecutive rows.
+
+    The view doesn't own the buffer, which must remain valid for as long as
+    the view, or any of its subviews, are used. It is cheap to copy.
+
+    wxImageView can be used to keep the pixels in an interleaved format, e.g.
+    premultiplied @c wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED which can be passed
+    directly to Cairo and other graphics APIs, while still being able to use
+    wxImage functions with them. wxImage::CopyToBuffer() can be used to fill
+    such buffer from an existing image.
+
+    Scale(), Mirror(), Rotate90() and Rotate180() work in the same way as the
+    wxImage functions with the same names, but read the pixels directly from
+    the buffer, converting them to wxImage format on the fly, so that only the
+    resulting image is allocated. To just convert the view to wxImage, use
+    wxImage constructor taking wxImageView.
+
+    Example of creating a thumbnail from an RGBA buffer:
+    @code
+    wxImageView view(pixels, width, height, wxIMAGE_FORMAT_RGBA, stride);
+    wxBitmap thumbnail(view.Scale(width / 8, height / 8));
+    @endcode
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.3
+*/
+class wxImageView
+{
+public:
+    /**
+        Default constructor creates an invalid view.
+    */
+    wxImageView();
+
+    /**
+        Creates a view of the pixels in the given buffer.
+
+        @param data
+            Pointer to the first pixel of the first row, must be non-null.
+        @param width
+            Width of the view in pixels, must be positive.
+        @param height
+            Height of the view in pixels, must be positive.
+        @param format
+            Layout of the pixels in the buffer.
+        @param stride
+            Offset in bytes between the starts of the consecutive rows. The
+            default value of 0 means that the rows are packed, i.e. that the
+            stride is equal to @a width multiplied by the number of bytes per
+            pixel, which is also the minimal allowed value.
+    */
+    wxImageView(const unsigned char* data,
+                int width,
+                int height,
+                wxImagePixelFormat format,
+                int stride = 0);
+
+    /// Returns @true if the view was successfully created.
+    bool IsOk() const;
+
+    /// Returns the width of the view in pixels.
+    int GetWidth() const;
+
+    /// Returns the height of the view in pixels.
+    int GetHeight() const;
+
+    /// Returns the size of the view in pixels.
+    wxSize GetSize() const;
+
+    /// Returns the format of the pixels.
+    wxImagePixelFormat GetFormat() const;
+
+    /// Returns the offset in bytes between the starts of consecutive rows.
+    int GetStride() const;
+
+    /// Returns the pointer to the first pixel.
+    const unsigned char* GetData() const;
+
+    /// Returns the pointer to the first pixel of the given row.
+    const unsigned char* GetRow(int y) const;
+
+    /// Returns @true if the pixel format includes alpha.
+    bool HasAlpha() const;
+
+    /// Returns the number of bytes used by a single pixel of this format.
+    static int GetBytesPerPixel(wxImagePixelFormat format);
+
+    /**
+        Returns the view of the given part of this view.
+
+        This function doesn't copy any data, the returned view uses the same
+        buffer and stride as this one.
+
+        @a rect must be non-empty and entirely inside this view.
+    */
+    wxImageView GetSubView(const wxRect& rect) const;
+
+    /**
+        Returns the image with the pixels of this view scaled to the given
+        size.
+
+        This function uses the same algorithms as wxImage::Scale(), with the
+        exception of @c wxIMAGE_QUALITY_NEAREST and @c wxIMAGE_QUALITY_FAST
+        which always select the nearest pixel, while wxImage::Scale() averages
+        the pixels when shrinking the image by an integer factor.
+    */
+    wxImage Scale(int width, int height,
+                  wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL) const;
+
+    /**
+        Returns the mirrored image.
+
+        @see wxImage::Mirror()
+    */
+    wxImage Mirror(bool horizontally = true) const;
+
+    /**
+        Returns the image rotated by 90 degrees in the given direction.
+
+        @see wxImage::Rotate90()
+    */
+    wxImage Rotate90(bool clockwise = true) const;
+
+    /**
+        Returns the image rotated by 180 degrees.
+
+        @see wxImage::Rotate180()
+    */
+    wxImage Rotate180() const;
+};
+
+/**
+    Result of loading a single image by wxImageBatchLoader.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.3
+*/
+struct wxImageBatchResult
+{
+    /**
+        Index of the image, as returned by wxImageBatchLoader::AddFile() or
+        wxImageBatchLoader::AddStream().
+    */
+    size_t index;
+
+    /// Name of the file the image was loaded from, empty for streams.
+    wxString filename;
+
+    /// The loaded image, invalid if loading it failed.
+    wxImage image;
+};
+
+/**
+    @class wxImageBatchLoader
+
+    Loads several images in parallel using worker threads.
+
+    This class is useful for loading many images, e.g. for showing them in a
+    gallery, as fast as possible. Images to load are added to the loader using
+    AddFile() or AddStream() and, once Start() is called, are loaded by the
+    worker threads, with the results available from GetNext() in the order
+    in which loading them completes, which is not necessarily the same as
+    the order in which they were added.
+
+    GetNext() blocks until the next image becomes available, unless a
+    timeout is specified, which makes it suitable for use in a non-GUI thread.
+    In the main thread of a GUI application, SetNotifyHandler() can be used to
+    get notified about the new images by wxThreadEvent which are processed by
+    the event loop as usual and GetNext() can then be called with 0 timeout
+    in their handler to retrieve the image without blocking.
+
+    By default all images are loaded as fast as possible, which can use a lot
+    of memory if they are not retrieved quickly enough. To prevent this from
+    happening, SetMemoryLimit() can be used to stop loading more images when
+    the total size of the loaded, but not yet retrieved, images exceeds the
+    given limit.
+
+    Example of using this class:
+    @code
+    wxImageBatchLoader loader;
+    for ( const wxString& file : files )
+        loader.AddFile(file);
+
+    loader.SetMemoryLimit(256*1024*1024);
+    loader.Start();
+
+    wxImageBatchResult result;
+    while ( loader.GetNext(result) )
+    {
+        if ( result.image.IsOk() )
+            ... use result.image corresponding to files[result.index] ...
+    }
+    @endcode
+
+    Note that image handlers must not be added or removed while the loader is
+    running, as they are used by the worker threads.
+
+    This class is only available when both @c wxUSE_THREADS and @c
+    wxUSE_STREAMS are set to 1.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.3
+*/
+class wxImageBatchLoader
+{
+public:
+    /**
+        Creates the loader using the given number of worker threads.
+
+        If @a numThreads is 0, as many threads as there are CPUs are used.
+        Notice that the threads are only created by Start().
+    */
+    explicit wxImageBatchLoader(int numThreads = 0);
+
+    /**
+        Destroys the loader.
+
+        Any images which are still being loaded are loaded to completion, but
+        loading the remaining images is cancelled and the images which were
+        not retrieved yet are discarded. The destructor returns only after all
+        worker threads terminate.
+    */
+    ~wxImageBatchLoader();
+
+    /**
+        Limits the memory used by the images which are not retrieved yet.
+
+        The worker threads don't start loading another image if the total
+        size of the images which were loaded but not yet returned by
+        GetNext(), together with the images currently being loaded, would
+        exceed @a maxBytes, and wait until some of them are retrieved instead.
+
+        As the size of an image is only known after decoding it, the size of
+        the images being loaded is estimated as the average size of the
+        images loaded so far, and only a single image is loaded until the
+        first one is done. This means that the limit can still be exceeded if
+        the images being loaded are bigger than the previous ones and, also,
+        that a single image is always loaded, even if it is bigger than the
+        limit on its own, if there are no other images pending.
+
+        The default value of 0 means that there is no limit.
+    */
+    void SetMemoryLimit(size_t maxBytes);
+
+    /**
+        Sets the handler to notify about newly loaded images.
+
+        If @a handler is non-null, a wxThreadEvent of type @c wxEVT_THREAD
+        with the given @a id is queued to it, using wxEvtHandler::QueueEvent(),
+        whenever an image is loaded. The handler must remain alive as long as
+        the loader is running.
+    */
+    void SetNotifyHandler(wxEvtHandler* handler, int id = wxID_ANY);
+
+    /**
+        Adds an image file to load.
+
+        The parameters have the same meaning as for wxImage::LoadFile().
+
+        @return The index of the image which is used for wxImageBatchResult
+            corresponding to it.
+    */
+    size_t AddFile(const wxString& filename,
+                   wxBitmapType type = wxBITMAP_TYPE_ANY,
+                   int index = -1);
+
+    /**
+        Adds an image to load from the given stream.
+
+        The loader takes ownership of @a stream, which must be non-null, and
+        deletes it once the image is loaded. It also must be seekable if
+        @a type is ::wxBITMAP_TYPE_ANY.
+
+        @return The index of the image which is used for wxImageBatchResult
+            corresponding to it.
+    */
+    size_t AddStream(wxInputStream* stream,
+                     wxBitmapType type = wxBITMAP_TYPE_ANY,
+                     int index = -1);
+
+    /**
+        Starts loading the images.
+
+        More images can still be added after calling this function. This
+        function can be called only once.
+
+        @return @false if the worker threads couldn't be created.
+    */
+    bool Start();
+
+    /**
+        Retrieves the next loaded image.
+
+        The images are returned in the order of loading completion. If no
+        images are currently available, this function waits up to @a timeout
+        milliseconds for one, or indefinitely if it is -1.
+
+        This function can only be called after Start().
+
+        @return @true if an image was returned in @a result, which is the
+            case even if loading it failed, or @false if there are no more
+            images to return or the timeout expired.
+    */
+    bool GetNext(wxImageBatchResult& result, long timeout = -1);
+
+    /**
+        Returns the number of images which were added to the loader but not
+        retrieved yet.
+    */
+    size_t GetPendingCount() const;
+};
+
 
 // ============================================================================
 // Global functions/macros
@@ -519,6 +519,13 @@ public:
         Enables logging mode in which a log message is logged once, and in case exactly
         the same message successively repeats one or more times, only the number of
         repetitions is logged.
+
+        Notice that when the active log target is thread-safe, see
+        IsThreadSafe(), the messages logged by all threads are checked for
+        repetitions together, under a lock, so the same message logged by
+        several threads at once is also counted as repeated. This lock is
+        only taken when repetition counting is enabled, so disabling it may
+        be preferable when logging a lot of messages from several threads.
     */
     static void SetRepetitionCounting(bool repetCounting = true);
 
@@ -693,6 +700,26 @@ protected:
     virtual void DoLogText(const wxString& msg);
 
     ///@}
+
+    /**
+        Return @true if this log target can be used from any thread.
+
+        By default, the messages logged from threads other than the main one
+        are buffered and only passed to the active log target when the main
+        thread calls FlushActive(), e.g. during idle time processing. If this
+        function is overridden to return @true, DoLogRecord() of the active
+        log target is called directly from the thread logging the message
+        instead, so it must be able to deal with concurrent calls.
+
+        Note that this function is only used for the global log target, the
+        thread-specific ones set using SetThreadActiveTarget() are always
+        used directly.
+
+        @see wxLogAsync
+
+        @since 3.3.3
+     */
+    virtual bool IsThreadSafe() const;
 };
 
 
@@ -826,6 +853,103 @@ public:
 };
 
 
+/**
+    @class wxLogAsync
+
+    Log target outputting the messages asynchronously from a separate thread.
+
+    This class forwards all messages to another log target, but instead of
+    doing it immediately, it just stores them in a buffer and returns, while
+    the real target is used only by a background thread created by this
+    object. This means that formatting the message, including its timestamp,
+    and writing it out doesn't slow down the thread which logs it, which can
+    be useful for the programs logging a lot, especially from several threads.
+
+    Each thread logging the messages uses its own buffer, so that logging
+    from different threads doesn't require any synchronization between them,
+    and the slots of this buffer are reused, so that logging a message
+    normally doesn't allocate any memory, other than what may be needed for
+    formatting the message itself. If the buffer becomes full, the logging
+    thread waits until some space in it becomes available. Notice that the
+    buffers are only freed when this object is destroyed, however a buffer
+    used by a thread which has exited is reused by the new thread with the
+    same ID, if any.
+
+    To avoid waking up the background thread for every message when many of
+    them are logged, it outputs them in batches, so a message may be output
+    with a delay of up to a few milliseconds after logging it.
+
+    The messages logged by the same thread are always output in the order in
+    which they were logged, but the messages logged by different threads may
+    be interleaved in any way.
+
+    This target is thread-safe (see wxLog::IsThreadSafe()), so the messages
+    logged from background threads are passed to it immediately and don't
+    wait for the main thread to flush them. However the target it forwards
+    the messages to must not require being used from the main thread, which
+    excludes GUI log targets such as wxLogGui or wxLogWindow. Typically it is
+    used with wxLogStderr, wxLogStream or a custom log target writing to a
+    file:
+
+    @code
+    delete wxLog::SetActiveTarget(new wxLogAsync(new wxLogStderr));
+    @endcode
+
+    Calling Flush() waits until all the messages logged so far by the current
+    thread are output and then flushes the target too. The remaining messages
+    are also output when this object is destroyed.
+
+    @library{wxbase}
+    @category{logging}
+
+    @since 3.3.3
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Create the log target forwarding the messages to the given one.
+
+        @param target
+            The log target to use for outputting the messages, must be
+            non-null. This object takes ownership of it and will delete it
+            when it is itself destroyed.
+        @param bufferSize
+            The maximal number of messages which can be logged by a single
+            thread before they are output, rounded up to a power of 2.
+     */
+    explicit wxLogAsync(wxLog* target, size_t bufferSize = 1024);
+
+    /**
+        Outputs all the remaining messages and destroys the target.
+     */
+    virtual ~wxLogAsync();
+
+    /**
+        Returns the log target the messages are forwarded to.
+
+        This target is used from a different thread, so it shouldn't be used
+        directly while this object exists.
+     */
+    wxLog* GetTarget() const;
+
+    /**
+        Waits until all the messages logged so far by the current thread are
+        output.
+
+        Then calls Flush() of the target from the background thread.
+
+        If all the messages logged by the current thread have been already
+        flushed, this function doesn't wait at all and just asks the
+        background thread to flush the target if any messages were logged by
+        the other threads since the last flush. This ensures that calling
+        this function from the main thread, which is done whenever it becomes
+        idle, doesn't block it.
+     */
+    virtual void Flush();
+};
+
+
 /**
     @class wxLogStream
 
@@ -5,6 +5,49 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    @name Flags for wxQuantize::Quantize()
+
+    Combination of these flags is used as the last argument of
+    wxQuantize::Quantize().
+*/
+///@{
+
+/// Reserve the first 20 entries of the palette for Windows system colours.
+#define wxQUANTIZE_INCLUDE_WINDOWS_COLOURS      0x01
+
+/// Return the palette indices of the image pixels in @c eightBitData.
+#define wxQUANTIZE_RETURN_8BIT_DATA             0x02
+
+/// Fill the destination image with the colours of the palette.
+#define wxQUANTIZE_FILL_DESTINATION_IMAGE       0x04
+
+/**
+    Map each pixel to the nearest palette colour without dithering.
+
+    This is much faster than the default Floyd-Steinberg dithering for big
+    images, but results in visible banding in smooth gradients.
+
+    @since 3.3.3
+ */
+#define wxQUANTIZE_NO_DITHER                    0x08
+
+/**
+    Use ordered dithering instead of the default Floyd-Steinberg one.
+
+    Ordered dithering is almost as fast as not using dithering at all and
+    looks better than it, although not as good as Floyd-Steinberg dithering.
+    It also doesn't change the pixels outside of the modified area when the
+    image changes, which is useful for compressing animations.
+
+    This flag is ignored if wxQUANTIZE_NO_DITHER is specified.
+
+    @since 3.3.3
+ */
+#define wxQUANTIZE_ORDERED_DITHER               0x10
+
+///@}
+
 /**
     @class wxQuantize
 
@@ -31,10 +74,15 @@ public:
         (@a in_rows contains @a w * 3 bytes per row, @a out_rows @a w bytes per row).
         Fills @a out_rows with indexes into palette (which is also stored into @a palette
         variable).
+
+        The @a flags parameter can be used to specify the dithering method
+        and may contain wxQUANTIZE_NO_DITHER or wxQUANTIZE_ORDERED_DITHER,
+        it is available since wxWidgets 3.3.3.
     */
     static void DoQuantize(unsigned int w, unsigned int h,
                            unsigned char** in_rows, unsigned char** out_rows,
-                           unsigned char* palette, int desiredNoColours);
+                           unsigned char* palette, int desiredNoColours,
+                           int flags = 0);
 
     /**
         Reduce the colours in the source image and put the result into the destination image.
@@ -42,6 +90,11 @@ public:
 
         Specify an optional palette pointer to receive the resulting palette.
         This palette may be passed to ConvertImageToBitmap, for example.
+
+        The @a flags parameter is a combination of @c wxQUANTIZE_XXX
+        constants. By default Floyd-Steinberg dithering is used to reduce the
+        number of colours, but wxQUANTIZE_NO_DITHER or
+        wxQUANTIZE_ORDERED_DITHER can be specified to use a faster method.
     */
     static bool Quantize(const wxImage& src, wxImage& dest,
                          wxPalette** pPalette, int desiredNoColours = 236,
@@ -2002,10 +2002,32 @@ public:
 
         @since 2.9.1
 
-        @see ToCDouble()
+        @see ToCDouble(), FromCDoubleShortest()
      */
     static wxString FromCDouble(double val, int precision = -1);
 
+    /**
+        Returns the shortest string representation of the number in C locale
+        which can be converted back to exactly the same value.
+
+        Unlike FromCDouble(), which uses 6 significant digits by default and
+        so may lose precision, this function uses as many digits as needed,
+        but not more, to ensure that ToCDouble() returns @a val when applied
+        to its result. This makes it appropriate for serializing floating
+        point numbers, e.g. when saving them to configuration or data files.
+
+        For example, this function returns @c "0.1" for @c 0.1 and @c
+        "3.141592653589793" for @c M_PI.
+
+        Note that exponential notation is used if it results in a shorter
+        string, e.g. @c "1e+22" is returned for @c 1e22.
+
+        @since 3.3.3
+
+        @see FromCDouble(), ToCDouble()
+     */
+    static wxString FromCDoubleShortest(double val);
+
     /**
         Returns a string with the textual representation of the number.
 
@@ -2196,6 +2218,119 @@ public:
 };
 
 
+/**
+    @class wxStringAtom
+
+    An interned string.
+
+    All atoms created from equal strings refer to the same copy of the string
+    stored in a global table, so an atom only takes the space of a pointer,
+    can be copied without allocating any memory and two atoms can be compared
+    in constant time, independently of the length of the strings.
+
+    This makes atoms useful for storing many copies of short, frequently
+    repeated, strings, such as column names or status values in a data model:
+    @code
+        static const wxStringAtom statusDone("done");
+
+        class MyModel : public wxDataViewVirtualListModel
+        {
+            ...
+            void GetValueByRow(wxVariant& variant,
+                               unsigned int row, unsigned int col) const override
+            {
+                // no copy of the string is made here
+                variant = m_status[row];
+            }
+
+            std::vector<wxStringAtom> m_status;
+        };
+    @endcode
+
+    Atoms can be used anywhere where a wxString is expected and can be stored
+    in wxVariant, which keeps the atom itself rather than a copy of the string,
+    and added to wxArrayString.
+
+    Creating an atom requires looking up the string in the global table, which
+    is safe to do from multiple threads. Notice that the strings added to the
+    table are never freed, so atoms should only be used for strings taking a
+    limited number of distinct values and not for arbitrary user data.
+
+    As all atoms created from the same string share the same wxString object,
+    only read-only access to the string returned by GetString() is safe from
+    multiple threads. Notably, this excludes the conversions to narrow or wide
+    C strings, such as mb_str(), wc_str() in UTF-8 build or the implicit
+    conversions of c_str() result, as they use a cache inside the wxString
+    object which is modified by them. If such conversions are needed while the
+    same atom can be used by other threads, make a copy of the string first:
+    @code
+        void WorkerThread::Log(const wxStringAtom& atom)
+        {
+            const wxString s(atom.GetString());
+            puts(s.mb_str());
+        }
+    @endcode
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.3
+*/
+class wxStringAtom
+{
+public:
+    /**
+        Default constructor creates the atom corresponding to the empty string.
+
+        This constructor doesn't need to look up the string in the global
+        table and so is very cheap.
+    */
+    wxStringAtom();
+
+    /**
+        Creates the atom for the given string.
+
+        The string is added to the global table if it is not there yet.
+    */
+    explicit wxStringAtom(const wxString& str);
+
+    /**
+        Returns the string corresponding to this atom.
+
+        The returned reference remains valid until the end of the program.
+    */
+    const wxString& GetString() const;
+
+    /**
+        Implicit conversion to wxString, returning GetString().
+    */
+    operator const wxString&() const;
+
+    /**
+        Returns @true if this atom corresponds to the empty string.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Compares two atoms.
+
+        As equal strings always give the same atoms, this only compares the
+        pointers to the interned strings.
+    */
+    bool operator==(const wxStringAtom& atom) const;
+
+    /**
+        Compares two atoms for inequality.
+    */
+    bool operator!=(const wxStringAtom& atom) const;
+
+    /**
+        Returns the number of distinct strings interned so far.
+    */
+    static size_t GetCount();
+};
+
+
 /** @addtogroup group_funcmacro_string */
 ///@{
 
@@ -2229,4 +2364,35 @@ template<bool (T)(const wxUniChar& c)>
  */
 wxString wxASCII_STR(const char* s);
 
+/**
+    Creates a format string checked at compile-time.
+
+    This macro can be used for the format string literal passed to
+    wxString::Format(), wxString::Printf(), wxPrintf(), wxFprintf() and all
+    wxLogXXX() functions, e.g.
+    @code
+        wxLogMessage(wxFORMAT("Processed %d of %zu items"), n, items.size());
+    @endcode
+
+    When using C++14 or later compiler, the format string is parsed and the
+    types of the arguments are checked during compilation, resulting in a
+    compile-time error if they don't match the format specifiers, instead of
+    an assertion failure at run-time. Moreover, as the format string doesn't
+    need to be parsed nor converted at run-time any more, formatting is also
+    noticeably faster, which may be important for the functions called very
+    often, such as logging functions in performance-sensitive code.
+
+    The string created by this macro can also be used with all the other
+    functions taking printf-like format strings, such as wxSnprintf(), but the
+    arguments are only checked at run-time for them.
+
+    Without C++14 support, this macro simply expands to wxS() and the
+    arguments are checked at run-time as usual. The symbol @c
+    wxHAS_COMPILE_TIME_FORMAT_CHECK is defined if the checks are done at
+    compile-time.
+
+    @since 3.3.3
+ */
+#define wxFORMAT(s)
+
 ///@}
@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     interface of wxThreadPool and related classes
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Base class for the tasks executed by wxThreadPool.
+
+    Derive from this class and override its Run() function to define a task
+    which can be executed by wxThreadPool::Post(). Usually it is simpler to
+    use wxThreadPool::Submit() which allows to execute any function object,
+    such as a lambda, and provides access to its result.
+
+    @since 3.3.3
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+*/
+class wxTask
+{
+public:
+    /// Default constructor.
+    wxTask();
+
+    /// Virtual destructor, the task is deleted by the pool after running it.
+    virtual ~wxTask();
+
+    /**
+        Execute the task.
+
+        This function is called in one of the pool threads.
+     */
+    virtual void Run() = 0;
+};
+
+/**
+    Token allowing to cancel the tasks which haven't started running yet.
+
+    The token is passed to wxThreadPool::Submit() and the task is not executed
+    at all if Cancel() is called before it starts, the corresponding
+    wxFuture::IsCancelled() returns @true in this case. Long running tasks can
+    also check IsCancelled() periodically and stop early if it returns @true.
+
+    All copies of the token share the same state, so it can be copied freely
+    and cancelling any copy cancels all the tasks using any of them.
+
+    @since 3.3.3
+
+    @library{wxbase}
+    @category{threading}
+*/
+class wxCancellationToken
+{
+public:
+    /// Create a new, not cancelled, token.
+    wxCancellationToken();
+
+    /// Cancel all tasks using this token. This can be called from any thread.
+    void Cancel();
+
+    /// Return @true if Cancel() had been called. Can be called from any thread.
+    bool IsCancelled() const;
+};
+
+/**
+    Result of a task executed by wxThreadPool.
+
+    Objects of this class are returned by wxThreadPool::Submit() and allow to
+    wait for the task to complete and retrieve its result. They can be copied
+    and all the copies refer to the same task.
+
+    @tparam T
+        The type of the task result, which may be @c void.
+
+    @since 3.3.3
+
+    @library{wxbase}
+    @category{threading}
+*/
+template <typename T>
+class wxFuture<T>
+{
+public:
+    /**
+        Default constructor creates an invalid future.
+
+        Such objects can only be assigned to or checked with IsValid().
+     */
+    wxFuture();
+
+    /// Return @true if this object is associated with a task.
+    bool IsValid() const;
+
+    /// Return @true if the task has completed, without blocking.
+    bool IsReady() const;
+
+    /**
+        Wait until the task completes.
+
+        If this function is called from one of the pool threads, e.g. by a
+        task waiting for its subtasks, it executes the other pending tasks
+        while waiting instead of blocking.
+     */
+    void Wait() const;
+
+    /**
+        Wait until the task completes and return @true if it was cancelled.
+
+        @see wxCancellationToken
+     */
+    bool IsCancelled() const;
+
+    /**
+        Wait until the task completes and return its result.
+
+        If the task threw an exception, this function rethrows it. It must not
+        be called if the task was cancelled.
+     */
+    T Get() const;
+
+    /**
+        Call the given function in the main thread once the task completes.
+
+        The function is called using wxEvtHandler::CallAfter() on the given
+        handler, which must remain alive until then, and takes this future as
+        its only argument, e.g.
+        @code
+        wxThreadPool::Get().Submit([]() { return ComputeSomething(); })
+                           .Then(this, [this](const wxFuture<int>& f) {
+                                m_text->SetValue(wxString::Format("%d", f.Get()));
+                            });
+        @endcode
+     */
+    template <typename F>
+    void Then(wxEvtHandler* handler, F func) const;
+
+    /**
+        Call the given function in the main thread once the task completes.
+
+        This overload uses wxApp::CallAfter() and can be used when there is no
+        appropriate handler. The function is not called if the application
+        object doesn't exist any more when the task completes.
+     */
+    template <typename F>
+    void Then(F func) const;
+};
+
+/**
+    Pool of threads executing the tasks.
+
+    This class allows executing the tasks in a fixed number of threads created
+    only once instead of creating a new thread for each of them.
+
+    Each pool thread has its own queue of tasks: the tasks posted from a pool
+    thread, e.g. the subtasks created by a running task, are added to its own
+    queue, which is processed in LIFO order to benefit from the data being
+    still in the CPU cache. The threads without any tasks to execute steal the
+    oldest tasks from the other threads queues, which ensures that all threads
+    remain busy when there is enough work for them. The tasks posted from the
+    other threads are added to a shared queue processed in FIFO order.
+
+    Most of the time the global pool returned by Get() should be used, but it
+    is also possible to create a separate pool, e.g. for the tasks which could
+    block for a long time.
+
+    Example of using the pool:
+    @code
+    // Execute a function in a pool thread and get its result.
+    wxFuture<int> f = wxThreadPool::Get().Submit([]() { return 17; });
+    ...
+    int result = f.Get();
+
+    // Compute the squares of all vector elements in parallel.
+    std::vector<double> v = ...;
+    wxThreadPool::Get().ParallelFor(0, v.size(), [&v](size_t n) { v[n] *= v[n]; });
+    @endcode
+
+    @since 3.3.3
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThread, wxMessageQueue<>
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Create the pool with the given number of threads.
+
+        The threads are started immediately.
+
+        @param numThreads
+            The number of threads to use, 0 means to use as many threads as
+            returned by wxThread::GetCPUCount().
+     */
+    explicit wxThreadPool(unsigned numThreads = 0);
+
+    /**
+        Destroy the pool.
+
+        Destructor waits until all the tasks, including the ones not started
+        yet, complete.
+     */
+    ~wxThreadPool();
+
+    /**
+        Return the global pool using as many threads as there are CPUs.
+
+        The pool is created on the first call to this function and destroyed
+        when the library is shut down. This function must not be called after
+        this happens: if it is, it asserts and returns a pool without any
+        threads, which executes all tasks synchronously in the calling thread.
+     */
+    static wxThreadPool& Get();
+
+    /// Return the number of threads in the pool.
+    unsigned GetThreadCount() const;
+
+    /**
+        Execute the given task in one of the pool threads.
+
+        The pool takes ownership of the task and deletes it after running it.
+
+        This function can be called from any thread.
+     */
+    void Post(wxTask* task);
+
+    /**
+        Execute the given function in one of the pool threads.
+
+        The function can return any type, including @c void, and the returned
+        future allows to retrieve its value once it is computed. Any exception
+        thrown by the function is rethrown by wxFuture::Get().
+
+        This function can be called from any thread.
+     */
+    template <typename F>
+    wxFuture<T> Submit(F func);
+
+    /**
+        Execute the given function in one of the pool threads unless the token
+        is cancelled before it starts running.
+
+        @see wxCancellationToken
+     */
+    template <typename F>
+    wxFuture<T> Submit(F func, const wxCancellationToken& token);
+
+    /**
+        Call the given function for all indices in the given range in parallel.
+
+        The range is split in chunks executed by the pool threads and the
+        current one, and this function returns only once all of them complete.
+        If the function throws an exception, the other calls still complete
+        and then the first exception is rethrown by this function.
+
+        The function may be called from a pool thread, including from inside
+        another ParallelFor() call.
+
+        @param begin
+            The first index to call the function for.
+        @param end
+            One past the last index to call the function for.
+        @param func
+            Function object taking @c size_t index.
+        @param grainSize
+            If non-zero, the calls for this number of consecutive indices are
+            always made by the same thread. By default, the range is split in
+            a few chunks per thread, which is appropriate if the function is
+            relatively expensive, but it can be useful to specify a bigger
+            value if it isn't, to reduce the overhead.
+     */
+    template <typename F>
+    void ParallelFor(size_t begin, size_t end, F func, size_t grainSize = 0);
+
+    /**
+        Execute one of the pending tasks in the current thread.
+
+        This can be used to help the pool threads when waiting for the tasks
+        to complete.
+
+        @return @true if a task was executed or @false if there were no
+            pending tasks.
+     */
+    bool RunPendingTask();
+};
@@ -90,6 +90,10 @@ enum wxStringTokenizerMode
     @library{wxbase}
     @category{data}
 
+    If the string is big and the tokens don't need to be stored, consider
+    using wxStringViewTokenizer instead, which avoids allocating memory for
+    them.
+
     @see ::wxStringTokenize()
 */
 class wxStringTokenizer : public wxObject
@@ -165,6 +169,162 @@ public:
 };
 
 
+/**
+    @class wxStringTokenView
+
+    A non-owning reference to a part of a string returned by
+    wxStringViewTokenizer.
+
+    This class only stores a pointer to the data of the string and its length,
+    so creating and copying it is cheap, but it must not be used after the
+    string it refers to is modified or destroyed.
+
+    Notice that the data is not @c NUL-terminated and that its size() is
+    expressed in ::wxStringCharType units, i.e. bytes when using UTF-8 build
+    (see @ref overview_unicode_support_utf) and not characters.
+
+    Objects of this class can be compared with wxString directly, e.g.
+    @code
+    if ( token == "yes" )
+        ...
+    @endcode
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.3
+*/
+class wxStringTokenView
+{
+public:
+    /// Default constructor creates an empty view.
+    wxStringTokenView();
+
+    /// Create a view of the given data.
+    wxStringTokenView(const wxStringCharType* data, size_t len);
+
+    /// Returns the pointer to the start of the data, which may be null.
+    const wxStringCharType* data() const;
+
+    /// Returns the size of the data in ::wxStringCharType units.
+    size_t size() const;
+
+    /// Returns @true if the view is empty.
+    bool empty() const;
+
+    /// Returns a new string with the contents of this view.
+    wxString ToString() const;
+
+    /// Returns @true if the view contains the same characters as @a str.
+    bool IsSameAs(const wxString& str) const;
+
+    /**
+        Returns a standard string view referring to the same data.
+
+        This function is only available if the compiler supports C++17 and
+        @c std::string_view and returns @c std::string_view in UTF-8 build and
+        @c std::wstring_view otherwise.
+    */
+    std::basic_string_view<wxStringCharType> ToStdStringView() const;
+};
+
+/**
+    @class wxStringViewTokenizer
+
+    wxStringViewTokenizer works in the same way as wxStringTokenizer, but
+    returns the tokens as wxStringTokenView objects referring to the
+    original string instead of creating new strings for them.
+
+    This means that it doesn't allocate any memory for the tokens, which makes
+    it significantly faster when parsing large amounts of text, such as CSV
+    files, but the string passed to it must remain alive and unchanged while
+    this object and the tokens returned by it are used. For this reason it
+    can't be constructed from a temporary string.
+
+    Example of parsing a simple configuration file contents:
+    @code
+    const wxString text = ReadFile();
+    wxStringViewTokenizer lines(text, "\n", wxTOKEN_STRTOK);
+    while ( lines.HasMoreTokens() )
+    {
+        wxStringViewTokenizer fields(lines.GetNextToken(), "=");
+        const wxStringTokenView name = fields.GetNextToken();
+        if ( name == "size" )
+            ...
+    }
+    @endcode
+
+    Notice that, unlike wxStringTokenizer, this class doesn't provide
+    GetPosition() as finding the index of the character in the string is not
+    a constant time operation in UTF-8 build.
+
+    @library{wxbase}
+    @category{data}
+
+    @since 3.3.3
+*/
+class wxStringViewTokenizer
+{
+public:
+    /**
+        Constructor takes the string to tokenize, which must remain valid for
+        the lifetime of this object, and the same parameters as
+        wxStringTokenizer constructor.
+    */
+    wxStringViewTokenizer(const wxString& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT);
+
+    /**
+        Constructor allowing to tokenize a token returned by another
+        tokenizer.
+    */
+    wxStringViewTokenizer(const wxStringTokenView& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT);
+
+    /**
+        Returns the number of tokens remaining in the input string.
+
+        This function doesn't allocate any memory but still needs to scan the
+        rest of the string.
+    */
+    size_t CountTokens() const;
+
+    /**
+        Returns @true if the tokenizer has further tokens, @false if none are
+        left.
+    */
+    bool HasMoreTokens() const;
+
+    /**
+        Returns the next token or an empty view if the end of string was
+        reached.
+    */
+    wxStringTokenView GetNextToken();
+
+    /**
+        Returns the delimiter which ended scan for the last token returned by
+        GetNextToken().
+
+        @see wxStringTokenizer::GetLastDelimiter()
+    */
+    wxChar GetLastDelimiter() const;
+
+    /**
+        Returns the mode used by this tokenizer, which is never
+        ::wxTOKEN_DEFAULT.
+    */
+    wxStringTokenizerMode GetMode() const;
+
+    /// Returns @true if empty tokens are returned.
+    bool AllowEmpty() const;
+
+    /// Returns the part of the string which is yet to be tokenized.
+    wxStringTokenView GetString() const;
+};
+
+
 /** @addtogroup group_funcmacro_string */
 ///@{
 
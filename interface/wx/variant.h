@@ -202,6 +202,18 @@ public:
     */
     wxVariant(const wxString& value, const wxString& name = wxEmptyString);
 
+    /**
+        Constructs a string variant from an interned string.
+
+        The variant stores the atom itself and not a copy of the string, which
+        makes this constructor cheaper than the one taking wxString. The
+        variant type is still "string" and GetString() can be used to
+        retrieve its value, as usual.
+
+        @since 3.3.3
+    */
+    wxVariant(const wxStringAtom& value, const wxString& name = wxEmptyString);
+
     /**
         Constructs a variant from a wide char.
     */
@@ -403,6 +415,17 @@ public:
     */
     wxString GetString() const;
 
+    /**
+        Gets the string value as an interned string.
+
+        If the variant was created from or assigned a wxStringAtom, this atom
+        is returned without any lookups, otherwise the string value is
+        interned.
+
+        @since 3.3.3
+    */
+    wxStringAtom GetStringAtom() const;
+
     /**
         Returns the value type as a string.
 
@@ -507,6 +530,7 @@ public:
     bool operator !=(const wxVariantList& value) const;
     bool operator !=(const wxArrayString& value) const;
     bool operator !=(const wxDateTime& value) const;
+    bool operator !=(const wxStringAtom& value) const;
     ///@}
 
     ///@{
@@ -529,6 +553,7 @@ public:
     void operator =(const wxVariantList& value);
     void operator =(const wxDateTime& value);
     void operator =(const wxArrayString& value);
+    void operator =(const wxStringAtom& value);
     ///@}
 
     ///@{
@@ -549,6 +574,7 @@ public:
     bool operator ==(const wxVariantList& value) const;
     bool operator ==(const wxArrayString& value) const;
     bool operator ==(const wxDateTime& value) const;
+    bool operator ==(const wxStringAtom& value) const;
     ///@}
 
     ///@{
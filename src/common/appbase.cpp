@@ -43,6 +43,7 @@
 #include "wx/thread.h"
 #include "wx/stdpaths.h"
 
+#include "wx/private/pendingevents.h"
 #include "wx/private/safecall.h"
 
 #if wxUSE_EXCEPTIONS
@@ -143,6 +144,7 @@ wxDEFINE_TIED_SCOPED_PTR_TYPE(wxEventLoopBase)
 // ----------------------------------------------------------------------------
 
 wxAppConsoleBase::wxAppConsoleBase()
+    : m_handlersWithPendingEvents(new wxPendingEventHandlers)
 {
     ms_appInstance = reinterpret_cast<wxAppConsole *>(this);
 
@@ -161,6 +163,8 @@ wxAppConsoleBase::~wxAppConsoleBase()
     // even crash so don't leave dangling pointers to it
     ms_appInstance = nullptr;
 
+    delete m_handlersWithPendingEvents;
+
     delete m_traits;
 }
 
@@ -488,64 +492,38 @@ int wxAppConsoleBase::FilterEvent(wxEvent& WXUNUSED(event))
 
 void wxAppConsoleBase::DelayPendingEventHandler(wxEvtHandler* toDelay)
 {
-    wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
+    wxCRIT_SECT_LOCKER(lock, m_handlersWithPendingEventsLocker);
 
     // move the handler from the list of handlers with processable pending events
     // to the list of handlers with pending events which needs to be processed later
-    m_handlersWithPendingEvents.Remove(toDelay);
-
-    if (m_handlersWithPendingDelayedEvents.Index(toDelay) == wxNOT_FOUND)
-        m_handlersWithPendingDelayedEvents.Add(toDelay);
-
-    wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+    m_handlersWithPendingEvents->Delay(toDelay->GetPendingEventsQueue());
 }
 
 void wxAppConsoleBase::RemovePendingEventHandler(wxEvtHandler* toRemove)
 {
-    wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
-
-    if (m_handlersWithPendingEvents.Index(toRemove) != wxNOT_FOUND)
-    {
-        m_handlersWithPendingEvents.Remove(toRemove);
-
-        // check that the handler was present only once in the list
-        wxASSERT_MSG( m_handlersWithPendingEvents.Index(toRemove) == wxNOT_FOUND,
-                        "Handler occurs twice in the m_handlersWithPendingEvents list!" );
-    }
-    //else: it wasn't in this list at all, it's ok
-
-    if (m_handlersWithPendingDelayedEvents.Index(toRemove) != wxNOT_FOUND)
-    {
-        m_handlersWithPendingDelayedEvents.Remove(toRemove);
+    // there is nothing to do if no events were ever queued for this handler
+    wxPendingEventsQueue* const queue = toRemove->m_pendingEvents.load();
+    if ( !queue )
+        return;
 
-        // check that the handler was present only once in the list
-        wxASSERT_MSG( m_handlersWithPendingDelayedEvents.Index(toRemove) == wxNOT_FOUND,
-                        "Handler occurs twice in m_handlersWithPendingDelayedEvents list!" );
-    }
-    //else: it wasn't in this list at all, it's ok
+    wxCRIT_SECT_LOCKER(lock, m_handlersWithPendingEventsLocker);
 
-    wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+    m_handlersWithPendingEvents->Remove(queue);
 }
 
 void wxAppConsoleBase::AppendPendingEventHandler(wxEvtHandler* toAppend)
 {
-    wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
-
-    if ( m_handlersWithPendingEvents.Index(toAppend) == wxNOT_FOUND )
-        m_handlersWithPendingEvents.Add(toAppend);
-
-    wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+    // notice that we don't need to lock anything here, this can be safely
+    // called from any thread
+    m_handlersWithPendingEvents->Add(toAppend->GetPendingEventsQueue());
 }
 
 bool wxAppConsoleBase::HasPendingEvents() const
 {
-    wxENTER_CRIT_SECT(const_cast<wxAppConsoleBase*>(this)->m_handlersWithPendingEventsLocker);
-
-    bool has = !m_handlersWithPendingEvents.IsEmpty();
-
-    wxLEAVE_CRIT_SECT(const_cast<wxAppConsoleBase*>(this)->m_handlersWithPendingEventsLocker);
+    wxCRIT_SECT_LOCKER(lock,
+        const_cast<wxAppConsoleBase*>(this)->m_handlersWithPendingEventsLocker);
 
-    return has;
+    return !m_handlersWithPendingEvents->IsEmpty();
 }
 
 void wxAppConsoleBase::SuspendProcessingOfPendingEvents()
@@ -564,18 +542,24 @@ void wxAppConsoleBase::ProcessPendingEvents()
     {
         wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
 
-        wxCHECK_RET( m_handlersWithPendingDelayedEvents.IsEmpty(),
-                     "this helper list should be empty" );
+        if ( m_handlersWithPendingEvents->HasDelayed() )
+        {
+            wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+
+            wxFAIL_MSG( "there should be no delayed handlers" );
+
+            return;
+        }
 
         // iterate until the list becomes empty: the handlers remove themselves
         // from it when they don't have any more pending events
-        while (!m_handlersWithPendingEvents.IsEmpty())
+        while ( wxPendingEventsQueue* const queue = m_handlersWithPendingEvents->GetFirst() )
         {
             // NOTE: we always call ProcessPendingEvents() on the first event handler
             //       with pending events because handlers auto-remove themselves
             //       from this list (see RemovePendingEventHandler) if they have no
             //       more pending events.
-            wxEvtHandler* const handler = m_handlersWithPendingEvents[0];
+            wxEvtHandler* const handler = queue->GetHandler();
 
             // In ProcessPendingEvents(), new handlers might be added
             // and we can safely leave the critical section here as we're not
@@ -587,16 +571,12 @@ void wxAppConsoleBase::ProcessPendingEvents()
             wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
         }
 
-        // now the wxHandlersWithPendingEvents is surely empty; however some event
-        // handlers may have moved themselves into wxHandlersWithPendingDelayedEvents
-        // because of a selective wxYield call in progress.
-        // Now we need to move them back to wxHandlersWithPendingEvents so the next
-        // call to this function has the chance of processing them:
-        if (!m_handlersWithPendingDelayedEvents.IsEmpty())
-        {
-            WX_APPEND_ARRAY(m_handlersWithPendingEvents, m_handlersWithPendingDelayedEvents);
-            m_handlersWithPendingDelayedEvents.Clear();
-        }
+        // now the list of handlers with pending events is surely empty;
+        // however some event handlers may have moved themselves into the list
+        // of delayed handlers because of a selective wxYield call in progress.
+        // Now we need to move them back to the main list so the next call to
+        // this function has the chance of processing them:
+        m_handlersWithPendingEvents->ResumeDelayed();
 
         wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
     }
@@ -604,17 +584,12 @@ void wxAppConsoleBase::ProcessPendingEvents()
 
 void wxAppConsoleBase::DeletePendingEvents()
 {
-    wxENTER_CRIT_SECT(m_handlersWithPendingEventsLocker);
-
-    wxCHECK_RET( m_handlersWithPendingDelayedEvents.IsEmpty(),
-                 "this helper list should be empty" );
-
-    for (unsigned int i=0; i<m_handlersWithPendingEvents.GetCount(); i++)
-        m_handlersWithPendingEvents[i]->DeletePendingEvents();
+    wxCRIT_SECT_LOCKER(lock, m_handlersWithPendingEventsLocker);
 
-    m_handlersWithPendingEvents.Clear();
+    wxCHECK_RET( !m_handlersWithPendingEvents->HasDelayed(),
+                 "there should be no delayed handlers" );
 
-    wxLEAVE_CRIT_SECT(m_handlersWithPendingEventsLocker);
+    m_handlersWithPendingEvents->DeleteAllEvents();
 }
 
 // ----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #include "wx/beforestd.h"
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include "wx/afterstd.h"
 
 // ============================================================================
@@ -114,6 +115,65 @@ int wxSortedArrayString::Index(const wxString& str,
     return it - begin();
 }
 
+void wxSortedArrayString::DoSort()
+{
+    std::sort(begin(), end(),
+              wxSortedArrayString_SortFunction(GetCompareFunction()));
+}
+
+void wxSortedArrayString::Merge(const wxSortedArrayString& other)
+{
+    wxCHECK_RET( &other != this, "can't merge the array with itself" );
+    wxASSERT_MSG( GetCompareFunction() == other.GetCompareFunction(),
+                  "arrays must be sorted in the same order" );
+
+    const size_t count = size();
+    insert(end(), other.begin(), other.end());
+
+    std::inplace_merge(begin(), begin() + count, end(),
+                       wxSortedArrayString_SortFunction(GetCompareFunction()));
+}
+
+void wxSortedArrayString::Merge(wxSortedArrayString&& other)
+{
+    wxCHECK_RET( &other != this, "can't merge the array with itself" );
+    wxASSERT_MSG( GetCompareFunction() == other.GetCompareFunction(),
+                  "arrays must be sorted in the same order" );
+
+    if ( empty() )
+    {
+        wxVector<wxString>::swap(other);
+        return;
+    }
+
+    const size_t count = size();
+    insert(end(),
+           std::make_move_iterator(other.begin()),
+           std::make_move_iterator(other.end()));
+    other.clear();
+
+    std::inplace_merge(begin(), begin() + count, end(),
+                       wxSortedArrayString_SortFunction(GetCompareFunction()));
+}
+
+size_t wxSortedArrayString::RemoveDuplicates()
+{
+    wxSortedArrayString_SortFunction less(GetCompareFunction());
+
+    // As the array is sorted, the elements are equal if the first one is not
+    // less than the second one.
+    const iterator last = std::unique(begin(), end(),
+                                      [&less](const wxString& s1, const wxString& s2)
+                                      {
+                                          return !less(s1, s2);
+                                      });
+
+    const size_t removed = end() - last;
+    erase(last, end());
+
+    return removed;
+}
+
 #else // !wxUSE_STD_CONTAINERS
 
 #ifndef   ARRAY_DEFAULT_INITIAL_SIZE    // also defined in dynarray.h
@@ -162,6 +222,19 @@ void wxArrayString::Copy(const wxArrayString& src)
   if ( src.m_nCount > ARRAY_DEFAULT_INITIAL_SIZE )
     Alloc(src.m_nCount);
 
+  if ( m_autoSort )
+  {
+    // Inserting the items into a sorted array one by one would be O(N^2), so
+    // append all of them at once and sort the array just once instead.
+    wxScopedArray<wxString> oldStrings(Grow(src.m_nCount));
+
+    std::copy(src.m_pItems, src.m_pItems + src.m_nCount, m_pItems + m_nCount);
+    m_nCount += src.m_nCount;
+
+    RestoreAutoSortOrder();
+    return;
+  }
+
   for ( size_t n = 0; n < src.m_nCount; n++ )
     Add(src[n]);
 }
@@ -201,9 +274,8 @@ wxString *wxArrayString::Grow(size_t nIncrement)
       m_nSize += nIncrement;
       wxString *pNew = new wxString[m_nSize];
 
-      // copy data to new location
-      for ( size_t j = 0; j < m_nCount; j++ )
-          pNew[j] = m_pItems[j];
+      // move data to new location
+      std::move(m_pItems, m_pItems + m_nCount, pNew);
 
       wxString* const pItemsOld = m_pItems;
 
@@ -248,8 +320,7 @@ void wxArrayString::Alloc(size_t nSize)
     if ( !pNew )
         return;
 
-    for ( size_t j = 0; j < m_nCount; j++ )
-        pNew[j] = m_pItems[j];
+    std::move(m_pItems, m_pItems + m_nCount, pNew);
     delete [] m_pItems;
 
     m_pItems = pNew;
@@ -265,9 +336,8 @@ void wxArrayString::Shrink()
     // allocates exactly as much memory as we need
     wxString *pNew = new wxString[m_nCount];
 
-    // copy data to new location
-    for ( size_t j = 0; j < m_nCount; j++ )
-        pNew[j] = m_pItems[j];
+    // move data to new location
+    std::move(m_pItems, m_pItems + m_nCount, pNew);
     delete [] m_pItems;
     m_pItems = pNew;
     m_nSize = m_nCount;
@@ -339,9 +409,14 @@ size_t wxArrayString::Add(const wxString& str, size_t nInsert)
     return nIndex;
   }
   else {
-    // Now that we must postpone freeing the old memory until we don't need it
-    // any more, i.e. don't reference "str" which could be a reference to one
-    // of our own strings.
+    // The existing strings are moved to the new buffer when growing it, so
+    // if "str" refers to one of them, we need to make a copy of it first.
+    if ( IsOwnString(str) )
+    {
+      const wxString copy(str);
+      return Add(copy, nInsert);
+    }
+
     wxScopedArray<wxString> oldStrings(Grow(nInsert));
 
     for (size_t i = 0; i < nInsert; i++)
@@ -362,10 +437,18 @@ void wxArrayString::Insert(const wxString& str, size_t nIndex, size_t nInsert)
   wxCHECK_RET( m_nCount <= m_nCount + nInsert,
                wxT("array size overflow in wxArrayString::Insert") );
 
+  // As in Add(), "str" may be invalidated by moving the existing strings.
+  if ( IsOwnString(str) )
+  {
+      const wxString copy(str);
+      Insert(copy, nIndex, nInsert);
+      return;
+  }
+
   wxScopedArray<wxString> oldStrings(Grow(nInsert));
 
-  for (int j = m_nCount - nIndex - 1; j >= 0; j--)
-      m_pItems[nIndex + nInsert + j] = m_pItems[nIndex + j];
+  std::move_backward(m_pItems + nIndex, m_pItems + m_nCount,
+                     m_pItems + m_nCount + nInsert);
 
   for (size_t i = 0; i < nInsert; i++)
   {
@@ -423,8 +506,8 @@ void wxArrayString::RemoveAt(size_t nIndex, size_t nRemove)
   wxCHECK_RET( nIndex + nRemove <= m_nCount,
                wxT("removing too many elements in wxArrayString::Remove") );
 
-  for ( size_t j =  0; j < m_nCount - nIndex -nRemove; j++)
-      m_pItems[nIndex + j] = m_pItems[nIndex + nRemove + j];
+  std::move(m_pItems + nIndex + nRemove, m_pItems + m_nCount,
+            m_pItems + nIndex);
 
   m_nCount -= nRemove;
 }
@@ -515,6 +598,105 @@ bool wxArrayString::operator==(const wxArrayString& a) const
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// wxSortedArrayString bulk operations
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the predicate corresponding to the order of the sorted array using
+// the given comparison function, which may be null for the default order.
+inline wxSortPredicateAdaptor
+GetAutoSortPredicate(wxArrayString::CompareFunction compareFunction)
+{
+    return wxSortPredicateAdaptor(compareFunction ? compareFunction
+                                                  : wxStringSortAscending);
+}
+
+} // anonymous namespace
+
+void wxArrayString::RestoreAutoSortOrder()
+{
+    std::sort(m_pItems, m_pItems + m_nCount,
+              GetAutoSortPredicate(m_compareFunction));
+}
+
+wxSortedArrayString::wxSortedArrayString(wxArrayString&& array)
+    : wxArrayString(true)
+{
+    // Take ownership of the strings without copying them.
+    wxSwap(m_nSize, array.m_nSize);
+    wxSwap(m_nCount, array.m_nCount);
+    wxSwap(m_pItems, array.m_pItems);
+
+    RestoreAutoSortOrder();
+}
+
+void wxSortedArrayString::Merge(const wxSortedArrayString& other)
+{
+    wxCHECK_RET( &other != this, "can't merge the array with itself" );
+    wxASSERT_MSG( m_compareFunction == other.m_compareFunction,
+                  "arrays must be sorted in the same order" );
+
+    const size_t count = m_nCount;
+
+    wxScopedArray<wxString> oldStrings(Grow(other.m_nCount));
+
+    std::copy(other.m_pItems, other.m_pItems + other.m_nCount,
+              m_pItems + m_nCount);
+    m_nCount += other.m_nCount;
+
+    std::inplace_merge(m_pItems, m_pItems + count, m_pItems + m_nCount,
+                       GetAutoSortPredicate(m_compareFunction));
+}
+
+void wxSortedArrayString::Merge(wxSortedArrayString&& other)
+{
+    wxCHECK_RET( &other != this, "can't merge the array with itself" );
+    wxASSERT_MSG( m_compareFunction == other.m_compareFunction,
+                  "arrays must be sorted in the same order" );
+
+    if ( !m_nCount )
+    {
+        wxSwap(m_nSize, other.m_nSize);
+        wxSwap(m_nCount, other.m_nCount);
+        wxSwap(m_pItems, other.m_pItems);
+        return;
+    }
+
+    const size_t count = m_nCount;
+
+    wxScopedArray<wxString> oldStrings(Grow(other.m_nCount));
+
+    std::move(other.m_pItems, other.m_pItems + other.m_nCount,
+              m_pItems + m_nCount);
+    m_nCount += other.m_nCount;
+
+    other.Clear();
+
+    std::inplace_merge(m_pItems, m_pItems + count, m_pItems + m_nCount,
+                       GetAutoSortPredicate(m_compareFunction));
+}
+
+size_t wxSortedArrayString::RemoveDuplicates()
+{
+    const wxSortPredicateAdaptor less = GetAutoSortPredicate(m_compareFunction);
+
+    // As the array is sorted, the elements are equal if the first one is not
+    // less than the second one.
+    wxString* const last = std::unique(m_pItems, m_pItems + m_nCount,
+                                       [&less](const wxString& s1, const wxString& s2)
+                                       {
+                                           return !less(s1, s2);
+                                       });
+
+    const size_t removed = m_pItems + m_nCount - last;
+    m_nCount -= removed;
+
+    return removed;
+}
+
 #endif // !wxUSE_STD_CONTAINERS
 
 // ===========================================================================
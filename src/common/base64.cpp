@@ -13,6 +13,110 @@
 
 #include "wx/base64.h"
 
+#include <string.h>
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+namespace
+{
+
+const char b64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Table mapping all 12-bit values to their representation as 2 base64
+// characters, which allows encoding 3 bytes using just 2 table lookups.
+class Base64PairsTable
+{
+public:
+    Base64PairsTable()
+    {
+        for ( unsigned n = 0; n < 4096; n++ )
+        {
+            m_pairs[2*n] = b64[n >> 6];
+            m_pairs[2*n + 1] = b64[n & 0x3f];
+        }
+    }
+
+    const char* Get(unsigned n) const { return m_pairs + 2*n; }
+
+private:
+    char m_pairs[2*4096];
+};
+
+// this table contains the values, in base 64, of all valid characters and
+// special values WSP or INV for white space and invalid characters
+// respectively as well as a special PAD value for '='
+enum
+{
+    WSP = 200,
+    INV,
+    PAD
+};
+
+const unsigned char decode[256] =
+{
+    WSP,INV,INV,INV,INV,INV,INV,INV,INV,WSP,WSP,INV,WSP,WSP,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    WSP,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,076,INV,INV,INV,077,
+    064,065,066,067,070,071,072,073,074,075,INV,INV,INV,PAD,INV,INV,
+    INV,000,001,002,003,004,005,006,007,010,011,012,013,014,015,016,
+    017,020,021,022,023,024,025,026,027,030,031,INV,INV,INV,INV,INV,
+    INV,032,033,034,035,036,037,040,041,042,043,044,045,046,047,050,
+    051,052,053,054,055,056,057,060,061,062,063,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+    INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
+};
+
+// Decode as many groups of 4 characters as possible as long as they contain
+// only the valid base64 characters, i.e. no padding, white space or anything
+// else requiring special handling, and return the number of decoded groups.
+//
+// This is the fast path used for the bulk of the data, which typically only
+// contains such groups, and so doesn't need the state machine used for the
+// general case.
+size_t DecodeGroups(unsigned char* dst, const char* src, size_t count)
+{
+    const unsigned char* const s = reinterpret_cast<const unsigned char*>(src);
+
+    size_t n;
+    for ( n = 0; n < count; n++ )
+    {
+        const unsigned char c0 = decode[s[4*n]],
+                            c1 = decode[s[4*n + 1]],
+                            c2 = decode[s[4*n + 2]],
+                            c3 = decode[s[4*n + 3]];
+
+        // All special values have their 2 most significant bits set while
+        // the normal values are all less than 64.
+        if ( (c0 | c1 | c2 | c3) & 0xc0 )
+            break;
+
+        if ( dst )
+        {
+            *dst++ = c0 << 2 | c1 >> 4;
+            *dst++ = c1 << 4 | c2 >> 2;
+            *dst++ = c2 << 6 | c3;
+        }
+    }
+
+    return n;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Functions
+// ----------------------------------------------------------------------------
+
+
 size_t
 wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
 {
@@ -20,44 +124,34 @@ wxBase64Encode(char *dst, size_t dstLen, const void *src_, size_t srcLen)
 
     const unsigned char *src = static_cast<const unsigned char *>(src_);
 
-    static const char b64[] =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const size_t encLen = wxBase64EncodedSize(srcLen);
+    if ( !dst )
+        return encLen;
 
+    if ( encLen > dstLen )
+        return wxCONV_FAILED;
 
-    size_t encLen = 0;
+    static const Base64PairsTable s_pairs;
 
     // encode blocks of 3 bytes into 4 base64 characters
     for ( ; srcLen >= 3; srcLen -= 3, src += 3 )
     {
-        encLen += 4;
-        if ( dst )
-        {
-            if ( encLen > dstLen )
-                return wxCONV_FAILED;
+        const unsigned block = src[0] << 16 | src[1] << 8 | src[2];
 
-            *dst++ = b64[src[0] >> 2];
-            *dst++ = b64[((src[0] & 0x03) << 4) | ((src[1] & 0xf0) >> 4)];
-            *dst++ = b64[((src[1] & 0x0f) << 2) | ((src[2] & 0xc0) >> 6)];
-            *dst++ = b64[src[2] & 0x3f];
-        }
+        memcpy(dst, s_pairs.Get(block >> 12), 2);
+        memcpy(dst + 2, s_pairs.Get(block & 0xfff), 2);
+        dst += 4;
     }
 
     // finish with the remaining characters
     if ( srcLen )
     {
-        encLen += 4;
-        if ( dst )
-        {
-            if ( encLen > dstLen )
-                return wxCONV_FAILED;
-
-            // we have definitely one and maybe two bytes remaining
-            unsigned char next = srcLen == 2 ? src[1] : 0;
-            *dst++ = b64[src[0] >> 2];
-            *dst++ = b64[((src[0] & 0x03) << 4) | ((next & 0xf0) >> 4)];
-            *dst++ = srcLen == 2 ? b64[((next & 0x0f) << 2)] : '=';
-            *dst = '=';
-        }
+        // we have definitely one and maybe two bytes remaining
+        unsigned char next = srcLen == 2 ? src[1] : 0;
+        *dst++ = b64[src[0] >> 2];
+        *dst++ = b64[((src[0] & 0x03) << 4) | ((next & 0xf0) >> 4)];
+        *dst++ = srcLen == 2 ? b64[((next & 0x0f) << 2)] : '=';
+        *dst = '=';
     }
 
     return encLen;
@@ -78,36 +172,6 @@ wxBase64Decode(void *dst_, size_t dstLen,
     if ( srcLen == wxNO_LEN )
         srcLen = strlen(src);
 
-    // this table contains the values, in base 64, of all valid characters and
-    // special values WSP or INV for white space and invalid characters
-    // respectively as well as a special PAD value for '='
-    enum
-    {
-        WSP = 200,
-        INV,
-        PAD
-    };
-
-    static const unsigned char decode[256] =
-    {
-        WSP,INV,INV,INV,INV,INV,INV,INV,INV,WSP,WSP,INV,WSP,WSP,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        WSP,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,076,INV,INV,INV,077,
-        064,065,066,067,070,071,072,073,074,075,INV,INV,INV,PAD,INV,INV,
-        INV,000,001,002,003,004,005,006,007,010,011,012,013,014,015,016,
-        017,020,021,022,023,024,025,026,027,030,031,INV,INV,INV,INV,INV,
-        INV,032,033,034,035,036,037,040,041,042,043,044,045,046,047,050,
-        051,052,053,054,055,056,057,060,061,062,063,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-        INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,INV,
-    };
-
     // we decode input by groups of 4 characters but things are complicated by
     // the fact that there can be whitespace and other junk in it too so keep
     // record of where exactly we're inside the current quartet in this var
@@ -118,6 +182,28 @@ wxBase64Decode(void *dst_, size_t dstLen,
     const char *p;
     for ( p = src; srcLen; p++, srcLen-- )
     {
+        if ( !n && !end )
+        {
+            // Decode everything we can at once before falling back to
+            // processing the input character by character.
+            size_t count = srcLen / 4;
+            if ( dst && count > (dstLen - decLen) / 3 )
+                count = (dstLen - decLen) / 3;
+
+            count = DecodeGroups(dst, p, count);
+            if ( count )
+            {
+                p += 4*count;
+                srcLen -= 4*count;
+                decLen += 3*count;
+                if ( dst )
+                    dst += 3*count;
+
+                if ( !srcLen )
+                    break;
+            }
+        }
+
         const unsigned char c = decode[static_cast<unsigned char>(*p)];
         switch ( c )
         {
@@ -234,4 +320,218 @@ wxMemoryBuffer wxBase64Decode(const char *src,
     return buf;
 }
 
+#if wxUSE_STREAMS
+
+// ----------------------------------------------------------------------------
+// wxBase64InputStream: decoding
+// ----------------------------------------------------------------------------
+
+void wxBase64InputStream::Init(wxBase64DecodeMode mode)
+{
+    m_mode = mode;
+    m_charsLen = 0;
+    m_decodedPos =
+    m_decodedLen = 0;
+    m_end = false;
+    m_pos = 0;
+}
+
+bool wxBase64InputStream::ReadMore()
+{
+    m_decodedPos =
+    m_decodedLen = 0;
+
+    // Note that we never have more than 3 characters remaining from the last
+    // time, so there is always space for reading more of them.
+    char* const start = m_chars + m_charsLen;
+    m_parent_i_stream->Read(start, BUF_SIZE - m_charsLen);
+
+    const size_t numRead = m_parent_i_stream->LastRead();
+    if ( !numRead )
+    {
+        if ( m_parent_i_stream->GetLastError() != wxSTREAM_EOF )
+        {
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return false;
+        }
+
+        // If we still have any characters, they don't form a complete group
+        // and so the input is truncated.
+        m_lasterror = m_charsLen ? wxSTREAM_READ_ERROR : wxSTREAM_EOF;
+        return false;
+    }
+
+    // Keep only the characters that are part of base64 data, so that we can
+    // always decode the complete groups of them, and check for the others
+    // here as we won't see them any more later.
+    char* out = start;
+    for ( const char* p = start; p != start + numRead; ++p )
+    {
+        const unsigned char c = decode[static_cast<unsigned char>(*p)];
+        if ( c < 64 || c == PAD )
+        {
+            *out++ = *p;
+            continue;
+        }
+
+        const bool ok = c == WSP ? m_mode != wxBase64DecodeMode_Strict
+                                 : m_mode == wxBase64DecodeMode_Relaxed;
+        if ( !ok )
+        {
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return false;
+        }
+    }
+
+    m_charsLen = out - m_chars;
+
+    // Nothing is allowed after the padding at the end of the data.
+    if ( m_end && m_charsLen )
+    {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return false;
+    }
+
+    const size_t len = m_charsLen - m_charsLen % 4;
+    if ( !len )
+        return true;
+
+    m_decodedLen = wxBase64Decode(m_decoded, WXSIZEOF(m_decoded),
+                                  m_chars, len, wxBase64DecodeMode_Strict);
+    if ( m_decodedLen == wxCONV_FAILED )
+    {
+        m_decodedLen = 0;
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return false;
+    }
+
+    m_end = m_chars[len - 1] == '=';
+
+    m_charsLen -= len;
+    memmove(m_chars, m_chars + len, m_charsLen);
+
+    return true;
+}
+
+size_t wxBase64InputStream::OnSysRead(void *buffer, size_t size)
+{
+    char* const out = static_cast<char*>(buffer);
+
+    size_t done = 0;
+    while ( done < size )
+    {
+        if ( m_decodedPos == m_decodedLen )
+        {
+            if ( !ReadMore() )
+                break;
+
+            // Note that we may have not decoded anything if we only read
+            // white space or an incomplete group, so just loop again.
+            continue;
+        }
+
+        size_t len = m_decodedLen - m_decodedPos;
+        if ( len > size - done )
+            len = size - done;
+
+        memcpy(out + done, m_decoded + m_decodedPos, len);
+        m_decodedPos += len;
+        done += len;
+    }
+
+    m_pos += done;
+    return done;
+}
+
+// ----------------------------------------------------------------------------
+// wxBase64OutputStream: encoding
+// ----------------------------------------------------------------------------
+
+void wxBase64OutputStream::Init()
+{
+    m_pendingLen = 0;
+    m_pos = 0;
+}
+
+bool wxBase64OutputStream::WriteEncoded(const void* data, size_t len)
+{
+    const size_t encLen = wxBase64Encode(m_chars, WXSIZEOF(m_chars), data, len);
+    wxCHECK_MSG( encLen != wxCONV_FAILED, false, "buffer unexpectedly too small" );
+
+    m_parent_o_stream->Write(m_chars, encLen);
+    if ( m_parent_o_stream->LastWrite() != encLen )
+    {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return false;
+    }
+
+    return true;
+}
+
+size_t wxBase64OutputStream::OnSysWrite(const void *buffer, size_t size)
+{
+    const unsigned char* src = static_cast<const unsigned char*>(buffer);
+    size_t left = size;
+
+    // Complete the group of 3 bytes remaining from the last call first.
+    if ( m_pendingLen )
+    {
+        while ( m_pendingLen < 3 && left )
+        {
+            m_pending[m_pendingLen++] = *src++;
+            left--;
+        }
+
+        if ( m_pendingLen < 3 )
+        {
+            m_pos += size;
+            return size;
+        }
+
+        if ( !WriteEncoded(m_pending, 3) )
+            return 0;
+
+        m_pendingLen = 0;
+    }
+
+    // Then encode all the complete groups in chunks fitting into our buffer.
+    while ( left >= 3 )
+    {
+        size_t len = left - left % 3;
+        if ( len > 3*BUF_SIZE/4 )
+            len = 3*BUF_SIZE/4;
+
+        if ( !WriteEncoded(src, len) )
+            return 0;
+
+        src += len;
+        left -= len;
+    }
+
+    // And keep the rest until we get more data or are closed, as we can't
+    // output it without padding before this.
+    memcpy(m_pending, src, left);
+    m_pendingLen = left;
+
+    m_pos += size;
+    return size;
+}
+
+bool wxBase64OutputStream::Close()
+{
+    if ( m_pendingLen )
+    {
+        const bool ok = WriteEncoded(m_pending, m_pendingLen);
+
+        m_pendingLen = 0;
+
+        if ( !ok )
+            return false;
+    }
+
+    return wxFilterOutputStream::Close() && IsOk();
+}
+
+#endif // wxUSE_STREAMS
+
 #endif // wxUSE_BASE64
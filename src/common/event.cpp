@@ -43,10 +43,12 @@
 
 #include "wx/thread.h"
 
+#include "wx/private/pendingevents.h"
 #include "wx/private/safecall.h"
 
 #if wxUSE_BASE
     #include <memory>
+    #include <unordered_map>
 #endif // wxUSE_BASE
 
 #if wxUSE_GUI
@@ -1190,6 +1192,355 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxPendingEventsQueue
+// ----------------------------------------------------------------------------
+
+void wxPendingEventsQueue::Push(wxPendingEventNode* first,
+                                wxPendingEventNode* last)
+{
+    last->next = m_posted.load(std::memory_order_relaxed);
+    while ( !m_posted.compare_exchange_weak(last->next, first) )
+        ;
+}
+
+void wxPendingEventsQueue::Post(wxEvent* event)
+{
+    wxPendingEventNode* const node = new wxPendingEventNode(event);
+
+    Push(node, node);
+}
+
+void wxPendingEventsQueue::PostAll(const wxVector<wxEvent*>& events)
+{
+    // Link the nodes in the reverse order, as expected by TakePosted().
+    wxPendingEventNode* first = nullptr;
+    wxPendingEventNode* last = nullptr;
+    for ( size_t n = 0; n < events.size(); n++ )
+    {
+        wxPendingEventNode* const node = new wxPendingEventNode(events[n]);
+        node->next = first;
+        first = node;
+
+        if ( !last )
+            last = node;
+    }
+
+    if ( first )
+        Push(first, last);
+}
+
+bool wxPendingEventsQueue::PostOrReplace(wxEvent* event)
+{
+    wxEvent* eventOld;
+
+    {
+        wxCRIT_SECT_LOCKER(lock, m_replaceableLock);
+
+        wxPendingEventNode*& node =
+            m_replaceable[ReplaceableKey(event->GetEventType(), event->GetId())];
+        if ( !node )
+        {
+            node = new wxPendingEventNode(event, true /* replaceable */);
+
+            // Note that the node must be pushed while still holding the lock
+            // as otherwise it could be processed before being replaced.
+            Push(node, node);
+
+            return true;
+        }
+
+        // The node is still pending, as it would have been removed from
+        // m_replaceable when taking its event otherwise, so reuse it.
+        eventOld = node->event;
+        node->event = event;
+    }
+
+    delete eventOld;
+
+    return false;
+}
+
+void wxPendingEventsQueue::TakePosted()
+{
+    wxPendingEventNode* node = m_posted.exchange(nullptr);
+    if ( !node )
+        return;
+
+    // The posted events are in the reverse order, so reverse them before
+    // appending them to the list: the last posted event becomes the last one.
+    wxPendingEventNode* const last = node;
+    wxPendingEventNode* first = nullptr;
+    while ( node )
+    {
+        wxPendingEventNode* const next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+
+    if ( m_last )
+        m_last->next = first;
+    else
+        m_first = first;
+
+    m_last = last;
+}
+
+wxEvent* wxPendingEventsQueue::Remove(wxPendingEventNode* node,
+                                      wxPendingEventNode* prev)
+{
+    if ( prev )
+        prev->next = node->next;
+    else
+        m_first = node->next;
+
+    if ( node == m_last )
+        m_last = prev;
+
+    wxEvent* event;
+    if ( node->replaceable )
+    {
+        wxCRIT_SECT_LOCKER(lock, m_replaceableLock);
+
+        // Any event posted with the same key from now on must be added to the
+        // queue again instead of replacing this one.
+        event = node->event;
+
+        const auto it = m_replaceable.find(ReplaceableKey(event->GetEventType(),
+                                                          event->GetId()));
+        if ( it != m_replaceable.end() && it->second == node )
+            m_replaceable.erase(it);
+    }
+    else
+    {
+        event = node->event;
+    }
+
+    delete node;
+
+    return event;
+}
+
+void wxPendingEventsQueue::DeleteAll()
+{
+    TakePosted();
+
+    // Ensure that the events of the nodes we're going to delete can't be
+    // replaced any more.
+    {
+        wxCRIT_SECT_LOCKER(lock, m_replaceableLock);
+
+        m_replaceable.clear();
+    }
+
+    for ( wxPendingEventNode* node = m_first; node; )
+    {
+        wxPendingEventNode* const next = node->next;
+
+        delete node->event;
+        delete node;
+
+        node = next;
+    }
+
+    m_first =
+    m_last = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// wxPendingEventHandlers
+// ----------------------------------------------------------------------------
+
+wxPendingEventHandlers::~wxPendingEventHandlers()
+{
+    // Don't leave the queues of the handlers which still exist in an
+    // inconsistent state, they could be added to another set later.
+    TakeAdded();
+
+    for ( List* list : { &m_main, &m_delayed } )
+    {
+        for ( wxPendingEventsQueue* queue = list->first; queue; )
+        {
+            wxPendingEventsQueue* const next = queue->m_next;
+
+            queue->m_listKind = wxPendingEventsQueue::ListKind::None;
+            queue->m_prev =
+            queue->m_next = nullptr;
+            queue->m_listed = false;
+
+            queue = next;
+        }
+    }
+}
+
+void wxPendingEventHandlers::Add(wxPendingEventsQueue* queue)
+{
+    // Only add the queue if it's not already in the set: this also ensures
+    // that it can't be added to the stack below more than once.
+    if ( queue->m_listed.exchange(true) )
+        return;
+
+    queue->m_nextAdded = m_added.load(std::memory_order_relaxed);
+    while ( !m_added.compare_exchange_weak(queue->m_nextAdded, queue) )
+        ;
+}
+
+void wxPendingEventHandlers::TakeAdded()
+{
+    wxPendingEventsQueue* queue = m_added.exchange(nullptr);
+    if ( !queue )
+        return;
+
+    // As in wxPendingEventsQueue::TakePosted(), restore the original order.
+    wxPendingEventsQueue* first = nullptr;
+    while ( queue )
+    {
+        wxPendingEventsQueue* const next = queue->m_nextAdded;
+        queue->m_nextAdded = first;
+        first = queue;
+        queue = next;
+    }
+
+    for ( queue = first; queue; )
+    {
+        wxPendingEventsQueue* const next = queue->m_nextAdded;
+        queue->m_nextAdded = nullptr;
+
+        Append(m_main, wxPendingEventsQueue::ListKind::Main, queue);
+
+        queue = next;
+    }
+}
+
+void wxPendingEventHandlers::Append(List& list,
+                                    wxPendingEventsQueue::ListKind kind,
+                                    wxPendingEventsQueue* queue)
+{
+    wxASSERT( queue->m_listKind == wxPendingEventsQueue::ListKind::None );
+
+    queue->m_listKind = kind;
+    queue->m_prev = list.last;
+    queue->m_next = nullptr;
+
+    if ( list.last )
+        list.last->m_next = queue;
+    else
+        list.first = queue;
+
+    list.last = queue;
+}
+
+void wxPendingEventHandlers::Unlink(wxPendingEventsQueue* queue)
+{
+    List* list;
+    switch ( queue->m_listKind )
+    {
+        case wxPendingEventsQueue::ListKind::Main:
+            list = &m_main;
+            break;
+
+        case wxPendingEventsQueue::ListKind::Delayed:
+            list = &m_delayed;
+            break;
+
+        case wxPendingEventsQueue::ListKind::None:
+        default:
+            return;
+    }
+
+    if ( queue->m_prev )
+        queue->m_prev->m_next = queue->m_next;
+    else
+        list->first = queue->m_next;
+
+    if ( queue->m_next )
+        queue->m_next->m_prev = queue->m_prev;
+    else
+        list->last = queue->m_prev;
+
+    queue->m_listKind = wxPendingEventsQueue::ListKind::None;
+    queue->m_prev =
+    queue->m_next = nullptr;
+}
+
+wxPendingEventsQueue* wxPendingEventHandlers::GetFirst()
+{
+    TakeAdded();
+
+    return m_main.first;
+}
+
+void wxPendingEventHandlers::RemoveIfEmpty(wxPendingEventsQueue* queue)
+{
+    TakeAdded();
+
+    // If the queue is not in any list even after taking the added ones, it's
+    // being added by another thread right now and we can't remove it yet, but
+    // it will be removed when its handler is processed later if it's empty.
+    if ( queue->m_listKind == wxPendingEventsQueue::ListKind::None )
+        return;
+
+    queue->TakePosted();
+    if ( !queue->IsEmpty() )
+        return;
+
+    Unlink(queue);
+
+    // Another thread could have posted an event after we checked for it above
+    // but before resetting this flag and, seeing it still set, wouldn't have
+    // added the queue to the set, so check for this and do it ourselves.
+    queue->m_listed = false;
+    if ( queue->HasPosted() && !queue->m_listed.exchange(true) )
+        Append(m_main, wxPendingEventsQueue::ListKind::Main, queue);
+}
+
+void wxPendingEventHandlers::Remove(wxPendingEventsQueue* queue)
+{
+    // Make sure the queue is not in the stack of the added ones any more.
+    TakeAdded();
+
+    Unlink(queue);
+
+    // Notice that we intentionally don't reset m_listed here, the queue is
+    // about to be destroyed and must not be added to the set again.
+}
+
+void wxPendingEventHandlers::Delay(wxPendingEventsQueue* queue)
+{
+    TakeAdded();
+
+    if ( queue->m_listKind != wxPendingEventsQueue::ListKind::Main )
+        return;
+
+    Unlink(queue);
+    Append(m_delayed, wxPendingEventsQueue::ListKind::Delayed, queue);
+}
+
+void wxPendingEventHandlers::ResumeDelayed()
+{
+    while ( wxPendingEventsQueue* const queue = m_delayed.first )
+    {
+        Unlink(queue);
+        Append(m_main, wxPendingEventsQueue::ListKind::Main, queue);
+    }
+}
+
+void wxPendingEventHandlers::DeleteAllEvents()
+{
+    TakeAdded();
+
+    for ( wxPendingEventsQueue* queue = m_main.first; queue; )
+    {
+        wxPendingEventsQueue* const next = queue->m_next;
+
+        queue->DeleteAll();
+        RemoveIfEmpty(queue);
+
+        queue = next;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
@@ -1241,7 +1592,8 @@ wxEvtHandler::~wxEvtHandler()
     if (wxTheApp)
         wxTheApp->RemovePendingEventHandler(this);
 
-    DeletePendingEvents();
+    // This also deletes all the pending events.
+    delete m_pendingEvents.load();
 
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
@@ -1322,53 +1674,148 @@ bool wxEvtHandler::ProcessThreadEvent(const wxEvent& event)
 
 #endif // wxUSE_THREADS
 
-void wxEvtHandler::QueueEvent(wxEvent *event)
+namespace
 {
-    wxCHECK_RET( event, "null event can't be posted" );
 
-    if (!wxTheApp)
+// Check if the events can be queued, i.e. if the application object exists.
+bool CanQueueEvents()
+{
+    if ( !wxTheApp )
     {
         // we need an event loop which manages the list of event handlers with
         // pending events... cannot proceed without it!
         wxLogDebug("No application object! Cannot queue this event!");
 
+        return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+void wxEvtHandler::QueueEvent(wxEvent *event)
+{
+    wxCHECK_RET( event, "null event can't be posted" );
+
+    if ( !CanQueueEvents() )
+    {
         // anyway delete the given event to avoid memory leaks
         delete event;
 
         return;
     }
 
-    // 1) Add this event to our list of pending events
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    // 1) Add this event to our list of pending events: this doesn't need any
+    //    locking and so doesn't block the other threads posting events
+    GetPendingEventsQueue()->Post(event);
+
+    // 2) Add this event handler to list of event handlers that
+    //    have pending events, this is lock-free too.
+    //
+    // Notice that this must be done after posting the event: if the pending
+    // events are processed in between, this handler may be added to the list
+    // without having any pending events, but it will just remove itself from
+    // it when it finds that it doesn't have any, while doing it in the other
+    // order could result in a handler with pending events not being in the
+    // list, as described in the ticket #9093.
+    wxTheApp->AppendPendingEventHandler(this);
+
+    // 3) Inform the system that new pending events are somewhere,
+    //    and that these should be processed in idle time.
+    wxWakeUpIdle();
+}
+
+void wxEvtHandler::QueueEvents(const wxVector<wxEvent*>& events)
+{
+    if ( events.empty() )
+        return;
+
+    for ( size_t n = 0; n < events.size(); n++ )
+    {
+        if ( !events[n] )
+        {
+            // We still own all the other events, so don't leak them.
+            for ( size_t m = 0; m < events.size(); m++ )
+                delete events[m];
 
-    if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
+            wxFAIL_MSG( "null event can't be posted" );
 
-    m_pendingEvents->Append(event);
+            return;
+        }
+    }
 
-    // 2) Add this event handler to list of event handlers that
-    //    have pending events.
+    if ( !CanQueueEvents() )
+    {
+        for ( size_t n = 0; n < events.size(); n++ )
+            delete events[n];
+
+        return;
+    }
+
+    // This does the same thing as QueueEvent(), but only once for all events.
+    GetPendingEventsQueue()->PostAll(events);
 
     wxTheApp->AppendPendingEventHandler(this);
 
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+    wxWakeUpIdle();
+}
+
+void wxEvtHandler::QueueOrReplaceEvent(wxEvent *event)
+{
+    wxCHECK_RET( event, "null event can't be posted" );
+
+    if ( !CanQueueEvents() )
+    {
+        delete event;
+
+        return;
+    }
+
+    // If the event replaced an already pending one, there is nothing else to
+    // do: this handler is already in the list of handlers with pending events
+    // and the event loop has already been woken up.
+    if ( !GetPendingEventsQueue()->PostOrReplace(event) )
+        return;
+
+    wxTheApp->AppendPendingEventHandler(this);
 
-    // 3) Inform the system that new pending events are somewhere,
-    //    and that these should be processed in idle time.
     wxWakeUpIdle();
 }
 
+wxPendingEventsQueue* wxEvtHandler::GetPendingEventsQueue()
+{
+    wxPendingEventsQueue* queue = m_pendingEvents.load();
+    if ( !queue )
+    {
+        // This can be called by several threads at once, so ensure that only
+        // the queue created by one of them is used.
+        wxPendingEventsQueue* const queueNew = new wxPendingEventsQueue(this);
+        if ( m_pendingEvents.compare_exchange_strong(queue, queueNew) )
+            queue = queueNew;
+        else
+            delete queueNew;
+    }
+
+    return queue;
+}
+
 void wxEvtHandler::DeletePendingEvents()
 {
-    if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
-    wxDELETE(m_pendingEvents);
+    wxPendingEventsQueue* const queue = m_pendingEvents.load();
+    if ( !queue )
+        return;
+
+    if ( !wxTheApp )
+    {
+        // no events can be queued without the application object anyhow
+        queue->DeleteAll();
+        return;
+    }
+
+    wxCRIT_SECT_LOCKER(lock, wxTheApp->m_handlersWithPendingEventsLocker);
+
+    queue->DeleteAll();
 }
 
 void wxEvtHandler::ProcessPendingEvents()
@@ -1381,59 +1828,73 @@ void wxEvtHandler::ProcessPendingEvents()
         return;
     }
 
+    // this method is only called by wxApp if this handler does have
+    // pending events
+    wxPendingEventsQueue* const queue = m_pendingEvents.load();
+    wxCHECK_RET( queue, "should have pending events if called" );
+
+    wxPendingEventHandlers* const
+        handlersWithPendingEvents = wxTheApp->m_handlersWithPendingEvents;
+
     // we need to process only a single pending event in this call because
     // each call to ProcessEvent() could result in the destruction of this
     // same event handler (see the comment at the end of this function)
 
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    wxENTER_CRIT_SECT( wxTheApp->m_handlersWithPendingEventsLocker );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+    queue->TakePosted();
 
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
+    wxPendingEventNode* node = queue->GetFirst();
+    if ( !node )
+    {
+        // this may happen if the pending events were deleted or if this
+        // handler was added to the list while its events were being processed
+        handlersWithPendingEvents->RemoveIfEmpty(queue);
+
+        wxLEAVE_CRIT_SECT( wxTheApp->m_handlersWithPendingEventsLocker );
+
+        return;
+    }
 
     // find the first event which can be processed now:
+    wxPendingEventNode* prev = nullptr;
     wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
     if (evtLoop && evtLoop->IsYielding())
     {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
+        // Don't use node->event here, it can be replaced by another thread.
+        while (node && !evtLoop->IsEventAllowedInsideYield(node->category))
         {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : nullptr;
+            prev = node;
+            node = node->next;
         }
 
         if (!node)
         {
             // all our events are NOT processable now... signal this:
-            wxTheApp->DelayPendingEventHandler(this);
+            handlersWithPendingEvents->Delay(queue);
 
             // see the comment at the beginning of evtloop.h header for the
             // logic behind YieldFor() and behind DelayPendingEventHandler()
 
-            wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+            wxLEAVE_CRIT_SECT( wxTheApp->m_handlersWithPendingEventsLocker );
 
             return;
         }
     }
 
-    std::unique_ptr<wxEvent> event(pEvent);
-
     // it's important we remove event from list before processing it, else a
     // nested event loop, for example from a modal dialog, might process the
     // same event again.
-    m_pendingEvents->Erase(node);
+    std::unique_ptr<wxEvent> event(queue->Remove(node, prev));
 
-    if ( m_pendingEvents->IsEmpty() )
+    if ( queue->IsEmpty() )
     {
         // if there are no more pending events left, we don't need to
         // stay in this list
-        wxTheApp->RemovePendingEventHandler(this);
+        handlersWithPendingEvents->RemoveIfEmpty(queue);
     }
 
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+    wxLEAVE_CRIT_SECT( wxTheApp->m_handlersWithPendingEventsLocker );
 
     // We must not let exceptions escape from here, there is no outer exception
     // handler to catch them and so letting them do it would just terminate the
@@ -1772,6 +2233,56 @@ bool wxEvtHandler::SearchEventTable(wxEventTable& table, wxEvent& event)
     return false;
 }
 
+// ----------------------------------------------------------------------------
+// dynamic event table index
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Don't bother with indexing the dynamic event table if it has fewer entries
+// than this, searching it linearly is fast enough then.
+const size_t MIN_DYNAMIC_ENTRIES_FOR_INDEX = 16;
+
+// Indices of the entries in DynamicEvents::m_entries, in increasing order.
+typedef wxVector<size_t> DynamicEntryIndices;
+
+} // anonymous namespace
+
+struct wxEvtHandler::DynamicEventsIndex
+{
+    // All entries for the same event type.
+    struct ForType
+    {
+        // The entries matching any id or a range of ids.
+        DynamicEntryIndices any;
+
+        // The entries matching a single id.
+        std::unordered_map<int, DynamicEntryIndices> byId;
+    };
+
+    void Add(const wxDynamicEventTableEntry& entry, size_t n)
+    {
+        ForType& forType = byType[entry.m_eventType];
+
+        if ( entry.m_id != wxID_ANY &&
+                (entry.m_lastId == wxID_ANY || entry.m_lastId == entry.m_id) )
+            forType.byId[entry.m_id].push_back(n);
+        else
+            forType.any.push_back(n);
+    }
+
+    // Notice that the elements of unordered_map are never moved in memory
+    // when it grows, so pointers to them remain valid even if new entries are
+    // added to the index while it's being used.
+    std::unordered_map<wxEventType, ForType> byType;
+};
+
+wxEvtHandler::DynamicEvents::~DynamicEvents()
+{
+    delete m_index;
+}
+
 void wxEvtHandler::DoBind(int id,
                           int lastId,
                           wxEventType eventType,
@@ -1796,6 +2307,9 @@ void wxEvtHandler::DoBind(int id,
     // than inserting the element at the front.
     m_dynamicEvents->m_entries.push_back(entry);
 
+    if ( m_dynamicEvents->m_index )
+        m_dynamicEvents->m_index->Add(*entry, m_dynamicEvents->m_entries.size() - 1);
+
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
     if ( eventSink && eventSink != this )
@@ -1849,6 +2363,7 @@ wxEvtHandler::DoUnbind(int id,
             // vector, which is not guaranteed by our API, but here we can use
             // this implementation detail.
             m_dynamicEvents->m_entries[cookie] = nullptr;
+            m_dynamicEvents->m_numDeleted++;
 
             delete entry;
             return true;
@@ -1905,53 +2420,105 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     DynamicEvents& dynamicEvents = *m_dynamicEvents;
 
     wxRecursionGuard guard(dynamicEvents.m_flag);
-    bool needToPruneDeleted = false;
 
-    // We can't use Get{First,Next}DynamicEntry() here as they hide the deleted
-    // but not yet pruned entries from the caller, but here we do want to know
-    // about them, so iterate directly. Remember to do it in the reverse order
-    // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.m_entries.size(); n; n-- )
+    const auto processEntry = [this, &event](wxDynamicEventTableEntry& entry)
+    {
+        wxEvtHandler *handler = entry.m_fn->GetEvtHandler();
+        if ( !handler )
+           handler = this;
+
+        // It's important to skip pruning of the unbound event entries below
+        // if this returns true because this object itself could have been
+        // deleted by the event handler making m_dynamicEvents a dangling
+        // pointer which can't be accessed any longer in the code below.
+        //
+        // In practice, it hopefully shouldn't be a problem to wait until we
+        // get an event that we don't handle before pruning because this
+        // should happen soon enough and even if it doesn't the worst possible
+        // outcome is slightly increased memory consumption while not skipping
+        // pruning can result in hard to reproduce (because they require the
+        // disconnection and deletion happen at the same time which is not
+        // always the case) crashes.
+        return ProcessEventIfMatchesId(entry, handler, event);
+    };
+
+    if ( !dynamicEvents.m_index &&
+            dynamicEvents.m_entries.size() - dynamicEvents.m_numDeleted
+                >= MIN_DYNAMIC_ENTRIES_FOR_INDEX )
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents.m_entries[n - 1];
+        dynamicEvents.m_index = new DynamicEventsIndex;
+        for ( size_t n = 0; n < dynamicEvents.m_entries.size(); n++ )
+        {
+            if ( dynamicEvents.m_entries[n] )
+                dynamicEvents.m_index->Add(*dynamicEvents.m_entries[n], n);
+        }
+    }
 
-        if ( !entry )
+    if ( dynamicEvents.m_index )
+    {
+        // Only check the entries for this event type which can match its id,
+        // but still in the reverse order of their connection, which requires
+        // merging the entries for this id with those for any id.
+        const DynamicEventsIndex::ForType* forType = nullptr;
         {
-            // This entry must have been unbound at some time in the past, so
-            // skip it now and really remove it from the vector below, once we
-            // finish iterating.
-            // N.B.:  If we are in a nested call, then we can't be done
-            // iterating during this call
-            needToPruneDeleted = !guard.IsInside();
-            continue;
+            const auto it = dynamicEvents.m_index->byType.find(event.GetEventType());
+            if ( it != dynamicEvents.m_index->byType.end() )
+                forType = &it->second;
         }
 
-        if ( event.GetEventType() == entry->m_eventType )
+        if ( forType )
         {
-            wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
-            if ( !handler )
-               handler = this;
-            if ( ProcessEventIfMatchesId(*entry, handler, event) )
+            const DynamicEntryIndices& any = forType->any;
+            const DynamicEntryIndices* byId = nullptr;
             {
-                // It's important to skip pruning of the unbound event entries
-                // below because this object itself could have been deleted by
-                // the event handler making m_dynamicEvents a dangling pointer
-                // which can't be accessed any longer in the code below.
-                //
-                // In practice, it hopefully shouldn't be a problem to wait
-                // until we get an event that we don't handle before pruning
-                // because this should happen soon enough and even if it
-                // doesn't the worst possible outcome is slightly increased
-                // memory consumption while not skipping pruning can result in
-                // hard to reproduce (because they require the disconnection
-                // and deletion happen at the same time which is not always the
-                // case) crashes.
-                return true;
+                const auto it = forType->byId.find(event.GetId());
+                if ( it != forType->byId.end() )
+                    byId = &it->second;
+            }
+
+            // Notice that we must not use iterators here as more entries can
+            // be added to these vectors by the event handlers, but, just as in
+            // the linear search below, they're not used for this event.
+            size_t nAny = any.size(),
+                   nId = byId ? byId->size() : 0;
+            while ( nAny || nId )
+            {
+                size_t n;
+                if ( nId && (!nAny || (*byId)[nId - 1] > any[nAny - 1]) )
+                    n = (*byId)[--nId];
+                else
+                    n = any[--nAny];
+
+                // Skip the entries unbound since the index was created.
+                wxDynamicEventTableEntry* const entry = dynamicEvents.m_entries[n];
+                if ( entry && processEntry(*entry) )
+                    return true;
+            }
+        }
+    }
+    else
+    {
+        // We can't use Get{First,Next}DynamicEntry() here as they would
+        // ignore the entries added by the event handlers while we iterate, so
+        // iterate directly. Remember to do it in the reverse order to honour
+        // the order of handlers connection.
+        for ( size_t n = dynamicEvents.m_entries.size(); n; n-- )
+        {
+            wxDynamicEventTableEntry* const entry = dynamicEvents.m_entries[n - 1];
+
+            // Null entries have been unbound at some time in the past, skip
+            // them now and really remove them from the vector below.
+            if ( entry && event.GetEventType() == entry->m_eventType )
+            {
+                if ( processEntry(*entry) )
+                    return true;
             }
         }
     }
 
-    if ( needToPruneDeleted )
+    // Prune the unbound entries, but only if we're not in a nested call, as
+    // the outer one still uses their indices.
+    if ( dynamicEvents.m_numDeleted && !guard.IsInside() )
     {
         size_t nNew = 0;
         for ( size_t n = 0; n != dynamicEvents.m_entries.size(); n++ )
@@ -1962,6 +2529,10 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
 
         wxASSERT( nNew != dynamicEvents.m_entries.size() );
         dynamicEvents.m_entries.resize(nNew);
+        dynamicEvents.m_numDeleted = 0;
+
+        // The index is invalid now, it will be recreated when needed.
+        wxDELETE(dynamicEvents.m_index);
     }
 
     return false;
@@ -2043,6 +2614,7 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
             // Just as in DoUnbind(), we use our knowledge of
             // GetNextDynamicEntry() implementation here.
             m_dynamicEvents->m_entries[cookie] = nullptr;
+            m_dynamicEvents->m_numDeleted++;
         }
     }
 }
@@ -22,14 +22,24 @@
     #include "wx/palette.h"
     #include "wx/intl.h"
     #include "wx/colour.h"
+    #include "wx/event.h"
 #endif
 
+#include "wx/stopwatch.h"           // for wxGetLocalTimeMillis()
+#include "wx/thread.h"
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
 
+#include "wx/private/image.h"
+
 // For memcpy
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <unordered_set>
 
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
@@ -56,6 +66,287 @@ IMPLEMENT_VARIANT_OBJECT_EXPORTED_SHALLOWCMP(wxImage,WXDLLEXPORT)
 wxList wxImage::sm_handlers;
 wxImage wxNullImage;
 
+//-----------------------------------------------------------------------------
+// parallel processing helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// Maximal number of threads to use for processing images, see
+// wxImage::SetParallelism(). This is atomic as images can be processed by any
+// thread.
+std::atomic<int> gs_imageParallelism(1);
+
+#if wxUSE_THREADS
+
+// Don't bother with using multiple threads for images smaller than this
+// number of pixels, as the overhead of doing it would outweigh any gains.
+const size_t MIN_PIXELS_FOR_PARALLELISM = 128*128;
+
+// Pool of worker threads used for processing image bands in parallel.
+//
+// The pool is created on demand and destroyed by wxImageModule on shutdown.
+class ImageWorkerPool
+{
+public:
+    ImageWorkerPool()
+        : m_condWork(m_mutex),
+          m_condDone(m_mutex)
+    {
+    }
+
+    ~ImageWorkerPool()
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            m_exit = true;
+            m_condWork.Broadcast();
+        }
+
+        for ( size_t n = 0; n < m_threads.size(); n++ )
+        {
+            m_threads[n]->Wait();
+            delete m_threads[n];
+        }
+    }
+
+    // This can be called from any thread, e.g. wxImageBatchLoader workers.
+    static ImageWorkerPool& Get()
+    {
+        wxCriticalSectionLocker lock(ms_poolCS);
+
+        if ( !ms_pool )
+            ms_pool = new ImageWorkerPool;
+
+        return *ms_pool;
+    }
+
+    static void Cleanup()
+    {
+        wxCriticalSectionLocker lock(ms_poolCS);
+
+        delete ms_pool;
+        ms_pool = nullptr;
+    }
+
+    // Call processBand() for all bands in [0, numBands) range using up to the
+    // given number of threads, including the current one, and return only
+    // once all of them have been processed.
+    //
+    // Returns false without doing anything if the pool is already busy, e.g.
+    // because it is used by another thread, in which case the caller should
+    // process the bands itself.
+    bool Run(int numThreads, int numBands,
+             const std::function<void (int)>& processBand)
+    {
+        if ( m_runMutex.TryLock() != wxMUTEX_NO_ERROR )
+            return false;
+
+        {
+            wxMutexLocker lock(m_mutex);
+
+            while ( static_cast<int>(m_threads.size()) < numThreads - 1 )
+            {
+                wxThread* const thread = new WorkerThread(*this);
+                if ( thread->Run() != wxTHREAD_NO_ERROR )
+                {
+                    delete thread;
+                    break;
+                }
+
+                m_threads.push_back(thread);
+            }
+
+            m_processBand = &processBand;
+            m_numBands = numBands;
+            m_nextBand = 0;
+            m_bandsLeft = numBands;
+            m_workersWanted = numThreads - 1;
+            m_generation++;
+
+            m_condWork.Broadcast();
+        }
+
+        ProcessBands();
+
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( m_bandsLeft )
+                m_condDone.Wait();
+
+            m_processBand = nullptr;
+        }
+
+        m_runMutex.Unlock();
+
+        return true;
+    }
+
+private:
+    class WorkerThread : public wxThread
+    {
+    public:
+        explicit WorkerThread(ImageWorkerPool& pool)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pool(pool)
+        {
+        }
+
+    protected:
+        virtual ExitCode Entry() override
+        {
+            m_pool.WorkerLoop();
+
+            return nullptr;
+        }
+
+    private:
+        ImageWorkerPool& m_pool;
+    };
+
+    void WorkerLoop()
+    {
+        unsigned generation = 0;
+
+        m_mutex.Lock();
+        for ( ;; )
+        {
+            while ( m_generation == generation && !m_exit )
+                m_condWork.Wait();
+
+            if ( m_exit )
+                break;
+
+            generation = m_generation;
+
+            // Only use as many threads as were requested for this job.
+            if ( !m_workersWanted )
+                continue;
+
+            m_workersWanted--;
+
+            m_mutex.Unlock();
+            ProcessBands();
+            m_mutex.Lock();
+        }
+        m_mutex.Unlock();
+    }
+
+    // Process the remaining bands of the current job, if any.
+    void ProcessBands()
+    {
+        for ( ;; )
+        {
+            int band;
+            const std::function<void (int)>* processBand;
+            {
+                wxMutexLocker lock(m_mutex);
+                if ( m_nextBand == m_numBands )
+                    break;
+
+                band = m_nextBand++;
+                processBand = m_processBand;
+            }
+
+            (*processBand)(band);
+
+            wxMutexLocker lock(m_mutex);
+            if ( !--m_bandsLeft )
+                m_condDone.Signal();
+        }
+    }
+
+    static ImageWorkerPool* ms_pool;
+
+    // Protects ms_pool itself.
+    static wxCriticalSection ms_poolCS;
+
+    // This mutex is held while running a job.
+    wxMutex m_runMutex;
+
+    // This mutex protects all the fields below.
+    wxMutex m_mutex;
+    wxCondition m_condWork,
+                m_condDone;
+
+    wxVector<wxThread*> m_threads;
+
+    const std::function<void (int)>* m_processBand = nullptr;
+    int m_numBands = 0,
+        m_nextBand = 0,
+        m_bandsLeft = 0,
+        m_workersWanted = 0;
+
+    // Incremented whenever a new job is started.
+    unsigned m_generation = 0;
+
+    bool m_exit = false;
+
+    wxDECLARE_NO_COPY_CLASS(ImageWorkerPool);
+};
+
+ImageWorkerPool* ImageWorkerPool::ms_pool = nullptr;
+wxCriticalSection ImageWorkerPool::ms_poolCS;
+
+#endif // wxUSE_THREADS
+
+// Call func(from, to) for the consecutive bands of items covering the entire
+// [0, count) range, where each item, typically a row or a column of the
+// image, consists of the given number of pixels.
+//
+// The bands are processed in parallel if this is enabled and the amount of
+// work is big enough to make it worthwhile, so func() must only modify the
+// data corresponding to the items it is called for. Notice that the results
+// don't depend on whether parallel processing is used or not.
+template <typename F>
+void ForEachImageBand(int count, size_t pixelsPerItem, const F& func)
+{
+#if wxUSE_THREADS
+    const int numThreads = wxMin(gs_imageParallelism.load(), count);
+    if ( numThreads > 1 &&
+            count*pixelsPerItem >= MIN_PIXELS_FOR_PARALLELISM )
+    {
+        // Use more bands than threads to balance the load between them.
+        const int numBands = wxMin(4*numThreads, count);
+
+        const std::function<void (int)> processBand = [&](int band)
+        {
+            func((count*wxInt64(band))/numBands,
+                 (count*wxInt64(band + 1))/numBands);
+        };
+
+        if ( ImageWorkerPool::Get().Run(numThreads, numBands, processBand) )
+            return;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(pixelsPerItem);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    func(0, count);
+}
+
+} // anonymous namespace
+
+/* static */
+void wxImage::SetParallelism(int numThreads)
+{
+    wxCHECK_RET( numThreads >= 0, "invalid number of threads" );
+
+#if wxUSE_THREADS
+    if ( !numThreads )
+        numThreads = wxThread::GetCPUCount();
+#endif // wxUSE_THREADS
+
+    gs_imageParallelism = numThreads > 1 ? numThreads : 1;
+}
+
+/* static */
+int wxImage::GetParallelism()
+{
+    return gs_imageParallelism;
+}
+
 //-----------------------------------------------------------------------------
 // wxImageRefData
 //-----------------------------------------------------------------------------
@@ -533,18 +824,185 @@ wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
     return image;
 }
 
-wxImage wxImage::ResampleNearest(int width, int height) const
+namespace
 {
-    wxImage image;
 
-    wxCHECK_MSG( IsOk(), image, "invalid image" );
+// Helpers for converting to and from the premultiplied alpha format: notice
+// that they must be consistent with each other, so that the pixels survive the
+// round trip unchanged if they are opaque.
+inline unsigned char Premultiply(unsigned alpha, unsigned value)
+{
+    return static_cast<unsigned char>((value * alpha) / 0xff);
+}
+
+inline unsigned char Unpremultiply(unsigned alpha, unsigned value)
+{
+    return alpha ? static_cast<unsigned char>(wxMin((value * 0xff) / alpha,
+                                                    0xffu))
+                 : 0;
+}
+
+// Provides access to the rows of the image being processed in wxImage format,
+// i.e. as RGB data and separate alpha values, if any, converting them from the
+// pixel format of wxImageView one row at a time if necessary.
+//
+// Pointers returned by this class may point to its internal buffers, so each
+// thread must use its own copy of it.
+class ImageRowSource
+{
+public:
+    // Use the data of the given image, ignoring its alpha if useAlpha is false.
+    explicit ImageRowSource(const wxImage& image, bool useAlpha = true)
+        : m_data(image.GetData()),
+          m_alpha(useAlpha ? image.GetAlpha() : nullptr),
+          m_width(image.GetWidth()),
+          m_height(image.GetHeight()),
+          m_stride(3*size_t(m_width)),
+          m_format(wxIMAGE_FORMAT_RGB),
+          m_hasAlpha(m_alpha != nullptr)
+    {
+    }
+
+    explicit ImageRowSource(const wxImageView& view)
+        : m_data(view.GetData()),
+          m_alpha(nullptr),
+          m_width(view.GetWidth()),
+          m_height(view.GetHeight()),
+          m_stride(view.GetStride()),
+          m_format(view.GetFormat()),
+          m_hasAlpha(view.HasAlpha())
+    {
+    }
+
+    // Copies share the image data but not the conversion buffers.
+    ImageRowSource(const ImageRowSource& other)
+        : m_data(other.m_data),
+          m_alpha(other.m_alpha),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_stride(other.m_stride),
+          m_format(other.m_format),
+          m_hasAlpha(other.m_hasAlpha)
+    {
+    }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    bool HasAlpha() const { return m_hasAlpha; }
+
+    // Return the RGB data of the given row, this pointer is only valid until
+    // the next call to this function.
+    const unsigned char* GetRGB(int y)
+    {
+        const unsigned char* const row = m_data + y*m_stride;
+        if ( m_format == wxIMAGE_FORMAT_RGB )
+            return row;
+
+        m_rgbRow.resize(3*size_t(m_width));
+        unsigned char* dst = &m_rgbRow[0];
+        switch ( m_format )
+        {
+            case wxIMAGE_FORMAT_RGB:
+                break;
+
+            case wxIMAGE_FORMAT_RGBA:
+                for ( int x = 0; x < m_width; x++, dst += 3 )
+                {
+                    dst[0] = row[4*x];
+                    dst[1] = row[4*x + 1];
+                    dst[2] = row[4*x + 2];
+                }
+                break;
+
+            case wxIMAGE_FORMAT_BGRA:
+                for ( int x = 0; x < m_width; x++, dst += 3 )
+                {
+                    dst[0] = row[4*x + 2];
+                    dst[1] = row[4*x + 1];
+                    dst[2] = row[4*x];
+                }
+                break;
+
+            case wxIMAGE_FORMAT_GRAY:
+                for ( int x = 0; x < m_width; x++, dst += 3 )
+                {
+                    dst[0] =
+                    dst[1] =
+                    dst[2] = row[x];
+                }
+                break;
+
+            case wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED:
+                {
+                    const wxUint32* const argbRow =
+                        reinterpret_cast<const wxUint32*>(row);
+                    for ( int x = 0; x < m_width; x++, dst += 3 )
+                    {
+                        const wxUint32 argb = argbRow[x];
+                        const unsigned a = argb >> 24;
+                        dst[0] = Unpremultiply(a, (argb >> 16) & 0xff);
+                        dst[1] = Unpremultiply(a, (argb >> 8) & 0xff);
+                        dst[2] = Unpremultiply(a, argb & 0xff);
+                    }
+                }
+                break;
+        }
+
+        return &m_rgbRow[0];
+    }
+
+    // Return the alpha values of the given row, which must only be called if
+    // HasAlpha() returns true. As with GetRGB(), the returned pointer is only
+    // valid until the next call to this function.
+    const unsigned char* GetAlpha(int y)
+    {
+        if ( m_alpha )
+            return m_alpha + y*size_t(m_width);
+
+        // All formats with alpha use 4 byte pixels.
+        const unsigned char* const row = m_data + y*m_stride;
+        m_alphaRow.resize(m_width);
+        if ( m_format == wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED )
+        {
+            const wxUint32* const argbRow =
+                reinterpret_cast<const wxUint32*>(row);
+            for ( int x = 0; x < m_width; x++ )
+                m_alphaRow[x] = argbRow[x] >> 24;
+        }
+        else
+        {
+            for ( int x = 0; x < m_width; x++ )
+                m_alphaRow[x] = row[4*x + 3];
+        }
+
+        return &m_alphaRow[0];
+    }
+
+private:
+    const unsigned char* const m_data;
+    const unsigned char* const m_alpha;
+    const int m_width,
+              m_height;
+    const size_t m_stride;
+    const wxImagePixelFormat m_format;
+    const bool m_hasAlpha;
+
+    wxVector<unsigned char> m_rgbRow,
+                            m_alphaRow;
+
+    wxDECLARE_NO_ASSIGN_CLASS(ImageRowSource);
+};
+
+wxImage DoResampleNearest(const ImageRowSource& source, int width, int height)
+{
+    wxImage image;
 
     // We use wxUIntPtr to rescale images of larger size in 64-bit builds:
     // using long wouldn't allow using images larger than 2^16 in either
     // direction because of the check below, as sizeof(long) == 4 even in 64
     // bit builds under MSW, but sizeof(wxUIntPtr) == 8 in this case.
-    const wxUIntPtr old_width  = M_IMGDATA->m_width;
-    const wxUIntPtr old_height = M_IMGDATA->m_height;
+    const wxUIntPtr old_width  = source.GetWidth();
+    const wxUIntPtr old_height = source.GetHeight();
 
     // We use "x << 16" in the code below, so check that this doesn't wrap
     // around, as the code wouldn't work correctly if it did.
@@ -559,52 +1017,63 @@ wxImage wxImage::ResampleNearest(int width, int height) const
 
     wxCHECK_MSG( data, image, wxT("unable to create image") );
 
-    const unsigned char *source_data = M_IMGDATA->m_data;
     unsigned char *target_data = data;
-    const unsigned char *source_alpha = nullptr ;
     unsigned char *target_alpha = nullptr ;
 
-    if ( !M_IMGDATA->m_hasMask )
+    if ( source.HasAlpha() )
     {
-        source_alpha = M_IMGDATA->m_alpha ;
-        if ( source_alpha )
-        {
-            image.SetAlpha() ;
-            target_alpha = image.GetAlpha() ;
-        }
+        image.SetAlpha() ;
+        target_alpha = image.GetAlpha() ;
     }
 
     const wxUIntPtr x_delta = (old_width  << 16) / width;
     const wxUIntPtr y_delta = (old_height << 16) / height;
 
-    unsigned char* dest_pixel = target_data;
-
-    wxUIntPtr y = y_delta / 2;
-    for (int j = 0; j < height; j++)
+    ForEachImageBand(height, width, [&](int from, int to)
     {
-        const unsigned char* src_line = &source_data[(y>>16)*old_width*3];
-        const unsigned char* src_alpha_line = source_alpha ? &source_alpha[(y>>16)*old_width] : nullptr ;
+        ImageRowSource rows(source);
 
-        wxUIntPtr x = x_delta / 2;
-        for (int i = 0; i < width; i++)
+        unsigned char* dest_pixel = target_data + from*wxUIntPtr(width)*3;
+        unsigned char* dest_alpha = target_alpha ? target_alpha + from*wxUIntPtr(width)
+                                                 : nullptr;
+
+        wxUIntPtr y = y_delta / 2 + from*y_delta;
+        for (int j = from; j < to; j++)
         {
-            const unsigned char* src_pixel = &src_line[(x>>16)*3];
-            const unsigned char* src_alpha_pixel = source_alpha ? &src_alpha_line[(x>>16)] : nullptr ;
-            dest_pixel[0] = src_pixel[0];
-            dest_pixel[1] = src_pixel[1];
-            dest_pixel[2] = src_pixel[2];
-            dest_pixel += 3;
-            if ( source_alpha )
-                *(target_alpha++) = *src_alpha_pixel ;
-            x += x_delta;
-        }
+            const unsigned char* src_line = rows.GetRGB(y>>16);
+            const unsigned char* src_alpha_line = dest_alpha ? rows.GetAlpha(y>>16) : nullptr ;
 
-        y += y_delta;
-    }
+            wxUIntPtr x = x_delta / 2;
+            for (int i = 0; i < width; i++)
+            {
+                const unsigned char* src_pixel = &src_line[(x>>16)*3];
+                dest_pixel[0] = src_pixel[0];
+                dest_pixel[1] = src_pixel[1];
+                dest_pixel[2] = src_pixel[2];
+                dest_pixel += 3;
+                if ( src_alpha_line )
+                    *(dest_alpha++) = src_alpha_line[x>>16] ;
+                x += x_delta;
+            }
+
+            y += y_delta;
+        }
+    });
 
     return image;
 }
 
+} // anonymous namespace
+
+wxImage wxImage::ResampleNearest(int width, int height) const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), "invalid image" );
+
+    // Alpha is not used for the images with mask.
+    return DoResampleNearest(ImageRowSource(*this, !M_IMGDATA->m_hasMask),
+                             width, height);
+}
+
 namespace
 {
 
@@ -659,10 +1128,93 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
 
 } // anonymous namespace
 
-wxImage wxImage::ResampleBox(int width, int height) const
+namespace
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
 
+// Cache of the horizontally resampled source rows used by the separable
+// resampling algorithms below.
+//
+// Consecutive destination rows typically use (some of) the same source rows,
+// especially when enlarging the image, so keeping the results of the
+// horizontal pass for the last few rows allows to avoid recomputing them.
+class ResampleRowCache
+{
+public:
+    ResampleRowCache(int numRows, size_t rowSize)
+        : m_rows(numRows, -1),
+          m_data(numRows*rowSize),
+          m_rowSize(rowSize)
+    {
+    }
+
+    // Fill the provided lines array with the pointers to the horizontally
+    // resampled versions of the given source rows, calling computeRow(row,
+    // line) for the rows not present in the cache yet.
+    //
+    // Both arrays must have the number of elements passed to the ctor.
+    template <typename F>
+    void GetRows(const int* rows, const double** lines, const F& computeRow)
+    {
+        const size_t numRows = m_rows.size();
+        for ( size_t n = 0; n < numRows; n++ )
+        {
+            const int row = rows[n];
+
+            size_t slot = FindSlot(row);
+            if ( slot == numRows )
+            {
+                // Reuse a slot which is not needed for the current rows: there
+                // is always at least one such slot if this row is not cached.
+                for ( slot = 0; slot < numRows; slot++ )
+                {
+                    if ( !IsUsed(m_rows[slot], rows) )
+                        break;
+                }
+
+                m_rows[slot] = row;
+                computeRow(row, &m_data[slot*m_rowSize]);
+            }
+
+            lines[n] = &m_data[slot*m_rowSize];
+        }
+    }
+
+private:
+    size_t FindSlot(int row) const
+    {
+        size_t slot;
+        for ( slot = 0; slot < m_rows.size(); slot++ )
+        {
+            if ( m_rows[slot] == row )
+                break;
+        }
+
+        return slot;
+    }
+
+    bool IsUsed(int row, const int* rows) const
+    {
+        for ( size_t n = 0; n < m_rows.size(); n++ )
+        {
+            if ( rows[n] == row )
+                return true;
+        }
+
+        return false;
+    }
+
+    wxVector<int> m_rows;
+    wxVector<double> m_data;
+    const size_t m_rowSize;
+};
+
+} // anonymous namespace
+
+namespace
+{
+
+wxImage DoResampleBox(const ImageRowSource& source, int width, int height)
+{
     // This function implements a simple pre-blur/box averaging method for
     // downsampling that gives reasonably smooth results To scale the image
     // down we will need to gather a grid of pixels of the size of the scale
@@ -673,94 +1225,169 @@ wxImage wxImage::ResampleBox(int width, int height) const
     wxVector<BoxPrecalc> vPrecalcs(height);
     wxVector<BoxPrecalc> hPrecalcs(width);
 
-    ResampleBoxPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBoxPrecalc(hPrecalcs, M_IMGDATA->m_width);
+    ResampleBoxPrecalc(vPrecalcs, source.GetHeight());
+    ResampleBoxPrecalc(hPrecalcs, source.GetWidth());
 
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    const bool src_alpha = source.HasAlpha();
+    unsigned char* ret_data = ret_image.GetData();
+    unsigned char* ret_alpha = nullptr;
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxCHECK_MSG( ret_data, ret_image, wxS("unable to create image") );
 
     if ( src_alpha )
     {
         ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        ret_alpha = ret_image.GetAlpha();
     }
 
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
-
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
+    ForEachImageBand(height, width, [&](int from, int to)
     {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
+        ImageRowSource rows(source);
 
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
+        unsigned char* dst_data = ret_data + from*size_t(width)*3;
+        unsigned char* dst_alpha = ret_alpha ? ret_alpha + from*size_t(width)
+                                             : nullptr;
+
+        // Sums of the (alpha-weighted, if we have alpha) colour values and of the
+        // alpha values themselves for all pixels of the current destination row.
+        //
+        // We accumulate them row by row, as this accesses the source data
+        // sequentially, instead of iterating over the box of each pixel in turn.
+        // Note that all values are integers, so using doubles for them doesn't
+        // result in any loss of precision while avoiding overflows.
+        wxVector<double> sums_rgb(3*width);
+        wxVector<double> sums_a(src_alpha ? width : 0);
+
+        for ( int y = from; y < to; y++ )          // Destination image - Y direction
         {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
+            // Source pixel in the Y direction
+            const BoxPrecalc& vPrecalc = vPrecalcs[y];
+
+            // When enlarging, many destination rows use exactly the same source
+            // rows, in which case we can just copy the previous row.
+            if ( y > from &&
+                    vPrecalc.boxStart == vPrecalcs[y - 1].boxStart &&
+                        vPrecalc.boxEnd == vPrecalcs[y - 1].boxEnd )
+            {
+                memcpy(dst_data, dst_data - 3*width, 3*width);
+                dst_data += 3*width;
+
+                if ( dst_alpha )
+                {
+                    memcpy(dst_alpha, dst_alpha - width, width);
+                    dst_alpha += width;
+                }
+
+                continue;
+            }
 
-            // Box of pixels to average
-            averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
-                                * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
-            sum_r = sum_g = sum_b = sum_a = 0.0;
+            std::fill(sums_rgb.begin(), sums_rgb.end(), 0.0);
+            std::fill(sums_a.begin(), sums_a.end(), 0.0);
 
             for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
             {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                const unsigned char* const src_line = rows.GetRGB(j);
+
+                double* sum = &sums_rgb[0];
+                if ( src_alpha )
                 {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
+                    const unsigned char* const src_alpha_line = rows.GetAlpha(j);
 
-                    if (src_alpha)
+                    for ( int x = 0; x < width; x++, sum += 3 )
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
+                        const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+                        wxUint64 sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+                        for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                        {
+                            const wxUint64 a = src_alpha_line[i];
+                            sum_r += src_line[i * 3 + 0] * a;
+                            sum_g += src_line[i * 3 + 1] * a;
+                            sum_b += src_line[i * 3 + 2] * a;
+                            sum_a += a;
+                        }
+
+                        sum[0] += sum_r;
+                        sum[1] += sum_g;
+                        sum[2] += sum_b;
+                        sums_a[x] += sum_a;
                     }
-                    else
+                }
+                else
+                {
+                    for ( int x = 0; x < width; x++, sum += 3 )
                     {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
+                        const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+                        unsigned sum_r = 0, sum_g = 0, sum_b = 0;
+                        for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+                        {
+                            sum_r += src_line[i * 3 + 0];
+                            sum_g += src_line[i * 3 + 1];
+                            sum_b += src_line[i * 3 + 2];
+                        }
+
+                        sum[0] += sum_r;
+                        sum[1] += sum_g;
+                        sum[2] += sum_b;
                     }
                 }
             }
 
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
+            const int box_height = vPrecalc.boxEnd - vPrecalc.boxStart + 1;
+
+            const double* sum = &sums_rgb[0];
+            for ( int x = 0; x < width; x++, sum += 3 )      // Destination image - X direction
             {
-                if (sum_a != 0)
+                // Source pixel in the X direction
+                const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+                // Box of pixels to average
+                const int averaged_pixels = box_height
+                                    * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
+
+                // Calculate the average from the sum and number of averaged pixels
+                if (src_alpha)
                 {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
+                    const double sum_a = sums_a[x];
+                    if (sum_a != 0)
+                    {
+                        dst_data[0] = (unsigned char)(sum[0] / sum_a);
+                        dst_data[1] = (unsigned char)(sum[1] / sum_a);
+                        dst_data[2] = (unsigned char)(sum[2] / sum_a);
+                    }
+                    else
+                    {
+                        dst_data[0] = 0;
+                        dst_data[1] = 0;
+                        dst_data[2] = 0;
+                    }
+                    *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    dst_data[0] = (unsigned char)(sum[0] / averaged_pixels);
+                    dst_data[1] = (unsigned char)(sum[1] / averaged_pixels);
+                    dst_data[2] = (unsigned char)(sum[2] / averaged_pixels);
                 }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
+                dst_data += 3;
             }
-            dst_data += 3;
         }
-    }
+    });
 
     return ret_image;
 }
 
+} // anonymous namespace
+
+wxImage wxImage::ResampleBox(int width, int height) const
+{
+    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+
+    return DoResampleBox(ImageRowSource(*this), width, height);
+}
+
 namespace
 {
 
@@ -819,91 +1446,118 @@ void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
     }
 }
 
-} // anonymous namespace
-
-wxImage wxImage::ResampleBilinear(int width, int height) const
+wxImage DoResampleBilinear(const ImageRowSource& source, int width, int height)
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
-
     // This function implements a Bilinear algorithm for resampling.
     wxImage ret_image(width, height, false);
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    const bool src_alpha = source.HasAlpha();
+    unsigned char* ret_data = ret_image.GetData();
+    unsigned char* ret_alpha = nullptr;
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxCHECK_MSG( ret_data, ret_image, wxS("unable to create image") );
 
     if ( src_alpha )
     {
         ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        ret_alpha = ret_image.GetAlpha();
     }
 
     wxVector<BilinearPrecalc> vPrecalcs(height);
     wxVector<BilinearPrecalc> hPrecalcs(width);
-    ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
-
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
-
-    for ( int dsty = 0; dsty < height; dsty++ )
-    {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
-
-
-        for ( int dstx = 0; dstx < width; dstx++ )
+    ResampleBilinearPrecalc(vPrecalcs, source.GetHeight());
+    ResampleBilinearPrecalc(hPrecalcs, source.GetWidth());
+
+    // Bilinear interpolation is separable, so we first interpolate the source
+    // rows in the X direction and then combine the two resulting lines. Each
+    // line contains 3*width colour values followed by width alpha values, if
+    // we have alpha.
+    const auto interpolateRow = [&](ImageRowSource& rows, int y, double* line)
+    {
+        const unsigned char* const src_line = rows.GetRGB(y);
+        double* rgb = line;
+        for ( int dstx = 0; dstx < width; dstx++, rgb += 3 )
         {
             // X-axis of pixel to interpolate from
             const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
+            const unsigned char* const src_pixel1 = src_line + hPrecalc.offset1*3;
+            const unsigned char* const src_pixel2 = src_line + hPrecalc.offset2*3;
             const double dx = hPrecalc.dd;
             const double dx1 = hPrecalc.dd1;
 
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
+            rgb[0] = src_pixel1[0] * dx1 + src_pixel2[0] * dx;
+            rgb[1] = src_pixel1[1] * dx1 + src_pixel2[1] * dx;
+            rgb[2] = src_pixel1[2] * dx1 + src_pixel2[2] * dx;
+        }
 
-            // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
+        if ( src_alpha )
+        {
+            const unsigned char* const src_alpha_line = rows.GetAlpha(y);
+            double* const alpha = line + 3*width;
+            for ( int dstx = 0; dstx < width; dstx++ )
+            {
+                const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
+                alpha[dstx] = src_alpha_line[hPrecalc.offset1] * hPrecalc.dd1 +
+                              src_alpha_line[hPrecalc.offset2] * hPrecalc.dd;
+            }
+        }
+    };
 
-            // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
-            if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
+    ForEachImageBand(height, width, [&](int from, int to)
+    {
+        unsigned char* dst_data = ret_data + from*size_t(width)*3;
+        unsigned char* dst_alpha = ret_alpha ? ret_alpha + from*size_t(width)
+                                             : nullptr;
+
+        ImageRowSource rows(source);
+        const auto computeRow = [&](int y, double* line)
+        {
+            interpolateRow(rows, y, line);
+        };
 
-            // result lines
+        ResampleRowCache rowCache(2, (src_alpha ? 4 : 3)*width);
 
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
+        for ( int dsty = from; dsty < to; dsty++ )
+        {
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
+            const int srcRows[2] = { vPrecalc.offset1, vPrecalc.offset2 };
+            const double* lines[2];
+            rowCache.GetRows(srcRows, lines, computeRow);
+
+            const double dy = vPrecalc.dd;
+            const double dy1 = vPrecalc.dd1;
+
+            // These loops don't depend on the pixel layout and so can be easily
+            // vectorized by the compiler.
+            const double* const line1 = lines[0];
+            const double* const line2 = lines[1];
+            for ( int n = 0; n < 3*width; n++ )
+                dst_data[n] = static_cast<unsigned char>(line1[n] * dy1 + line2[n] * dy + .5);
+            dst_data += 3*width;
 
             if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+            {
+                const double* const alpha1 = line1 + 3*width;
+                const double* const alpha2 = line2 + 3*width;
+                for ( int n = 0; n < width; n++ )
+                    dst_alpha[n] = static_cast<unsigned char>(alpha1[n] * dy1 + alpha2[n] * dy + .5);
+                dst_alpha += width;
+            }
         }
-    }
+    });
 
     return ret_image;
 }
 
+} // anonymous namespace
+
+wxImage wxImage::ResampleBilinear(int width, int height) const
+{
+    wxCHECK_MSG( IsOk(), {}, "invalid image" );
+
+    return DoResampleBilinear(ImageRowSource(*this), width, height);
+}
+
 // The following two local functions are for the B-spline weighting of the
 // bicubic sampling algorithm
 static inline double spline_cube(double value)
@@ -973,13 +1627,9 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
     }
 }
 
-} // anonymous namespace
-
 // This is the bicubic resampling algorithm
-wxImage wxImage::ResampleBicubic(int width, int height) const
+wxImage DoResampleBicubic(const ImageRowSource& source, int width, int height)
 {
-    wxCHECK_MSG( IsOk(), {}, "invalid image" );
-
     // This function implements a Bicubic B-Spline algorithm for resampling.
     // This method is certainly a little slower than wxImage's default pixel
     // replication method, however for most reasonably sized images not being
@@ -1010,32 +1660,39 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
 
     ret_image.Create(width, height, false);
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = nullptr;
+    const bool src_alpha = source.HasAlpha();
+    unsigned char* ret_data = ret_image.GetData();
+    unsigned char* ret_alpha = nullptr;
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxCHECK_MSG( ret_data, ret_image, wxS("unable to create image") );
 
     if ( src_alpha )
     {
         ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        ret_alpha = ret_image.GetAlpha();
     }
 
     // Precalculate weights
     wxVector<BicubicPrecalc> vPrecalcs(height);
     wxVector<BicubicPrecalc> hPrecalcs(width);
 
-    ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
-
-    for ( int dsty = 0; dsty < height; dsty++ )
-    {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
-
-        for ( int dstx = 0; dstx < width; dstx++ )
+    ResampleBicubicPrecalc(vPrecalcs, source.GetHeight());
+    ResampleBicubicPrecalc(hPrecalcs, source.GetWidth());
+
+    // The B-spline kernel is separable, so we first compute the weighted sums
+    // of the pixels of the source rows in the X direction and then combine the
+    // four resulting lines in the Y direction. Each line contains 3*width
+    // (alpha-weighted, if we have alpha) colour sums followed by width alpha
+    // sums.
+    const auto interpolateRow = [&](ImageRowSource& rows, int y, double* line)
+    {
+        const unsigned char* const src_line = rows.GetRGB(y);
+        const unsigned char* const src_alpha_line = src_alpha
+                                                        ? rows.GetAlpha(y)
+                                                        : nullptr;
+        double* rgb = line;
+        double* const alpha = line + 3*width;
+        for ( int dstx = 0; dstx < width; dstx++, rgb += 3 )
         {
             // X-axis of pixel to interpolate from
             const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
@@ -1043,44 +1700,82 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
             // Sums for each color channel
             double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
 
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
+            for ( int i = 0; i < 4; i++ )
             {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+                // X offset
+                const int x_offset = hPrecalc.offset[i];
+                const unsigned char* const src_pixel = src_line + x_offset*3;
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
+                // Create a sum of all values for each color channel
+                // adjusted for the pixel's calculated weight
+                if ( src_alpha_line )
+                {
+                    const double
+                        pixel_weight = hPrecalc.weight[i] * src_alpha_line[x_offset];
+                    sum_r += src_pixel[0] * pixel_weight;
+                    sum_g += src_pixel[1] * pixel_weight;
+                    sum_b += src_pixel[2] * pixel_weight;
+                    sum_a += pixel_weight;
+                }
+                else
                 {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
+                    const double pixel_weight = hPrecalc.weight[i];
+                    sum_r += src_pixel[0] * pixel_weight;
+                    sum_g += src_pixel[1] * pixel_weight;
+                    sum_b += src_pixel[2] * pixel_weight;
+                }
+            }
 
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
+            rgb[0] = sum_r;
+            rgb[1] = sum_g;
+            rgb[2] = sum_b;
+            if ( src_alpha_line )
+                alpha[dstx] = sum_a;
+        }
+    };
 
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
+    ForEachImageBand(height, width, [&](int from, int to)
+    {
+        unsigned char* dst_data = ret_data + from*size_t(width)*3;
+        unsigned char* dst_alpha = ret_alpha ? ret_alpha + from*size_t(width)
+                                             : nullptr;
 
-                    // Create a sum of all values for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
-                    {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
-                    }
+        ImageRowSource rows(source);
+        const auto computeRow = [&](int y, double* line)
+        {
+            interpolateRow(rows, y, line);
+        };
+
+        ResampleRowCache rowCache(4, (src_alpha ? 4 : 3)*width);
+
+        // Sums for each color channel for all pixels of the current row
+        wxVector<double> sums_rgb(3*width);
+        wxVector<double> sums_a(src_alpha ? width : 0);
+
+        for ( int dsty = from; dsty < to; dsty++ )
+        {
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+
+            const double* lines[4];
+            rowCache.GetRows(vPrecalc.offset, lines, computeRow);
+
+            // Combine the lines using the weights for the Y direction: as above,
+            // these loops are simple enough to be vectorized by the compiler.
+            std::fill(sums_rgb.begin(), sums_rgb.end(), 0.0);
+            std::fill(sums_a.begin(), sums_a.end(), 0.0);
+            for ( int k = 0; k < 4; k++ )
+            {
+                const double weight = vPrecalc.weight[k];
+                const double* const line = lines[k];
+                for ( int n = 0; n < 3*width; n++ )
+                    sums_rgb[n] += line[n] * weight;
+
+                if ( src_alpha )
+                {
+                    const double* const alpha = line + 3*width;
+                    for ( int n = 0; n < width; n++ )
+                        sums_a[n] += alpha[n] * weight;
                 }
             }
 
@@ -1088,234 +1783,252 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
             // of double data type and are rounded here for accuracy
             if ( src_alpha )
             {
-                if (sum_a != 0)
-                {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
-                }
-                else
+                const double* sum = &sums_rgb[0];
+                for ( int dstx = 0; dstx < width; dstx++, sum += 3 )
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    const double sum_a = sums_a[dstx];
+                    if (sum_a != 0)
+                    {
+                         dst_data[0] = (unsigned char)(sum[0] / sum_a + 0.5);
+                         dst_data[1] = (unsigned char)(sum[1] / sum_a + 0.5);
+                         dst_data[2] = (unsigned char)(sum[2] / sum_a + 0.5);
+                    }
+                    else
+                    {
+                        dst_data[0] = 0;
+                        dst_data[1] = 0;
+                        dst_data[2] = 0;
+                    }
+                    dst_data += 3;
+                    *dst_alpha++ = (unsigned char)sum_a;
                 }
-                *dst_alpha++ = (unsigned char)sum_a;
             }
             else
             {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
+                for ( int n = 0; n < 3*width; n++ )
+                    dst_data[n] = (unsigned char)(sums_rgb[n] + 0.5);
+                dst_data += 3*width;
             }
-            dst_data += 3;
         }
-    }
+    });
 
     return ret_image;
 }
 
-// Blur in the horizontal direction
-wxImage wxImage::BlurHorizontal(int blurRadius) const
+} // anonymous namespace
+
+wxImage wxImage::ResampleBicubic(int width, int height) const
 {
-    wxImage ret_image(MakeEmptyClone());
+    wxCHECK_MSG( IsOk(), {}, "invalid image" );
 
-    wxCHECK( ret_image.IsOk(), ret_image );
+    return DoResampleBicubic(ImageRowSource(*this), width, height);
+}
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+namespace
+{
 
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
+// How to round the averages computed by the box blur functions below.
+enum BoxBlurRounding
+{
+    // Truncate the values, this is used by Blur() for compatibility.
+    BoxBlur_Truncate,
 
-    // Horizontal blurring algorithm - average all pixels in the specified blur
-    // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in the blur radius for the first
-        // pixel of the row
-        for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
-        {
-            // To deal with the pixels at the start of a row so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous row
-            if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
+    // Round the values to nearest, which avoids darkening the image when
+    // applying several blur passes successively.
+    BoxBlur_Round
+};
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+// Blur a single line of pixels, each consisting of the given number of
+// channels, using a box of the given radius and duplicating the edge pixels.
+//
+// Only the pixels entering and leaving the box are used to update the running
+// sums for each pixel, so the cost of this function doesn't depend on the
+// radius.
+void
+BoxBlurLine(const unsigned char* src, unsigned char* dst,
+            int len, int channels, int radius, BoxBlurRounding rounding)
+{
+    const unsigned area = 2*radius + 1;
+    const unsigned bias = rounding == BoxBlur_Round ? area / 2 : 0;
+    const int last = len - 1;
 
-        dst = dst_data + y * M_IMGDATA->m_width*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+    for ( int c = 0; c < channels; c++ )
+    {
+        const unsigned char* const s = src + c;
+        unsigned char* const d = dst + c;
 
-        // Now average the values of the rest of the pixels by just moving the
-        // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
+        // Initialize the sum for the first pixel: the box contains radius+1
+        // copies of the first pixel and the next radius pixels, with the last
+        // pixel being repeated if the line is shorter than the radius.
+        unsigned sum = (radius + 1)*s[0];
+        const int inside = wxMin(radius, last);
+        for ( int i = 1; i <= inside; i++ )
+            sum += s[i*channels];
+        sum += (radius - inside)*s[last*channels];
+
+        d[0] = static_cast<unsigned char>((sum + bias) / area);
+
+        for ( int x = 1; x < len; x++ )
         {
-            // Take care of edge pixels on the left edge by essentially
-            // duplicating the edge pixel
-            if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the left side of the blur
-            // radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+            sum += s[wxMin(x + radius, last)*channels];
+            sum -= s[wxMax(x - radius - 1, 0)*channels];
 
-            // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
+            d[x*channels] = static_cast<unsigned char>((sum + bias) / area);
+        }
+    }
+}
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+// Blur the columns of the given block of data vertically using a box of the
+// given radius and duplicating the edge pixels.
+//
+// Each of the values in [from, to) range of each row is processed
+// independently of all the others, but all of them are processed at once,
+// as this allows to access the data row by row in a cache-friendly way and to
+// vectorize the inner loops.
+void
+BoxBlurColumns(const unsigned char* src, unsigned char* dst,
+               size_t stride, int height, size_t from, size_t to,
+               int radius, BoxBlurRounding rounding)
+{
+    const unsigned area = 2*radius + 1;
+    const unsigned bias = rounding == BoxBlur_Round ? area / 2 : 0;
+    const int last = height - 1;
+    const size_t count = to - from;
 
-            // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+    const auto row = [=](int y) { return src + y*stride + from; };
+
+    wxVector<unsigned> sums(count);
+
+    // See BoxBlurLine() for the explanation of the initial sums computation.
+    const unsigned char* const first = row(0);
+    for ( size_t n = 0; n < count; n++ )
+        sums[n] = (radius + 1)*first[n];
+
+    const int inside = wxMin(radius, last);
+    for ( int i = 1; i <= inside; i++ )
+    {
+        const unsigned char* const r = row(i);
+        for ( size_t n = 0; n < count; n++ )
+            sums[n] += r[n];
+    }
+
+    const unsigned char* const lastRow = row(last);
+    for ( size_t n = 0; n < count; n++ )
+        sums[n] += (radius - inside)*lastRow[n];
+
+    for ( int y = 0; y < height; y++ )
+    {
+        if ( y > 0 )
+        {
+            const unsigned char* const in = row(wxMin(y + radius, last));
+            const unsigned char* const out = row(wxMax(y - radius - 1, 0));
+            for ( size_t n = 0; n < count; n++ )
+                sums[n] += in[n] - out[n];
         }
+
+        unsigned char* const d = dst + y*stride + from;
+        for ( size_t n = 0; n < count; n++ )
+            d[n] = static_cast<unsigned char>((sums[n] + bias) / area);
     }
+}
 
-    return ret_image;
+// Blur the entire plane of the image, which is either its RGB data or alpha,
+// in the given direction.
+void
+BoxBlurPlane(const unsigned char* src, unsigned char* dst,
+             int width, int height, int channels,
+             int radius, wxOrientation orient, BoxBlurRounding rounding)
+{
+    const size_t stride = width*channels;
+
+    if ( orient == wxHORIZONTAL )
+    {
+        ForEachImageBand(height, width, [=](int from, int to)
+        {
+            for ( int y = from; y < to; y++ )
+            {
+                BoxBlurLine(src + y*stride, dst + y*stride,
+                            width, channels, radius, rounding);
+            }
+        });
+    }
+    else
+    {
+        ForEachImageBand(width, height, [=](int from, int to)
+        {
+            BoxBlurColumns(src, dst, stride, height,
+                           from*channels, to*channels, radius, rounding);
+        });
+    }
 }
 
-// Blur in the vertical direction
-wxImage wxImage::BlurVertical(int blurRadius) const
+// Compute the radii of the successive box blurs approximating the Gaussian
+// blur with the given standard deviation.
+//
+// This uses the approach described in "Fast Almost-Gaussian Filtering" by
+// Peter Kovesi: the sizes of the boxes are chosen as the two odd integers
+// closest to the ideal box size in such proportion that the variance of the
+// result is as close as possible to sigma^2.
+void GetGaussianBoxRadii(double sigma, int* radii, int count)
+{
+    const double variance12 = 12*sigma*sigma;
+
+    int wl = static_cast<int>(floor(sqrt(variance12/count + 1)));
+    if ( wl % 2 == 0 )
+        wl--;
+
+    const int m = wxRound((variance12 - count*wl*wl - 4*count*wl - 3*count) /
+                          (-4.0*wl - 4));
+
+    for ( int n = 0; n < count; n++ )
+        radii[n] = ((n < m ? wl : wl + 2) - 1) / 2;
+}
+
+} // anonymous namespace
+
+// Blur in the horizontal direction
+wxImage wxImage::BlurHorizontal(int blurRadius) const
 {
     wxImage ret_image(MakeEmptyClone());
 
     wxCHECK( ret_image.IsOk(), ret_image );
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+    const int width = M_IMGDATA->m_width;
+    const int height = M_IMGDATA->m_height;
 
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
-    // Vertical blurring algorithm - same as horizontal but switched the
-    // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
-        {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
+    // Horizontal blurring algorithm - average all pixels in the specified blur
+    // radius in the X or horizontal direction
+    BoxBlurPlane(M_IMGDATA->m_data, ret_image.GetData(), width, height, 3,
+                 blurRadius, wxHORIZONTAL, BoxBlur_Truncate);
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+    if ( M_IMGDATA->m_alpha )
+    {
+        BoxBlurPlane(M_IMGDATA->m_alpha, ret_image.GetAlpha(), width, height, 1,
+                     blurRadius, wxHORIZONTAL, BoxBlur_Truncate);
+    }
 
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
+    return ret_image;
+}
 
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
-        {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
+// Blur in the vertical direction
+wxImage wxImage::BlurVertical(int blurRadius) const
+{
+    wxImage ret_image(MakeEmptyClone());
 
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
+    const int width = M_IMGDATA->m_width;
+    const int height = M_IMGDATA->m_height;
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    // Vertical blurring algorithm - same as horizontal but switched the
+    // opposite direction
+    BoxBlurPlane(M_IMGDATA->m_data, ret_image.GetData(), width, height, 3,
+                 blurRadius, wxVERTICAL, BoxBlur_Truncate);
 
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
+    if ( M_IMGDATA->m_alpha )
+    {
+        BoxBlurPlane(M_IMGDATA->m_alpha, ret_image.GetAlpha(), width, height, 1,
+                     blurRadius, wxVERTICAL, BoxBlur_Truncate);
     }
 
     return ret_image;
@@ -1334,95 +2047,178 @@ wxImage wxImage::Blur(int blurRadius) const
     return ret_image;
 }
 
-wxImage wxImage::Rotate90( bool clockwise ) const
+wxImage wxImage::GaussianBlur(double sigma) const
 {
-    wxImage image(MakeEmptyClone(Clone_SwapOrientation));
+    wxCHECK_MSG( sigma >= 0, wxImage(), "invalid standard deviation" );
 
-    wxCHECK( image.IsOk(), image );
+    wxImage ret_image(MakeEmptyClone());
 
-    long height = M_IMGDATA->m_height;
-    long width  = M_IMGDATA->m_width;
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_X) )
-    {
-        int hot_x = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_X );
-        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y,
-                        clockwise ? hot_x : width - 1 - hot_x);
-    }
+    const int width = M_IMGDATA->m_width;
+    const int height = M_IMGDATA->m_height;
 
-    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y) )
-    {
-        int hot_y = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_Y );
-        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_X,
-                        clockwise ? height - 1 - hot_y : hot_y);
-    }
+    // Gaussian blur is approximated by applying 3 successive box blurs in
+    // each direction, which is enough to get a result visually
+    // indistinguishable from the real Gaussian blur.
+    static const int NUM_PASSES = 3;
+    int radii[NUM_PASSES];
+    GetGaussianBoxRadii(sigma, radii, NUM_PASSES);
 
-    unsigned char *data = image.GetData();
-    unsigned char *target_data;
+    wxVector<unsigned char> buffer(static_cast<size_t>(width)*height*3);
 
-    // we rotate the image in 21-pixel (63-byte) wide strips
-    // to make better use of cpu cache - memory transfers
-    // (note: while much better than single-pixel "strips",
-    //  our vertical strips will still generally straddle 64-byte cachelines)
-    for (long ii = 0; ii < width; )
+    const auto blurPlane = [&](const unsigned char* src, unsigned char* dst,
+                               int channels)
     {
-        long next_ii = wxMin(ii + 21, width);
+        // Alternate between the temporary buffer and the destination, so that
+        // the final pass writes to the latter.
+        unsigned char* const tmp = &buffer[0];
+        unsigned char* bufs[2] = { tmp, dst };
 
-        for (long j = 0; j < height; j++)
+        int n = 0;
+        for ( int orient = 0; orient < 2; orient++ )
         {
-            const unsigned char *source_data =
-                M_IMGDATA->m_data + (j*width + ii)*3;
-
-            for (long i = ii; i < next_ii; i++)
+            for ( int pass = 0; pass < NUM_PASSES; pass++, n++ )
             {
-                if ( clockwise )
-                {
-                    target_data = data + ((i + 1)*height - j - 1)*3;
-                }
-                else
-                {
-                    target_data = data + (height*(width - 1 - i) + j)*3;
-                }
-                memcpy( target_data, source_data, 3 );
-                source_data += 3;
+                unsigned char* const out = bufs[n % 2];
+                BoxBlurPlane(src, out, width, height, channels, radii[pass],
+                             orient ? wxVERTICAL : wxHORIZONTAL,
+                             BoxBlur_Round);
+                src = out;
             }
         }
+    };
 
-        ii = next_ii;
-    }
+    blurPlane(M_IMGDATA->m_data, ret_image.GetData(), 3);
 
-    const unsigned char *source_alpha = M_IMGDATA->m_alpha;
+    if ( M_IMGDATA->m_alpha )
+        blurPlane(M_IMGDATA->m_alpha, ret_image.GetAlpha(), 1);
 
-    if ( source_alpha )
-    {
-        unsigned char *alpha_data = image.GetAlpha();
+    return ret_image;
+}
 
-        for (long ii = 0; ii < width; )
-        {
-            long next_ii = wxMin(ii + 64, width);
+namespace
+{
+
+// Size of the square tiles used by Rotate90(): the source and destination
+// lines of a single tile must remain in the cache while it is processed.
+constexpr int ROTATE_TILE_SIZE = 32;
+
+// Rotate a plane of pixels of N bytes each by 90 degrees.
+//
+// The destination image is processed in bands of rows, corresponding to the
+// columns of the source one, and each band is processed in square tiles, so
+// that both reading and writing happen within a small working set instead of
+// writing (or reading) a full column of the image for each row.
+template <int N>
+void RotatePlane90(const unsigned char* src,
+                   unsigned char* dst,
+                   int width,
+                   int height,
+                   bool clockwise)
+{
+    ForEachImageBand(width, height, [=](int from, int to)
+    {
+        for ( int i0 = from; i0 < to; i0 += ROTATE_TILE_SIZE )
+        {
+            const int i1 = wxMin(i0 + ROTATE_TILE_SIZE, to);
 
-            for (long j = 0; j < height; j++)
+            for ( int j0 = 0; j0 < height; j0 += ROTATE_TILE_SIZE )
             {
-                source_alpha = M_IMGDATA->m_alpha + j*width + ii;
+                const int j1 = wxMin(j0 + ROTATE_TILE_SIZE, height);
 
-                for (long i = ii; i < next_ii; i++)
+                for ( int i = i0; i < i1; i++ )
                 {
-                    unsigned char* target_alpha;
+                    const unsigned char* p = src + (size_t(j0)*width + i)*N;
+
+                    // Source pixel (i, j) goes to the row i and the column
+                    // height - 1 - j when rotating clockwise and to the row
+                    // width - 1 - i and the column j otherwise.
                     if ( clockwise )
                     {
-                        target_alpha = alpha_data + (i+1)*height - j - 1;
+                        unsigned char* q = dst + (size_t(i)*height + height - 1 - j0)*N;
+                        for ( int j = j0; j < j1; j++, p += size_t(width)*N, q -= N )
+                            memcpy(q, p, N);
                     }
                     else
                     {
-                        target_alpha = alpha_data + height*(width - i - 1) + j;
+                        unsigned char* q = dst + (size_t(width - 1 - i)*height + j0)*N;
+                        for ( int j = j0; j < j1; j++, p += size_t(width)*N, q += N )
+                            memcpy(q, p, N);
                     }
-
-                    *target_alpha = *source_alpha++;
                 }
             }
+        }
+    });
+}
+
+// Copy a plane of pixels of N bytes each, possibly reversing the order of the
+// rows and/or pixels in them.
+template <int N>
+void FlipPlane(const unsigned char* src,
+               unsigned char* dst,
+               int width,
+               int height,
+               bool reverseRows,
+               bool reversePixels)
+{
+    const size_t rowSize = size_t(width)*N;
+
+    ForEachImageBand(height, width, [=](int from, int to)
+    {
+        for ( int y = from; y < to; y++ )
+        {
+            const unsigned char* p = src + y*rowSize;
+            unsigned char* const q = dst + (reverseRows ? height - 1 - y : y)*rowSize;
+
+            if ( !reversePixels )
+            {
+                memcpy(q, p, rowSize);
+                continue;
+            }
 
-            ii = next_ii;
+            unsigned char* r = q + rowSize;
+            for ( int x = 0; x < width; x++, p += N )
+            {
+                r -= N;
+                memcpy(r, p, N);
+            }
         }
+    });
+}
+
+} // anonymous namespace
+
+wxImage wxImage::Rotate90( bool clockwise ) const
+{
+    wxImage image(MakeEmptyClone(Clone_SwapOrientation));
+
+    wxCHECK( image.IsOk(), image );
+
+    const int height = M_IMGDATA->m_height;
+    const int width  = M_IMGDATA->m_width;
+
+    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_X) )
+    {
+        int hot_x = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_X );
+        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y,
+                        clockwise ? hot_x : width - 1 - hot_x);
+    }
+
+    if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_Y) )
+    {
+        int hot_y = GetOptionInt( wxIMAGE_OPTION_CUR_HOTSPOT_Y );
+        image.SetOption(wxIMAGE_OPTION_CUR_HOTSPOT_X,
+                        clockwise ? height - 1 - hot_y : hot_y);
+    }
+
+    RotatePlane90<3>(M_IMGDATA->m_data, image.GetData(),
+                     width, height, clockwise);
+
+    if ( M_IMGDATA->m_alpha )
+    {
+        RotatePlane90<1>(M_IMGDATA->m_alpha, image.GetAlpha(),
+                         width, height, clockwise);
     }
 
     return image;
@@ -1434,8 +2230,8 @@ wxImage wxImage::Rotate180() const
 
     wxCHECK( image.IsOk(), image );
 
-    long height = M_IMGDATA->m_height;
-    long width  = M_IMGDATA->m_width;
+    const int height = M_IMGDATA->m_height;
+    const int width  = M_IMGDATA->m_width;
 
     if ( HasOption(wxIMAGE_OPTION_CUR_HOTSPOT_X) )
     {
@@ -1449,33 +2245,12 @@ wxImage wxImage::Rotate180() const
                         height - 1 - GetOptionInt(wxIMAGE_OPTION_CUR_HOTSPOT_Y));
     }
 
-    unsigned char *data = image.GetData();
-    unsigned char *alpha = image.GetAlpha();
-    const unsigned char *source_data = M_IMGDATA->m_data;
-    unsigned char *target_data = data + width * height * 3;
-
-    for (long j = 0; j < height; j++)
-    {
-        for (long i = 0; i < width; i++)
-        {
-            target_data -= 3;
-            memcpy( target_data, source_data, 3 );
-            source_data += 3;
-        }
-    }
+    FlipPlane<3>(M_IMGDATA->m_data, image.GetData(), width, height, true, true);
 
-    if ( alpha )
+    if ( M_IMGDATA->m_alpha )
     {
-        const unsigned char *src_alpha = M_IMGDATA->m_alpha;
-        unsigned char *dest_alpha = alpha + width * height;
-
-        for (long j = 0; j < height; ++j)
-        {
-            for (long i = 0; i < width; ++i)
-            {
-                *(--dest_alpha) = *(src_alpha++);
-            }
-        }
+        FlipPlane<1>(M_IMGDATA->m_alpha, image.GetAlpha(),
+                     width, height, true, true);
     }
 
     return image;
@@ -1487,72 +2262,16 @@ wxImage wxImage::Mirror( bool horizontally ) const
 
     wxCHECK( image.IsOk(), image );
 
-    long height = M_IMGDATA->m_height;
-    long width  = M_IMGDATA->m_width;
-
-    unsigned char *data = image.GetData();
-    unsigned char *alpha = image.GetAlpha();
-    const unsigned char *source_data = M_IMGDATA->m_data;
-    unsigned char *target_data;
-
-    if (horizontally)
-    {
-        for (long j = 0; j < height; j++)
-        {
-            data += width*3;
-            target_data = data-3;
-            for (long i = 0; i < width; i++)
-            {
-                memcpy( target_data, source_data, 3 );
-                source_data += 3;
-                target_data -= 3;
-            }
-        }
+    const int height = M_IMGDATA->m_height;
+    const int width  = M_IMGDATA->m_width;
 
-        if (alpha != nullptr)
-        {
-            // src_alpha starts at the first pixel and increases by 1 after each step
-            // (a step here is the copy of the alpha value of one pixel)
-            const unsigned char *src_alpha = M_IMGDATA->m_alpha;
-            // dest_alpha starts just beyond the first line, decreases before each step,
-            // and after each line is finished, increases by 2 widths (skipping the line
-            // just copied and the line that will be copied next)
-            unsigned char *dest_alpha = alpha + width;
+    FlipPlane<3>(M_IMGDATA->m_data, image.GetData(),
+                 width, height, !horizontally, horizontally);
 
-            for (long jj = 0; jj < height; ++jj)
-            {
-                for (long i = 0; i < width; ++i) {
-                    *(--dest_alpha) = *(src_alpha++); // copy one pixel
-                }
-                dest_alpha += 2 * width; // advance beyond the end of the next line
-            }
-        }
-    }
-    else
+    if ( M_IMGDATA->m_alpha )
     {
-        for (long i = 0; i < height; i++)
-        {
-            target_data = data + 3*width*(height-1-i);
-            memcpy( target_data, source_data, (size_t)3*width );
-            source_data += 3*width;
-        }
-
-        if ( alpha )
-        {
-            // src_alpha starts at the first pixel and increases by 1 width after each step
-            // (a step here is the copy of the alpha channel of an entire line)
-            const unsigned char *src_alpha = M_IMGDATA->m_alpha;
-            // dest_alpha starts just beyond the last line (beyond the whole image)
-            // and decreases by 1 width before each step
-            unsigned char *dest_alpha = alpha + width * height;
-
-            for (long jj = 0; jj < height; ++jj)
-            {
-                dest_alpha -= width;
-                memcpy( dest_alpha, src_alpha, (size_t)width );
-                src_alpha += width;
-            }
-        }
+        FlipPlane<1>(M_IMGDATA->m_alpha, image.GetAlpha(),
+                     width, height, !horizontally, horizontally);
     }
 
     return image;
@@ -2915,30 +3634,23 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
     // rescale the image to the specified size if needed
     if ( maxWidth || maxHeight )
     {
-        const unsigned widthOrig = GetWidth(),
-                       heightOrig = GetHeight();
+        // the handler may have already scaled the image down while loading
+        // it, in which case it sets these options to the original size, but
+        // not necessarily to the final one, so we still need to check for it
+        // and we also need to restore these options after Rescale
+        const int widthOrigOption = GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH),
+                  heightOrigOption = GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT);
 
-        // this uses the same (trivial) algorithm as the JPEG handler
-        unsigned width = widthOrig,
-                 height = heightOrig;
-        while ( (maxWidth && width > maxWidth) ||
-                    (maxHeight && height > maxHeight) )
-        {
-            width /= 2;
-            height /= 2;
-        }
+        const wxSize sizeOrig(widthOrigOption ? widthOrigOption : GetWidth(),
+                              heightOrigOption ? heightOrigOption : GetHeight());
 
-        if ( width != widthOrig || height != heightOrig )
+        const wxSize size = wxGetImageLoadSize(sizeOrig, maxWidth, maxHeight);
+        if ( size != GetSize() )
         {
-            // get the original size if it was set by the image handler
-            // but also in order to restore it after Rescale
-            int widthOrigOption = GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH),
-                heightOrigOption = GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT);
+            Rescale(size.x, size.y, wxIMAGE_QUALITY_HIGH);
 
-            Rescale(width, height, wxIMAGE_QUALITY_HIGH);
-
-            SetOption(wxIMAGE_OPTION_ORIGINAL_WIDTH, widthOrigOption ? widthOrigOption : widthOrig);
-            SetOption(wxIMAGE_OPTION_ORIGINAL_HEIGHT, heightOrigOption ? heightOrigOption : heightOrig);
+            SetOption(wxIMAGE_OPTION_ORIGINAL_WIDTH, sizeOrig.x);
+            SetOption(wxIMAGE_OPTION_ORIGINAL_HEIGHT, sizeOrig.y);
         }
     }
 
@@ -3046,6 +3758,69 @@ bool wxImage::LoadFile( wxInputStream& stream, const wxString& mimetype, int ind
     return DoLoad(*handler, stream, index);
 }
 
+/* static */
+wxImageRowReader*
+wxImage::CreateRowReader(wxInputStream& stream, wxBitmapType type, int index)
+{
+    const bool verbose = (GetDefaultLoadFlags() & Load_Verbose) != 0;
+
+    if ( type == wxBITMAP_TYPE_ANY )
+    {
+        if ( !stream.IsSeekable() )
+        {
+            if ( verbose )
+            {
+                wxLogError(_("Can't automatically determine the image format "
+                             "for non-seekable input."));
+            }
+            return nullptr;
+        }
+
+        const wxList& list = GetHandlers();
+        for ( wxList::compatibility_iterator node = list.GetFirst();
+              node;
+              node = node->GetNext() )
+        {
+            wxImageHandler* const handler = (wxImageHandler*)node->GetData();
+            if ( handler->CanRead(stream) )
+            {
+                // Don't try the other handlers if this one recognized the
+                // format, even if it doesn't support incremental reading:
+                // they wouldn't be able to read it anyhow.
+                return handler->CreateRowReader(stream, verbose, index);
+            }
+        }
+
+        if ( verbose )
+        {
+            wxLogWarning( _("Unknown image data format.") );
+        }
+
+        return nullptr;
+    }
+
+    wxImageHandler* const handler = FindHandler(type);
+    if ( !handler )
+    {
+        if ( verbose )
+        {
+            wxLogWarning( _("No image handler for type %d defined."), type );
+        }
+        return nullptr;
+    }
+
+    if ( stream.IsSeekable() && !handler->CanRead(stream) )
+    {
+        if ( verbose )
+        {
+            wxLogError(_("This is not a %s."), handler->GetName());
+        }
+        return nullptr;
+    }
+
+    return handler->CreateRowReader(stream, verbose, index);
+}
+
 bool wxImage::DoSave(wxImageHandler& handler, wxOutputStream& stream) const
 {
     wxImage * const self = const_cast<wxImage *>(this);
@@ -3311,183 +4086,1034 @@ wxImage::RGBValue wxImage::HSVtoRGB(const HSVValue& hsv)
         green = hsv.value;
         blue = hsv.value;
     }
-    else // not grey
+    else // not grey
+    {
+        double hue = hsv.hue * 6.0;      // sector 0 to 5
+        int i = (int)floor(hue);
+        double f = hue - i;          // fractional part of h
+        double p = hsv.value * (1.0 - hsv.saturation);
+
+        switch (i)
+        {
+            case 0:
+                red = hsv.value;
+                green = hsv.value * (1.0 - hsv.saturation * (1.0 - f));
+                blue = p;
+                break;
+
+            case 1:
+                red = hsv.value * (1.0 - hsv.saturation * f);
+                green = hsv.value;
+                blue = p;
+                break;
+
+            case 2:
+                red = p;
+                green = hsv.value;
+                blue = hsv.value * (1.0 - hsv.saturation * (1.0 - f));
+                break;
+
+            case 3:
+                red = p;
+                green = hsv.value * (1.0 - hsv.saturation * f);
+                blue = hsv.value;
+                break;
+
+            case 4:
+                red = hsv.value * (1.0 - hsv.saturation * (1.0 - f));
+                green = p;
+                blue = hsv.value;
+                break;
+
+            default:    // case 5:
+                red = hsv.value;
+                green = p;
+                blue = hsv.value * (1.0 - hsv.saturation * f);
+                break;
+        }
+    }
+
+    return RGBValue((unsigned char)wxRound(red * 255.0),
+                    (unsigned char)wxRound(green * 255.0),
+                    (unsigned char)wxRound(blue * 255.0));
+}
+
+static void DoRotateHue(unsigned char *rgb, double angle)
+{
+    wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
+    wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
+
+    hsvValue.hue = hsvValue.hue + angle;
+
+    if (hsvValue.hue > 1.0)
+        hsvValue.hue = hsvValue.hue - 1.0;
+    else if (hsvValue.hue < 0.0)
+        hsvValue.hue = hsvValue.hue + 1.0;
+
+    rgbValue = wxImage::HSVtoRGB(hsvValue);
+    rgb[0] = rgbValue.red;
+    rgb[1] = rgbValue.green;
+    rgb[2] = rgbValue.blue;
+}
+
+// Rotates the hue of each pixel in the image by angle, which is a double in the
+// range [-1.0..+1.0], where -1.0 corresponds to -360 degrees and +1.0 corresponds
+// to +360 degrees.
+void wxImage::RotateHue(double angle)
+{
+    if ( wxIsNullDouble(angle) )
+        return;
+
+    wxASSERT(angle >= -1.0 && angle <= 1.0);
+    ApplyToAllPixels([angle](unsigned char *rgb)
+    {
+        DoRotateHue(rgb, angle);
+    });
+}
+
+static void DoChangeSaturation(unsigned char *rgb, double factor)
+{
+    wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
+    wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
+
+    hsvValue.saturation += hsvValue.saturation * factor;
+
+    if (hsvValue.saturation > 1.0)
+        hsvValue.saturation = 1.0;
+    else if (hsvValue.saturation < 0.0)
+        hsvValue.saturation = 0.0;
+
+    rgbValue = wxImage::HSVtoRGB(hsvValue);
+    rgb[0] = rgbValue.red;
+    rgb[1] = rgbValue.green;
+    rgb[2] = rgbValue.blue;
+}
+
+// Changes the saturation of each pixel in the image. factor is a double in the
+// range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0 corresponds
+// to +100 percent.
+void wxImage::ChangeSaturation(double factor)
+{
+    if ( wxIsNullDouble(factor) )
+        return;
+
+    wxASSERT(factor >= -1.0 && factor <= 1.0);
+    ApplyToAllPixels([factor](unsigned char *rgb)
+    {
+        DoChangeSaturation(rgb, factor);
+    });
+}
+
+static void DoChangeBrightness(unsigned char *rgb, double factor)
+{
+    wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
+    wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
+
+    hsvValue.value += hsvValue.value * factor;
+
+    if (hsvValue.value > 1.0)
+        hsvValue.value = 1.0;
+    else if (hsvValue.value < 0.0)
+        hsvValue.value = 0.0;
+
+    rgbValue = wxImage::HSVtoRGB(hsvValue);
+    rgb[0] = rgbValue.red;
+    rgb[1] = rgbValue.green;
+    rgb[2] = rgbValue.blue;
+}
+
+// Changes the brightness (value) of each pixel in the image. factor is a double
+// in the range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0
+// corresponds to +100 percent.
+void wxImage::ChangeBrightness(double factor)
+{
+    if ( wxIsNullDouble(factor) )
+        return;
+
+    wxASSERT(factor >= -1.0 && factor <= 1.0);
+    ApplyToAllPixels([factor](unsigned char *rgb)
+    {
+        DoChangeBrightness(rgb, factor);
+    });
+}
+
+// Changes the hue, the saturation and the brightness (value) of each pixel in
+// the image. angleH is a double in the range [-1.0..+1.0], where -1.0 corresponds
+// to -360 degrees and +1.0 corresponds to +360 degrees, factorS is a double in
+// the range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0
+// corresponds to +100 percent and factorV is a double in the range [-1.0..+1.0],
+// where -1.0 corresponds to -100 percent and +1.0 corresponds to +100 percent.
+void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
+{
+    if ( wxIsNullDouble(angleH) && wxIsNullDouble(factorS) && wxIsNullDouble(factorV) )
+        return;
+
+    wxASSERT(angleH >= -1.0 && angleH <= 1.0 && factorS >= -1.0 &&
+             factorS <= 1.0 && factorV >= -1.0 && factorV <= 1.0);
+    ApplyToAllPixels([angleH, factorS, factorV](unsigned char *rgb)
+    {
+        if ( !wxIsNullDouble(angleH) )
+            DoRotateHue(rgb, angleH);
+
+        if ( !wxIsNullDouble(factorS) )
+            DoChangeSaturation(rgb, factorS);
+
+        if ( !wxIsNullDouble(factorV) )
+            DoChangeBrightness(rgb, factorV);
+    });
+}
+
+wxSize wxGetImageLoadSize(const wxSize& size, unsigned maxWidth, unsigned maxHeight)
+{
+    const wxUint64 width = size.x,
+                   height = size.y;
+
+    // Check which dimension limits the scale factor more, if any.
+    bool byWidth;
+    if ( maxWidth && width > maxWidth )
+        byWidth = !maxHeight || maxWidth*height <= maxHeight*width;
+    else if ( maxHeight && height > maxHeight )
+        byWidth = false;
+    else
+        return size;
+
+    // Scale the other dimension preserving the aspect ratio, rounding it to
+    // the nearest integer (which can't exceed its maximum).
+    wxSize sizeNew;
+    if ( byWidth )
+    {
+        sizeNew.x = maxWidth;
+        sizeNew.y = (height*maxWidth + width/2) / width;
+    }
+    else
+    {
+        sizeNew.x = (width*maxHeight + height/2) / height;
+        sizeNew.y = maxHeight;
+    }
+
+    sizeNew.IncTo(wxSize(1, 1));
+
+    return sizeNew;
+}
+
+//-----------------------------------------------------------------------------
+// wxImageRowReader
+//-----------------------------------------------------------------------------
+
+int
+wxImageRowReader::ReadRows(unsigned char* data, unsigned char* alpha, int numRows)
+{
+    wxCHECK_MSG( data, 0, "null data pointer" );
+    wxCHECK_MSG( numRows >= 0, 0, "invalid number of rows" );
+
+    if ( IsDone() )
+        return 0;
+
+    numRows = wxMin(numRows, m_height - m_currentRow);
+    if ( !numRows )
+        return 0;
+
+    if ( !DoReadRows(data, m_hasAlpha ? alpha : nullptr, numRows) )
+    {
+        m_ok = false;
+        return 0;
+    }
+
+    m_currentRow += numRows;
+
+    return numRows;
+}
+
+wxImage wxImageRowReader::ReadImage(int numRows)
+{
+    if ( IsDone() )
+        return wxImage();
+
+    numRows = wxMin(numRows, m_height - m_currentRow);
+
+    wxImage image(m_width, numRows, false);
+    if ( !image.IsOk() )
+        return wxImage();
+
+    if ( m_hasAlpha )
+        image.SetAlpha();
+
+    if ( !ReadRows(image.GetData(), image.GetAlpha(), numRows) )
+        return wxImage();
+
+    return image;
+}
+
+//-----------------------------------------------------------------------------
+// wxImageView
+//-----------------------------------------------------------------------------
+
+wxImageView::wxImageView(const unsigned char* data,
+                         int width,
+                         int height,
+                         wxImagePixelFormat format,
+                         int stride)
+{
+    wxCHECK_RET( data, "null data pointer" );
+    wxCHECK_RET( width > 0 && height > 0, "invalid view size" );
+
+    const int rowSize = width*GetBytesPerPixel(format);
+    if ( !stride )
+        stride = rowSize;
+
+    wxCHECK_RET( stride >= rowSize, "stride too small for the view width" );
+
+    if ( format == wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED )
+    {
+        wxCHECK_RET( !(wxUIntPtr(data) % sizeof(wxUint32)) &&
+                        !(stride % sizeof(wxUint32)),
+                     "32-bit pixels must be aligned" );
+    }
+
+    m_data = data;
+    m_width = width;
+    m_height = height;
+    m_stride = stride;
+    m_format = format;
+}
+
+/* static */
+int wxImageView::GetBytesPerPixel(wxImagePixelFormat format)
+{
+    switch ( format )
+    {
+        case wxIMAGE_FORMAT_RGB:
+            return 3;
+
+        case wxIMAGE_FORMAT_RGBA:
+        case wxIMAGE_FORMAT_BGRA:
+        case wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED:
+            return 4;
+
+        case wxIMAGE_FORMAT_GRAY:
+            return 1;
+    }
+
+    wxFAIL_MSG( "unknown pixel format" );
+
+    return 0;
+}
+
+wxImageView wxImageView::GetSubView(const wxRect& rect) const
+{
+    wxCHECK_MSG( IsOk(), wxImageView(), "invalid view" );
+    wxCHECK_MSG( wxRect(GetSize()).Contains(rect) && !rect.IsEmpty(),
+                 wxImageView(), "invalid subview rectangle" );
+
+    return wxImageView(GetRow(rect.y) + rect.x*GetBytesPerPixel(m_format),
+                       rect.width, rect.height, m_format, m_stride);
+}
+
+wxImage::wxImage(const wxImageView& view)
+{
+    wxCHECK_RET( view.IsOk(), "invalid view" );
+
+    const int width = view.GetWidth();
+    if ( !Create(width, view.GetHeight(), false /* don't clear */) )
+        return;
+
+    if ( view.HasAlpha() )
+        SetAlpha();
+
+    unsigned char* const data = M_IMGDATA->m_data;
+    unsigned char* const alpha = M_IMGDATA->m_alpha;
+
+    const ImageRowSource source(view);
+    ForEachImageBand(view.GetHeight(), width, [&](int from, int to)
+    {
+        ImageRowSource rows(source);
+        for ( int y = from; y < to; y++ )
+        {
+            memcpy(data + 3*size_t(width)*y, rows.GetRGB(y), 3*size_t(width));
+            if ( alpha )
+                memcpy(alpha + size_t(width)*y, rows.GetAlpha(y), width);
+        }
+    });
+}
+
+namespace
+{
+
+// Write a row of pixels in wxImage format to the buffer in the given format.
+void WriteImageRow(const unsigned char* rgb,
+                   const unsigned char* alpha,
+                   int width,
+                   wxImagePixelFormat format,
+                   unsigned char* dst)
+{
+    switch ( format )
+    {
+        case wxIMAGE_FORMAT_RGB:
+            memcpy(dst, rgb, 3*size_t(width));
+            break;
+
+        case wxIMAGE_FORMAT_RGBA:
+            for ( int x = 0; x < width; x++, rgb += 3, dst += 4 )
+            {
+                dst[0] = rgb[0];
+                dst[1] = rgb[1];
+                dst[2] = rgb[2];
+                dst[3] = alpha ? alpha[x] : wxIMAGE_ALPHA_OPAQUE;
+            }
+            break;
+
+        case wxIMAGE_FORMAT_BGRA:
+            for ( int x = 0; x < width; x++, rgb += 3, dst += 4 )
+            {
+                dst[0] = rgb[2];
+                dst[1] = rgb[1];
+                dst[2] = rgb[0];
+                dst[3] = alpha ? alpha[x] : wxIMAGE_ALPHA_OPAQUE;
+            }
+            break;
+
+        case wxIMAGE_FORMAT_GRAY:
+            for ( int x = 0; x < width; x++, rgb += 3 )
+            {
+                unsigned char r = rgb[0],
+                              g = rgb[1],
+                              b = rgb[2];
+                wxColour::MakeGrey(&r, &g, &b, 0.299, 0.587, 0.114);
+                dst[x] = r;
+            }
+            break;
+
+        case wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED:
+            {
+                wxUint32* const argb = reinterpret_cast<wxUint32*>(dst);
+                if ( !alpha )
+                {
+                    for ( int x = 0; x < width; x++, rgb += 3 )
+                    {
+                        argb[x] = 0xff000000u |
+                                  wxUint32(rgb[0]) << 16 |
+                                  wxUint32(rgb[1]) << 8 |
+                                  rgb[2];
+                    }
+                    break;
+                }
+
+                for ( int x = 0; x < width; x++, rgb += 3 )
+                {
+                    const unsigned a = alpha[x];
+                    argb[x] = wxUint32(a) << 24 |
+                              wxUint32(Premultiply(a, rgb[0])) << 16 |
+                              wxUint32(Premultiply(a, rgb[1])) << 8 |
+                              Premultiply(a, rgb[2]);
+                }
+            }
+            break;
+    }
+}
+
+} // anonymous namespace
+
+bool
+wxImage::CopyToBuffer(unsigned char* data,
+                      wxImagePixelFormat format,
+                      int stride) const
+{
+    wxCHECK_MSG( IsOk(), false, "invalid image" );
+    wxCHECK_MSG( data, false, "null data pointer" );
+
+    const int width = M_IMGDATA->m_width;
+    const int rowSize = width*wxImageView::GetBytesPerPixel(format);
+    if ( !stride )
+        stride = rowSize;
+
+    wxCHECK_MSG( stride >= rowSize, false, "stride too small for the image" );
+
+    if ( format == wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED )
+    {
+        wxCHECK_MSG( !(wxUIntPtr(data) % sizeof(wxUint32)) &&
+                        !(stride % sizeof(wxUint32)),
+                     false, "32-bit pixels must be aligned" );
+    }
+
+    const unsigned char* const rgb = M_IMGDATA->m_data;
+    const unsigned char* const alpha = M_IMGDATA->m_alpha;
+
+    ForEachImageBand(M_IMGDATA->m_height, width, [=](int from, int to)
+    {
+        for ( int y = from; y < to; y++ )
+        {
+            WriteImageRow(rgb + 3*size_t(width)*y,
+                          alpha ? alpha + size_t(width)*y : nullptr,
+                          width,
+                          format,
+                          data + size_t(stride)*y);
+        }
+    });
+
+    return true;
+}
+
+wxImage
+wxImageView::Scale(int width, int height, wxImageResizeQuality quality) const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), "invalid view" );
+    wxCHECK_MSG( (width > 0) && (height > 0), wxImage(),
+                 "invalid new image size" );
+
+    if ( width == m_width && height == m_height )
+        return wxImage(*this);
+
+    // This uses the same algorithms as wxImage::Scale(), except for the fast
+    // scaling which always uses the nearest neighbour, even when shrinking by
+    // an integer factor.
+    const ImageRowSource source(*this);
+    switch ( quality )
+    {
+        case wxIMAGE_QUALITY_NORMAL:
+            if ( width <= m_width && height <= m_height )
+            {
+                const double shrinkFactorX = double(m_width) / width;
+                const double shrinkFactorY = double(m_height) / height;
+
+                const int shrinkInt(wxMin(shrinkFactorX, shrinkFactorY));
+
+                wxImage image = DoResampleBilinear(source,
+                                                   width * shrinkInt,
+                                                   height * shrinkInt);
+                if ( shrinkInt != 1 && image.IsOk() )
+                    image = DoResampleBox(ImageRowSource(image), width, height);
+
+                return image;
+            }
+            return DoResampleBox(source, width, height);
+
+        case wxIMAGE_QUALITY_FAST:
+        case wxIMAGE_QUALITY_NEAREST:
+            return DoResampleNearest(source, width, height);
+
+        case wxIMAGE_QUALITY_BILINEAR:
+            return DoResampleBilinear(source, width, height);
+
+        case wxIMAGE_QUALITY_BICUBIC:
+            return DoResampleBicubic(source, width, height);
+
+        case wxIMAGE_QUALITY_BOX_AVERAGE:
+            return DoResampleBox(source, width, height);
+
+        case wxIMAGE_QUALITY_HIGH:
+            return width < m_width && height < m_height
+                        ? DoResampleBox(source, width, height)
+                        : DoResampleBicubic(source, width, height);
+    }
+
+    wxFAIL_MSG( "unknown resize quality" );
+
+    return wxImage();
+}
+
+namespace
+{
+
+// Copy the rows of the view, in wxImage format, to the given image, whose size
+// must be the same as the size of the view, possibly reversing the order of
+// the rows and/or pixels in them.
+void CopyViewRows(const wxImageView& view,
+                  wxImage& image,
+                  bool reverseRows,
+                  bool reversePixels)
+{
+    const int width = view.GetWidth();
+    const int height = view.GetHeight();
+    unsigned char* const data = image.GetData();
+    unsigned char* const alpha = image.GetAlpha();
+
+    const ImageRowSource source(view);
+    ForEachImageBand(height, width, [&](int from, int to)
+    {
+        ImageRowSource rows(source);
+        for ( int y = from; y < to; y++ )
+        {
+            const size_t yDst = reverseRows ? height - 1 - y : y;
+            unsigned char* const dstRGB = data + 3*size_t(width)*yDst;
+            unsigned char* const dstAlpha = alpha ? alpha + size_t(width)*yDst
+                                                  : nullptr;
+
+            const unsigned char* const srcRGB = rows.GetRGB(y);
+            const unsigned char* const srcAlpha = alpha ? rows.GetAlpha(y)
+                                                        : nullptr;
+
+            if ( !reversePixels )
+            {
+                memcpy(dstRGB, srcRGB, 3*size_t(width));
+                if ( dstAlpha )
+                    memcpy(dstAlpha, srcAlpha, width);
+                continue;
+            }
+
+            for ( int x = 0; x < width; x++ )
+            {
+                const int xDst = width - 1 - x;
+                memcpy(dstRGB + 3*xDst, srcRGB + 3*x, 3);
+                if ( dstAlpha )
+                    dstAlpha[xDst] = srcAlpha[x];
+            }
+        }
+    });
+}
+
+// Create an image of the given size and with alpha if the view has it.
+wxImage CreateImageForView(const wxImageView& view, int width, int height)
+{
+    wxImage image(width, height, false /* don't clear */);
+    if ( image.IsOk() && view.HasAlpha() )
+        image.SetAlpha();
+
+    return image;
+}
+
+} // anonymous namespace
+
+wxImage wxImageView::Mirror(bool horizontally) const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), "invalid view" );
+
+    wxImage image = CreateImageForView(*this, m_width, m_height);
+    wxCHECK_MSG( image.IsOk(), image, "unable to create image" );
+
+    CopyViewRows(*this, image, !horizontally, horizontally);
+
+    return image;
+}
+
+wxImage wxImageView::Rotate180() const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), "invalid view" );
+
+    wxImage image = CreateImageForView(*this, m_width, m_height);
+    wxCHECK_MSG( image.IsOk(), image, "unable to create image" );
+
+    CopyViewRows(*this, image, true, true);
+
+    return image;
+}
+
+wxImage wxImageView::Rotate90(bool clockwise) const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), "invalid view" );
+
+    const int width = m_width;
+    const int height = m_height;
+
+    wxImage image = CreateImageForView(*this, height, width);
+    wxCHECK_MSG( image.IsOk(), image, "unable to create image" );
+
+    unsigned char* const data = image.GetData();
+    unsigned char* const alpha = image.GetAlpha();
+
+    // Source pixel (x, y) goes to the row x of the new image when rotating
+    // clockwise and to the row width - 1 - x otherwise, so processing bands
+    // of source rows writes to disjoint columns of the new image.
+    const ImageRowSource source(*this);
+    ForEachImageBand(height, width, [&](int from, int to)
+    {
+        ImageRowSource rows(source);
+        for ( int y = from; y < to; y++ )
+        {
+            const unsigned char* const srcRGB = rows.GetRGB(y);
+            const unsigned char* const srcAlpha = alpha ? rows.GetAlpha(y)
+                                                        : nullptr;
+
+            const size_t xDst = clockwise ? height - 1 - y : y;
+            for ( int x = 0; x < width; x++ )
+            {
+                const size_t yDst = clockwise ? x : width - 1 - x;
+                const size_t offset = yDst*height + xDst;
+                memcpy(data + 3*offset, srcRGB + 3*x, 3);
+                if ( alpha )
+                    alpha[offset] = srcAlpha[x];
+            }
+        }
+    });
+
+    return image;
+}
+
+#if wxUSE_THREADS && wxUSE_STREAMS
+
+//-----------------------------------------------------------------------------
+// wxImageBatchLoader
+//-----------------------------------------------------------------------------
+
+class wxImageBatchLoaderImpl
+{
+public:
+    explicit wxImageBatchLoaderImpl(int numThreads)
+        : m_numThreads(numThreads),
+          m_condWork(m_mutex),
+          m_condResult(m_mutex)
+    {
+    }
+
+    ~wxImageBatchLoaderImpl()
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            m_exit = true;
+            m_condWork.Broadcast();
+        }
+
+        for ( size_t n = 0; n < m_threads.size(); n++ )
+        {
+            m_threads[n]->Wait();
+            delete m_threads[n];
+        }
+    }
+
+    void SetMemoryLimit(size_t maxBytes)
+    {
+        wxMutexLocker lock(m_mutex);
+        m_maxBytes = maxBytes;
+
+        // Some workers may be able to proceed now.
+        m_condWork.Broadcast();
+    }
+
+    void SetNotifyHandler(wxEvtHandler* handler, int id)
+    {
+        wxMutexLocker lock(m_mutex);
+        m_handler = handler;
+        m_handlerId = id;
+    }
+
+    size_t Add(const wxString& filename,
+               wxInputStream* stream,
+               wxBitmapType type,
+               int index)
+    {
+        wxMutexLocker lock(m_mutex);
+
+        Item item;
+        item.index = m_numAdded++;
+
+        // Make a deep copy of the string as it's going to be used by another
+        // thread.
+        item.filename = filename.Clone();
+        item.stream.reset(stream);
+        item.type = type;
+        item.imageIndex = index;
+
+        m_items.push_back(std::move(item));
+        m_numPending++;
+
+        m_condWork.Signal();
+
+        return m_numAdded - 1;
+    }
+
+    bool Start()
+    {
+        wxMutexLocker lock(m_mutex);
+
+        wxCHECK_MSG( m_threads.empty(), false, "loader already started" );
+
+        for ( int n = 0; n < m_numThreads; n++ )
+        {
+            wxThread* const thread = new WorkerThread(*this);
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                delete thread;
+                break;
+            }
+
+            m_threads.push_back(thread);
+        }
+
+        return !m_threads.empty();
+    }
+
+    bool GetNext(wxImageBatchResult& result, long timeout)
+    {
+        wxMutexLocker lock(m_mutex);
+
+        wxCHECK_MSG( !m_threads.empty(), false, "loader must be started" );
+
+        // We may be woken up without getting a result, e.g. spuriously, so
+        // don't wait for more than the remaining time after doing it.
+        const wxMilliClock_t deadline = timeout > 0
+                                            ? wxGetLocalTimeMillis() + timeout
+                                            : wxMilliClock_t(0);
+
+        while ( m_results.empty() )
+        {
+            if ( !m_numPending )
+                return false;
+
+            long remaining = 0;
+            if ( timeout > 0 )
+                remaining = (deadline - wxGetLocalTimeMillis()).ToLong();
+
+            if ( timeout == -1 )
+            {
+                m_condResult.Wait();
+            }
+            else if ( remaining <= 0 ||
+                        m_condResult.WaitTimeout(remaining) == wxCOND_TIMEOUT )
+            {
+                // We could have got a result just before timing out, but
+                // we don't care about this as, if we did, the next call will
+                // return it without waiting.
+                if ( m_results.empty() )
+                    return false;
+            }
+        }
+
+        result = std::move(m_results.front());
+        m_results.pop_front();
+
+        m_numPending--;
+        m_bytesLoaded -= GetImageBytes(result.image);
+
+        // More than one worker may be able to proceed now.
+        m_condWork.Broadcast();
+
+        return true;
+    }
+
+    size_t GetPendingCount() const
+    {
+        wxMutexLocker lock(m_mutex);
+        return m_numPending;
+    }
+
+private:
+    struct Item
+    {
+        size_t index = 0;
+        wxString filename;
+        std::unique_ptr<wxInputStream> stream;
+        wxBitmapType type = wxBITMAP_TYPE_ANY;
+        int imageIndex = -1;
+    };
+
+    class WorkerThread : public wxThread
+    {
+    public:
+        explicit WorkerThread(wxImageBatchLoaderImpl& loader)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_loader(loader)
+        {
+        }
+
+    protected:
+        virtual ExitCode Entry() override
+        {
+            m_loader.WorkerLoop();
+
+            return nullptr;
+        }
+
+    private:
+        wxImageBatchLoaderImpl& m_loader;
+    };
+
+    static size_t GetImageBytes(const wxImage& image)
+    {
+        if ( !image.IsOk() )
+            return 0;
+
+        return size_t(image.GetWidth())*image.GetHeight()*
+                (image.HasAlpha() ? 4 : 3);
+    }
+
+    // Return the expected size of the next image to be loaded.
+    //
+    // As we don't know the image size before decoding it, use the average
+    // size of the images loaded so far or, if there are none yet, assume the
+    // worst, i.e. that a single image uses up all the allowed memory.
+    size_t GetEstimatedImageBytes() const
+    {
+        return m_numLoaded ? m_bytesTotal / m_numLoaded : m_maxBytes;
+    }
+
+    // Return true if we can't start loading another image without exceeding
+    // the memory limit, taking into account the images being loaded.
+    //
+    // Notice that we always allow loading an image if there are no others
+    // being loaded or waiting to be retrieved, as otherwise we could never
+    // make progress if a single image is bigger than the limit.
+    bool IsOverMemoryLimit() const
     {
-        double hue = hsv.hue * 6.0;      // sector 0 to 5
-        int i = (int)floor(hue);
-        double f = hue - i;          // fractional part of h
-        double p = hsv.value * (1.0 - hsv.saturation);
+        if ( !m_maxBytes || (m_results.empty() && !m_numLoading) )
+            return false;
 
-        switch (i)
+        const size_t used = m_bytesLoaded + m_bytesReserved;
+        return used >= m_maxBytes ||
+                GetEstimatedImageBytes() > m_maxBytes - used;
+    }
+
+    void WorkerLoop()
+    {
+        wxMutexLocker lock(m_mutex);
+        for ( ;; )
         {
-            case 0:
-                red = hsv.value;
-                green = hsv.value * (1.0 - hsv.saturation * (1.0 - f));
-                blue = p;
-                break;
+            while ( !m_exit && (m_items.empty() || IsOverMemoryLimit()) )
+                m_condWork.Wait();
 
-            case 1:
-                red = hsv.value * (1.0 - hsv.saturation * f);
-                green = hsv.value;
-                blue = p;
+            if ( m_exit )
                 break;
 
-            case 2:
-                red = p;
-                green = hsv.value;
-                blue = hsv.value * (1.0 - hsv.saturation * (1.0 - f));
-                break;
+            Item item = std::move(m_items.front());
+            m_items.pop_front();
 
-            case 3:
-                red = p;
-                green = hsv.value * (1.0 - hsv.saturation * f);
-                blue = hsv.value;
-                break;
+            // Reserve the memory for this image before decoding it to avoid
+            // starting too many decodes in parallel.
+            const size_t reserved = m_maxBytes ? GetEstimatedImageBytes() : 0;
+            m_bytesReserved += reserved;
+            m_numLoading++;
 
-            case 4:
-                red = hsv.value * (1.0 - hsv.saturation * (1.0 - f));
-                green = p;
-                blue = hsv.value;
-                break;
+            m_mutex.Unlock();
 
-            default:    // case 5:
-                red = hsv.value;
-                green = p;
-                blue = hsv.value * (1.0 - hsv.saturation * f);
-                break;
+            wxImageBatchResult result;
+            result.index = item.index;
+            if ( item.stream )
+                result.image.LoadFile(*item.stream, item.type, item.imageIndex);
+            else
+                result.image.LoadFile(item.filename, item.type, item.imageIndex);
+
+            result.filename = std::move(item.filename);
+
+            // Close the file as soon as possible.
+            item.stream.reset();
+
+            m_mutex.Lock();
+
+            const size_t bytes = GetImageBytes(result.image);
+
+            m_bytesReserved -= reserved;
+            m_numLoading--;
+
+            m_bytesLoaded += bytes;
+            if ( bytes )
+            {
+                m_bytesTotal += bytes;
+                m_numLoaded++;
+            }
+
+            m_results.push_back(std::move(result));
+
+            m_condResult.Signal();
+
+            // The estimate used for the other images may have changed, so let
+            // the workers waiting for the memory to become available recheck.
+            if ( m_maxBytes )
+                m_condWork.Broadcast();
+
+            if ( m_handler )
+                m_handler->QueueEvent(new wxThreadEvent(wxEVT_THREAD,
+                                                        m_handlerId));
         }
     }
 
-    return RGBValue((unsigned char)wxRound(red * 255.0),
-                    (unsigned char)wxRound(green * 255.0),
-                    (unsigned char)wxRound(blue * 255.0));
-}
+    const int m_numThreads;
 
-static void DoRotateHue(unsigned char *rgb, double angle)
-{
-    wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
-    wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
+    // This mutex protects all the fields below.
+    mutable wxMutex m_mutex;
+    wxCondition m_condWork,
+                m_condResult;
 
-    hsvValue.hue = hsvValue.hue + angle;
+    wxVector<wxThread*> m_threads;
 
-    if (hsvValue.hue > 1.0)
-        hsvValue.hue = hsvValue.hue - 1.0;
-    else if (hsvValue.hue < 0.0)
-        hsvValue.hue = hsvValue.hue + 1.0;
+    // Images that haven't started loading yet.
+    std::deque<Item> m_items;
 
-    rgbValue = wxImage::HSVtoRGB(hsvValue);
-    rgb[0] = rgbValue.red;
-    rgb[1] = rgbValue.green;
-    rgb[2] = rgbValue.blue;
-}
+    // Images that have been loaded but not retrieved yet.
+    std::deque<wxImageBatchResult> m_results;
 
-// Rotates the hue of each pixel in the image by angle, which is a double in the
-// range [-1.0..+1.0], where -1.0 corresponds to -360 degrees and +1.0 corresponds
-// to +360 degrees.
-void wxImage::RotateHue(double angle)
-{
-    if ( wxIsNullDouble(angle) )
-        return;
+    // Total number of images added.
+    size_t m_numAdded = 0;
 
-    wxASSERT(angle >= -1.0 && angle <= 1.0);
-    ApplyToAllPixels([angle](unsigned char *rgb)
-    {
-        DoRotateHue(rgb, angle);
-    });
-}
+    // Number of images added but not retrieved yet.
+    size_t m_numPending = 0;
 
-static void DoChangeSaturation(unsigned char *rgb, double factor)
-{
-    wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
-    wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
+    // Memory used by the images in m_results, memory reserved for the images
+    // being currently loaded and the limit for the sum of both.
+    size_t m_bytesLoaded = 0,
+           m_bytesReserved = 0,
+           m_maxBytes = 0;
 
-    hsvValue.saturation += hsvValue.saturation * factor;
+    // Number of images being currently loaded.
+    size_t m_numLoading = 0;
 
-    if (hsvValue.saturation > 1.0)
-        hsvValue.saturation = 1.0;
-    else if (hsvValue.saturation < 0.0)
-        hsvValue.saturation = 0.0;
+    // Total size and number of all successfully loaded images, used to
+    // estimate the size of the next one.
+    size_t m_bytesTotal = 0,
+           m_numLoaded = 0;
 
-    rgbValue = wxImage::HSVtoRGB(hsvValue);
-    rgb[0] = rgbValue.red;
-    rgb[1] = rgbValue.green;
-    rgb[2] = rgbValue.blue;
-}
+    wxEvtHandler* m_handler = nullptr;
+    int m_handlerId = wxID_ANY;
 
-// Changes the saturation of each pixel in the image. factor is a double in the
-// range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0 corresponds
-// to +100 percent.
-void wxImage::ChangeSaturation(double factor)
-{
-    if ( wxIsNullDouble(factor) )
-        return;
+    bool m_exit = false;
 
-    wxASSERT(factor >= -1.0 && factor <= 1.0);
-    ApplyToAllPixels([factor](unsigned char *rgb)
-    {
-        DoChangeSaturation(rgb, factor);
-    });
+    wxDECLARE_NO_COPY_CLASS(wxImageBatchLoaderImpl);
+};
+
+wxImageBatchLoader::wxImageBatchLoader(int numThreads)
+    : m_impl(new wxImageBatchLoaderImpl(numThreads > 0
+                                            ? numThreads
+                                            : wxMax(wxThread::GetCPUCount(), 1)))
+{
 }
 
-static void DoChangeBrightness(unsigned char *rgb, double factor)
+wxImageBatchLoader::~wxImageBatchLoader()
 {
-    wxImage::RGBValue rgbValue(rgb[0], rgb[1], rgb[2]);
-    wxImage::HSVValue hsvValue = wxImage::RGBtoHSV(rgbValue);
+    delete m_impl;
+}
 
-    hsvValue.value += hsvValue.value * factor;
+void wxImageBatchLoader::SetMemoryLimit(size_t maxBytes)
+{
+    m_impl->SetMemoryLimit(maxBytes);
+}
 
-    if (hsvValue.value > 1.0)
-        hsvValue.value = 1.0;
-    else if (hsvValue.value < 0.0)
-        hsvValue.value = 0.0;
+void wxImageBatchLoader::SetNotifyHandler(wxEvtHandler* handler, int id)
+{
+    m_impl->SetNotifyHandler(handler, id);
+}
 
-    rgbValue = wxImage::HSVtoRGB(hsvValue);
-    rgb[0] = rgbValue.red;
-    rgb[1] = rgbValue.green;
-    rgb[2] = rgbValue.blue;
+size_t
+wxImageBatchLoader::AddFile(const wxString& filename,
+                            wxBitmapType type,
+                            int index)
+{
+    return m_impl->Add(filename, nullptr, type, index);
 }
 
-// Changes the brightness (value) of each pixel in the image. factor is a double
-// in the range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0
-// corresponds to +100 percent.
-void wxImage::ChangeBrightness(double factor)
+size_t
+wxImageBatchLoader::AddStream(wxInputStream* stream,
+                              wxBitmapType type,
+                              int index)
 {
-    if ( wxIsNullDouble(factor) )
-        return;
+    wxCHECK_MSG( stream, static_cast<size_t>(-1), "null stream" );
 
-    wxASSERT(factor >= -1.0 && factor <= 1.0);
-    ApplyToAllPixels([factor](unsigned char *rgb)
-    {
-        DoChangeBrightness(rgb, factor);
-    });
+    return m_impl->Add(wxString(), stream, type, index);
 }
 
-// Changes the hue, the saturation and the brightness (value) of each pixel in
-// the image. angleH is a double in the range [-1.0..+1.0], where -1.0 corresponds
-// to -360 degrees and +1.0 corresponds to +360 degrees, factorS is a double in
-// the range [-1.0..+1.0], where -1.0 corresponds to -100 percent and +1.0
-// corresponds to +100 percent and factorV is a double in the range [-1.0..+1.0],
-// where -1.0 corresponds to -100 percent and +1.0 corresponds to +100 percent.
-void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
+bool wxImageBatchLoader::Start()
 {
-    if ( wxIsNullDouble(angleH) && wxIsNullDouble(factorS) && wxIsNullDouble(factorV) )
-        return;
-
-    wxASSERT(angleH >= -1.0 && angleH <= 1.0 && factorS >= -1.0 &&
-             factorS <= 1.0 && factorV >= -1.0 && factorV <= 1.0);
-    ApplyToAllPixels([angleH, factorS, factorV](unsigned char *rgb)
-    {
-        if ( !wxIsNullDouble(angleH) )
-            DoRotateHue(rgb, angleH);
+    return m_impl->Start();
+}
 
-        if ( !wxIsNullDouble(factorS) )
-            DoChangeSaturation(rgb, factorS);
+bool wxImageBatchLoader::GetNext(wxImageBatchResult& result, long timeout)
+{
+    return m_impl->GetNext(result, timeout);
+}
 
-        if ( !wxIsNullDouble(factorV) )
-            DoChangeBrightness(rgb, factorV);
-    });
+size_t wxImageBatchLoader::GetPendingCount() const
+{
+    return m_impl->GetPendingCount();
 }
 
+#endif // wxUSE_THREADS && wxUSE_STREAMS
+
 //-----------------------------------------------------------------------------
 // wxImageHandler
 //-----------------------------------------------------------------------------
@@ -3645,8 +5271,6 @@ unsigned long wxImage::ComputeHistogram( wxImageHistogram &h ) const
  * Rotation code by Carlos Moreno
  */
 
-static const double wxROTATE_EPSILON = 1e-10;
-
 // Auxiliary function to rotate a point (x,y) with respect to point p0
 // make it inline and use a straight return to facilitate optimization
 // also, the function receives the sine and cosine of the angle to avoid
@@ -3676,29 +5300,9 @@ wxImage wxImage::Rotate(double angle,
     // screen coordinates are a mirror image of "real" coordinates
     angle = -angle;
 
-    const bool has_alpha = HasAlpha();
-
     const int w = GetWidth();
     const int h = GetHeight();
 
-    int i;
-
-    // Create pointer-based array to accelerate access to wxImage's data
-    unsigned char ** data = new unsigned char * [h];
-    data[0] = GetData();
-    for (i = 1; i < h; i++)
-        data[i] = data[i - 1] + (3 * w);
-
-    // Same for alpha channel
-    unsigned char ** alpha = nullptr;
-    if (has_alpha)
-    {
-        alpha = new unsigned char * [h];
-        alpha[0] = GetAlpha();
-        for (i = 1; i < h; i++)
-            alpha[i] = alpha[i - 1] + w;
-    }
-
     // precompute coefficients for rotation formula
     const double cos_angle = cos(angle);
     const double sin_angle = sin(angle);
@@ -3722,7 +5326,7 @@ wxImage wxImage::Rotate(double angle,
     // Create rotated image
     wxImage rotated (x2a - x1a + 1, y2a - y1a + 1, false);
     // With alpha channel
-    if (has_alpha)
+    if (HasAlpha())
         rotated.SetAlpha();
 
     if (offset_after_rotation != nullptr)
@@ -3730,12 +5334,6 @@ wxImage wxImage::Rotate(double angle,
         *offset_after_rotation = wxPoint (x1a, y1a);
     }
 
-    // the rotated (destination) image is always accessed sequentially via this
-    // pointer, there is no need for pointer-based arrays here
-    unsigned char *dst = rotated.GetData();
-
-    unsigned char *alpha_dst = has_alpha ? rotated.GetAlpha() : nullptr;
-
     // if the original image has a mask, use its RGB values as the blank pixel,
     // else, fall back to default (black).
     unsigned char blank_r = 0;
@@ -3750,9 +5348,30 @@ wxImage wxImage::Rotate(double angle,
         rotated.SetMaskColour( blank_r, blank_g, blank_b );
     }
 
+    const unsigned char* const src_data = GetData();
+    const unsigned char* const src_alpha = GetAlpha();
+    unsigned char* const dst_data = rotated.GetData();
+    unsigned char* const dst_alpha = rotated.GetAlpha();
+
     // Now, for each point of the rotated image, find where it came from, by
     // performing an inverse rotation (a rotation of -angle) and getting the
-    // pixel at those coordinates
+    // pixel at those coordinates.
+    //
+    // As the source point moves by the same amount for each step along the
+    // row of the rotated image, compute it using floating point arithmetic
+    // only once per row and then step it using fixed point numbers with 32
+    // bits for the fractional part, which is precise enough for any images.
+    const int FRAC_BITS = 32;
+    const wxInt64 ONE = wxInt64(1) << FRAC_BITS;
+    const wxInt64 HALF = ONE / 2;
+
+    const auto toFixed = [ONE](double v)
+    {
+        return static_cast<wxInt64>(floor(v * ONE + 0.5));
+    };
+
+    const wxInt64 step_x = toFixed(cos_angle);
+    const wxInt64 step_y = toFixed(-sin_angle);
 
     const int rH = rotated.GetHeight();
     const int rW = rotated.GetWidth();
@@ -3761,188 +5380,147 @@ wxImage wxImage::Rotate(double angle,
     // only once, instead of repeating it for each pixel.
     if (interpolating)
     {
-        for (int y = 0; y < rH; y++)
+        // The points within this distance from the image border are still
+        // considered to be inside it, using the colour of the nearest pixel.
+        const wxInt64 min_x = -ONE / 4,
+                      min_y = -ONE / 4,
+                      max_x = w*ONE - 3*ONE / 4,
+                      max_y = h*ONE - 3*ONE / 4;
+
+        // Return the integer coordinate of the left (or top) pixel to use for
+        // interpolation and the 8 bit weight of the next one.
+        const auto split = [ONE](wxInt64 v, int size, int& frac)
         {
-            for (int x = 0; x < rW; x++)
+            if ( v <= 0 )
             {
-                wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
-
-                if (-0.25 < src.x && src.x < w - 0.75 &&
-                    -0.25 < src.y && src.y < h - 0.75)
-                {
-                    // interpolate using the 4 enclosing grid-points.  Those
-                    // points can be obtained using floor and ceiling of the
-                    // exact coordinates of the point
-                    int x1, y1, x2, y2;
-
-                    if (0 < src.x && src.x < w - 1)
-                    {
-                        x1 = (int) floor(src.x);
-                        x2 = (int) ceil(src.x);
-                    }
-                    else    // else means that x is near one of the borders (0 or width-1)
-                    {
-                        x1 = x2 = wxRound (src.x);
-                    }
-
-                    if (0 < src.y && src.y < h - 1)
-                    {
-                        y1 = (int) floor(src.y);
-                        y2 = (int) ceil(src.y);
-                    }
-                    else
-                    {
-                        y1 = y2 = wxRound (src.y);
-                    }
-
-                    // get four points and the distances (square of the distance,
-                    // for efficiency reasons) for the interpolation formula
+                frac = 0;
+                return 0;
+            }
 
-                    // GRG: Do not calculate the points until they are
-                    //      really needed -- this way we can calculate
-                    //      just one, instead of four, if d1, d2, d3
-                    //      or d4 are < wxROTATE_EPSILON
+            if ( v >= (size - 1)*ONE )
+            {
+                frac = 0;
+                return size - 1;
+            }
 
-                    const double d1 = (src.x - x1) * (src.x - x1) + (src.y - y1) * (src.y - y1);
-                    const double d2 = (src.x - x2) * (src.x - x2) + (src.y - y1) * (src.y - y1);
-                    const double d3 = (src.x - x2) * (src.x - x2) + (src.y - y2) * (src.y - y2);
-                    const double d4 = (src.x - x1) * (src.x - x1) + (src.y - y2) * (src.y - y2);
+            frac = static_cast<int>((v >> (FRAC_BITS - 8)) & 0xff);
+            return static_cast<int>(v >> FRAC_BITS);
+        };
 
-                    // Now interpolate as a weighted average of the four surrounding
-                    // points, where the weights are the distances to each of those points
+        ForEachImageBand(rH, rW, [&](int from, int to)
+        {
+            for (int y = from; y < to; y++)
+            {
+                const wxRealPoint start = wxRotatePoint(x1a, y + y1a,
+                                                        cos_angle, -sin_angle,
+                                                        p0);
+                wxInt64 sx = toFixed(start.x);
+                wxInt64 sy = toFixed(start.y);
 
-                    // If the point is exactly at one point of the grid of the source
-                    // image, then don't interpolate -- just assign the pixel
+                unsigned char* dst = dst_data + 3*size_t(rW)*y;
+                unsigned char* alpha_dst = dst_alpha ? dst_alpha + size_t(rW)*y
+                                                     : nullptr;
 
-                    // d1,d2,d3,d4 are positive -- no need for abs()
-                    if (d1 < wxROTATE_EPSILON)
+                for (int x = 0; x < rW; x++, sx += step_x, sy += step_y)
+                {
+                    if (sx <= min_x || sx >= max_x || sy <= min_y || sy >= max_y)
                     {
-                        unsigned char *p = data[y1] + (3 * x1);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                        *(dst++) = blank_r;
+                        *(dst++) = blank_g;
+                        *(dst++) = blank_b;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y1] + x1);
-                    }
-                    else if (d2 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y1] + (3 * x2);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                        if (alpha_dst)
+                            *(alpha_dst++) = 0;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y1] + x2);
+                        continue;
                     }
-                    else if (d3 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y2] + (3 * x2);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y2] + x2);
-                    }
-                    else if (d4 < wxROTATE_EPSILON)
+                    // Use bilinear interpolation between the 4 enclosing grid
+                    // points, with 8 bit weights whose sum is 2^16.
+                    int fx, fy;
+                    const int x1 = split(sx, w, fx);
+                    const int y1 = split(sy, h, fy);
+                    const int x2 = x1 < w - 1 ? x1 + 1 : x1;
+                    const int y2 = y1 < h - 1 ? y1 + 1 : y1;
+
+                    const unsigned w11 = (256 - fx)*(256 - fy),
+                                   w21 = fx*(256 - fy),
+                                   w12 = (256 - fx)*fy,
+                                   w22 = fx*fy;
+
+                    const unsigned char* const v11 = src_data + 3*(size_t(y1)*w + x1);
+                    const unsigned char* const v21 = src_data + 3*(size_t(y1)*w + x2);
+                    const unsigned char* const v12 = src_data + 3*(size_t(y2)*w + x1);
+                    const unsigned char* const v22 = src_data + 3*(size_t(y2)*w + x2);
+
+                    for (int c = 0; c < 3; c++)
                     {
-                        unsigned char *p = data[y2] + (3 * x1);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
-
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y2] + x1);
+                        *(dst++) = static_cast<unsigned char>
+                            ((w11*v11[c] + w21*v21[c] + w12*v12[c] + w22*v22[c]
+                              + 0x8000) >> 16);
                     }
-                    else
+
+                    if (alpha_dst)
                     {
-                        // weights for the weighted average are proportional to the inverse of the distance
-                        unsigned char *v1 = data[y1] + (3 * x1);
-                        unsigned char *v2 = data[y1] + (3 * x2);
-                        unsigned char *v3 = data[y2] + (3 * x2);
-                        unsigned char *v4 = data[y2] + (3 * x1);
-
-                        const double w1 = 1/d1, w2 = 1/d2, w3 = 1/d3, w4 = 1/d4;
-
-                        // GRG: Unrolled.
-
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *(v1++) + w2 * *(v2++) +
-                               w3 * *(v3++) + w4 * *(v4++)) /
-                              (w1 + w2 + w3 + w4) );
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *(v1++) + w2 * *(v2++) +
-                               w3 * *(v3++) + w4 * *(v4++)) /
-                              (w1 + w2 + w3 + w4) );
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *v1 + w2 * *v2 +
-                               w3 * *v3 + w4 * *v4) /
-                              (w1 + w2 + w3 + w4) );
-
-                        if (has_alpha)
-                        {
-                            v1 = alpha[y1] + (x1);
-                            v2 = alpha[y1] + (x2);
-                            v3 = alpha[y2] + (x2);
-                            v4 = alpha[y2] + (x1);
-
-                            *(alpha_dst++) = (unsigned char)
-                                ( (w1 * *v1 + w2 * *v2 +
-                                   w3 * *v3 + w4 * *v4) /
-                                  (w1 + w2 + w3 + w4) );
-                        }
-                    }
-                }
-                else
-                {
-                    *(dst++) = blank_r;
-                    *(dst++) = blank_g;
-                    *(dst++) = blank_b;
+                        const unsigned char* const a1 = src_alpha + size_t(y1)*w;
+                        const unsigned char* const a2 = src_alpha + size_t(y2)*w;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = 0;
+                        *(alpha_dst++) = static_cast<unsigned char>
+                            ((w11*a1[x1] + w21*a1[x2] + w12*a2[x1] + w22*a2[x2]
+                              + 0x8000) >> 16);
+                    }
                 }
             }
-        }
+        });
     }
     else // not interpolating
     {
-        for (int y = 0; y < rH; y++)
+        ForEachImageBand(rH, rW, [&](int from, int to)
         {
-            for (int x = 0; x < rW; x++)
+            for (int y = from; y < to; y++)
             {
-                wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
+                const wxRealPoint start = wxRotatePoint(x1a, y + y1a,
+                                                        cos_angle, -sin_angle,
+                                                        p0);
+                wxInt64 sx = toFixed(start.x);
+                wxInt64 sy = toFixed(start.y);
 
-                const int xs = wxRound (src.x);      // wxRound rounds to the
-                const int ys = wxRound (src.y);      // closest integer
+                unsigned char* dst = dst_data + 3*size_t(rW)*y;
+                unsigned char* alpha_dst = dst_alpha ? dst_alpha + size_t(rW)*y
+                                                     : nullptr;
 
-                if (0 <= xs && xs < w && 0 <= ys && ys < h)
+                for (int x = 0; x < rW; x++, sx += step_x, sy += step_y)
                 {
-                    unsigned char *p = data[ys] + (3 * xs);
-                    *(dst++) = *(p++);
-                    *(dst++) = *(p++);
-                    *(dst++) = *p;
+                    // Round to the closest pixel: notice that -0.5 must be
+                    // rounded down, i.e. outside of the image.
+                    const int xs = sx > -HALF ? int((sx + HALF) >> FRAC_BITS) : -1;
+                    const int ys = sy > -HALF ? int((sy + HALF) >> FRAC_BITS) : -1;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = *(alpha[ys] + (xs));
-                }
-                else
-                {
-                    *(dst++) = blank_r;
-                    *(dst++) = blank_g;
-                    *(dst++) = blank_b;
+                    if (0 <= xs && xs < w && 0 <= ys && ys < h)
+                    {
+                        const size_t offset = size_t(ys)*w + xs;
+                        const unsigned char *p = src_data + 3*offset;
+                        *(dst++) = *(p++);
+                        *(dst++) = *(p++);
+                        *(dst++) = *p;
+
+                        if (alpha_dst)
+                            *(alpha_dst++) = src_alpha[offset];
+                    }
+                    else
+                    {
+                        *(dst++) = blank_r;
+                        *(dst++) = blank_g;
+                        *(dst++) = blank_b;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = 255;
+                        if (alpha_dst)
+                            *(alpha_dst++) = 255;
+                    }
                 }
             }
-        }
+        });
     }
 
-    delete [] data;
-    delete [] alpha;
-
     return rotated;
 }
 
@@ -3952,13 +5530,17 @@ void wxImage::ApplyToAllPixels(const F& func)
 {
     AllocExclusive();
 
-    const size_t size = GetWidth() * GetHeight();
-    unsigned char *data = GetData();
+    const size_t width = GetWidth();
+    unsigned char* const data = GetData();
 
-    for ( size_t i = 0; i < size; i++, data += 3 )
+    ForEachImageBand(GetHeight(), width, [=, &func](int from, int to)
     {
-        func(data);
-    }
+        const size_t end = to*width*3;
+        for ( size_t i = from*width*3; i < end; i += 3 )
+        {
+            func(data + i);
+        }
+    });
 }
 
 // A module to allow wxImage initialization/cleanup
@@ -3969,9 +5551,23 @@ class wxImageModule: public wxModule
 {
     wxDECLARE_DYNAMIC_CLASS(wxImageModule);
 public:
-    wxImageModule() {}
+    wxImageModule()
+    {
+#if wxUSE_THREADS
+        // We need to stop our worker threads before wxThreadModule cleanup.
+        AddDependency("wxThreadModule");
+#endif // wxUSE_THREADS
+    }
+
     bool OnInit() override { wxImage::InitStandardHandlers(); return true; }
-    void OnExit() override { wxImage::CleanUpHandlers(); }
+    void OnExit() override
+    {
+        wxImage::CleanUpHandlers();
+
+#if wxUSE_THREADS
+        ImageWorkerPool::Cleanup();
+#endif // wxUSE_THREADS
+    }
 };
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxImageModule, wxModule);
@@ -40,6 +40,8 @@
 #include "wx/filefn.h"
 #include "wx/wfstream.h"
 
+#include "wx/private/image.h"
+
 // For memcpy
 #include <string.h>
 // For JPEG library error handling
@@ -224,6 +226,42 @@ static inline void wx_cmyk_to_rgb(unsigned char* rgb, const unsigned char* cmyk)
     rgb[2] = (unsigned char)((c > 255) ? 0 : (255 - c));
 }
 
+// select the output colour space for the image, return the number of bytes
+// per pixel in it
+static int wx_jpeg_set_out_color_space( j_decompress_ptr cinfo )
+{
+    if ((cinfo->out_color_space == JCS_CMYK) || (cinfo->out_color_space == JCS_YCCK))
+    {
+        cinfo->out_color_space = JCS_CMYK;
+        return 4;
+    }
+    else // all the rest is treated as RGB
+    {
+        cinfo->out_color_space = JCS_RGB;
+        return 3;
+    }
+}
+
+// copy the scanline in the output colour space to RGB data
+static void
+wx_jpeg_copy_scanline( j_decompress_ptr cinfo, unsigned char* ptr, const JSAMPLE* line )
+{
+    if (cinfo->out_color_space == JCS_RGB)
+    {
+        memcpy( ptr, line, cinfo->output_width * 3 );
+    }
+    else // CMYK
+    {
+        const unsigned char* inptr = (const unsigned char*) line;
+        for (size_t i = 0; i < cinfo->output_width; i++)
+        {
+            wx_cmyk_to_rgb(ptr, inptr);
+            ptr += 3;
+            inptr += 4;
+        }
+    }
+}
+
 // temporarily disable the warning C4611 (interaction between '_setjmp' and
 // C++ object destruction is non-portable) - I don't see any dtors here
 #ifdef __VISUALC__
@@ -268,26 +306,27 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     wx_jpeg_io_src( &cinfo, stream );
     jpeg_read_header( &cinfo, TRUE );
 
-    int bytesPerPixel;
-    if ((cinfo.out_color_space == JCS_CMYK) || (cinfo.out_color_space == JCS_YCCK))
-    {
-        cinfo.out_color_space = JCS_CMYK;
-        bytesPerPixel = 4;
-    }
-    else // all the rest is treated as RGB
-    {
-        cinfo.out_color_space = JCS_RGB;
-        bytesPerPixel = 3;
-    }
+    const int bytesPerPixel = wx_jpeg_set_out_color_space(&cinfo);
 
-    // scale the picture to fit in the specified max size if necessary
+    // scale the picture down during decompression if it needs to fit in the
+    // specified max size: use the biggest reduction factor, out of those
+    // supported by libjpeg, still resulting in the image at least as big as
+    // the final size, wxImage::LoadFile() will scale it down to it later
     if ( maxWidth > 0 || maxHeight > 0 )
     {
-        unsigned& scale = cinfo.scale_denom;
-        while ( (maxWidth && (cinfo.image_width / scale > maxWidth)) ||
-                    (maxHeight && (cinfo.image_height / scale > maxHeight)) )
+        const wxSize size = wxGetImageLoadSize(wxSize(cinfo.image_width,
+                                                      cinfo.image_height),
+                                               maxWidth, maxHeight);
+        if ( size.x < (int)cinfo.image_width || size.y < (int)cinfo.image_height )
         {
-            scale *= 2;
+            cinfo.scale_denom = 8;
+            for ( cinfo.scale_num = 1; cinfo.scale_num < 8; cinfo.scale_num++ )
+            {
+                jpeg_calc_output_dimensions( &cinfo );
+                if ( (int)cinfo.output_width >= size.x &&
+                        (int)cinfo.output_height >= size.y )
+                    break;
+            }
         }
     }
 
@@ -309,21 +348,8 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     while ( cinfo.output_scanline < cinfo.output_height )
     {
         jpeg_read_scanlines( &cinfo, tempbuf, 1 );
-        if (cinfo.out_color_space == JCS_RGB)
-        {
-            memcpy( ptr, tempbuf[0], stride );
-            ptr += stride;
-        }
-        else // CMYK
-        {
-            const unsigned char* inptr = (const unsigned char*) tempbuf[0];
-            for (size_t i = 0; i < cinfo.output_width; i++)
-            {
-                wx_cmyk_to_rgb(ptr, inptr);
-                ptr += 3;
-                inptr += 4;
-            }
-        }
+        wx_jpeg_copy_scanline( &cinfo, ptr, tempbuf[0] );
+        ptr += cinfo.output_width * 3;
     }
 
     // set up resolution if available: it's part of optional JFIF APP0 chunk
@@ -349,6 +375,131 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+namespace
+{
+
+// Reader returning JPEG image rows as they are decoded.
+class wxJPEGRowReader : public wxImageRowReader
+{
+public:
+    explicit wxJPEGRowReader(bool verbose)
+    {
+        m_cinfo.err = jpeg_std_error( &m_jerr );
+        m_jerr.error_exit = wx_error_exit;
+
+        if (!verbose)
+            m_cinfo.err->output_message = wx_ignore_message;
+    }
+
+    ~wxJPEGRowReader()
+    {
+        if ( m_created )
+        {
+            // Don't use jpeg_finish_decompress() here as it would fail if not
+            // all lines were read, but we still need to free our buffer.
+            if ( m_cinfo.src )
+                (m_cinfo.src->term_source)(&m_cinfo);
+            jpeg_destroy_decompress( &m_cinfo );
+        }
+    }
+
+    // Read the image header and prepare for decompressing it.
+    bool Init(wxInputStream& stream);
+
+protected:
+    virtual bool DoReadRows(unsigned char* data,
+                            unsigned char* alpha,
+                            int numRows) override;
+
+private:
+    struct jpeg_decompress_struct m_cinfo;
+    wx_error_mgr m_jerr;
+    bool m_created = false;
+
+    // Used for CMYK images only, RGB ones are decoded directly into the
+    // output buffer.
+    JSAMPARRAY m_cmykbuf = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(wxJPEGRowReader);
+};
+
+bool wxJPEGRowReader::Init(wxInputStream& stream)
+{
+    if (setjmp(m_jerr.setjmp_buffer))
+        return false;
+
+    jpeg_create_decompress( &m_cinfo );
+    m_created = true;
+
+    wx_jpeg_io_src( &m_cinfo, stream );
+    jpeg_read_header( &m_cinfo, TRUE );
+
+    const int bytesPerPixel = wx_jpeg_set_out_color_space(&m_cinfo);
+
+    jpeg_start_decompress( &m_cinfo );
+
+    if ( bytesPerPixel != 3 )
+    {
+        m_cmykbuf = (*m_cinfo.mem->alloc_sarray)
+                        ((j_common_ptr) &m_cinfo, JPOOL_IMAGE,
+                         m_cinfo.output_width * bytesPerPixel, 1 );
+    }
+
+    SetImageInfo(m_cinfo.output_width, m_cinfo.output_height, false);
+
+    return true;
+}
+
+bool
+wxJPEGRowReader::DoReadRows(unsigned char* data,
+                            unsigned char* WXUNUSED(alpha),
+                            int numRows)
+{
+    if (setjmp(m_jerr.setjmp_buffer))
+        return false;
+
+    const size_t stride = m_cinfo.output_width * 3;
+    for ( int n = 0; n < numRows; n++ )
+    {
+        unsigned char* const ptr = data + n * stride;
+
+        if ( m_cmykbuf )
+        {
+            jpeg_read_scanlines( &m_cinfo, m_cmykbuf, 1 );
+            wx_jpeg_copy_scanline( &m_cinfo, ptr, m_cmykbuf[0] );
+        }
+        else
+        {
+            JSAMPROW row = ptr;
+            jpeg_read_scanlines( &m_cinfo, &row, 1 );
+        }
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+wxImageRowReader*
+wxJPEGHandler::CreateRowReader(wxInputStream& stream,
+                               bool verbose,
+                               int WXUNUSED(index))
+{
+    wxJPEGRowReader* const reader = new wxJPEGRowReader(verbose);
+    if ( !reader->Init(stream) )
+    {
+        if (verbose)
+        {
+            wxLogError(_("JPEG: Couldn't load - file is probably corrupted."));
+        }
+
+        delete reader;
+        return nullptr;
+    }
+
+    return reader;
+}
+
 typedef struct {
     struct jpeg_destination_mgr pub;
 
@@ -30,6 +30,8 @@
     #include "wx/stream.h"
 #endif
 
+#include "wx/vector.h"
+
 #include "png.h"
 
 // For memcpy
@@ -486,6 +488,203 @@ wxPNGHandler::LoadFile(wxImage *image,
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// reading PNGs incrementally
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class wxPNGRowReader : public wxImageRowReader
+{
+public:
+    wxPNGRowReader(wxInputStream& stream, bool verbose)
+    {
+        m_wxinfo.verbose = verbose;
+        m_wxinfo.stream.in = &stream;
+    }
+
+    ~wxPNGRowReader()
+    {
+        if ( m_png_ptr )
+        {
+            png_destroy_read_struct( &m_png_ptr,
+                                     m_info_ptr ? &m_info_ptr : (png_infopp) nullptr,
+                                     (png_infopp) nullptr );
+        }
+    }
+
+    // Read the image header, must be called, and succeed, before using this
+    // object.
+    bool Init();
+
+protected:
+    virtual bool DoReadRows(unsigned char* data,
+                            unsigned char* alpha,
+                            int numRows) override;
+
+private:
+    wxPNGInfoStruct m_wxinfo;
+    png_structp m_png_ptr = nullptr;
+    png_infop m_info_ptr = nullptr;
+
+    // Buffer for a single RGBA row if the image has alpha, or for the entire
+    // image in RGB or RGBA format if it's interlaced, as libpng can only
+    // return its rows after reading all of them in this case.
+    wxVector<unsigned char> m_buf;
+    wxVector<png_bytep> m_lines;
+    bool m_interlaced = false;
+    bool m_readAll = false;
+
+    wxDECLARE_NO_COPY_CLASS(wxPNGRowReader);
+};
+
+bool wxPNGRowReader::Init()
+{
+    m_png_ptr = png_create_read_struct
+                (
+                    PNG_LIBPNG_VER_STRING,
+                    nullptr,
+                    wx_PNG_error,
+                    wx_PNG_warning
+                );
+    if ( !m_png_ptr )
+        return false;
+
+    // NB: please see the comment near wxPNGInfoStruct declaration for
+    //     explanation why this line is mandatory
+    png_set_read_fn( m_png_ptr, &m_wxinfo, wx_PNG_stream_reader );
+
+    m_info_ptr = png_create_info_struct( m_png_ptr );
+    if ( !m_info_ptr )
+        return false;
+
+    if ( setjmp(m_wxinfo.jmpbuf) )
+        return false;
+
+    png_read_info( m_png_ptr, m_info_ptr );
+
+    png_uint_32 width, height;
+    int bit_depth, color_type;
+    png_get_IHDR( m_png_ptr, m_info_ptr, &width, &height, &bit_depth, &color_type,
+                  nullptr, nullptr, nullptr );
+
+    // Use the same transformations as DoLoadPNGFile().
+    png_set_expand( m_png_ptr );
+    png_set_gray_to_rgb( m_png_ptr );
+    png_set_strip_16( m_png_ptr );
+    png_set_packing( m_png_ptr );
+
+    m_interlaced = png_set_interlace_handling( m_png_ptr ) > 1;
+
+    png_read_update_info( m_png_ptr, m_info_ptr );
+
+    const bool hasAlpha =
+        (color_type & PNG_COLOR_MASK_ALPHA) ||
+        png_get_valid(m_png_ptr, m_info_ptr, PNG_INFO_tRNS);
+
+    const size_t rowSize = png_get_rowbytes( m_png_ptr, m_info_ptr );
+    if ( rowSize != width*(hasAlpha ? 4 : 3) )
+        return false;
+
+    if ( m_interlaced )
+    {
+        m_buf.resize(rowSize*height);
+        m_lines.resize(height);
+        for ( png_uint_32 y = 0; y < height; y++ )
+            m_lines[y] = &m_buf[y*rowSize];
+    }
+    else if ( hasAlpha )
+        m_buf.resize(rowSize);
+
+    SetImageInfo(static_cast<int>(width), static_cast<int>(height), hasAlpha);
+
+    return true;
+}
+
+bool
+wxPNGRowReader::DoReadRows(unsigned char* data, unsigned char* alpha, int numRows)
+{
+    if ( setjmp(m_wxinfo.jmpbuf) )
+        return false;
+
+    const int width = GetWidth();
+    const size_t rowSize = width*(HasAlpha() ? 4 : 3);
+
+    if ( m_interlaced && !m_readAll )
+    {
+        png_read_image( m_png_ptr, &m_lines[0] );
+
+        m_readAll = true;
+    }
+
+    for ( int n = 0; n < numRows; n++ )
+    {
+        unsigned char* const dst = data + static_cast<size_t>(n)*width*3;
+
+        const unsigned char* src;
+        if ( m_interlaced )
+        {
+            src = &m_buf[(GetCurrentRow() + n)*rowSize];
+        }
+        else if ( HasAlpha() )
+        {
+            png_read_row( m_png_ptr, &m_buf[0], nullptr );
+            src = &m_buf[0];
+        }
+        else // Read RGB data directly into the output buffer.
+        {
+            png_read_row( m_png_ptr, dst, nullptr );
+            continue;
+        }
+
+        if ( HasAlpha() )
+        {
+            unsigned char* ptrDst = dst;
+            unsigned char* ptrAlpha = alpha ? alpha + static_cast<size_t>(n)*width
+                                            : nullptr;
+            for ( int x = 0; x < width; x++ )
+            {
+                *ptrDst++ = *src++;
+                *ptrDst++ = *src++;
+                *ptrDst++ = *src++;
+
+                if ( ptrAlpha )
+                    *ptrAlpha++ = *src;
+                src++;
+            }
+        }
+        else
+        {
+            memcpy(dst, src, rowSize);
+        }
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+wxImageRowReader*
+wxPNGHandler::CreateRowReader(wxInputStream& stream,
+                              bool verbose,
+                              int WXUNUSED(index))
+{
+    wxPNGRowReader* const reader = new wxPNGRowReader(stream, verbose);
+    if ( !reader->Init() )
+    {
+        if ( verbose )
+        {
+           wxLogError(_("Couldn't load a PNG image - file is corrupted or not enough memory."));
+        }
+
+        delete reader;
+        return nullptr;
+    }
+
+    return reader;
+}
+
 // ----------------------------------------------------------------------------
 // SaveFile() palette helpers
 // ----------------------------------------------------------------------------
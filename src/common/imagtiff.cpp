@@ -288,6 +288,117 @@ TIFFwxOpen(wxOutputStream &stream, const char* name, const char* mode)
     return tif;
 }
 
+namespace
+{
+
+// Parameters of the TIFF image which determine how it can be decoded.
+struct wxTIFFImageInfo
+{
+    wxTIFFImageInfo() = default;
+    explicit wxTIFFImageInfo(TIFF* tif);
+
+    // Return true if the image needs to be read line by line using
+    // ConvertGreyAlphaScanline() instead of TIFFRGBAImage functions.
+    bool NeedsGreyAlphaScanlines(TIFF* tif) const;
+
+    wxUint32 width = 0,
+             height = 0;
+    wxUint16 samplesPerPixel = 0,
+             bitsPerSample = 0,
+             extraSamples = 0,
+             photometric = PHOTOMETRIC_MINISWHITE,
+             planarConfig = PLANARCONFIG_CONTIG;
+    bool hasAlpha = false;
+};
+
+wxTIFFImageInfo::wxTIFFImageInfo(TIFF* tif)
+{
+    TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &width );
+    TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &height );
+
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
+
+    wxUint16* samplesInfo;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_EXTRASAMPLES,
+                          &extraSamples, &samplesInfo);
+
+    (void) TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
+
+    hasAlpha = (extraSamples >= 1
+        && ((samplesInfo[0] == EXTRASAMPLE_UNSPECIFIED)
+            || samplesInfo[0] == EXTRASAMPLE_ASSOCALPHA
+            || samplesInfo[0] == EXTRASAMPLE_UNASSALPHA))
+        || (extraSamples == 0 && samplesPerPixel == 4
+            && photometric == PHOTOMETRIC_RGB);
+
+    (void) TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarConfig);
+}
+
+bool wxTIFFImageInfo::NeedsGreyAlphaScanlines(TIFF* tif) const
+{
+    if ( planarConfig != PLANARCONFIG_CONTIG || samplesPerPixel != 2
+            || extraSamples != 1 )
+        return false;
+
+    char msg[1024] = "";
+    return !TIFFRGBAImageOK(tif, msg) || bitsPerSample == 8;
+}
+
+/*
+Decode a line of 8 bit greyscale or 1 bit black and white image with alpha
+to ABGR format as that is what the code, that converts to wxImage, later on
+expects (normally TIFFRGBAImage functions are used to decode which use an ABGR
+layout).
+*/
+void
+ConvertGreyAlphaScanline(const wxTIFFImageInfo& info,
+                         const unsigned char* buf,
+                         wxUint32* raster)
+{
+    const bool minIsWhite = (info.photometric == PHOTOMETRIC_MINISWHITE);
+    const int minValue =  minIsWhite ? 255 : 0;
+    const int maxValue = 255 - minValue;
+
+    if (info.bitsPerSample == 8)
+    {
+        for (wxUint32 x = 0; x < info.width; ++x)
+        {
+            wxUint8 val = minIsWhite ? 255 - buf[x*2] : buf[x*2];
+            wxUint8 alpha = minIsWhite ? 255 - buf[x*2+1] : buf[x*2+1];
+            *raster++ = val + (val << 8) + (val << 16) + (alpha << 24);
+        }
+    }
+    else
+    {
+        for (wxUint32 x = 0; x < info.width; ++x)
+        {
+            int mask = buf[x*2/8] << ((x*2)%8);
+
+            wxUint8 val = mask & 128 ? maxValue : minValue;
+            *raster++ = val + (val << 8) + (val << 16)
+                + ((mask & 64 ? maxValue : minValue) << 24);
+        }
+    }
+}
+
+// Copy the pixels in ABGR format to wxImage RGB data and alpha, if non-null.
+void
+CopyRasterToImage(const wxUint32* raster, size_t numPixels,
+                  unsigned char* ptr, unsigned char* alpha)
+{
+    for (size_t pos = 0; pos < numPixels; pos++)
+    {
+        *(ptr++) = (unsigned char)TIFFGetR(raster[pos]);
+        *(ptr++) = (unsigned char)TIFFGetG(raster[pos]);
+        *(ptr++) = (unsigned char)TIFFGetB(raster[pos]);
+        if ( alpha )
+            *(alpha++) = (unsigned char)TIFFGetA(raster[pos]);
+    }
+}
+
+} // anonymous namespace
+
 bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int index )
 {
     if (index == -1)
@@ -319,34 +430,12 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         return false;
     }
 
-    wxUint32 w, h;
-    wxUint32 *raster;
-
-    TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &w );
-    TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &h );
-
-    wxUint16 samplesPerPixel = 0;
-    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
-
-    wxUint16 bitsPerSample = 0;
-    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
-
-    wxUint16 extraSamples;
-    wxUint16* samplesInfo;
-    TIFFGetFieldDefaulted(tif, TIFFTAG_EXTRASAMPLES,
-                          &extraSamples, &samplesInfo);
+    const wxTIFFImageInfo info(tif);
+    const wxUint32 w = info.width,
+                   h = info.height;
+    const bool hasAlpha = info.hasAlpha;
 
-    wxUint16 photometric;
-    if (!TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric))
-    {
-        photometric = PHOTOMETRIC_MINISWHITE;
-    }
-    const bool hasAlpha = (extraSamples >= 1
-        && ((samplesInfo[0] == EXTRASAMPLE_UNSPECIFIED)
-            || samplesInfo[0] == EXTRASAMPLE_ASSOCALPHA
-            || samplesInfo[0] == EXTRASAMPLE_UNASSALPHA))
-        || (extraSamples == 0 && samplesPerPixel == 4
-            && photometric == PHOTOMETRIC_RGB);
+    wxUint32 *raster;
 
     // guard against integer overflow during multiplication which could result
     // in allocating a too small buffer and then overflowing it
@@ -394,34 +483,11 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     if ( hasAlpha )
         image->SetAlpha();
 
-    wxUint16 planarConfig = PLANARCONFIG_CONTIG;
-    (void) TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarConfig);
-
     bool ok = true;
-    char msg[1024] = "";
-    if
-    (
-        (planarConfig == PLANARCONFIG_CONTIG && samplesPerPixel == 2
-            && extraSamples == 1)
-        &&
-        (
-            ( !TIFFRGBAImageOK(tif, msg) )
-            || (bitsPerSample == 8)
-        )
-    )
+    if ( info.NeedsGreyAlphaScanlines(tif) )
     {
-        const bool isGreyScale = (bitsPerSample == 8);
         unsigned char *buf = (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tif));
-        wxUint32 pos = 0;
-        const bool minIsWhite = (photometric == PHOTOMETRIC_MINISWHITE);
-        const int minValue =  minIsWhite ? 255 : 0;
-        const int maxValue = 255 - minValue;
 
-        /*
-        Decode to ABGR format as that is what the code, that converts to
-        wxImage, later on expects (normally TIFFReadRGBAImageOriented is
-        used to decode which uses an ABGR layout).
-        */
         for (wxUint32 y = 0; y < h; ++y)
         {
             if (TIFFReadScanline(tif, buf, y, 0) != 1)
@@ -430,29 +496,7 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
                 break;
             }
 
-            if (isGreyScale)
-            {
-                for (wxUint32 x = 0; x < w; ++x)
-                {
-                    wxUint8 val = minIsWhite ? 255 - buf[x*2] : buf[x*2];
-                    wxUint8 alpha = minIsWhite ? 255 - buf[x*2+1] : buf[x*2+1];
-                    raster[pos] = val + (val << 8) + (val << 16)
-                        + (alpha << 24);
-                    pos++;
-                }
-            }
-            else
-            {
-                for (wxUint32 x = 0; x < w; ++x)
-                {
-                    int mask = buf[x*2/8] << ((x*2)%8);
-
-                    wxUint8 val = mask & 128 ? maxValue : minValue;
-                    raster[pos] = val + (val << 8) + (val << 16)
-                        + ((mask & 64 ? maxValue : minValue) << 24);
-                    pos++;
-                }
-            }
+            ConvertGreyAlphaScanline(info, buf, raster + y*w);
         }
 
         _TIFFfree(buf);
@@ -478,26 +522,11 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         return false;
     }
 
-    unsigned char *ptr = image->GetData();
-
-    unsigned char *alpha = image->GetAlpha();
-
-    wxUint32 pos = 0;
-
-    for (wxUint32 i = 0; i < h; i++)
-    {
-        for (wxUint32 j = 0; j < w; j++)
-        {
-            *(ptr++) = (unsigned char)TIFFGetR(raster[pos]);
-            *(ptr++) = (unsigned char)TIFFGetG(raster[pos]);
-            *(ptr++) = (unsigned char)TIFFGetB(raster[pos]);
-            if ( hasAlpha )
-                *(alpha++) = (unsigned char)TIFFGetA(raster[pos]);
-
-            pos++;
-        }
-    }
+    CopyRasterToImage(raster, (size_t)w*h, image->GetData(), image->GetAlpha());
 
+    const wxUint16 photometric = info.photometric,
+                   samplesPerPixel = info.samplesPerPixel,
+                   bitsPerSample = info.bitsPerSample;
 
     image->SetOption(wxIMAGE_OPTION_TIFF_PHOTOMETRIC, photometric);
 
@@ -580,6 +609,203 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+namespace
+{
+
+// Reader decoding TIFF images one strip or row of tiles at a time.
+class wxTIFFRowReader : public wxImageRowReader
+{
+public:
+    explicit wxTIFFRowReader(bool verbose) : m_verbose(verbose) { }
+
+    ~wxTIFFRowReader()
+    {
+        if ( m_rgbaStarted )
+            TIFFRGBAImageEnd(&m_rgba);
+
+        if ( m_tif )
+            TIFFClose(m_tif);
+    }
+
+    // Open the image with the given index in the stream.
+    bool Init(wxInputStream& stream, int index);
+
+protected:
+    virtual bool DoReadRows(unsigned char* data,
+                            unsigned char* alpha,
+                            int numRows) override;
+
+private:
+    // Decode the chunk of rows starting at the given one into m_raster.
+    bool ReadChunk(wxUint32 row);
+
+    const bool m_verbose;
+
+    TIFF* m_tif = nullptr;
+    wxTIFFImageInfo m_info;
+
+    // Used unless the image needs to be read line by line using
+    // ConvertGreyAlphaScanline().
+    TIFFRGBAImage m_rgba;
+    bool m_rgbaStarted = false;
+
+    // Number of rows decoded at once, this corresponds to the strip or tile
+    // height, as decoding less than that would be inefficient.
+    wxUint32 m_chunkHeight = 1;
+
+    // The decoded rows in ABGR format, as returned by TIFFRGBAImageGet(),
+    // and the range of rows they correspond to.
+    wxVector<wxUint32> m_raster;
+    wxUint32 m_chunkStart = 0,
+             m_chunkRows = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxTIFFRowReader);
+};
+
+bool wxTIFFRowReader::Init(wxInputStream& stream, int index)
+{
+    m_tif = TIFFwxOpen( stream, "image", "r" );
+    if ( !m_tif )
+        return false;
+
+    if ( !TIFFSetDirectory( m_tif, (tdir_t)(index == -1 ? 0 : index) ) )
+        return false;
+
+    m_info = wxTIFFImageInfo(m_tif);
+
+    if ( !m_info.NeedsGreyAlphaScanlines(m_tif) )
+    {
+        char msg[1024] = "";
+        if ( !TIFFRGBAImageOK(m_tif, msg) ||
+                !TIFFRGBAImageBegin(&m_rgba, m_tif, 0, msg) )
+        {
+            if ( m_verbose )
+            {
+                wxLogError( _("TIFF: Error reading image.") );
+            }
+
+            return false;
+        }
+
+        m_rgbaStarted = true;
+        m_rgba.req_orientation = ORIENTATION_TOPLEFT;
+
+        wxUint32 chunkHeight = 0;
+        if ( TIFFIsTiled(m_tif) )
+            TIFFGetField(m_tif, TIFFTAG_TILELENGTH, &chunkHeight);
+        else
+            TIFFGetFieldDefaulted(m_tif, TIFFTAG_ROWSPERSTRIP, &chunkHeight);
+
+        // Images stored in any order other than the default top to bottom
+        // one can't be decoded incrementally, so read them all at once.
+        wxUint16 orientation = ORIENTATION_TOPLEFT;
+        TIFFGetFieldDefaulted(m_tif, TIFFTAG_ORIENTATION, &orientation);
+        if ( orientation != ORIENTATION_TOPLEFT )
+            chunkHeight = m_info.height;
+
+        m_chunkHeight = wxMax(1, wxMin(chunkHeight, m_info.height));
+    }
+
+    // guard against integer overflow, as in LoadFile()
+    const double bytesNeeded = (double)m_info.width * m_chunkHeight * sizeof(wxUint32);
+    if ( bytesNeeded >= wxUINT32_MAX || m_info.height > INT_MAX )
+    {
+        if ( m_verbose )
+        {
+            wxLogError( _("TIFF: Image size is abnormally big.") );
+        }
+
+        return false;
+    }
+
+    m_raster.resize((size_t)m_info.width * m_chunkHeight);
+
+    SetImageInfo((int)m_info.width, (int)m_info.height, m_info.hasAlpha);
+
+    return true;
+}
+
+bool wxTIFFRowReader::ReadChunk(wxUint32 row)
+{
+    m_chunkStart = row;
+    m_chunkRows = wxMin(m_chunkHeight, m_info.height - row);
+
+    if ( !m_rgbaStarted )
+    {
+        wxVector<unsigned char> buf(TIFFScanlineSize(m_tif));
+        for ( wxUint32 n = 0; n < m_chunkRows; n++ )
+        {
+            if ( TIFFReadScanline(m_tif, &buf[0], row + n, 0) != 1 )
+                return false;
+
+            ConvertGreyAlphaScanline(m_info, &buf[0], &m_raster[n*m_info.width]);
+        }
+
+        return true;
+    }
+
+    m_rgba.row_offset = row;
+    m_rgba.col_offset = 0;
+
+    return TIFFRGBAImageGet(&m_rgba, &m_raster[0],
+                            m_info.width, m_chunkRows) != 0;
+}
+
+bool
+wxTIFFRowReader::DoReadRows(unsigned char* data, unsigned char* alpha, int numRows)
+{
+    const size_t width = m_info.width;
+
+    for ( int done = 0; done < numRows; )
+    {
+        const wxUint32 row = GetCurrentRow() + done;
+        if ( row >= m_chunkStart + m_chunkRows )
+        {
+            if ( !ReadChunk(row) )
+            {
+                if ( m_verbose )
+                {
+                    wxLogError( _("TIFF: Error reading image.") );
+                }
+
+                return false;
+            }
+        }
+
+        const int count = wxMin(numRows - done,
+                                (int)(m_chunkStart + m_chunkRows - row));
+
+        CopyRasterToImage(&m_raster[(row - m_chunkStart)*width],
+                          count*width,
+                          data + done*width*3,
+                          alpha ? alpha + done*width : nullptr);
+
+        done += count;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+wxImageRowReader*
+wxTIFFHandler::CreateRowReader( wxInputStream& stream, bool verbose, int index )
+{
+    wxTIFFRowReader* const reader = new wxTIFFRowReader(verbose);
+    if ( !reader->Init(stream, index) )
+    {
+        if ( verbose )
+        {
+            wxLogError( _("TIFF: Error loading image.") );
+        }
+
+        delete reader;
+        return nullptr;
+    }
+
+    return reader;
+}
+
 int wxTIFFHandler::DoGetImageCount( wxInputStream& stream )
 {
     TIFF *tif = TIFFwxOpen( stream, "image", "r" );
@@ -49,6 +49,17 @@
 
 #include <stdlib.h>
 
+#include <atomic>
+
+#if wxUSE_THREADS
+    #include <chrono>
+    #include <condition_variable>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+#endif // wxUSE_THREADS
+
 #if defined(__WINDOWS__)
     // This header includes <windows.h> and declares wxMSWFormatMessage().
     #include "wx/msw/private.h"
@@ -99,10 +110,17 @@ WX_DEFINE_LOG_CS(TraceMask);
 // and this one is used for GetComponentLevels()
 WX_DEFINE_LOG_CS(Levels);
 
+// this one protects gs_prevLog which may be accessed from several threads at
+// once when the active log target is thread-safe
+WX_DEFINE_LOG_CS(PreviousLog);
+
 thread_local wxLog* wxPerThreadLogger = nullptr;
 
 thread_local bool wxPerThreadLoggingDisabled = false;
 
+// true in the thread used by wxLogAsync to output the messages
+thread_local bool wxInAsyncLogSink = false;
+
 } // anonymous namespace
 
 #endif // wxUSE_THREADS
@@ -148,8 +166,38 @@ struct PreviousLogInfo
     unsigned numRepeated;
 };
 
+// NB: all accesses to it must be protected by GetPreviousLogCS()
 PreviousLogInfo gs_prevLog;
 
+// return the message used to indicate that the previous one was repeated
+wxString GetRepeatedMessage(unsigned numRepeated)
+{
+    wxString msg;
+#if wxUSE_INTL
+    if ( numRepeated == 1 )
+    {
+        // We use a separate message for this case as "repeated 1 time"
+        // looks somewhat strange.
+        msg = _("The previous message repeated once.");
+    }
+    else
+    {
+        // Notice that we still use wxPLURAL() to ensure that multiple
+        // numbers of times are correctly formatted, even though we never
+        // actually use the singular string.
+        msg.Printf(wxPLURAL("The previous message repeated %u time.",
+                            "The previous message repeated %u times.",
+                            numRepeated),
+                   numRepeated);
+    }
+#else
+    msg.Printf(wxS("The previous message was repeated %u time(s)."),
+               numRepeated);
+#endif
+
+    return msg;
+}
+
 
 // map containing all components for which log level was explicitly set
 //
@@ -162,6 +210,11 @@ inline ComponentLevelsMap& GetComponentLevels()
     return s_componentLevels;
 }
 
+// set to true when the map above becomes non-empty for the first time, this
+// allows GetComponentLevel() to avoid locking in the common case when it's
+// never used
+std::atomic<bool> gs_hasComponentLevels{false};
+
 } // anonymous namespace
 
 // ============================================================================
@@ -271,44 +324,32 @@ wxLogFormatter::FormatTimeMS(wxLongLong_t msec) const
 
 unsigned wxLog::LogLastRepeatIfNeeded()
 {
-    const unsigned count = gs_prevLog.numRepeated;
-
-    if ( gs_prevLog.numRepeated )
+    PreviousLogInfo last;
     {
-        wxString msg;
-#if wxUSE_INTL
-        if ( gs_prevLog.numRepeated == 1 )
-        {
-            // We use a separate message for this case as "repeated 1 time"
-            // looks somewhat strange.
-            msg = _("The previous message repeated once.");
-        }
-        else
-        {
-            // Notice that we still use wxPLURAL() to ensure that multiple
-            // numbers of times are correctly formatted, even though we never
-            // actually use the singular string.
-            msg.Printf(wxPLURAL("The previous message repeated %u time.",
-                                "The previous message repeated %u times.",
-                                gs_prevLog.numRepeated),
-                       gs_prevLog.numRepeated);
-        }
-#else
-        msg.Printf(wxS("The previous message was repeated %u time(s)."),
-                   gs_prevLog.numRepeated);
-#endif
+        wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
+
+        if ( !gs_prevLog.numRepeated )
+            return 0;
+
+        last = gs_prevLog;
+
         gs_prevLog.numRepeated = 0;
         gs_prevLog.msg.clear();
-        DoLogRecord(gs_prevLog.level, msg, gs_prevLog.info);
     }
 
-    return count;
+    // Don't keep the lock while logging, this could deadlock if the target
+    // logs something itself.
+    DoLogRecord(last.level, GetRepeatedMessage(last.numRepeated), last.info);
+
+    return last.numRepeated;
 }
 
 wxLog::~wxLog()
 {
     // Flush() must be called before destroying the object as otherwise some
     // messages could be lost
+    wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
+
     if ( gs_prevLog.numRepeated )
     {
         wxMessageOutputDebug().Printf
@@ -369,6 +410,12 @@ wxLog::OnLog(wxLogLevel level,
     if ( !wxThread::IsMain() )
     {
         logger = wxPerThreadLogger;
+        if ( !logger && ms_pLogger && ms_pLogger->IsThreadSafe() )
+        {
+            // the global logger can be used from this thread directly
+            logger = ms_pLogger;
+        }
+
         if ( !logger )
         {
             if ( ms_pLogger )
@@ -408,21 +455,36 @@ wxLog::CallDoLogNow(wxLogLevel level,
 {
     if ( GetRepetitionCounting() )
     {
-        if ( msg == gs_prevLog.msg )
+        // This function may be called from several threads at once if this
+        // target is thread-safe, so protect the shared state.
+        PreviousLogInfo last;
         {
-            gs_prevLog.numRepeated++;
+            wxCRIT_SECT_LOCKER(lock, GetPreviousLogCS());
 
-            // nothing else to do, in particular, don't log the
-            // repeated message
-            return;
-        }
+            if ( msg == gs_prevLog.msg )
+            {
+                gs_prevLog.numRepeated++;
+
+                // nothing else to do, in particular, don't log the
+                // repeated message
+                return;
+            }
 
-        LogLastRepeatIfNeeded();
+            last = gs_prevLog;
 
-        // reset repetition counter for a new message
-        gs_prevLog.msg = msg;
-        gs_prevLog.level = level;
-        gs_prevLog.info = info;
+            // reset repetition counter for a new message
+            gs_prevLog.msg = msg;
+            gs_prevLog.level = level;
+            gs_prevLog.info = info;
+            gs_prevLog.numRepeated = 0;
+        }
+
+        if ( last.numRepeated )
+        {
+            DoLogRecord(last.level,
+                        GetRepeatedMessage(last.numRepeated),
+                        last.info);
+        }
     }
 
     // handle extra data which may be passed to us by wxLogXXX()
@@ -443,7 +505,11 @@ wxLog::CallDoLogNow(wxLogLevel level,
     }
 #endif // wxUSE_LOG_TRACE
 
-    DoLogRecord(level, prefix + msg + suffix, info);
+    // avoid creating a new string in the common case of no prefix or suffix
+    if ( prefix.empty() && suffix.empty() )
+        DoLogRecord(level, msg, info);
+    else
+        DoLogRecord(level, prefix + msg + suffix, info);
 }
 
 void wxLog::DoLogRecord(wxLogLevel level,
@@ -589,12 +655,19 @@ void wxLog::SetComponentLevel(const wxString& component, wxLogLevel level)
         wxCRIT_SECT_LOCKER(lock, GetLevelsCS());
 
         GetComponentLevels()[component] = level;
+
+        gs_hasComponentLevels.store(true, std::memory_order_release);
     }
 }
 
 /* static */
 wxLogLevel wxLog::GetComponentLevel(const wxString& componentOrig)
 {
+    // this is called for every logging statement, so don't lock anything if
+    // no component levels are used at all
+    if ( !gs_hasComponentLevels.load(std::memory_order_acquire) )
+        return GetLogLevel();
+
     wxCRIT_SECT_LOCKER(lock, GetLevelsCS());
 
     // Make a copy before modifying it in the loop.
@@ -985,6 +1058,527 @@ wxLogInterposerTemp::wxLogInterposerTemp()
     #pragma warning(default:4355)
 #endif // VC++
 
+#if wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// wxLogAsync
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Ring buffer containing the records logged by a single thread and not output
+// yet: it is written to only by this thread and read only by the sink thread,
+// so it doesn't need any locking.
+//
+// The slots are reused, so once the strings in them become big enough, adding
+// the records to the buffer doesn't allocate any memory.
+class AsyncLogRing
+{
+public:
+    AsyncLogRing(wxThreadIdType threadId, size_t size)
+        : m_threadId(threadId),
+          m_slots(size),
+          m_mask(size - 1)
+    {
+    }
+
+    wxThreadIdType GetThreadId() const { return m_threadId; }
+
+    // Called by the producer thread, returns the number of records in the
+    // buffer after adding the new one or 0 if the buffer is full.
+    size_t Push(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t used = tail - m_head.load(std::memory_order_acquire);
+        if ( used == m_slots.size() )
+            return 0;
+
+        Slot& slot = m_slots[tail & m_mask];
+        slot.level = level;
+        slot.msg = msg;
+        slot.info = info;
+
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return used + 1;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_head.load(std::memory_order_relaxed) ==
+                m_tail.load(std::memory_order_acquire);
+    }
+
+    // Called by the producer thread to check if it can push more records.
+    bool IsFull() const
+    {
+        return m_tail.load(std::memory_order_relaxed) -
+                m_head.load(std::memory_order_acquire) == m_slots.size();
+    }
+
+    // Called by the producer thread to check if any of the records it pushed
+    // haven't been flushed yet.
+    bool HasUnflushed() const
+    {
+        return m_tail.load(std::memory_order_relaxed) !=
+                m_flushed.load(std::memory_order_acquire);
+    }
+
+    // Called by the sink thread after flushing the target to remember that
+    // all the records drained from this ring so far have been flushed.
+    void MarkFlushed()
+    {
+        m_flushed.store(m_head.load(std::memory_order_relaxed),
+                        std::memory_order_release);
+    }
+
+    // Called by the sink thread to pass all the records to the given target,
+    // returns true if there were any.
+    bool Drain(wxLog* target)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        if ( head == tail )
+            return false;
+
+        for ( ; head != tail; ++head )
+        {
+            const Slot& slot = m_slots[head & m_mask];
+            target->LogRecord(slot.level, slot.msg, slot.info);
+
+            // Free the slot immediately to let the producer continue if it's
+            // waiting for space in the buffer.
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        wxLogLevel level = 0;
+        wxString msg;
+        wxLogRecordInfo info;
+    };
+
+    const wxThreadIdType m_threadId;
+    std::vector<Slot> m_slots;
+    const size_t m_mask;
+
+    // Keep the indices modified by different threads in different cache
+    // lines to avoid false sharing between them.
+    char m_pad1[64];
+    std::atomic<size_t> m_head{0};
+    char m_pad2[64];
+    std::atomic<size_t> m_tail{0};
+    char m_pad3[64];
+
+    // Value of m_head when the target was flushed the last time.
+    std::atomic<size_t> m_flushed{0};
+
+    wxDECLARE_NO_COPY_CLASS(AsyncLogRing);
+};
+
+// Each wxLogAsync object gets a unique ID used to check whether the ring
+// cached by the current thread belongs to it: we can't use the pointer to the
+// object for this as it could be reused by another object later.
+std::atomic<unsigned> gs_lastAsyncLogId{0};
+
+// The ring used by the current thread is owned by the logger, this per-thread
+// cache only avoids looking it up every time.
+//
+// Notice that this struct must remain trivially destructible because objects
+// with non-trivial destructors can't be used as thread_local variables with
+// MinGW versions before 15 (see UntranslatedStringHolder in translation.cpp).
+struct AsyncLogRingCache
+{
+    unsigned id = 0;
+    AsyncLogRing* ring = nullptr;
+};
+
+thread_local AsyncLogRingCache gs_asyncLogRingCache;
+
+} // anonymous namespace
+
+// Notice that std::thread is used here instead of wxThread because the log
+// target can be (and usually is) destroyed only after wxThreadModule cleanup.
+class wxLogAsyncImpl
+{
+public:
+    wxLogAsyncImpl(wxLog* target, size_t bufferSize)
+        : m_target(target),
+          m_id(++gs_lastAsyncLogId)
+    {
+        // Round up the buffer size to a power of 2 to allow using masking
+        // instead of division for wrapping around.
+        m_bufferSize = 2;
+        while ( m_bufferSize < bufferSize )
+            m_bufferSize *= 2;
+
+        m_thread = std::thread(&wxLogAsyncImpl::SinkLoop, this);
+    }
+
+    ~wxLogAsyncImpl()
+    {
+        m_stop.store(true);
+        Wake();
+
+        m_thread.join();
+
+        delete m_target;
+    }
+
+    wxLog* GetTarget() const { return m_target; }
+
+    void Log(wxLogLevel level, const wxString& msg, const wxLogRecordInfo& info)
+    {
+        if ( wxInAsyncLogSink )
+        {
+            // Don't queue the messages logged by the target itself, this
+            // would deadlock if the buffer were full.
+            m_target->LogRecord(level, msg, info);
+            return;
+        }
+
+        AsyncLogRingCache& cache = gs_asyncLogRingCache;
+        if ( cache.id != m_id )
+            UseRingInCurrentThread(cache);
+
+        AsyncLogRing& ring = *cache.ring;
+
+        size_t used;
+        while ( (used = ring.Push(level, msg, info)) == 0 )
+        {
+            // The buffer is full, wait until the sink thread drains it. This
+            // fence pairs with the one in SinkLoop(): either the sink thread
+            // sees that we're waiting or we see the space freed by it.
+            m_numWaitingForSpace.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            Wake();
+
+            {
+                std::unique_lock<std::mutex> lock(m_spaceMutex);
+                m_spaceCond.wait(lock, [&ring]() { return !ring.IsFull(); });
+            }
+
+            m_numWaitingForSpace.fetch_sub(1);
+        }
+
+        // This fence pairs with the one in SinkLoop(): either the sink thread
+        // sees the new record or we see that it's going to sleep.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        switch ( m_state.load(std::memory_order_relaxed) )
+        {
+            case State_Awake:
+                break;
+
+            case State_Dozing:
+                // Waking up the sink thread for every record would be too
+                // expensive, so let it wake up on its own, unless the buffer
+                // starts filling up.
+                if ( used < m_bufferSize / 2 )
+                    break;
+                wxFALLTHROUGH;
+
+            case State_Sleeping:
+                Wake();
+                break;
+        }
+    }
+
+    void Flush()
+    {
+        if ( wxInAsyncLogSink )
+        {
+            m_target->Flush();
+            return;
+        }
+
+        // Flush() is called by the main thread whenever it becomes idle, so
+        // don't block it unless it has logged something not flushed yet.
+        const AsyncLogRingCache& cache = gs_asyncLogRingCache;
+        if ( cache.id != m_id || !cache.ring->HasUnflushed() )
+        {
+            // But still ask the sink thread to flush the records output by
+            // the other threads, if any.
+            if ( m_hasUnflushed.exchange(false) )
+            {
+                ++m_flushRequested;
+                Wake();
+            }
+
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_flushMutex);
+
+        const unsigned request = ++m_flushRequested;
+        Wake();
+
+        m_flushCond.wait(lock, [this, request]()
+            {
+                return static_cast<int>(request - m_flushDone) <= 0;
+            });
+    }
+
+private:
+    void UseRingInCurrentThread(AsyncLogRingCache& cache)
+    {
+        const wxThreadIdType threadId = wxThread::GetCurrentId();
+
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+
+        cache.id = m_id;
+
+        // This thread could have already used this logger before if it
+        // alternated between using different loggers, in which case we must
+        // continue using the same ring to preserve the order of messages.
+        //
+        // We can't know when a thread exits, so the rings are never freed
+        // before the logger itself, but the IDs of the exited threads are
+        // typically reused by the new ones, which then reuse their rings too.
+        for ( size_t n = 0; n < m_rings.size(); n++ )
+        {
+            if ( m_rings[n]->GetThreadId() == threadId )
+            {
+                cache.ring = m_rings[n].get();
+                return;
+            }
+        }
+
+        m_rings.push_back(std::unique_ptr<AsyncLogRing>
+                          (
+                            new AsyncLogRing(threadId, m_bufferSize)
+                          ));
+        m_numRings.store(m_rings.size(), std::memory_order_release);
+
+        cache.ring = m_rings.back().get();
+    }
+
+    void Wake()
+    {
+        if ( m_state.exchange(State_Awake) != State_Awake )
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_wakeCond.notify_one();
+        }
+    }
+
+    // Return true if there is anything for the sink thread to do.
+    bool HasWork(const std::vector<AsyncLogRing*>& rings) const
+    {
+        if ( m_stop.load() || m_flushRequested.load() != m_flushDone )
+            return true;
+
+        if ( m_numWaitingForSpace.load() )
+            return true;
+
+        if ( m_numRings.load(std::memory_order_acquire) != rings.size() )
+            return true;
+
+        for ( size_t n = 0; n < rings.size(); n++ )
+        {
+            if ( !rings[n]->IsEmpty() )
+                return true;
+        }
+
+        return false;
+    }
+
+    void SinkLoop()
+    {
+        wxInAsyncLogSink = true;
+
+        // Our own copy of m_rings, only updated when new rings are added.
+        std::vector<AsyncLogRing*> rings;
+
+        // True if we've just waited for the new records for DOZE_TIME.
+        bool dozed = false;
+
+        for ( ;; )
+        {
+            // Read these flags before draining the buffers to ensure that all
+            // the records logged before setting them are output.
+            const bool stop = m_stop.load();
+            const unsigned flushRequested = m_flushRequested.load();
+
+            if ( m_numRings.load(std::memory_order_acquire) != rings.size() )
+            {
+                std::lock_guard<std::mutex> lock(m_ringsMutex);
+                for ( size_t n = rings.size(); n < m_rings.size(); n++ )
+                    rings.push_back(m_rings[n].get());
+            }
+
+            bool logged = false;
+            for ( size_t n = 0; n < rings.size(); n++ )
+            {
+                if ( rings[n]->Drain(m_target) )
+                    logged = true;
+            }
+
+            if ( logged )
+            {
+                m_hasUnflushed.store(true);
+
+                // Wake up the threads waiting for space in their rings, if
+                // any, see the matching fence in Log().
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if ( m_numWaitingForSpace.load() )
+                {
+                    std::lock_guard<std::mutex> lock(m_spaceMutex);
+                    m_spaceCond.notify_all();
+                }
+            }
+
+            if ( flushRequested != m_flushDone || stop )
+            {
+                m_hasUnflushed.store(false);
+                m_target->Flush();
+
+                for ( size_t n = 0; n < rings.size(); n++ )
+                    rings[n]->MarkFlushed();
+
+                std::lock_guard<std::mutex> lock(m_flushMutex);
+                m_flushDone = flushRequested;
+                m_flushCond.notify_all();
+            }
+
+            if ( stop )
+                break;
+
+            if ( logged )
+            {
+                dozed = false;
+                continue;
+            }
+
+            // When there are no more records, wait for a short time first:
+            // if more records are logged during it, they will be output when
+            // it expires in a single batch. Only if nothing was logged, sleep
+            // until we're woken up by the next record.
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+            m_state.store(dozed ? State_Sleeping : State_Dozing);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if ( HasWork(rings) )
+            {
+                m_state.store(State_Awake);
+                dozed = false;
+                continue;
+            }
+
+            const auto isAwake = [this]()
+                {
+                    return m_state.load() == State_Awake;
+                };
+
+            if ( dozed )
+            {
+                m_wakeCond.wait(lock, isAwake);
+                dozed = false;
+            }
+            else
+            {
+                m_wakeCond.wait_for(lock, std::chrono::milliseconds(DOZE_TIME),
+                                    isAwake);
+                m_state.store(State_Awake);
+                dozed = true;
+            }
+        }
+    }
+
+
+    wxLog* const m_target;
+
+    // Unique ID of this logger, see gs_asyncLogRingCache.
+    const unsigned m_id;
+
+    // The size of each ring, always a power of 2.
+    size_t m_bufferSize;
+
+    // All the rings, protected by m_ringsMutex, and their number, which can
+    // be checked without locking.
+    std::mutex m_ringsMutex;
+    std::vector< std::unique_ptr<AsyncLogRing> > m_rings;
+    std::atomic<size_t> m_numRings{0};
+
+    // Used to wake up the sink thread when it's waiting for new records.
+    enum State
+    {
+        State_Awake,
+        State_Dozing,   // Waiting for DOZE_TIME.
+        State_Sleeping  // Waiting until woken up.
+    };
+
+    // Maximal delay, in ms, between logging a record and outputting it.
+    //
+    // Notice that this can't be a static const int member without defining it
+    // outside of the class, as it's passed by reference to chrono functions.
+    enum { DOZE_TIME = 10 };
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCond;
+    std::atomic<int> m_state{State_Awake};
+    std::atomic<bool> m_stop{false};
+
+    // Flush() increments the number of requests and waits until the sink
+    // thread updates m_flushDone, which is protected by m_flushMutex.
+    std::mutex m_flushMutex;
+    std::condition_variable m_flushCond;
+    std::atomic<unsigned> m_flushRequested{0};
+    unsigned m_flushDone = 0;
+
+    // Set by the sink thread when it outputs anything and reset when it
+    // flushes the target or when Flush() asks it to do it.
+    std::atomic<bool> m_hasUnflushed{false};
+
+    // The producers wait on m_spaceCond when their ring is full and the sink
+    // thread signals it after draining the rings if m_numWaitingForSpace is
+    // non-zero.
+    std::mutex m_spaceMutex;
+    std::condition_variable m_spaceCond;
+    std::atomic<int> m_numWaitingForSpace{0};
+
+    std::thread m_thread;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncImpl);
+};
+
+wxLogAsync::wxLogAsync(wxLog *target, size_t bufferSize)
+          : m_impl(new wxLogAsyncImpl(target, bufferSize))
+{
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    delete m_impl;
+}
+
+wxLog *wxLogAsync::GetTarget() const
+{
+    return m_impl->GetTarget();
+}
+
+void wxLogAsync::Flush()
+{
+    wxLog::Flush();
+
+    m_impl->Flush();
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    m_impl->Log(level, msg, info);
+}
+
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // Global functions/variables
 // ============================================================================
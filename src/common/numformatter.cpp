@@ -18,6 +18,8 @@
 #include "wx/numformatter.h"
 #include "wx/uilocale.h"
 
+#include <type_traits>
+
 // ============================================================================
 // wxNumberFormatter implementation
 // ============================================================================
@@ -78,6 +80,39 @@ void ReplaceSeparatorIfNecessary(wxString& s, wxChar sepOld, wxChar sepNew)
     }
 }
 
+// Convert an integer to string: this is much faster than using "%d" and
+// similar formats with wxString::Format() and there is no need to deal with
+// the locale here, as integers are formatted in the same way in all of them.
+template <typename T>
+wxString IntToString(T val)
+{
+    // This is enough for any 64-bit number including its sign.
+    wxChar buf[24];
+    wxChar* const end = buf + WXSIZEOF(buf);
+    wxChar* p = end;
+
+    typedef typename std::make_unsigned<T>::type U;
+
+    const bool negative = std::is_signed<T>::value && val < T();
+
+    // Note that negating an unsigned value works even for the minimal value
+    // of the signed type, unlike negating the signed value itself.
+    U u = static_cast<U>(val);
+    if ( negative )
+        u = U() - u;
+
+    do
+    {
+        *--p = static_cast<wxChar>(wxT('0') + u % 10);
+        u /= 10;
+    } while ( u );
+
+    if ( negative )
+        *--p = wxT('-');
+
+    return wxString(p, end - p);
+}
+
 } // anonymous namespace
 
 wxString wxNumberFormatter::PostProcessIntString(wxString s, int style)
@@ -97,23 +132,21 @@ wxString wxNumberFormatter::PostProcessIntString(wxString s, int style)
 
 wxString wxNumberFormatter::ToString(long val, int style)
 {
-    return PostProcessIntString(wxString::Format("%ld", val), style);
+    return PostProcessIntString(IntToString(val), style);
 }
 
 #ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
 wxString wxNumberFormatter::ToString(wxLongLong_t val, int style)
 {
-    return PostProcessIntString(wxString::Format("%" wxLongLongFmtSpec "d", val),
-                                style);
+    return PostProcessIntString(IntToString(val), style);
 }
 
 #endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
 
 wxString wxNumberFormatter::ToString(wxULongLong_t val, int style)
 {
-    return PostProcessIntString(wxString::Format("%" wxLongLongFmtSpec "u", val),
-                                style);
+    return PostProcessIntString(IntToString(val), style);
 }
 
 wxString wxNumberFormatter::ToString(double val, int precision, int style)
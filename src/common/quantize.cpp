@@ -28,6 +28,12 @@
 
 /* modified by Vaclav Slavik for use as jpeglib-independent module */
 
+/* Support for mapping without dithering and for ordered dithering using the
+ * average distance between the colors of the map as the dither amplitude
+ * added for use by wxQuantize: both are much faster than Floyd-Steinberg
+ * dithering, which is inherently sequential, for big images.
+ */
+
 // For compilers that support precompilation, includes "wx/wx.h".
 #include "wx/wxprec.h"
 
@@ -66,12 +72,19 @@ typedef JSAMPLE *JSAMPROW;
 typedef JSAMPROW *JSAMPARRAY;
 typedef unsigned int JDIMENSION;
 
+typedef enum {
+        JDITHER_NONE,           /* no dithering */
+        JDITHER_ORDERED,        /* simple ordered dither */
+        JDITHER_FS              /* Floyd-Steinberg error diffusion dither */
+} J_DITHER_MODE;
+
 typedef struct {
         void *cquantize;
         JDIMENSION output_width;
         JSAMPARRAY colormap;
         int actual_number_of_colors;
         int desired_number_of_colors;
+        J_DITHER_MODE dither_mode;
         JSAMPLE *sample_range_limit, *srl_orig;
 } j_decompress;
 
@@ -283,6 +296,10 @@ typedef struct {
   FSERRPTR fserrors;        /* accumulated errors */
   bool on_odd_row;      /* flag to remember which row we are on */
   int * error_limiter;      /* table for clamping the applied error */
+
+  /* Variables for ordered dithering */
+  int ordered_dither[8][8]; /* dither values to add to the pixels */
+  int row_index;        /* current row's index into ordered_dither */
 } my_cquantizer;
 
 typedef my_cquantizer * my_cquantize_ptr;
@@ -992,7 +1009,6 @@ fill_inverse_cmap (j_decompress_ptr cinfo, int c0, int c1, int c2)
  * Map some rows of pixels to the output colormapped representation.
  */
 
-#if 0
 void
 pass2_no_dither (j_decompress_ptr cinfo,
          JSAMPARRAY input_buf, JSAMPARRAY output_buf, int num_rows)
@@ -1025,7 +1041,110 @@ pass2_no_dither (j_decompress_ptr cinfo,
     }
   }
 }
-#endif
+
+
+/* 8x8 Bayer matrix used for ordered dithering, with values in 0..63 range. */
+
+const int ordered_dither_matrix[8][8] = {
+  {  0, 32,  8, 40,  2, 34, 10, 42 },
+  { 48, 16, 56, 24, 50, 18, 58, 26 },
+  { 12, 44,  4, 36, 14, 46,  6, 38 },
+  { 60, 28, 52, 20, 62, 30, 54, 22 },
+  {  3, 35, 11, 43,  1, 33,  9, 41 },
+  { 51, 19, 59, 27, 49, 17, 57, 25 },
+  { 15, 47,  7, 39, 13, 45,  5, 37 },
+  { 63, 31, 55, 23, 61, 29, 53, 21 }
+};
+
+void
+pass2_ordered_dither (j_decompress_ptr cinfo,
+         JSAMPARRAY input_buf, JSAMPARRAY output_buf, int num_rows)
+/* This version performs ordered dithering */
+{
+  my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
+  hist3d histogram = cquantize->histogram;
+  JSAMPROW inptr, outptr;
+  histptr cachep;
+  JSAMPLE *range_limit = cinfo->sample_range_limit;
+  const int *dither;
+  int c0, c1, c2;
+  int row;
+  JDIMENSION col;
+  JDIMENSION width = cinfo->output_width;
+
+  for (row = 0; row < num_rows; row++) {
+    inptr = input_buf[row];
+    outptr = output_buf[row];
+    dither = cquantize->ordered_dither[cquantize->row_index];
+    cquantize->row_index = (cquantize->row_index + 1) & 7;
+    for (col = 0; col < width; col++) {
+      /* add the dither value and range-limit the result, the maximum
+       * dither value is much less than MAXJSAMPLE, so the table is big
+       * enough for it */
+      int d = dither[col & 7];
+      c0 = GETJSAMPLE(range_limit[GETJSAMPLE(*inptr++) + d]) >> C0_SHIFT;
+      c1 = GETJSAMPLE(range_limit[GETJSAMPLE(*inptr++) + d]) >> C1_SHIFT;
+      c2 = GETJSAMPLE(range_limit[GETJSAMPLE(*inptr++) + d]) >> C2_SHIFT;
+      cachep = & histogram[c0][c1][c2];
+      if (*cachep == 0)
+    fill_inverse_cmap(cinfo, c0,c1,c2);
+      *outptr++ = (JSAMPLE) (*cachep - 1);
+    }
+  }
+}
+
+
+/*
+ * Initialize the ordered dither table for the current colormap.
+ * As the colormap is irregular, we use the average distance from each of its
+ * colors to the nearest other one, measured as the biggest difference between
+ * their components, as the dither amplitude: this ensures that the dither is
+ * strong enough to produce intermediate colors in the densely populated parts
+ * of the color space without adding too much noise elsewhere.
+ */
+
+void
+init_ordered_dither (j_decompress_ptr cinfo)
+{
+  my_cquantize_ptr cquantize = (my_cquantize_ptr) cinfo->cquantize;
+  int ncolors = cinfo->actual_number_of_colors;
+  JSAMPROW colormap0 = cinfo->colormap[0];
+  JSAMPROW colormap1 = cinfo->colormap[1];
+  JSAMPROW colormap2 = cinfo->colormap[2];
+  long total = 0;
+  int spread;
+  int i, j;
+
+  for (i = 0; i < ncolors; i++) {
+    int mindist = MAXJSAMPLE;
+    for (j = 0; j < ncolors; j++) {
+      int dist, d;
+      if (j == i)
+    continue;
+      dist = abs(GETJSAMPLE(colormap0[i]) - GETJSAMPLE(colormap0[j]));
+      d = abs(GETJSAMPLE(colormap1[i]) - GETJSAMPLE(colormap1[j]));
+      if (d > dist)
+    dist = d;
+      d = abs(GETJSAMPLE(colormap2[i]) - GETJSAMPLE(colormap2[j]));
+      if (d > dist)
+    dist = d;
+      if (dist < mindist)
+    mindist = dist;
+    }
+    total += mindist;
+  }
+
+  spread = ncolors ? (int) (total / ncolors) : 0;
+
+  /* map matrix values to -spread/2..spread/2 range */
+  for (i = 0; i < 8; i++) {
+    for (j = 0; j < 8; j++) {
+      cquantize->ordered_dither[i][j] =
+        ((2 * ordered_dither_matrix[i][j] - 63) * spread) / 128;
+    }
+  }
+  cquantize->row_index = 0;
+}
 
 void
 pass2_fs_dither (j_decompress_ptr cinfo,
@@ -1277,10 +1396,15 @@ start_pass_2_quant (j_decompress_ptr cinfo, bool is_pre_scan)
     cquantize->needs_zeroed = true; /* Always zero histogram */
   } else {
     /* Set up method pointers */
-    cquantize->pub.color_quantize = pass2_fs_dither;
     cquantize->pub.finish_pass = finish_pass2;
 
-    {
+    if (cinfo->dither_mode == JDITHER_NONE) {
+      cquantize->pub.color_quantize = pass2_no_dither;
+    } else if (cinfo->dither_mode == JDITHER_ORDERED) {
+      cquantize->pub.color_quantize = pass2_ordered_dither;
+      init_ordered_dither(cinfo);
+    } else {
+      cquantize->pub.color_quantize = pass2_fs_dither;
       size_t arraysize = (size_t) ((cinfo->output_width + 2) *
                    (3 * sizeof(FSERROR)));
       /* Allocate Floyd-Steinberg workspace if we didn't already. */
@@ -1293,7 +1417,6 @@ start_pass_2_quant (j_decompress_ptr cinfo, bool is_pre_scan)
     init_error_limit(cinfo);
       cquantize->on_odd_row = false;
     }
-
   }
   /* Zero the histogram or inverse color map, if necessary */
   if (cquantize->needs_zeroed) {
@@ -1420,7 +1543,7 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
 wxIMPLEMENT_DYNAMIC_CLASS(wxQuantize, wxObject);
 
 void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
-    unsigned char *palette, int desiredNoColours)
+    unsigned char *palette, int desiredNoColours, int flags)
 {
     j_decompress dec;
     my_cquantize_ptr cquantize;
@@ -1428,6 +1551,12 @@ void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, uns
     dec.colormap = nullptr;
     dec.output_width = w;
     dec.desired_number_of_colors = desiredNoColours;
+    if ( flags & wxQUANTIZE_NO_DITHER )
+        dec.dither_mode = JDITHER_NONE;
+    else if ( flags & wxQUANTIZE_ORDERED_DITHER )
+        dec.dither_mode = JDITHER_ORDERED;
+    else
+        dec.dither_mode = JDITHER_FS;
     prepare_range_limit_table(&dec);
     jinit_2pass_quantizer(&dec);
     cquantize = (my_cquantize_ptr) dec.cquantize;
@@ -1507,7 +1636,7 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
         outrows[i] = data8bit + w * i;
 
     //RGB->palette
-    DoQuantize(w, h, rows, outrows, palette, desiredNoColours);
+    DoQuantize(w, h, rows, outrows, palette, desiredNoColours, flags);
 
     delete[] rows;
     delete[] outrows;
@@ -1517,7 +1646,7 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
     if (flags & wxQUANTIZE_FILL_DESTINATION_IMAGE)
     {
         if (!dest.IsOk())
-            dest.Create(w, h);
+            dest.Create(w, h, false /* don't clear */);
 
         imgdt = dest.GetData();
         for (i = 0; i < w * h; i++)
@@ -49,6 +49,15 @@
 
 #include <unordered_map>
 
+// SSE2 is always available when targeting x86-64 and is used for processing
+// runs of ASCII characters in UTF-8 conversions below if it is, otherwise we
+// fall back to processing 8 bytes at once using normal integer operations.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_SSE2_UTF8
+    #include <emmintrin.h>
+#endif
+
 #define TRACE_STRCONV wxT("strconv")
 
 // WC_UTF16 is defined only if sizeof(wchar_t) == 2, otherwise it's supposed to
@@ -943,6 +952,187 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+namespace
+{
+
+// Number of characters processed one by one before switching to processing
+// them in blocks in the functions below.
+const size_t SHORT_ASCII_RUN = 16;
+
+// Copy the ASCII characters at the start of src, but not more than len of
+// them, to dst, which may be null if only the number of characters is needed.
+//
+// Returns the number of characters copied, which may be 0 if the first one is
+// not ASCII.
+size_t CopyASCIIToWChar(wchar_t* dst, const char* src, size_t len)
+{
+    // Start by copying the characters one by one, as in non-Latin text ASCII
+    // characters (spaces, digits, punctuation) typically come in short runs,
+    // for which setting up the block processing below is not worth it.
+    size_t n = 0;
+    for ( ; n < len && n < SHORT_ASCII_RUN; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c >= 0x80 )
+            return n;
+
+        if ( dst )
+            dst[n] = c;
+    }
+
+#ifdef wxHAS_SSE2_UTF8
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i
+            bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n));
+
+        // Leave the block containing non-ASCII characters to the loop below.
+        if ( _mm_movemask_epi8(bytes) )
+            break;
+
+        if ( !dst )
+            continue;
+
+        const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+        __m128i* const out = reinterpret_cast<__m128i*>(dst + n);
+#ifdef WC_UTF16
+        _mm_storeu_si128(out, lo);
+        _mm_storeu_si128(out + 1, hi);
+#else // !WC_UTF16
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+#endif // WC_UTF16/!WC_UTF16
+    }
+#else // !wxHAS_SSE2_UTF8
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        wxUint64 bytes;
+        memcpy(&bytes, src + n, sizeof(bytes));
+        if ( bytes & wxULL(0x8080808080808080) )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t i = n; i < n + 8; i++ )
+                dst[i] = static_cast<unsigned char>(src[i]);
+        }
+    }
+#endif // wxHAS_SSE2_UTF8/!wxHAS_SSE2_UTF8
+
+    // Deal with the remaining characters, if any, one by one.
+    for ( ; n < len; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = c;
+    }
+
+    return n;
+}
+
+// Same as above, but in the other direction, i.e. copy the wide characters in
+// the ASCII range at the start of src to dst, which again may be null.
+size_t CopyASCIIFromWChar(char* dst, const wchar_t* src, size_t len)
+{
+    size_t n = 0;
+    for ( ; n < len && n < SHORT_ASCII_RUN; n++ )
+    {
+        const wxUint32 c = static_cast<wxUint32>(src[n]);
+        if ( c >= 0x80 )
+            return n;
+
+        if ( dst )
+            dst[n] = static_cast<char>(c);
+    }
+
+#ifdef wxHAS_SSE2_UTF8
+    // Loading 16 wide characters as several 128 bit values is not the most
+    // straightforward way to do it, but allows to pack them back into bytes
+    // using just a couple of instructions.
+#ifdef WC_UTF16
+    const __m128i nonASCIIMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+#else // !WC_UTF16
+    const __m128i nonASCIIMask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+#endif // WC_UTF16/!WC_UTF16
+    const __m128i zero = _mm_setzero_si128();
+
+    for ( ; n + 16 <= len; n += 16 )
+    {
+        const __m128i* const in = reinterpret_cast<const __m128i*>(src + n);
+
+#ifdef WC_UTF16
+        const __m128i w0 = _mm_loadu_si128(in);
+        const __m128i w1 = _mm_loadu_si128(in + 1);
+
+        const __m128i all = _mm_or_si128(w0, w1);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(all, nonASCIIMask),
+                                               zero)) != 0xFFFF )
+            break;
+
+        const __m128i bytes = _mm_packus_epi16(w0, w1);
+#else // !WC_UTF16
+        const __m128i w0 = _mm_loadu_si128(in);
+        const __m128i w1 = _mm_loadu_si128(in + 1);
+        const __m128i w2 = _mm_loadu_si128(in + 2);
+        const __m128i w3 = _mm_loadu_si128(in + 3);
+
+        const __m128i all = _mm_or_si128(_mm_or_si128(w0, w1),
+                                         _mm_or_si128(w2, w3));
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, nonASCIIMask),
+                                               zero)) != 0xFFFF )
+            break;
+
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(w0, w1),
+                                               _mm_packs_epi32(w2, w3));
+#endif // WC_UTF16/!WC_UTF16
+
+        if ( dst )
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n), bytes);
+    }
+#endif // wxHAS_SSE2_UTF8
+
+    // Without SSE2 rely on the compiler to vectorize this loop, which it can
+    // do if we check for non-ASCII characters in blocks.
+    const size_t BLOCK_SIZE = 8;
+    for ( ; n + BLOCK_SIZE <= len; n += BLOCK_SIZE )
+    {
+        wxUint32 all = 0;
+        for ( size_t i = n; i < n + BLOCK_SIZE; i++ )
+            all |= static_cast<wxUint32>(src[i]);
+
+        if ( all >= 0x80 )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t i = n; i < n + BLOCK_SIZE; i++ )
+                dst[i] = static_cast<char>(src[i]);
+        }
+    }
+
+    for ( ; n < len; n++ )
+    {
+        const wxUint32 c = static_cast<wxUint32>(src[n]);
+        if ( c >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = static_cast<char>(c);
+    }
+
+    return n;
+}
+
+} // anonymous namespace
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -955,6 +1145,25 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
 
     for ( const char *p = src; ; p++ )
     {
+        // Most strings consist mostly of ASCII characters, so handle all of
+        // them at once before falling back to decoding them one by one.
+        if ( srcLen && static_cast<unsigned char>(*p) < 0x80 )
+        {
+            const size_t ascii = CopyASCIIToWChar(out, p,
+                                                  out && dstLen < srcLen
+                                                    ? dstLen
+                                                    : srcLen);
+
+            p += ascii;
+            srcLen -= ascii;
+            written += ascii;
+            if ( out )
+            {
+                out += ascii;
+                dstLen -= ascii;
+            }
+        }
+
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -1068,6 +1277,24 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : src + srcLen;
     for ( const wchar_t *wp = src; ; )
     {
+        // As in ToWChar(), deal with ASCII characters in bulk, but only if we
+        // know the string length, as we can't read beyond its end otherwise.
+        if ( end && wp != end && static_cast<wxUint32>(*wp) < 0x80 )
+        {
+            const size_t left = end - wp;
+            const size_t ascii = CopyASCIIFromWChar(out, wp,
+                                                    out && dstLen < left ? dstLen
+                                                                         : left);
+
+            wp += ascii;
+            written += ascii;
+            if ( out )
+            {
+                out += ascii;
+                dstLen -= ascii;
+            }
+        }
+
         if ( end ? wp == end : !*wp )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -1212,6 +1439,19 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
                     *buf++ = cc;
                 len++;
             }
+            else if (!isNulTerminated &&
+                        !(m_options & MAP_INVALID_UTF8_TO_OCTAL))
+            {
+                // copy all the following ASCII characters at once too
+                const size_t ascii = CopyASCIIToWChar(buf, psz,
+                                        buf && n - len < srcLen ? n - len
+                                                                : srcLen);
+                psz += ascii;
+                srcLen -= ascii;
+                len += ascii;
+                if (buf)
+                    buf += ascii;
+            }
         }
         else
         {
@@ -1425,6 +1665,20 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
                 if (buf)
                     *buf++ = (char) cc;
                 len++;
+
+                // copy all the following ASCII characters at once too, which
+                // we can only do if we don't need to look for backslashes
+                if ( end && !(m_options & MAP_INVALID_UTF8_TO_OCTAL) )
+                {
+                    const size_t left = end - psz;
+                    const size_t ascii = CopyASCIIFromWChar(buf, psz,
+                                            buf && n - len < left ? n - len
+                                                                  : left);
+                    psz += ascii;
+                    len += ascii;
+                    if (buf)
+                        buf += ascii;
+                }
             }
             else
             {
@@ -29,10 +29,15 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "wx/hashmap.h"
+#include "wx/thread.h"
 #include "wx/uilocale.h"
 #include "wx/vector.h"
 #include "wx/xlocale.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #ifdef __WINDOWS__
     #include "wx/msw/wrapwin.h"
 #endif // __WINDOWS__
@@ -93,13 +98,14 @@ struct wxStrCacheDumper
             const wxString::Cache::Element&
                 c = wxString::GetCacheBegin()[n];
 
-            printf("\t%u%s\t%p: pos=(%lu, %lu), len=%ld\n",
+            printf("\t%u%s\t%p: pos=(%lu, %lu), len=%ld, ascii=%lu\n",
                    n,
                    n == wxString::LastUsedCacheElement() ? " [*]" : "",
                    c.str,
                    (unsigned long)c.pos,
                    (unsigned long)c.impl,
-                   (long)c.len);
+                   (long)c.len,
+                   (unsigned long)c.ascii);
         }
     }
 };
@@ -869,14 +875,12 @@ size_t wxString::find_last_not_of(const char* sz, size_t nStart,
 
 int wxString::CmpNoCase(const wxString& s) const
 {
-#if !wxUSE_UNICODE_UTF8
-    // We compare NUL-delimited chunks of the strings inside the loop. We will
-    // do as many iterations as there are embedded NULs in the string, i.e.
-    // usually we will run it just once.
-
-    typedef const wxStringImpl::value_type *pchar_type;
-    const pchar_type thisBegin = m_impl.c_str();
-    const pchar_type thatBegin = s.m_impl.c_str();
+    // The strings compared are often identical or differ only in a few
+    // characters, so skip over the parts which are exactly the same quickly
+    // and only compare the case-folded characters when they're different.
+    typedef const wxStringCharType *pchar_type;
+    const pchar_type thisBegin = m_impl.data();
+    const pchar_type thatBegin = s.m_impl.data();
 
     const pchar_type thisEnd = thisBegin + m_impl.length();
     const pchar_type thatEnd = thatBegin + s.m_impl.length();
@@ -884,72 +888,54 @@ int wxString::CmpNoCase(const wxString& s) const
     pchar_type thisCur = thisBegin;
     pchar_type thatCur = thatBegin;
 
-    int rc;
     for ( ;; )
     {
-        // Compare until the next NUL, if the strings differ this is the final
-        // result.
-        rc = wxStricmp(thisCur, thatCur);
-        if ( rc )
+        const size_t thisLeft = thisEnd - thisCur;
+        const size_t thatLeft = thatEnd - thatCur;
+        const size_t common = wxStringOperations::GetCommonPrefixLength
+                              (
+                                thisCur,
+                                thatCur,
+                                thisLeft < thatLeft ? thisLeft : thatLeft
+                              );
+        thisCur += common;
+        thatCur += common;
+
+        if ( thisCur == thisEnd || thatCur == thatEnd )
             break;
 
-        const size_t lenChunk = wxStrlen(thisCur);
-        thisCur += lenChunk;
-        thatCur += lenChunk;
-
-        // Skip all the NULs as wxStricmp() doesn't handle them.
-        for ( ; !*thisCur; thisCur++, thatCur++ )
+        wxUniChar ch1, ch2;
+#if wxUSE_UNICODE_UTF8
+        // We could have stopped in the middle of a multibyte sequence, go
+        // back to its beginning, which is the same in both strings.
+        while ( (static_cast<unsigned char>(*thisCur) & 0xC0) == 0x80 )
         {
-            // Check if we exhausted either of the strings.
-            if ( thisCur == thisEnd )
-            {
-                // This one is exhausted, is the other one too?
-                return thatCur == thatEnd ? 0 : -1;
-            }
-
-            if ( thatCur == thatEnd )
-            {
-                // Because of the test above we know that this one is not
-                // exhausted yet so it's greater than the other one that is.
-                return 1;
-            }
-
-            if ( *thatCur )
-            {
-                // Anything non-NUL is greater than NUL.
-                return -1;
-            }
+            thisCur--;
+            thatCur--;
         }
-    }
 
-    return rc;
-#else // wxUSE_UNICODE_UTF8
-    // CRT functions can't be used for case-insensitive comparison of UTF-8
-    // strings so do it in the naive, simple and inefficient way.
+        ch1 = wxStringOperations::DecodeChar(m_impl.begin() + (thisCur - thisBegin));
+        ch2 = wxStringOperations::DecodeChar(s.m_impl.begin() + (thatCur - thatBegin));
 
-    // FIXME-UTF8: use wxUniChar::ToLower/ToUpper once added
-    const_iterator i1 = begin();
-    const_iterator end1 = end();
-    const_iterator i2 = s.begin();
-    const_iterator end2 = s.end();
+        thisCur += wxStringOperations::GetUtf8CharLength(*thisCur);
+        thatCur += wxStringOperations::GetUtf8CharLength(*thatCur);
+#else // wxUSE_UNICODE_WCHAR
+        ch1 = *thisCur++;
+        ch2 = *thatCur++;
+#endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
 
-    for ( ; i1 != end1 && i2 != end2; ++i1, ++i2 )
-    {
-        wxUniChar lower1 = (wxChar)wxTolower(*i1);
-        wxUniChar lower2 = (wxChar)wxTolower(*i2);
+        // FIXME-UTF8: use wxUniChar::ToLower/ToUpper once added
+        const wxChar lower1 = (wxChar)wxTolower(ch1);
+        const wxChar lower2 = (wxChar)wxTolower(ch2);
         if ( lower1 != lower2 )
             return lower1 < lower2 ? -1 : 1;
     }
 
-    size_t len1 = length();
-    size_t len2 = s.length();
+    // One of the strings is exhausted, is the other one too?
+    if ( thisCur == thisEnd )
+        return thatCur == thatEnd ? 0 : -1;
 
-    if ( len1 < len2 )
-        return -1;
-    else if ( len1 > len2 )
-        return 1;
-    return 0;
-#endif // !wxUSE_UNICODE_UTF8/wxUSE_UNICODE_UTF8
+    return 1;
 }
 
 
@@ -1232,48 +1218,119 @@ size_t wxString::Replace(const wxString& strOld,
         const size_t uiOldLen = strOld.m_impl.length();
         const size_t uiNewLen = strNew.m_impl.length();
 
-        // first scan the string to find all positions at which the replacement
-        // should be made
-        wxVector<size_t> replacePositions;
+        typedef std::char_traits<wxStringCharType> Traits;
+
+        const wxStringCharType* const pNew = strNew.m_impl.data();
 
-        size_t pos;
-        for ( pos = m_impl.find(strOld.m_impl, 0);
-              pos != npos;
-              pos = m_impl.find(strOld.m_impl, pos + uiOldLen))
+        // we can't modify the string in place if it's also the one we search
+        // for or replace with (which is weird, but still valid)
+        if ( uiNewLen <= uiOldLen && &strOld != this && &strNew != this )
         {
-            replacePositions.push_back(pos);
-            ++uiCount;
-        }
+            // the string doesn't grow, so we can do the replacements in place,
+            // without allocating any memory, by moving the parts between the
+            // matches towards the beginning of the string as we go
+            size_t pos = m_impl.find(strOld.m_impl);
+            if ( pos == npos )
+                return 0;
 
-        if ( !uiCount )
-            return 0;
+            // m_impl.begin() is not const, so it ensures that we have our own
+            // copy of the buffer which can be modified
+            wxStringCharType* const p = &*m_impl.begin();
+            size_t dst = pos;
+            for ( ;; )
+            {
+                Traits::copy(p + dst, pNew, uiNewLen);
+                dst += uiNewLen;
+                uiCount++;
 
-        // allocate enough memory for the whole new string
-        wxString tmp;
-        tmp.m_impl.reserve(m_impl.length() + uiCount*(uiNewLen - uiOldLen));
+                const size_t next = m_impl.find(strOld.m_impl, pos + uiOldLen);
+                const size_t end = next == npos ? m_impl.length() : next;
 
-        // copy this string to tmp doing replacements on the fly
-        size_t replNum = 0;
-        for ( pos = 0; replNum < uiCount; replNum++ )
+                // nothing needs to be moved if the lengths are the same
+                if ( dst != pos + uiOldLen )
+                    Traits::move(p + dst, p + pos + uiOldLen,
+                                 end - pos - uiOldLen);
+                dst += end - pos - uiOldLen;
+
+                if ( next == npos )
+                    break;
+
+                pos = next;
+            }
+
+            m_impl.resize(dst);
+        }
+        else // the string grows or we can't modify it in place
         {
-            const size_t nextReplPos = replacePositions[replNum];
+            // count the matches first to allocate the new string only once,
+            // this is cheap as searching uses memchr() or equivalent
+            size_t pos;
+            if ( uiOldLen == 1 )
+            {
+                uiCount = std::count(m_impl.begin(), m_impl.end(),
+                                     strOld.m_impl[0]);
+            }
+            else
+            {
+                for ( pos = m_impl.find(strOld.m_impl);
+                      pos != npos;
+                      pos = m_impl.find(strOld.m_impl, pos + uiOldLen) )
+                {
+                    ++uiCount;
+                }
+            }
+
+            if ( !uiCount )
+                return 0;
+
+            wxStringImpl tmp(m_impl.length() + uiCount*(uiNewLen - uiOldLen),
+                             wxStringCharType());
+            wxStringCharType* const pTmp = &*tmp.begin();
+            const wxStringCharType* const pOld = m_impl.data();
 
-            if ( pos != nextReplPos )
+            // copy this string to tmp doing replacements on the fly
+            size_t dst = 0;
+            size_t prev = 0;
+            if ( uiOldLen == 1 )
             {
-                tmp.m_impl.append(m_impl, pos, nextReplPos - pos);
+                // calling find() for each match is relatively expensive when
+                // there are many of them, so just check all the characters
+                const wxStringCharType chOld = strOld.m_impl[0];
+                const size_t len = m_impl.length();
+                for ( size_t n = 0; n < len; n++ )
+                {
+                    if ( pOld[n] == chOld )
+                    {
+                        Traits::copy(pTmp + dst, pNew, uiNewLen);
+                        dst += uiNewLen;
+                    }
+                    else
+                    {
+                        pTmp[dst++] = pOld[n];
+                    }
+                }
             }
+            else
+            {
+                for ( pos = m_impl.find(strOld.m_impl);
+                      pos != npos;
+                      pos = m_impl.find(strOld.m_impl, prev) )
+                {
+                    Traits::copy(pTmp + dst, pOld + prev, pos - prev);
+                    dst += pos - prev;
 
-            tmp.m_impl.append(strNew.m_impl);
-            pos = nextReplPos + uiOldLen;
-        }
+                    Traits::copy(pTmp + dst, pNew, uiNewLen);
+                    dst += uiNewLen;
 
-        if ( pos != m_impl.length() )
-        {
-            // append the rest of the string unchanged
-            tmp.m_impl.append(m_impl, pos, m_impl.length() - pos);
-        }
+                    prev = pos + uiOldLen;
+                }
+
+                // and append the rest of the string unchanged
+                Traits::copy(pTmp + dst, pOld + prev, m_impl.length() - prev);
+            }
 
-        swap(tmp);
+            m_impl.swap(tmp);
+        }
     }
 
     return uiCount;
@@ -1281,6 +1338,12 @@ size_t wxString::Replace(const wxString& strOld,
 
 bool wxString::IsAscii() const
 {
+#if wxUSE_UNICODE_UTF8
+    // no need to decode the characters, just check all bytes at once
+    return wxStringOperations::GetASCIIPrefixLength(m_impl.data(),
+                                                    m_impl.length())
+            == m_impl.length();
+#else // wxUSE_UNICODE_WCHAR
     for ( const_iterator i = begin(); i != end(); ++i )
     {
         if ( !(*i).IsAscii() )
@@ -1288,6 +1351,7 @@ bool wxString::IsAscii() const
     }
 
     return true;
+#endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
 }
 
 bool wxString::IsWord() const
@@ -1332,18 +1396,84 @@ wxString wxString::Strip(stripType w) const
 // case conversion
 // ---------------------------------------------------------------------------
 
+namespace
+{
+
+// Change the case of all characters of the string using the given function.
+//
+// The ASCII characters are handled directly, without calling the function,
+// as this is much faster and their case mapping doesn't depend on the locale,
+// with the exception of "I" and "i" which are special in Turkish locale and
+// so are passed to the function too, just as all the other characters.
+template <typename ChangeCase>
+void DoChangeCase(wxString& str, wxStringImpl& impl,
+                  char asciiFirst, char asciiLast, char special,
+                  ChangeCase changeCase)
+{
+#if !wxUSE_UNICODE_UTF8
+    wxUnusedVar(str);
+#endif
+
+    const size_t len = impl.length();
+    if ( !len )
+        return;
+
+    // impl.begin() is not const, so it ensures that we have our own copy of
+    // the buffer which can be modified
+    wxStringCharType* const p = &*impl.begin();
+
+    const int delta = asciiFirst == 'A' ? 'a' - 'A' : 'A' - 'a';
+
+    // The special character is the only ASCII one whose case may be changed
+    // differently depending on the locale (think of Turkish dotless i), but
+    // in all the other locales it doesn't need any special handling.
+    const bool checkSpecial = changeCase(special) != wxUniChar(special + delta);
+
+    for ( size_t n = 0; n < len; n++ )
+    {
+        const wxStringCharType ch = p[n];
+        if ( static_cast<wxUint32>(ch) < 0x80 &&
+                (ch != special || !checkSpecial) )
+        {
+            if ( ch >= asciiFirst && ch <= asciiLast )
+                p[n] = static_cast<wxStringCharType>(ch + delta);
+            continue;
+        }
+
+#if wxUSE_UNICODE_UTF8
+        // Changing the case of non-ASCII characters can change the length of
+        // their UTF-8 representation, so handle the rest of the string, which
+        // may be modified, using the iterators. Notice that all the characters
+        // before this one are ASCII and so the byte index is the same as the
+        // character one.
+        for ( wxString::iterator it = str.begin() + n, en = str.end();
+              it != en;
+              ++it )
+        {
+            *it = changeCase(*it);
+        }
+
+        break;
+#else // wxUSE_UNICODE_WCHAR
+        p[n] = changeCase(ch);
+#endif // wxUSE_UNICODE_UTF8/wxUSE_UNICODE_WCHAR
+    }
+}
+
+} // anonymous namespace
+
 wxString& wxString::MakeUpper()
 {
-  for ( iterator it = begin(), en = end(); it != en; ++it )
-    *it = (wxChar)wxToupper(*it);
+  DoChangeCase(*this, m_impl, 'a', 'z', 'i',
+               [](wxUniChar ch) { return (wxChar)wxToupper(ch); });
 
   return *this;
 }
 
 wxString& wxString::MakeLower()
 {
-  for ( iterator it = begin(), en = end(); it != en; ++it )
-    *it = (wxChar)wxTolower(*it);
+  DoChangeCase(*this, m_impl, 'A', 'Z', 'I',
+               [](wxUniChar ch) { return (wxChar)wxTolower(ch); });
 
   return *this;
 }
@@ -1643,15 +1773,73 @@ bool SkipOptPrefixAndSetBase(int& base, const char*& start, const char* end)
     return true;
 }
 
+// Helper providing the string contents as NUL-terminated char range for
+// std::from_chars().
+//
+// In UTF-8 build this is just the string data itself, but in wchar_t build we
+// would need to allocate memory for the UTF-8 conversion, which is more
+// expensive than the parsing itself for the typical short strings containing
+// numbers. So narrow such strings into a buffer on the stack instead: as only
+// ASCII characters can be part of a valid number, replacing all the others
+// with a character never accepted by from_chars() doesn't change the result.
+class NumberChars
+{
+public:
+    explicit NumberChars(const wxString& s)
+#if wxUSE_UNICODE_WCHAR
+    {
+        const size_t len = s.length();
+        if ( len < WXSIZEOF(m_chars) )
+        {
+            const wxStringCharType* const p = s.wx_str();
+            for ( size_t n = 0; n < len; ++n )
+                m_chars[n] = p[n] < 0x80 ? static_cast<char>(p[n]) : '?';
+            m_chars[len] = '\0';
+
+            m_start = m_chars;
+            m_end = m_chars + len;
+        }
+        else
+        {
+            m_buf = s.utf8_str();
+            m_start = m_buf.data();
+            m_end = m_start + m_buf.length();
+        }
+    }
+#else // wxUSE_UNICODE_UTF8
+        : m_buf(s.utf8_str()),
+          m_start(m_buf.data()),
+          m_end(m_start + m_buf.length())
+    {
+    }
+#endif // wxUSE_UNICODE_WCHAR/wxUSE_UNICODE_UTF8
+
+    const char* GetStart() const { return m_start; }
+    const char* GetEnd() const { return m_end; }
+
+private:
+    wxScopedCharBuffer m_buf;
+    const char* m_start;
+    const char* m_end;
+
+#if wxUSE_UNICODE_WCHAR
+    // This is enough for any number which doesn't have a lot of leading
+    // whitespace or zeroes.
+    char m_chars[64];
+#endif // wxUSE_UNICODE_WCHAR
+
+    wxDECLARE_NO_COPY_CLASS(NumberChars);
+};
+
 } // anonymous namespace
 
 bool wxString::ToCLong(long *pVal, int base) const
 {
     wxCHECK_MSG( pVal, false, "null output pointer" );
 
-    const wxScopedCharBuffer& buf = utf8_str();
-    auto start = buf.data();
-    const auto end = start + buf.length();
+    const NumberChars chars(*this);
+    auto start = chars.GetStart();
+    const auto end = chars.GetEnd();
 
     if ( !SkipOptPrefixAndSetBase(base, start, end) )
         return false;
@@ -1665,9 +1853,9 @@ bool wxString::ToCULong(unsigned long *pVal, int base) const
 {
     wxCHECK_MSG( pVal, false, "null output pointer" );
 
-    const wxScopedCharBuffer& buf = utf8_str();
-    auto start = buf.data();
-    const auto end = start + buf.length();
+    const NumberChars chars(*this);
+    auto start = chars.GetStart();
+    const auto end = chars.GetEnd();
 
     if ( !SkipOptPrefixAndSetBase(base, start, end) )
         return false;
@@ -1697,9 +1885,9 @@ bool wxString::ToCDouble(double *pVal) const
 {
     wxCHECK_MSG( pVal, false, "null output pointer" );
 
-    const wxScopedCharBuffer& buf = utf8_str();
-    auto start = buf.data();
-    const auto end = start + buf.length();
+    const NumberChars chars(*this);
+    auto start = chars.GetStart();
+    const auto end = chars.GetEnd();
 
     // Retain compatibility with the strtod() function by allowing starting spaces
     // and a leading + sign, which from_chars() does not accept.
@@ -1739,9 +1927,21 @@ wxString wxString::FromCDouble(double val, int precision)
     if ( res.ec != std::errc{} )
         return {};
 
-    *res.ptr = '\0';
+    return wxString::FromAscii(buf, res.ptr - buf);
+}
+
+/* static */
+wxString wxString::FromCDoubleShortest(double val)
+{
+    char buf[64];
 
-    return wxString::FromAscii(buf);
+    // Without the format argument, to_chars() produces the shortest string
+    // which round trips to the same value, which is exactly what we need.
+    const auto res = std::to_chars(buf, buf + sizeof(buf), val);
+    if ( res.ec != std::errc{} )
+        return {};
+
+    return wxString::FromAscii(buf, res.ptr - buf);
 }
 
 #elif wxUSE_XLOCALE
@@ -1895,6 +2095,31 @@ wxString wxString::FromCDouble(double val, int precision)
     return s;
 }
 
+/* static */
+wxString wxString::FromCDoubleShortest(double val)
+{
+    // Without std::to_chars() we have to find the shortest representation
+    // ourselves: 17 significant digits are always enough to represent any
+    // double exactly, but try the shorter precisions first as they're enough
+    // for most "nice" numbers and produce much more readable results.
+    wxString s;
+    for ( int digits = 15; digits <= 17; ++digits )
+    {
+        s = wxString::Format("%.*g", digits, val);
+
+        // See the comment in FromCDouble() above.
+        const size_t posComma = s.find(',');
+        if ( posComma != npos )
+            s[posComma] = '.';
+
+        double d;
+        if ( digits == 17 || (s.ToCDouble(&d) && d == val) )
+            break;
+    }
+
+    return s;
+}
+
 #endif // !__cpp_lib_to_chars
 
 // ---------------------------------------------------------------------------
@@ -1937,6 +2162,22 @@ int wxString::DoPrintfUtf8(const char *format, ...)
 }
 #endif // wxUSE_UNICODE_UTF8
 
+// helper of DoStringPrintfV() below
+static inline void
+AssignPrintfResult(wxString& str, const wchar_t* buf, size_t len)
+{
+    str.assign(buf, len);
+}
+
+#if wxUSE_UNICODE_UTF8
+static inline void
+AssignPrintfResult(wxString& str, const char* buf, size_t len)
+{
+    // this overload is only used under UTF-8 locale
+    str = wxString::FromUTF8Unchecked(buf, len);
+}
+#endif // wxUSE_UNICODE_UTF8
+
 /*
     Uses wxVsnprintf and places the result into the this string.
 
@@ -1980,9 +2221,40 @@ template<typename BufferType>
 static int DoStringPrintfV(wxString& str,
                            const wxString& format, va_list argptr)
 {
-    size_t size = 1024;
     PreserveErrno preserveErrno;
 
+    // Most formatted strings are short, so try formatting into a buffer on
+    // the stack first: this avoids allocating a big buffer on the heap only
+    // to shrink it later and allows reusing the memory already allocated by
+    // the string if it's big enough, e.g. when formatting into the same
+    // string repeatedly.
+    {
+#if wxUSE_UNICODE_UTF8
+        typedef typename BufferType::CharType CharType;
+#else
+        typedef wxChar CharType;
+#endif
+
+        CharType buf[512];
+
+        va_list argptrcopy;
+        wxVaCopy(argptrcopy, argptr);
+        const int len = wxVsnprintf(buf, WXSIZEOF(buf), format, argptrcopy);
+        va_end(argptrcopy);
+
+        // Notice that if the output was truncated, we can get either -1 or
+        // the required length here, depending on the implementation, and we
+        // also fall back to the code below in case of any other error to
+        // handle it there.
+        if ( len >= 0 && static_cast<size_t>(len) < WXSIZEOF(buf) )
+        {
+            AssignPrintfResult(str, buf, len);
+            return str.length();
+        }
+    }
+
+    size_t size = 1024;
+
     for ( ;; )
     {
 #if wxUSE_UNICODE_UTF8
@@ -2253,3 +2525,77 @@ int wxString::Freq(wxUniChar ch) const
     return count;
 }
 
+// ----------------------------------------------------------------------------
+// wxStringAtom
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The table of interned strings is split into several shards, each protected
+// by its own lock and selected by the string hash, so that atoms can be
+// created from different threads without all of them contending for a single
+// lock.
+class wxStringAtomTable
+{
+public:
+    const wxString* Intern(const wxString& str)
+    {
+        Shard& shard = m_shards[wxStringHash()(str) % SHARD_COUNT];
+
+        wxCriticalSectionLocker lock(shard.cs);
+
+        // Notice that the elements of an unordered set are never moved in
+        // memory, so it's safe to return the pointer to them.
+        return &*shard.strings.insert(str).first;
+    }
+
+    size_t GetCount()
+    {
+        size_t count = 0;
+        for ( Shard& shard : m_shards )
+        {
+            wxCriticalSectionLocker lock(shard.cs);
+            count += shard.strings.size();
+        }
+
+        return count;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Shard
+    {
+        wxCriticalSection cs;
+        std::unordered_set<wxString, wxStringHash, wxStringEqual> strings;
+    };
+
+    Shard m_shards[SHARD_COUNT];
+};
+
+wxStringAtomTable& GetStringAtomTable()
+{
+    static wxStringAtomTable s_table;
+    return s_table;
+}
+
+} // anonymous namespace
+
+const wxString wxStringAtom::ms_empty;
+
+/* static */
+const wxString* wxStringAtom::Intern(const wxString& str)
+{
+    // The empty string is not stored in the table, see ms_empty.
+    if ( str.empty() )
+        return &ms_empty;
+
+    return GetStringAtomTable().Intern(str);
+}
+
+/* static */
+size_t wxStringAtom::GetCount()
+{
+    return GetStringAtomTable().GetCount();
+}
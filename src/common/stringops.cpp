@@ -25,8 +25,44 @@
 // implementation
 // ===========================================================================
 
+namespace
+{
+
+// compare 8 bytes at once for as long as possible, this is significantly
+// faster than comparing the characters one by one for long strings
+template <typename T>
+size_t DoGetCommonPrefixLength(const T *s1, const T *s2, size_t len)
+{
+    const size_t charsPerWord = sizeof(wxUint64) / sizeof(T);
+
+    size_t n = 0;
+    for ( ; n + charsPerWord <= len; n += charsPerWord )
+    {
+        wxUint64 w1, w2;
+        memcpy(&w1, s1 + n, sizeof(w1));
+        memcpy(&w2, s2 + n, sizeof(w2));
+        if ( w1 != w2 )
+            break;
+    }
+
+    while ( n < len && s1[n] == s2[n] )
+        n++;
+
+    return n;
+}
+
+} // anonymous namespace
+
 #if wxUSE_UNICODE_WCHAR
 
+size_t
+wxStringOperationsWchar::GetCommonPrefixLength(const wchar_t *s1,
+                                               const wchar_t *s2,
+                                               size_t len)
+{
+    return DoGetCommonPrefixLength(s1, s2, len);
+}
+
 #if wxUSE_UNICODE_UTF16
 
 wxStringOperationsWchar::Utf16CharBuffer wxStringOperationsWchar::EncodeChar(const wxUniChar& ch)
@@ -103,6 +139,61 @@ unsigned char wxStringOperationsUtf8::GetUTF8IterOffset(unsigned char c)
     return l;
 }
 
+size_t wxStringOperationsUtf8::GetASCIIPrefixLength(const char *str, size_t len)
+{
+    size_t n = 0;
+
+    // check 8 bytes at once for as long as possible
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        wxUint64 bytes;
+        memcpy(&bytes, str + n, sizeof(bytes));
+        if ( bytes & wxULL(0x8080808080808080) )
+            break;
+    }
+
+    while ( n < len && !(static_cast<unsigned char>(str[n]) & 0x80) )
+        n++;
+
+    return n;
+}
+
+size_t wxStringOperationsUtf8::CountChars(const char *str, size_t len)
+{
+    // every character contains exactly one byte which is not a continuation
+    // byte, i.e. is not of the form 10xxxxxx, so count the continuation bytes
+    // and subtract them from the total, doing it for 8 bytes at once: the
+    // high bit of each byte of "cont" is set iff it's a continuation byte
+    size_t count = len;
+    size_t n = 0;
+    for ( ; n + 8 <= len; n += 8 )
+    {
+        wxUint64 bytes;
+        memcpy(&bytes, str + n, sizeof(bytes));
+
+        const wxUint64 cont = bytes & ~(bytes << 1) & wxULL(0x8080808080808080);
+
+        // this sums the (0 or 1) high bits of all bytes in the topmost one
+        count -= static_cast<size_t>(((cont >> 7) * wxULL(0x0101010101010101)) >> 56);
+    }
+
+    for ( ; n < len; n++ )
+    {
+        if ( (static_cast<unsigned char>(str[n]) & 0xC0) == 0x80 )
+            count--;
+    }
+
+    return count;
+}
+
+size_t
+wxStringOperationsUtf8::GetCommonPrefixLength(const char *s1,
+                                              const char *s2,
+                                              size_t len)
+{
+    return DoGetCommonPrefixLength(s1, s2, len);
+}
+
 // ---------------------------------------------------------------------------
 // UTF-8 operations
 // ---------------------------------------------------------------------------
@@ -142,7 +233,13 @@ bool wxStringOperationsUtf8::IsValidUtf8String(const char *str, size_t len)
         }
 
         if ( b <= 0x7F ) // 00..7F
+        {
+            // skip all the following ASCII characters at once if we can
+            if ( end != nullptr )
+                c += GetASCIIPrefixLength((const char*)c + 1, end - c - 1);
+
             continue;
+        }
 
         else if ( b < 0xC2 ) // invalid lead bytes: 80..C1
             return false;
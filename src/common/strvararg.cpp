@@ -793,12 +793,55 @@ void DoValidateFormat(const CharType* format, const std::vector<int>& argTypes)
     }
 }
 
+// Same as DoValidateFormat() but for the format strings parsed at compile-time.
+void
+DoValidateArgTypes(const wxFormatString& format,
+                   const unsigned short* types,
+                   unsigned numTypes,
+                   const std::vector<int>& argTypes)
+{
+    if ( numTypes > argTypes.size() )
+    {
+        wxFAIL_MSG
+        (
+            wxString::Format
+            (
+                "Not enough arguments, %zu given but at least %u needed",
+                argTypes.size(),
+                numTypes
+            )
+        );
+
+        return;
+    }
+
+    for ( unsigned n = 0; n < numTypes; ++n )
+    {
+        wxASSERT_MSG
+        (
+            (types[n] & argTypes[n]) == types[n],
+            wxString::Format
+            (
+                "Format specifier mismatch for argument %u of \"%s\"",
+                n + 1, format.InputAsString()
+            )
+        );
+    }
+}
+
 #endif // wxDEBUG_LEVEL
 
 } // anonymous namespace
 
 wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 {
+    wxCHECK_MSG( n > 0, Arg_Unknown, "argument indices are 1-based" );
+
+    // there is no need to parse the string if we already know the types
+    if ( m_argTypes )
+        return n > m_numArgTypes ? Arg_Unused
+                                 : static_cast<ArgumentType>(m_argTypes[n - 1]);
+
     if ( m_char )
         return DoGetArgumentType(m_char.data(), n);
     else if ( m_wchar )
@@ -816,7 +859,9 @@ wxFormatString::ArgumentType wxFormatString::GetArgumentType(unsigned n) const
 
 void wxFormatString::Validate(const std::vector<int>& argTypes) const
 {
-    if ( m_char )
+    if ( m_argTypes )
+        DoValidateArgTypes(*this, m_argTypes, m_numArgTypes, argTypes);
+    else if ( m_char )
         DoValidateFormat(m_char.data(), argTypes);
     else if ( m_wchar )
         DoValidateFormat(m_wchar.data(), argTypes);
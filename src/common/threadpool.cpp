@@ -0,0 +1,666 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool and wxFuture implementation
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// For compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_THREADS
+
+#include "wx/threadpool.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include <deque>
+
+// ============================================================================
+// wxThreadPool implementation
+// ============================================================================
+
+// A queue of tasks: the worker owning it takes the tasks from its back, while
+// the other threads steal them from its front.
+struct wxThreadPool::Queue
+{
+    Queue() : m_size(0) { }
+
+    void PushBack(wxTask* task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        m_tasks.push_back(task);
+        m_size++;
+    }
+
+    wxTask* PopBack()
+    {
+        // Avoid locking the critical section if there is nothing to take, as
+        // this is a common case when looking for the tasks to steal.
+        if ( !m_size.load() )
+            return nullptr;
+
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_tasks.empty() )
+            return nullptr;
+
+        wxTask* const task = m_tasks.back();
+        m_tasks.pop_back();
+        m_size--;
+
+        return task;
+    }
+
+    wxTask* PopFront()
+    {
+        if ( !m_size.load() )
+            return nullptr;
+
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_tasks.empty() )
+            return nullptr;
+
+        wxTask* const task = m_tasks.front();
+        m_tasks.pop_front();
+        m_size--;
+
+        return task;
+    }
+
+    wxCriticalSection m_cs;
+    std::deque<wxTask*> m_tasks;
+
+    // The number of elements in m_tasks which can be read without locking.
+    std::atomic<size_t> m_size;
+};
+
+class wxThreadPoolWorker : public wxThread
+{
+public:
+    wxThreadPoolWorker(wxThreadPool& pool, size_t index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool),
+          m_index(index)
+    {
+    }
+
+    wxThreadPool& m_pool;
+    const size_t m_index;
+
+    // The tasks posted from this worker thread.
+    wxThreadPool::Queue m_queue;
+
+    // True if the thread was successfully started.
+    bool m_running = false;
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_pool.WorkerMain(this);
+
+        return nullptr;
+    }
+};
+
+namespace
+{
+
+// The worker running in the current thread, if any.
+thread_local wxThreadPoolWorker* gs_currentWorker = nullptr;
+
+// The global pool returned by wxThreadPool::Get().
+wxThreadPool* gs_globalPool = nullptr;
+
+// Set once the global pool is destroyed during the library shutdown.
+bool gs_globalPoolDestroyed = false;
+
+wxCRIT_SECT_DECLARE(gs_csGlobalPool);
+
+// The state shared by all threads executing wxThreadPool::ParallelFor().
+struct wxParallelForState
+{
+    wxParallelForState(size_t begin_,
+                       size_t end_,
+                       size_t grainSize_,
+                       const std::function<void (size_t, size_t)>& func_)
+        : begin(begin_),
+          end(end_),
+          grainSize(grainSize_),
+          numChunks((end_ - begin_ + grainSize_ - 1) / grainSize_),
+          func(func_),
+          nextChunk(0),
+          numDone(0),
+          condition(mutex)
+    {
+    }
+
+    // Execute the chunks until there are no more of them left.
+    void RunChunks()
+    {
+        for ( ;; )
+        {
+            const size_t chunk = nextChunk++;
+            if ( chunk >= numChunks )
+                break;
+
+            // Notice that func is only used after taking a chunk, i.e. only
+            // while DoParallelFor() is waiting for it to be done.
+            const size_t from = begin + chunk*grainSize;
+            const size_t to = wxMin(from + grainSize, end);
+
+#if wxUSE_EXCEPTIONS
+            try
+            {
+                func(from, to);
+            }
+            catch ( ... )
+            {
+                wxMutexLocker lock(mutex);
+
+                if ( !exception )
+                    exception = std::current_exception();
+            }
+#else // !wxUSE_EXCEPTIONS
+            func(from, to);
+#endif // wxUSE_EXCEPTIONS/!wxUSE_EXCEPTIONS
+
+            if ( ++numDone == numChunks )
+            {
+                wxMutexLocker lock(mutex);
+                condition.Broadcast();
+            }
+        }
+    }
+
+    const size_t begin,
+                 end,
+                 grainSize,
+                 numChunks;
+
+    const std::function<void (size_t, size_t)>& func;
+
+    std::atomic<size_t> nextChunk,
+                        numDone;
+
+    wxMutex mutex;
+    wxCondition condition;
+
+#if wxUSE_EXCEPTIONS
+    // The first exception thrown by func, protected by mutex.
+    std::exception_ptr exception;
+#endif // wxUSE_EXCEPTIONS
+};
+
+class wxParallelForTask : public wxTask
+{
+public:
+    explicit wxParallelForTask(const std::shared_ptr<wxParallelForState>& state)
+        : m_state(state)
+    {
+    }
+
+    virtual void Run() override
+    {
+        m_state->RunChunks();
+    }
+
+private:
+    const std::shared_ptr<wxParallelForState> m_state;
+};
+
+} // anonymous namespace
+
+wxThreadPool::wxThreadPool(unsigned numThreads)
+    : m_injected(new Queue),
+      m_numQueued(0),
+      m_numSleeping(0),
+      m_stopping(false),
+      m_wakeUpCondition(m_wakeUpMutex)
+{
+    if ( !numThreads )
+    {
+        const int numCPUs = wxThread::GetCPUCount();
+        numThreads = numCPUs > 0 ? numCPUs : 1;
+    }
+
+    // Create all workers before starting any of them, as they access
+    // m_workers when looking for the tasks to steal.
+    for ( unsigned n = 0; n < numThreads; n++ )
+        m_workers.push_back(new wxThreadPoolWorker(*this, n));
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        if ( m_workers[n]->Run() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to start thread pool worker %zu.", n);
+            continue;
+        }
+
+        m_workers[n]->m_running = true;
+        m_numRunning++;
+    }
+}
+
+wxThreadPool::wxThreadPool(NoThreadsTag)
+    : m_injected(new Queue),
+      m_numQueued(0),
+      m_numSleeping(0),
+      m_stopping(false),
+      m_wakeUpCondition(m_wakeUpMutex)
+{
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    {
+        wxMutexLocker lock(m_wakeUpMutex);
+
+        m_stopping = true;
+        m_wakeUpCondition.Broadcast();
+    }
+
+    // The workers only exit when there are no more tasks left.
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        if ( m_workers[n]->m_running )
+            m_workers[n]->Wait();
+
+        delete m_workers[n];
+    }
+
+    delete m_injected;
+}
+
+/* static */
+wxThreadPool& wxThreadPool::Get()
+{
+    wxCRIT_SECT_LOCKER(lock, gs_csGlobalPool);
+
+    if ( !gs_globalPool )
+    {
+        if ( gs_globalPoolDestroyed )
+        {
+            // We can't create a new pool as nothing would destroy it, so
+            // return the pool executing all tasks in the calling thread.
+            wxFAIL_MSG( "wxThreadPool::Get() can't be used after shutdown" );
+
+            static wxThreadPool s_poolWithoutThreads(NoThreadsTag{});
+            return s_poolWithoutThreads;
+        }
+
+        gs_globalPool = new wxThreadPool();
+    }
+
+    return *gs_globalPool;
+}
+
+unsigned wxThreadPool::GetThreadCount() const
+{
+    return m_numRunning;
+}
+
+void wxThreadPool::Post(wxTask* task)
+{
+    wxCHECK_RET( task, "null task can't be posted" );
+
+    // The tasks posted by a worker, e.g. the subtasks of its current task,
+    // are put in its own queue, where they're likely to be taken by it.
+    wxThreadPoolWorker* const worker = gs_currentWorker;
+    if ( worker && &worker->m_pool == this )
+        worker->m_queue.PushBack(task);
+    else
+        m_injected->PushBack(task);
+
+    m_numQueued++;
+
+    if ( !m_numRunning )
+    {
+        // Not much else we can do if we couldn't start any threads.
+        RunPendingTask();
+        return;
+    }
+
+    WakeUpWorker();
+}
+
+void wxThreadPool::WakeUpAll()
+{
+    wxMutexLocker lock(m_wakeUpMutex);
+    m_wakeUpCondition.Broadcast();
+}
+
+void wxThreadPool::WakeUpWorker()
+{
+    // Notice that m_numSleeping is incremented before checking m_numQueued in
+    // WorkerMain(), while m_numQueued was incremented before calling this
+    // function, so either we see the sleeping worker here or it sees the new
+    // task there.
+    if ( !m_numSleeping.load() )
+        return;
+
+    wxMutexLocker lock(m_wakeUpMutex);
+    m_wakeUpCondition.Signal();
+}
+
+wxTask* wxThreadPool::GetTaskFor(wxThreadPoolWorker* worker)
+{
+    // Take the most recently posted own task first, as it's more likely to
+    // use the data still in the cache, then the oldest task posted from
+    // outside and, finally, the oldest task posted by another worker.
+    wxTask* task = worker ? worker->m_queue.PopBack() : nullptr;
+
+    if ( !task )
+        task = m_injected->PopFront();
+
+    const size_t count = m_workers.size();
+    const size_t start = worker ? worker->m_index + 1 : 0;
+    for ( size_t n = 0; n < count && !task; n++ )
+    {
+        wxThreadPoolWorker* const victim = m_workers[(start + n) % count];
+        if ( victim != worker )
+            task = victim->m_queue.PopFront();
+    }
+
+    if ( task )
+        m_numQueued--;
+
+    return task;
+}
+
+void wxThreadPool::RunTask(wxTask* task)
+{
+    std::unique_ptr<wxTask> ptr(task);
+
+    ptr->Run();
+}
+
+bool wxThreadPool::RunPendingTask()
+{
+    wxThreadPoolWorker* worker = gs_currentWorker;
+    if ( worker && &worker->m_pool != this )
+        worker = nullptr;
+
+    wxTask* const task = GetTaskFor(worker);
+    if ( !task )
+        return false;
+
+    RunTask(task);
+
+    return true;
+}
+
+void wxThreadPool::WorkerMain(wxThreadPoolWorker* worker)
+{
+    gs_currentWorker = worker;
+
+    for ( ;; )
+    {
+        if ( wxTask* const task = GetTaskFor(worker) )
+        {
+            RunTask(task);
+            continue;
+        }
+
+        wxMutexLocker lock(m_wakeUpMutex);
+
+        m_numSleeping++;
+        while ( !m_numQueued.load() && !m_stopping.load() )
+            m_wakeUpCondition.Wait();
+        m_numSleeping--;
+
+        if ( m_stopping.load() && !m_numQueued.load() )
+            break;
+    }
+
+    gs_currentWorker = nullptr;
+}
+
+void wxThreadPool::WaitExecutingTasks(const wxFutureStateBase& state)
+{
+    while ( !state.IsReady() )
+    {
+        if ( RunPendingTask() )
+            continue;
+
+        // The task we're waiting for must be running in another thread, so
+        // sleep until either it completes, which wakes us up using
+        // WakeUpAll(), or another task is posted.
+        wxMutexLocker lock(m_wakeUpMutex);
+
+        m_numSleeping++;
+        while ( !m_numQueued.load() && !state.IsReady() )
+            m_wakeUpCondition.Wait();
+        m_numSleeping--;
+    }
+}
+
+void wxThreadPool::DoParallelFor(size_t begin,
+                                 size_t end,
+                                 size_t grainSize,
+                                 const std::function<void (size_t, size_t)>& func)
+{
+    if ( begin >= end )
+        return;
+
+    const size_t numThreads = m_numRunning + 1;
+    if ( !grainSize )
+    {
+        // Use a few chunks per thread to balance the load between them if
+        // some chunks take longer than the others.
+        const size_t numChunks = 4*numThreads;
+        grainSize = (end - begin + numChunks - 1) / numChunks;
+    }
+
+    std::shared_ptr<wxParallelForState>
+        state(new wxParallelForState(begin, end, grainSize, func));
+
+    // The current thread executes the chunks too, so one helper task less is
+    // needed. Also notice that the helper tasks may only start running after
+    // all chunks are done, in which case they just return immediately.
+    const size_t numHelpers = wxMin(state->numChunks, numThreads) - 1;
+    for ( size_t n = 0; n < numHelpers; n++ )
+        Post(new wxParallelForTask(state));
+
+    state->RunChunks();
+
+    // The remaining chunks are being executed by the other threads, so we
+    // can just wait until they're done.
+    {
+        wxMutexLocker lock(state->mutex);
+
+        while ( state->numDone.load() < state->numChunks )
+            state->condition.Wait();
+    }
+
+#if wxUSE_EXCEPTIONS
+    if ( state->exception )
+        std::rethrow_exception(state->exception);
+#endif // wxUSE_EXCEPTIONS
+}
+
+// ----------------------------------------------------------------------------
+// wxFutureStateBase
+// ----------------------------------------------------------------------------
+
+wxFutureStateBase::wxFutureStateBase()
+    : m_ready(false),
+      m_condition(m_mutex)
+{
+}
+
+wxFutureStateBase::~wxFutureStateBase()
+{
+}
+
+void wxFutureStateBase::Wait()
+{
+    if ( IsReady() )
+        return;
+
+    if ( wxThreadPoolWorker* const worker = gs_currentWorker )
+    {
+        // Blocking the worker thread could result in a deadlock if the task
+        // we're waiting for hasn't started yet and all the other workers are
+        // blocked too, so execute the other tasks while waiting.
+        wxThreadPool& pool = worker->m_pool;
+
+        // Often the task we're waiting for is among the pending ones, so try
+        // executing them first, as this doesn't require any locking here.
+        while ( !IsReady() && pool.RunPendingTask() )
+            ;
+
+        if ( IsReady() )
+            return;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            if ( m_ready.load() )
+                return;
+
+            m_waitingPools.push_back(&pool);
+        }
+
+        pool.WaitExecutingTasks(*this);
+
+        // Notice that SetReady() can still be using the pool, so don't return
+        // before it stops doing it, as the pool could be destroyed then.
+        wxMutexLocker lock(m_mutex);
+        for ( size_t n = 0; n < m_waitingPools.size(); n++ )
+        {
+            if ( m_waitingPools[n] == &pool )
+            {
+                m_waitingPools.erase(m_waitingPools.begin() + n);
+                break;
+            }
+        }
+
+        return;
+    }
+
+    wxMutexLocker lock(m_mutex);
+
+    while ( !m_ready.load() )
+        m_condition.Wait();
+}
+
+void wxFutureStateBase::SetReady()
+{
+    wxVector<std::function<void()>> onReady;
+
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_ready = true;
+        m_condition.Broadcast();
+
+        for ( size_t n = 0; n < m_waitingPools.size(); n++ )
+            m_waitingPools[n]->WakeUpAll();
+
+        onReady.swap(m_onReady);
+    }
+
+    for ( size_t n = 0; n < onReady.size(); n++ )
+        onReady[n]();
+}
+
+void wxFutureStateBase::SetCancelled()
+{
+    m_cancelled = true;
+
+    SetReady();
+}
+
+#if wxUSE_EXCEPTIONS
+
+void wxFutureStateBase::SetException(std::exception_ptr exception)
+{
+    m_exception = exception;
+
+    SetReady();
+}
+
+void wxFutureStateBase::RethrowIfFailed() const
+{
+    if ( m_exception )
+        std::rethrow_exception(m_exception);
+}
+
+#endif // wxUSE_EXCEPTIONS
+
+void wxFutureStateBase::OnReady(const std::function<void()>& func)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( !m_ready.load() )
+        {
+            m_onReady.push_back(func);
+            return;
+        }
+    }
+
+    func();
+}
+
+void wxFutureStateBase::CallAfterReady(const std::function<void()>& func)
+{
+    OnReady([func]()
+        {
+            if ( wxTheApp )
+                wxTheApp->CallAfter(func);
+        });
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule: destroys the global pool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule()
+    {
+        // The pool threads must be stopped before the threads module cleanup.
+        AddDependency("wxThreadModule");
+    }
+
+    virtual bool OnInit() override
+    {
+        gs_globalPoolDestroyed = false;
+
+        return true;
+    }
+
+    virtual void OnExit() override
+    {
+        wxCRIT_SECT_LOCKER(lock, gs_csGlobalPool);
+
+        wxDELETE(gs_globalPool);
+        gs_globalPoolDestroyed = true;
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
@@ -70,6 +70,38 @@ find_first_not_of(const wxChar *delims, size_t len,
     return end;
 }
 
+// replace wxTOKEN_DEFAULT with the mode actually used for these delimiters
+static wxStringTokenizerMode
+GetActualMode(const wxString& delims, wxStringTokenizerMode mode)
+{
+    if ( mode == wxTOKEN_DEFAULT )
+    {
+        // by default, we behave like strtok() if the delimiters are only
+        // whitespace characters and as wxTOKEN_RET_EMPTY otherwise (for
+        // whitespace delimiters, strtok() behaviour is better because we want
+        // to count consecutive spaces as one delimiter)
+        wxString::const_iterator p;
+        for ( p = delims.begin(); p != delims.end(); ++p )
+        {
+            if ( !wxIsspace(*p) )
+                break;
+        }
+
+        if ( p != delims.end() )
+        {
+            // not whitespace char in delims
+            mode = wxTOKEN_RET_EMPTY;
+        }
+        else
+        {
+            // only whitespaces
+            mode = wxTOKEN_STRTOK;
+        }
+    }
+
+    return mode;
+}
+
 // ----------------------------------------------------------------------------
 // wxStringTokenizer construction
 // ----------------------------------------------------------------------------
@@ -101,35 +133,10 @@ void wxStringTokenizer::SetString(const wxString& str,
                                   const wxString& delims,
                                   wxStringTokenizerMode mode)
 {
-    if ( mode == wxTOKEN_DEFAULT )
-    {
-        // by default, we behave like strtok() if the delimiters are only
-        // whitespace characters and as wxTOKEN_RET_EMPTY otherwise (for
-        // whitespace delimiters, strtok() behaviour is better because we want
-        // to count consecutive spaces as one delimiter)
-        wxString::const_iterator p;
-        for ( p = delims.begin(); p != delims.end(); ++p )
-        {
-            if ( !wxIsspace(*p) )
-                break;
-        }
-
-        if ( p != delims.end() )
-        {
-            // not whitespace char in delims
-            mode = wxTOKEN_RET_EMPTY;
-        }
-        else
-        {
-            // only whitespaces
-            mode = wxTOKEN_STRTOK;
-        }
-    }
-
     m_delims = delims.wc_str();
     m_delimsLen = delims.length();
 
-    m_mode = mode;
+    m_mode = GetActualMode(delims, mode);
 
     Reinit(str);
 }
@@ -226,21 +233,11 @@ size_t wxStringTokenizer::CountTokens() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("you should call SetString() first") );
 
-    // VZ: this function is IMHO not very useful, so it's probably not very
-    //     important if its implementation here is not as efficient as it
-    //     could be -- but OTOH like this we're sure to get the correct answer
-    //     in all modes
-    wxStringTokenizer tkz(wxString(m_pos, m_stringEnd), m_delims, m_mode);
-
-    size_t count = 0;
-    while ( tkz.HasMoreTokens() )
-    {
-        count++;
+    // use a new tokenizer to be sure to get the correct answer in all modes,
+    // but avoid allocating memory for all the tokens
+    const wxString rest = GetString();
 
-        (void)tkz.GetNextToken();
-    }
-
-    return count;
+    return wxStringViewTokenizer(rest, m_delims, m_mode).CountTokens();
 }
 
 // ----------------------------------------------------------------------------
@@ -297,6 +294,225 @@ wxString wxStringTokenizer::GetNextToken()
     return token;
 }
 
+// ============================================================================
+// wxStringViewTokenizer
+// ============================================================================
+
+wxStringViewTokenizer::wxStringViewTokenizer(const wxString& str,
+                                             const wxString& delims,
+                                             wxStringTokenizerMode mode)
+{
+#if wxUSE_UNICODE_UTF8
+    Init(str.wx_str(), str.utf8_length(), delims, mode);
+#else
+    Init(str.wx_str(), str.length(), delims, mode);
+#endif
+}
+
+wxStringViewTokenizer::wxStringViewTokenizer(const wxStringTokenView& str,
+                                             const wxString& delims,
+                                             wxStringTokenizerMode mode)
+{
+    Init(str.data(), str.size(), delims, mode);
+}
+
+void wxStringViewTokenizer::Init(const wxStringCharType* str, size_t len,
+                                 const wxString& delims,
+                                 wxStringTokenizerMode mode)
+{
+    m_start =
+    m_pos = str;
+    m_end = str + len;
+    m_nonDelim = nullptr;
+
+#if wxUSE_UNICODE_UTF8
+    m_delims.assign(delims.wx_str(), delims.utf8_length());
+#else
+    m_delims.assign(delims.wx_str(), delims.length());
+#endif
+
+    // ASCII delimiters are by far the most common ones, so check for them
+    // using a bit mask instead of searching in m_delims
+    memset(m_asciiDelims, 0, sizeof(m_asciiDelims));
+    m_hasNonASCIIDelims = false;
+    for ( wxString::const_iterator p = delims.begin(); p != delims.end(); ++p )
+    {
+        const wxUniChar ch = *p;
+        if ( ch.IsAscii() )
+        {
+            const unsigned n = ch.GetValue();
+            m_asciiDelims[n >> 5] |= 1u << (n & 31);
+        }
+        else
+        {
+            m_hasNonASCIIDelims = true;
+        }
+    }
+
+    // and a single delimiter, which is even more common, can be found even
+    // more efficiently
+    m_singleDelim = m_delims.length() == 1 ? m_delims[0] : wxT('\0');
+
+    m_mode = GetActualMode(delims, mode);
+    m_lastDelim = wxT('\0');
+}
+
+size_t wxStringViewTokenizer::GetDelimLength(const wxStringCharType* p) const
+{
+#if wxUSE_UNICODE_UTF8
+    const unsigned ch = static_cast<unsigned char>(*p);
+#else
+    const wxUint32 ch = static_cast<wxUint32>(*p);
+#endif
+
+    if ( ch < 0x80 )
+        return (m_asciiDelims[ch >> 5] >> (ch & 31)) & 1;
+
+    if ( !m_hasNonASCIIDelims )
+        return 0;
+
+#if wxUSE_UNICODE_UTF8
+    // UTF-8 encoding of a delimiter can only start with a lead byte and can't
+    // be found in the middle of any other character, so we can match it at
+    // any lead byte
+    if ( (ch & 0xC0) != 0xC0 )
+        return 0;
+
+    const size_t len = wxStringOperations::GetUtf8CharLength(*p);
+    if ( len > static_cast<size_t>(m_end - p) )
+        return 0;
+#else
+    const size_t len = 1;
+#endif
+
+    return m_delims.find(p, 0, len) == wxStringImpl::npos ? 0 : len;
+}
+
+const wxStringCharType*
+wxStringViewTokenizer::FindDelim(const wxStringCharType* from) const
+{
+    if ( m_singleDelim )
+    {
+        const wxStringCharType* const p =
+            std::char_traits<wxStringCharType>::find(from, m_end - from,
+                                                     m_singleDelim);
+        return p ? p : m_end;
+    }
+
+    // notice that we don't need to skip over whole characters in UTF-8 build
+    // here, see the comment in GetDelimLength()
+    for ( const wxStringCharType* p = from; p != m_end; ++p )
+    {
+        if ( GetDelimLength(p) )
+            return p;
+    }
+
+    return m_end;
+}
+
+const wxStringCharType*
+wxStringViewTokenizer::FindNonDelim(const wxStringCharType* from) const
+{
+    for ( const wxStringCharType* p = from; p != m_end; )
+    {
+        const size_t len = GetDelimLength(p);
+        if ( !len )
+            return p;
+
+        p += len;
+    }
+
+    return m_end;
+}
+
+bool wxStringViewTokenizer::HasMoreTokens() const
+{
+    // the cached value remains valid while m_pos doesn't go beyond it as all
+    // the characters before it are delimiters
+    if ( !m_nonDelim || m_nonDelim < m_pos )
+        m_nonDelim = FindNonDelim(m_pos);
+
+    if ( m_nonDelim != m_end )
+        return true;
+
+    // see the comments in wxStringTokenizer::DoHasMoreTokens()
+    switch ( m_mode )
+    {
+        case wxTOKEN_RET_EMPTY:
+        case wxTOKEN_RET_DELIMS:
+            return m_start != m_end && m_pos == m_start;
+
+        case wxTOKEN_RET_EMPTY_ALL:
+            return m_pos < m_end || m_lastDelim != wxT('\0');
+
+        case wxTOKEN_INVALID:
+        case wxTOKEN_DEFAULT:
+            wxFAIL_MSG( wxT("unexpected tokenizer mode") );
+            wxFALLTHROUGH;
+
+        case wxTOKEN_STRTOK:
+            break;
+    }
+
+    return false;
+}
+
+size_t wxStringViewTokenizer::CountTokens() const
+{
+    // copying doesn't copy the string being tokenized, only the delimiters,
+    // which are usually short enough to not require any allocations
+    wxStringViewTokenizer tkz(*this);
+
+    size_t count = 0;
+    while ( tkz.HasMoreTokens() )
+    {
+        count++;
+
+        (void)tkz.GetNextToken();
+    }
+
+    return count;
+}
+
+wxStringTokenView wxStringViewTokenizer::GetNextToken()
+{
+    wxStringTokenView token;
+    do
+    {
+        if ( !HasMoreTokens() )
+            break;
+
+        const wxStringCharType* const pos = FindDelim(m_pos);
+        if ( pos == m_end )
+        {
+            token = wxStringTokenView(m_pos, m_end - m_pos);
+            m_pos = m_end;
+            m_lastDelim = wxT('\0');
+        }
+        else // we found a delimiter at pos
+        {
+            const size_t len = GetDelimLength(pos);
+
+            const wxStringCharType* tokenEnd = pos;
+            if ( m_mode == wxTOKEN_RET_DELIMS )
+                tokenEnd += len;
+
+            token = wxStringTokenView(m_pos, tokenEnd - m_pos);
+            m_pos = pos + len;
+
+#if wxUSE_UNICODE_UTF8
+            m_lastDelim = (wxChar)wxStringOperations::DecodeChar(
+                            m_delims.begin() + m_delims.find(pos, 0, len));
+#else
+            m_lastDelim = *pos;
+#endif
+        }
+    }
+    while ( !AllowEmpty() && token.empty() );
+
+    return token;
+}
+
 // ----------------------------------------------------------------------------
 // public functions
 // ----------------------------------------------------------------------------
@@ -306,10 +522,10 @@ wxArrayString wxStringTokenize(const wxString& str,
                                wxStringTokenizerMode mode)
 {
     wxArrayString tokens;
-    wxStringTokenizer tk(str, delims, mode);
+    wxStringViewTokenizer tk(str, delims, mode);
     while ( tk.HasMoreTokens() )
     {
-        tokens.Add(tk.GetNextToken());
+        tokens.Add(tk.GetNextToken().ToString());
     }
 
     return tokens;
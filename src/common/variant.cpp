@@ -836,9 +836,19 @@ class WXDLLIMPEXP_BASE wxVariantDataString: public wxVariantData
 public:
     wxVariantDataString() { }
     wxVariantDataString(const wxString& value) : m_value(value) { }
+    wxVariantDataString(const wxStringAtom& atom) : m_atom(atom) { }
 
-    inline wxString GetValue() const { return m_value; }
-    inline void SetValue(const wxString& value) { m_value = value; }
+    // notice that only one of m_value and m_atom is used, the other one is
+    // always empty
+    inline const wxString& GetValue() const
+        { return m_atom.IsEmpty() ? m_value : m_atom.GetString(); }
+    inline void SetValue(const wxString& value)
+        { m_value = value; m_atom = wxStringAtom(); }
+
+    inline wxStringAtom GetAtom() const
+        { return m_atom.IsEmpty() ? wxStringAtom(m_value) : m_atom; }
+    inline void SetAtom(const wxStringAtom& atom)
+        { m_value.clear(); m_atom = atom; }
 
     virtual bool Eq(wxVariantData& data) const override;
 #if wxUSE_STD_IOSTREAM
@@ -854,14 +864,34 @@ public:
     virtual bool Write(wxOutputStream& str) const;
 #endif // wxUSE_STREAMS
     virtual wxString GetType() const override { return wxT("string"); }
-    wxVariantData* Clone() const override { return new wxVariantDataString(m_value); }
+    wxVariantData* Clone() const override
+    {
+        return m_atom.IsEmpty() ? new wxVariantDataString(m_value)
+                                : new wxVariantDataString(m_atom);
+    }
 
     DECLARE_WXANY_CONVERSION()
 protected:
     wxString m_value;
+
+    // strings created from atoms are stored as atoms to avoid copying them
+    wxStringAtom m_atom;
 };
 
-IMPLEMENT_TRIVIAL_WXANY_CONVERSION(wxString, wxVariantDataString)
+#if wxUSE_ANY
+bool wxVariantDataString::GetAsAny(wxAny* any) const
+{
+    *any = GetValue();
+    return true;
+}
+
+wxVariantData* wxVariantDataString::VariantDataFactory(const wxAny& any)
+{
+    return new wxVariantDataString(any.As<wxString>());
+}
+
+REGISTER_WXANY_CONVERSION(wxString, wxVariantDataString)
+#endif // wxUSE_ANY
 
 #if wxUSE_ANY
 // This allows converting string literal wxAnys to string variants
@@ -889,20 +919,24 @@ bool wxVariantDataString::Eq(wxVariantData& data) const
 
     wxVariantDataString& otherData = (wxVariantDataString&) data;
 
-    return (otherData.m_value == m_value);
+    // different atoms always correspond to different strings
+    if ( !m_atom.IsEmpty() && !otherData.m_atom.IsEmpty() )
+        return otherData.m_atom == m_atom;
+
+    return otherData.GetValue() == GetValue();
 }
 
 #if wxUSE_STD_IOSTREAM
 bool wxVariantDataString::Write(std::ostream& str) const
 {
-    str << (const char*) m_value.mb_str();
+    str << (const char*) GetValue().mb_str();
     return true;
 }
 #endif
 
 bool wxVariantDataString::Write(wxString& str) const
 {
-    str = m_value;
+    str = GetValue();
     return true;
 }
 
@@ -911,7 +945,7 @@ bool wxVariantDataString::Write(wxOutputStream& str) const
 {
   // why doesn't wxOutputStream::operator<< take "const wxString&"
     wxTextOutputStream s(str);
-    s.WriteString(m_value);
+    s.WriteString(GetValue());
     return true;
 }
 
@@ -919,14 +953,14 @@ bool wxVariantDataString::Read(wxInputStream& str)
 {
     wxTextInputStream s(str);
 
-    m_value = s.ReadLine();
+    SetValue(s.ReadLine());
     return true;
 }
 #endif // wxUSE_STREAMS
 
 bool wxVariantDataString::Read(wxString& str)
 {
-    m_value = str;
+    SetValue(str);
     return true;
 }
 
@@ -1020,6 +1054,35 @@ wxString wxVariant::GetString() const
     return value;
 }
 
+wxVariant::wxVariant(const wxStringAtom& val, const wxString& name)
+{
+    m_refData = new wxVariantDataString(val);
+    m_name = name;
+}
+
+wxVariant& wxVariant::operator=(const wxStringAtom& value)
+{
+    if (GetType() == wxT("string") &&
+        m_refData->GetRefCount() == 1)
+    {
+        ((wxVariantDataString*)GetData())->SetAtom(value);
+    }
+    else
+    {
+        UnRef();
+        m_refData = new wxVariantDataString(value);
+    }
+    return *this;
+}
+
+wxStringAtom wxVariant::GetStringAtom() const
+{
+    if (GetType() == wxT("string"))
+        return ((wxVariantDataString*)GetData())->GetAtom();
+
+    return wxStringAtom(GetString());
+}
+
 // ----------------------------------------------------------------------------
 // wxVariantDataWxObjectPtr
 // ----------------------------------------------------------------------------
@@ -96,7 +96,7 @@ using namespace std;
 #include <cairo-quartz.h>
 #endif
 
-// Helper functions for dealing with alpha pre-multiplication.
+// Helper function for dealing with alpha pre-multiplication.
 namespace
 {
 
@@ -105,11 +105,6 @@ namespace
         return alpha ? (data * alpha) / 0xff : data;
     }
 
-    inline unsigned char Unpremultiply(unsigned char alpha, unsigned char data)
-    {
-        return alpha ? (data * 0xff) / alpha : data;
-    }
-
 } // anonymous namespace
 
 class WXDLLIMPEXP_CORE wxCairoPathData : public wxGraphicsPathData
@@ -1759,54 +1754,10 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
 
     int stride = InitBuffer(image.GetWidth(), image.GetHeight(), bufferFormat);
 
-    // Copy wxImage data into the buffer. Notice that we work with wxUint32
-    // values and not bytes becase Cairo always works with buffers in native
-    // endianness.
-    wxUint32* dst = reinterpret_cast<wxUint32*>(m_buffer);
-    const unsigned char* src = image.GetData();
-
-    if ( bufferFormat == CAIRO_FORMAT_ARGB32 )
-    {
-        const unsigned char* alpha = image.GetAlpha();
-
-        for ( int y = 0; y < m_height; y++ )
-        {
-            wxUint32* const rowStartDst = dst;
-
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const unsigned char a = alpha ? *alpha : wxALPHA_OPAQUE;
-
-                *dst++ = a                    << 24 |
-                         ((a * src[0]) / 255) << 16 |
-                         ((a * src[1]) / 255) <<  8 |
-                         ((a * src[2]) / 255);
-                src += 3;
-
-                if ( alpha )
-                    alpha++;
-            }
-
-            dst = rowStartDst + stride / 4;
-        }
-    }
-    else // RGB
-    {
-        for ( int y = 0; y < m_height; y++ )
-        {
-            wxUint32* const rowStartDst = dst;
-
-            for ( int x = 0; x < m_width; x++ )
-            {
-                *dst++ = src[0] << 16 |
-                         src[1] <<  8 |
-                         src[2];
-                src += 3;
-            }
-
-            dst = rowStartDst + stride / 4;
-        }
-    }
+    // Copy wxImage data into the buffer. Notice that opaque pixels have the
+    // same representation in ARGB32 and RGB24 formats, as the alpha byte is
+    // just ignored in the latter one.
+    image.CopyToBuffer(m_buffer, wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED, stride);
 
     // if there is a mask, set the alpha bytes in the target buffer to
     // fully transparent or retain original value
@@ -1816,8 +1767,8 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
         unsigned char mg = image.GetMaskGreen();
         unsigned char mb = image.GetMaskBlue();
 
-        dst = reinterpret_cast<wxUint32*>(m_buffer);
-        src = image.GetData();
+        wxUint32* dst = reinterpret_cast<wxUint32*>(m_buffer);
+        const unsigned char* src = image.GetData();
 
         if ( bufferFormat == CAIRO_FORMAT_ARGB32 )
         {
@@ -1844,17 +1795,16 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
 
 wxImage wxCairoBitmapData::ConvertToImage() const
 {
-    wxImage image(m_width, m_height, false /* don't clear */);
-
     // Get the surface type and format.
     wxCHECK_MSG( cairo_surface_get_type(m_surface) == CAIRO_SURFACE_TYPE_IMAGE,
                  wxNullImage,
                  wxS("Can't convert non-image surface to image.") );
 
+    bool hasAlpha = false;
     switch ( cairo_image_surface_get_format(m_surface) )
     {
         case CAIRO_FORMAT_ARGB32:
-            image.SetAlpha();
+            hasAlpha = true;
             break;
 
         case CAIRO_FORMAT_RGB24:
@@ -1880,54 +1830,39 @@ wxImage wxCairoBitmapData::ConvertToImage() const
     wxCHECK_MSG( stride > 0, wxNullImage,
                  wxS("Failed to get Cairo surface stride.") );
 
+    if ( hasAlpha )
+    {
+        // We need to also copy alpha and undo the pre-multiplication as Cairo
+        // stores pre-multiplied values in this format while wxImage does not.
+        return wxImage(wxImageView(reinterpret_cast<const unsigned char*>(src),
+                                   m_width, m_height,
+                                   wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED,
+                                   stride));
+    }
+
     // As we work with wxUint32 pointers and not char ones, we need to adjust
     // the stride accordingly. This should be lossless as the stride must be a
     // multiple of pixel size.
     wxASSERT_MSG( !(stride % sizeof(wxUint32)), wxS("Unexpected stride.") );
     stride /= sizeof(wxUint32);
 
+    wxImage image(m_width, m_height, false /* don't clear */);
     unsigned char* dst = image.GetData();
-    unsigned char *alpha = image.GetAlpha();
-    if ( alpha )
-    {
-        // We need to also copy alpha and undo the pre-multiplication as Cairo
-        // stores pre-multiplied values in this format while wxImage does not.
-        for ( int y = 0; y < m_height; y++ )
-        {
-            const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const wxUint32 argb = *src++;
-
-                const unsigned char a = argb >> 24;
-                *alpha++ = a;
 
-                // Copy the RGB data undoing the pre-multiplication.
-                *dst++ = Unpremultiply(a, argb >> 16);
-                *dst++ = Unpremultiply(a, argb >>  8);
-                *dst++ = Unpremultiply(a, argb);
-            }
-
-            src = rowStart + stride;
-        }
-    }
-    else // RGB
+    // Things are pretty simple in this case, just copy RGB bytes.
+    for ( int y = 0; y < m_height; y++ )
     {
-        // Things are pretty simple in this case, just copy RGB bytes.
-        for ( int y = 0; y < m_height; y++ )
+        const wxUint32* const rowStart = src;
+        for ( int x = 0; x < m_width; x++ )
         {
-            const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
-            {
-                const wxUint32 argb = *src++;
+            const wxUint32 argb = *src++;
 
-                *dst++ = (argb & 0x00ff0000) >> 16;
-                *dst++ = (argb & 0x0000ff00) >>  8;
-                *dst++ = (argb & 0x000000ff);
-            }
-
-            src = rowStart + stride;
+            *dst++ = (argb & 0x00ff0000) >> 16;
+            *dst++ = (argb & 0x0000ff00) >>  8;
+            *dst++ = (argb & 0x000000ff);
         }
+
+        src = rowStart + stride;
     }
 
     return image;
@@ -603,26 +603,19 @@ void wxBitmap::InitFromImage(const wxImage& image, int depth, double scale)
     GdkPixbuf* pixbuf_dst = gdk_pixbuf_new(GDK_COLORSPACE_RGB, depth == 32, 8, w, h);
     bmpData->m_pixbufNoMask = pixbuf_dst;
     wxASSERT(bmpData->m_bpp == 32 || !gdk_pixbuf_get_has_alpha(bmpData->m_pixbufNoMask));
-    const guchar* src = image.GetData();
+    image.CopyToBuffer(gdk_pixbuf_get_pixels(pixbuf_dst),
+                       depth == 32 ? wxIMAGE_FORMAT_RGBA : wxIMAGE_FORMAT_RGB,
+                       gdk_pixbuf_get_rowstride(pixbuf_dst));
 
-    guchar* dst = gdk_pixbuf_get_pixels(pixbuf_dst);
-    const int dstStride = gdk_pixbuf_get_rowstride(pixbuf_dst);
-    CopyImageData(dst, gdk_pixbuf_get_n_channels(pixbuf_dst), dstStride, src, 3, 3 * w, w, h);
-
-    if (depth == 32 && alpha)
-    {
-        for (int j = 0; j < h; j++, dst += dstStride)
-            for (int i = 0; i < w; i++)
-                dst[i * 4 + 3] = *alpha++;
-    }
     if (image.HasMask())
     {
+        const guchar* src = image.GetData();
         const guchar r = image.GetMaskRed();
         const guchar g = image.GetMaskGreen();
         const guchar b = image.GetMaskBlue();
         cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_A8, w, h);
         const int stride = cairo_image_surface_get_stride(surface);
-        dst = cairo_image_surface_get_data(surface);
+        guchar* dst = cairo_image_surface_get_data(surface);
         memset(dst, 0xff, stride * h);
         for (int j = 0; j < h; j++, dst += stride)
             for (int i = 0; i < w; i++, src += 3)
@@ -48,45 +48,88 @@ wxTimerScheduler *wxTimerScheduler::ms_instance = nullptr;
 
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    DoAddTimer(wxTimerSchedule(timer, expiration));
+    DoAddTimer(timer, expiration);
 }
 
-void wxTimerScheduler::DoAddTimer(const wxTimerSchedule& s)
+void wxTimerScheduler::DoAddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
+    wxASSERT_MSG( timer->GetScheduleIndex() == wxUnixTimerImpl::NOT_SCHEDULED,
+                  wxT("adding the same timer twice?") );
+
+    m_timers.push_back(wxTimerSchedule(timer, expiration, m_nextOrder++));
+    timer->SetScheduleIndex(m_timers.size() - 1);
+    SiftUp(m_timers.size() - 1);
+}
+
+void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
+{
+    const size_t index = timer->GetScheduleIndex();
+    wxCHECK_RET( index < m_timers.size() && m_timers[index].m_timer == timer,
+                 wxT("removing inexistent timer?") );
+
+    DoRemoveAt(index);
+}
+
+void wxTimerScheduler::DoRemoveAt(size_t index)
+{
+    m_timers[index].m_timer->SetScheduleIndex(wxUnixTimerImpl::NOT_SCHEDULED);
+
+    const size_t last = m_timers.size() - 1;
+    if ( index != last )
     {
-        wxASSERT_MSG( node->m_timer != s.m_timer,
-                      wxT("adding the same timer twice?") );
+        // replace the removed element with the last one and restore the heap
+        // property, which could be violated in either direction
+        PlaceAt(index, m_timers[last]);
+        m_timers.pop_back();
+
+        if ( index > 0 && m_timers[index].IsBefore(m_timers[(index - 1) / 2]) )
+            SiftUp(index);
+        else
+            SiftDown(index);
+    }
+    else
+    {
+        m_timers.pop_back();
+    }
+}
 
-        if ( node->m_expiration > s.m_expiration )
+void wxTimerScheduler::SiftUp(size_t index)
+{
+    const wxTimerSchedule s = m_timers[index];
+    while ( index > 0 )
+    {
+        const size_t parent = (index - 1) / 2;
+        if ( !s.IsBefore(m_timers[parent]) )
             break;
-    }
 
-    m_timers.insert(node, s);
+        PlaceAt(index, m_timers[parent]);
+        index = parent;
+    }
 
-    wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
-               s.m_timer->GetId(),
-               s.m_expiration.ToString());
+    PlaceAt(index, s);
 }
 
-void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
+void wxTimerScheduler::SiftDown(size_t index)
 {
-    wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
-
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    const size_t count = m_timers.size();
+    const wxTimerSchedule s = m_timers[index];
+    for ( ;; )
     {
-        if ( node->m_timer == timer )
-        {
-            m_timers.erase(node);
-            return;
-        }
+        size_t child = 2*index + 1;
+        if ( child >= count )
+            break;
+
+        if ( child + 1 < count && m_timers[child + 1].IsBefore(m_timers[child]) )
+            child++;
+
+        if ( !m_timers[child].IsBefore(s) )
+            break;
+
+        PlaceAt(index, m_timers[child]);
+        index = child;
     }
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    PlaceAt(index, s);
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -96,12 +139,20 @@ bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
 
     wxCHECK_MSG( remaining, false, wxT("null pointer") );
 
-    *remaining = m_timers.begin()->m_expiration - wxGetUTCTimeUSec();
+    *remaining = m_timers[0].m_expiration - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
         *remaining = 0;
     }
+    else
+    {
+        // the event loop can't wait for less than a millisecond, so round the
+        // time up to avoid waking up before the timer expiration and then
+        // busy-waiting for it, this also ensures that all the timers expiring
+        // during the same millisecond are notified together
+        *remaining = (*remaining + 999) / 1000 * 1000;
+    }
 
     return true;
 }
@@ -115,56 +166,58 @@ bool wxTimerScheduler::NotifyExpired()
 
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() && m_timers[0].m_expiration <= now )
     {
-        wxTimerSchedule s = *cur;
-        if ( s.m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
-            break;
-        }
-
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
-
-        m_timers.erase(cur);
-
         // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s.m_timer;
+        wxUnixTimerImpl * const timer = m_timers[0].m_timer;
+        DoRemoveAt(0);
+
         if ( timer->IsOneShot() )
         {
             // the timer needs to be stopped but don't call its Stop() from
-            // here as it would attempt to remove the timer from our list and
+            // here as it would attempt to remove the timer from our heap and
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
         }
-        else // reschedule the next timer expiration
-        {
-            // always keep the expiration time in the future, i.e. base it on
-            // the current time instead of just offsetting it from the current
-            // expiration time because it could happen that we're late and the
-            // current expiration time is (far) in the past
-            s.m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
-        }
 
         // we can't notify the timer from this loop as the timer event handler
         // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
+        // timer), so do it after the loop end
         toNotify.push_back(timer);
     }
 
     if ( toNotify.empty() )
         return false;
 
+    // reschedule the next expiration of the periodic timers only now, as
+    // doing it in the loop above would notify the timers with very short
+    // intervals again and again
     for ( TimerImpls::const_iterator i = toNotify.begin(),
                                      end = toNotify.end();
           i != end;
           ++i )
     {
+        wxUnixTimerImpl * const timer = *i;
+        if ( !timer->IsOneShot() )
+        {
+            // always keep the expiration time in the future, i.e. base it on
+            // the current time instead of just offsetting it from the current
+            // expiration time because it could happen that we're late and the
+            // current expiration time is (far) in the past
+            DoAddTimer(timer, now + timer->GetInterval()*1000);
+        }
+    }
+
+    for ( TimerImpls::const_iterator i = toNotify.begin(),
+                                     end = toNotify.end();
+          i != end;
+          ++i )
+    {
+        // notice that adding and removing timers is not traced as it happens
+        // too often in the programs using many timers and wxLogTrace() is not
+        // free even when tracing is disabled
+        wxLogTrace(wxTrace_Timer, wxT("Notifying timer %d"), (*i)->GetId());
+
         (*i)->Notify();
     }
 
@@ -179,6 +232,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_scheduleIndex = NOT_SCHEDULED;
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
@@ -357,6 +357,23 @@ TEST_CASE("wxArrayString", "[dynarray]")
     CHECK( a9.size() == 5 );
 }
 
+TEST_CASE("wxArrayString::AddOwn", "[dynarray]")
+{
+    // Adding or inserting an element of the array itself must work even when
+    // the array needs to be reallocated to do it.
+    wxArrayString a;
+    a.Add("first");
+    for ( int n = 0; n < 100; n++ )
+        a.Add(a[0]);
+
+    a.Insert(a[50], 0);
+    a.Insert(a.Last(), 10, 50);
+
+    REQUIRE( a.size() == 152 );
+    for ( const auto& s : a )
+        CHECK( s == "first" );
+}
+
 TEST_CASE("wxArrayString::Vector", "[dynarray][vector]")
 {
     SECTION("wxString")
@@ -415,6 +432,61 @@ TEST_CASE("wxSortedArrayString", "[dynarray]")
     CHECK( ad.Index("z") == wxNOT_FOUND );
 }
 
+TEST_CASE("wxSortedArrayString::Bulk", "[dynarray]")
+{
+    wxArrayString unsorted;
+    unsorted.push_back("c");
+    unsorted.push_back("a");
+    unsorted.push_back("d");
+    unsorted.push_back("a");
+    unsorted.push_back("b");
+
+    wxSortedArrayString a(unsorted);
+    CHECK( unsorted.size() == 5 );
+    CHECK( wxJoin(a, ',') == "a,a,b,c,d" );
+
+    CHECK( a.RemoveDuplicates() == 1 );
+    CHECK( wxJoin(a, ',') == "a,b,c,d" );
+    CHECK( a.RemoveDuplicates() == 0 );
+
+    wxSortedArrayString moved(std::move(unsorted));
+    CHECK( wxJoin(moved, ',') == "a,a,b,c,d" );
+
+    wxSortedArrayString other;
+    other.Add("bb");
+    other.Add("e");
+    other.Add("0");
+
+    a.Merge(other);
+    CHECK( other.size() == 3 );
+    CHECK( wxJoin(a, ',') == "0,a,b,bb,c,d,e" );
+    CHECK( a.Index("bb") == 3 );
+
+    a.Merge(std::move(moved));
+    CHECK( moved.empty() );
+    CHECK( wxJoin(a, ',') == "0,a,a,a,b,b,bb,c,c,d,d,e" );
+    CHECK( a.RemoveDuplicates() == 5 );
+    CHECK( wxJoin(a, ',') == "0,a,b,bb,c,d,e" );
+
+    wxSortedArrayString empty;
+    empty.Merge(std::move(other));
+    CHECK( wxJoin(empty, ',') == "0,bb,e" );
+
+    // check that the custom comparison function is used too
+    wxSortedArrayString ad(wxDictionaryStringSortAscending);
+    ad.Add("b");
+    ad.Add("A");
+
+    wxSortedArrayString ad2(wxDictionaryStringSortAscending);
+    ad2.Add("B");
+    ad2.Add("a");
+    ad2.Add("C");
+
+    ad.Merge(ad2);
+    CHECK( wxJoin(ad, ',') == "A,a,B,b,C" );
+    CHECK( ad.Index("B") == 2 );
+}
+
 TEST_CASE("Arrays::Split", "[dynarray]")
 {
     // test wxSplit:
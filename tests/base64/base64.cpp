@@ -19,6 +19,8 @@
 #if wxUSE_BASE64
 
 #include "wx/base64.h"
+#include "wx/mstream.h"
+#include "wx/sstream.h"
 
 static const char encoded0to255[] =
     "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8gISIj"
@@ -262,4 +264,121 @@ TEST_CASE("Decode Invalid", "[base64]")
     CHECK( !wxBase64Decode("wxGetApp()").GetDataLen() );
 }
 
+TEST_CASE("Decode Mixed", "[base64]")
+{
+    // Check that decoding the groups without any special characters in them
+    // at once works correctly when they're mixed with the other ones.
+    unsigned char buff[256];
+    generatePatternedData(buff, sizeof(buff), 0, 1);
+
+    wxString str = wxBase64Encode(buff, sizeof(buff));
+    for ( size_t n = 70; n < str.length(); n += 71 )
+        str.insert(n, n % 2 ? "\r\n" : " ");
+
+    wxMemoryBuffer mbuff = wxBase64Decode(str, wxBase64DecodeMode_SkipWS);
+    REQUIRE( mbuff.GetDataLen() == sizeof(buff) );
+    CHECK( memcmp(mbuff.GetData(), buff, sizeof(buff)) == 0 );
+
+    size_t posErr;
+    CHECK( wxBase64Decode(nullptr, 0, str, wxBase64DecodeMode_Strict, &posErr)
+            == wxCONV_FAILED );
+    CHECK( posErr == 70 );
+
+    // The output buffer must not be overflowed when decoding in bulk.
+    char small[5] = { 0, 0, 0, 0, 'x' };
+    CHECK( wxBase64Decode(small, 4, "QUJDREVGR0hJ") == wxCONV_FAILED );
+    CHECK( small[4] == 'x' );
+
+    CHECK( wxBase64Decode(nullptr, 0, "QUJDREVG=QUJD") == wxCONV_FAILED );
+    CHECK( wxBase64Decode(nullptr, 0, "QUJDQQ==QUJD") == wxCONV_FAILED );
+}
+
+#if wxUSE_STREAMS
+
+TEST_CASE("Base64 Streams", "[base64][stream]")
+{
+    unsigned char buff[10000];
+    generatePatternedData(buff, sizeof(buff), 0, 3, 7);
+
+    const wxString encoded = wxBase64Encode(buff, sizeof(buff));
+
+    // Write the data in chunks of different sizes to check that incomplete
+    // groups are handled correctly.
+    for ( size_t chunk : { 1, 2, 3, 4, 5, 1000, 4095, 4096, 10000 } )
+    {
+        INFO( "Chunk size " << chunk );
+
+        wxString str;
+        {
+            wxStringOutputStream sout(&str);
+            wxBase64OutputStream b64out(sout);
+            for ( size_t n = 0; n < sizeof(buff); n += chunk )
+            {
+                const size_t len = wxMin(chunk, sizeof(buff) - n);
+                CHECK( b64out.Write(buff + n, len).LastWrite() == len );
+            }
+
+            CHECK( b64out.Close() );
+        }
+
+        CHECK( str == encoded );
+
+        // And read it back in the same way.
+        const wxScopedCharBuffer utf8 = str.utf8_str();
+        wxMemoryInputStream min(utf8.data(), utf8.length());
+        wxBase64InputStream b64in(min);
+
+        unsigned char decoded[sizeof(buff) + 1];
+        size_t total = 0;
+        while ( total < sizeof(decoded) )
+        {
+            const size_t
+                len = b64in.Read(decoded + total,
+                                 wxMin(chunk, sizeof(decoded) - total)).LastRead();
+            if ( !len )
+                break;
+
+            total += len;
+        }
+
+        CHECK( b64in.GetLastError() == wxSTREAM_EOF );
+        REQUIRE( total == sizeof(buff) );
+        CHECK( memcmp(decoded, buff, sizeof(buff)) == 0 );
+    }
+}
+
+TEST_CASE("Base64 Streams Errors", "[base64][stream]")
+{
+    const auto decode = [](const char* s, wxBase64DecodeMode mode) -> wxString
+    {
+        wxMemoryInputStream min(s, strlen(s));
+        wxBase64InputStream b64in(min, mode);
+
+        wxString str;
+        wxStringOutputStream sout(&str);
+        b64in.Read(sout);
+
+        return b64in.GetLastError() == wxSTREAM_EOF ? str : wxString("ERROR");
+    };
+
+    CHECK( decode("", wxBase64DecodeMode_Strict) == "" );
+    CHECK( decode("QUJD", wxBase64DecodeMode_Strict) == "ABC" );
+    CHECK( decode("QUJDRA==", wxBase64DecodeMode_Strict) == "ABCD" );
+    CHECK( decode(" QUJD\nRA==\n", wxBase64DecodeMode_SkipWS) == "ABCD" );
+    CHECK( decode("QU*JDRA==", wxBase64DecodeMode_Relaxed) == "ABCD" );
+
+    CHECK( decode(" QUJD", wxBase64DecodeMode_Strict) == "ERROR" );
+    CHECK( decode("QU*JD", wxBase64DecodeMode_SkipWS) == "ERROR" );
+    CHECK( decode("QUJDR", wxBase64DecodeMode_Strict) == "ERROR" );
+    CHECK( decode("QUJDRA==QUJD", wxBase64DecodeMode_Strict) == "ERROR" );
+
+    // Padding at the end of one chunk must be detected in the next one too.
+    wxString s(' ', 4092);
+    s += "QQ==";
+    CHECK( decode(s.c_str(), wxBase64DecodeMode_SkipWS) == "A" );
+    CHECK( decode((s + "QUJD").c_str(), wxBase64DecodeMode_SkipWS) == "ERROR" );
+}
+
+#endif // wxUSE_STREAMS
+
 #endif // wxUSE_BASE64
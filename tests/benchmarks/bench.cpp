@@ -84,6 +84,14 @@ private:
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
 
+// ----------------------------------------------------------------------------
+// globals
+// ----------------------------------------------------------------------------
+
+// amount of work done by a single run of the current benchmark, if known
+static double gs_workAmount = 0;
+static const char* gs_workUnits = nullptr;
+
 // ============================================================================
 // Bench namespace symbols implementation
 // ============================================================================
@@ -102,6 +110,12 @@ wxString Bench::GetStringParameter(const wxString& defVal)
     return !val.empty() ? val : defVal;
 }
 
+void Bench::SetWorkAmount(double amount, const char* units)
+{
+    gs_workAmount = amount;
+    gs_workUnits = units;
+}
+
 // ============================================================================
 // BenchApp implementation
 // ============================================================================
@@ -282,6 +296,9 @@ int BenchApp::OnRun()
 
 bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 {
+    gs_workAmount = 0;
+    gs_workUnits = nullptr;
+
     if ( !func->Init() )
         return false;
 
@@ -349,7 +366,7 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
     // much sense.
     if ( n == 1 )
     {
-        wxPrintf("single run took %.0fus\n", m);
+        wxPrintf("single run took %.0fus", m);
     }
     else
     {
@@ -357,11 +374,17 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 
         wxPrintf
         (
-            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)\n",
+            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)",
             n, m, s, timeMin, timeMax
         );
     }
 
+    // Also show the throughput if the benchmark told us how much work it does.
+    if ( gs_workUnits && m > 0 )
+        wxPrintf(", %.2f %s/s", gs_workAmount / m * 1e6, gs_workUnits);
+
+    wxPrintf("\n");
+
     fflush(stdout);
 
     return true;
@@ -93,6 +93,16 @@ long GetNumericParameter(long defValue = 1);
  */
 wxString GetStringParameter(const wxString& defValue = wxString());
 
+/**
+    Set the amount of work done by a single run of the current benchmark.
+
+    If this function is called by the benchmark function, the throughput, i.e.
+    the amount of work done per second, is shown in addition to the timings.
+    The @a units string, e.g. "MP" for megapixels or "MB" for megabytes, is
+    used in the output and must be a literal.
+ */
+void SetWorkAmount(double amount, const char* units);
+
 } // namespace Bench
 
 /**
@@ -0,0 +1,215 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Event processing benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+
+#include <vector>
+
+namespace
+{
+
+// Notice that wxThreadEvent is used because wxCommandEvent is not available in
+// the base library, but any event class would do.
+wxDEFINE_EVENT(wxEVT_BENCH_FIRST, wxThreadEvent);
+wxDEFINE_EVENT(wxEVT_BENCH_SECOND, wxThreadEvent);
+wxDEFINE_EVENT(wxEVT_BENCH_UNBOUND, wxThreadEvent);
+
+// Number of ids used for the bindings, this is similar to a frame handling
+// the commands from many menu items or toolbar buttons.
+const int NUM_IDS = 256;
+
+class BenchHandler : public wxEvtHandler
+{
+public:
+    BenchHandler() = default;
+
+    void OnCommand(wxThreadEvent& event)
+    {
+        m_count += event.GetId();
+    }
+
+    int m_count = 0;
+};
+
+BenchHandler* gs_handler = nullptr;
+
+// The numeric parameter specifies the number of bindings, 1000 by default.
+bool InitBindings()
+{
+    gs_handler = new BenchHandler;
+
+    const long count = Bench::GetNumericParameter(1000);
+    for ( long n = 0; n < count; n++ )
+    {
+        gs_handler->Bind(n % 2 ? wxEVT_BENCH_SECOND : wxEVT_BENCH_FIRST,
+                         &BenchHandler::OnCommand, gs_handler,
+                         wxID_HIGHEST + (n / 2) % NUM_IDS);
+    }
+
+    return true;
+}
+
+void DoneBindings()
+{
+    delete gs_handler;
+    gs_handler = nullptr;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(ProcessEventBound, InitBindings, DoneBindings)
+{
+    for ( int n = 0; n < NUM_IDS; n++ )
+    {
+        wxThreadEvent event(wxEVT_BENCH_FIRST, wxID_HIGHEST + n);
+        gs_handler->ProcessEvent(event);
+    }
+
+    return gs_handler->m_count != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ProcessEventUnbound, InitBindings, DoneBindings)
+{
+    // Events of a type for which there are no handlers at all still need to
+    // be checked against the dynamic event table.
+    for ( int n = 0; n < NUM_IDS; n++ )
+    {
+        wxThreadEvent event(wxEVT_BENCH_UNBOUND, wxID_HIGHEST + n);
+        gs_handler->ProcessEvent(event);
+    }
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// The function used for queuing the events.
+enum class QueueMode
+{
+    Single,     // QueueEvent()
+    Batch,      // QueueEvents()
+    Replace     // QueueOrReplaceEvent()
+};
+
+// Thread queuing many events for the given handler.
+class QueuingThread : public wxThread
+{
+public:
+    QueuingThread(wxEvtHandler& handler, int count, QueueMode mode)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_count(count),
+          m_mode(mode)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        const int BATCH_SIZE = 100;
+
+        wxVector<wxEvent*> batch;
+        for ( int n = 0; n < m_count; n++ )
+        {
+            switch ( m_mode )
+            {
+                case QueueMode::Single:
+                    m_handler.QueueEvent(new wxThreadEvent(wxEVT_BENCH_FIRST, n));
+                    break;
+
+                case QueueMode::Batch:
+                    batch.push_back(new wxThreadEvent(wxEVT_BENCH_FIRST, n));
+                    if ( batch.size() == BATCH_SIZE )
+                    {
+                        m_handler.QueueEvents(batch);
+                        batch.clear();
+                    }
+                    break;
+
+                case QueueMode::Replace:
+                    // Use a few different ids, as if reporting the progress
+                    // of several tasks.
+                    m_handler.QueueOrReplaceEvent(
+                        new wxThreadEvent(wxEVT_BENCH_FIRST, n % 8 + 1));
+                    break;
+            }
+        }
+
+        m_handler.QueueEvents(batch);
+
+        return nullptr;
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const int m_count;
+    const QueueMode m_mode;
+};
+
+// Queue the events from the given number of threads to the same handler or
+// to a separate handler for each thread and process them all.
+bool QueueFromThreads(bool sameHandler, QueueMode mode = QueueMode::Single)
+{
+    const int NUM_THREADS = 4;
+    const int NUM_EVENTS = 10000;
+
+    BenchHandler handlers[NUM_THREADS];
+    for ( int n = 0; n < NUM_THREADS; n++ )
+        handlers[n].Bind(wxEVT_BENCH_FIRST, &BenchHandler::OnCommand, &handlers[n]);
+
+    std::vector<wxThread*> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.push_back(new QueuingThread(handlers[sameHandler ? 0 : n],
+                                            NUM_EVENTS, mode));
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    wxTheApp->ProcessPendingEvents();
+
+    return handlers[0].m_count != 0;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(QueueEventThreadsSameHandler)
+{
+    return QueueFromThreads(true);
+}
+
+BENCHMARK_FUNC(QueueEventThreadsManyHandlers)
+{
+    return QueueFromThreads(false);
+}
+
+BENCHMARK_FUNC(QueueEventsThreadsSameHandler)
+{
+    return QueueFromThreads(true, QueueMode::Batch);
+}
+
+BENCHMARK_FUNC(QueueOrReplaceEventThreadsSameHandler)
+{
+    return QueueFromThreads(true, QueueMode::Replace);
+}
+
+#endif // wxUSE_THREADS
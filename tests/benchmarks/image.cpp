@@ -8,6 +8,8 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "wx/image.h"
+#include "wx/math.h"
+#include "wx/quantize.h"
 
 #include "bench.h"
 
@@ -43,6 +45,25 @@ BENCHMARK_FUNC(LoadPNG)
     return image.LoadFile("horse.png");
 }
 
+// This benchmark uses the numeric parameter as the maximal size of the image
+// to load, so it can be used to check how efficiently thumbnails are created.
+BENCHMARK_FUNC(LoadJPEGThumbnail)
+{
+    static bool s_handlerAdded = false;
+    if ( !s_handlerAdded )
+    {
+        s_handlerAdded = true;
+        wxImage::AddHandler(new wxJPEGHandler);
+    }
+
+    const int maxSize = Bench::GetNumericParameter(64);
+
+    wxImage image;
+    image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, maxSize);
+    image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, maxSize);
+    return image.LoadFile(Bench::GetStringParameter("horse.jpg"));
+}
+
 #if wxUSE_LIBTIFF
 BENCHMARK_FUNC(LoadTIFF)
 {
@@ -71,50 +92,379 @@ static const wxImage& GetTestImage()
     return s_image;
 }
 
-BENCHMARK_FUNC(EnlargeNormal)
+static void SetTestImageWorkAmount()
 {
     const wxImage& image = GetTestImage();
-    const double factor = Bench::GetNumericParameter(150) / 100.;
-    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
-                       wxIMAGE_QUALITY_NORMAL).IsOk();
+    Bench::SetWorkAmount(image.GetWidth()*double(image.GetHeight()) / 1e6, "MP");
 }
 
-BENCHMARK_FUNC(EnlargeBoxAverage)
+// Scale the test image using the given quality and report the throughput in
+// megapixels of the resulting image per second.
+static bool ScaleTestImage(double factor, wxImageResizeQuality quality)
 {
     const wxImage& image = GetTestImage();
-    const double factor = Bench::GetNumericParameter(150) / 100.;
-    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
-                       wxIMAGE_QUALITY_BOX_AVERAGE).IsOk();
+    const int width = factor*image.GetWidth();
+    const int height = factor*image.GetHeight();
+
+    Bench::SetWorkAmount(width*double(height) / 1e6, "MP");
+
+    return image.Scale(width, height, quality).IsOk();
+}
+
+static double GetEnlargeFactor()
+{
+    return Bench::GetNumericParameter(150) / 100.;
+}
+
+static double GetShrinkFactor()
+{
+    return Bench::GetNumericParameter(50) / 100.;
+}
+
+BENCHMARK_FUNC(EnlargeNormal)
+{
+    return ScaleTestImage(GetEnlargeFactor(), wxIMAGE_QUALITY_NORMAL);
+}
+
+BENCHMARK_FUNC(EnlargeBoxAverage)
+{
+    return ScaleTestImage(GetEnlargeFactor(), wxIMAGE_QUALITY_BOX_AVERAGE);
+}
+
+BENCHMARK_FUNC(EnlargeBilinear)
+{
+    return ScaleTestImage(GetEnlargeFactor(), wxIMAGE_QUALITY_BILINEAR);
+}
+
+BENCHMARK_FUNC(EnlargeBicubic)
+{
+    return ScaleTestImage(GetEnlargeFactor(), wxIMAGE_QUALITY_BICUBIC);
 }
 
 BENCHMARK_FUNC(EnlargeHighQuality)
 {
-    const wxImage& image = GetTestImage();
-    const double factor = Bench::GetNumericParameter(150) / 100.;
-    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
-                       wxIMAGE_QUALITY_HIGH).IsOk();
+    return ScaleTestImage(GetEnlargeFactor(), wxIMAGE_QUALITY_HIGH);
 }
 
 BENCHMARK_FUNC(ShrinkNormal)
 {
-    const wxImage& image = GetTestImage();
-    const double factor = Bench::GetNumericParameter(50) / 100.;
-    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
-                       wxIMAGE_QUALITY_NORMAL).IsOk();
+    return ScaleTestImage(GetShrinkFactor(), wxIMAGE_QUALITY_NORMAL);
 }
 
 BENCHMARK_FUNC(ShrinkBoxAverage)
 {
-    const wxImage& image = GetTestImage();
-    const double factor = Bench::GetNumericParameter(50) / 100.;
-    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
-                       wxIMAGE_QUALITY_BOX_AVERAGE).IsOk();
+    return ScaleTestImage(GetShrinkFactor(), wxIMAGE_QUALITY_BOX_AVERAGE);
+}
+
+BENCHMARK_FUNC(ShrinkBilinear)
+{
+    return ScaleTestImage(GetShrinkFactor(), wxIMAGE_QUALITY_BILINEAR);
+}
+
+BENCHMARK_FUNC(ShrinkBicubic)
+{
+    return ScaleTestImage(GetShrinkFactor(), wxIMAGE_QUALITY_BICUBIC);
 }
 
 BENCHMARK_FUNC(ShrinkHighQuality)
+{
+    return ScaleTestImage(GetShrinkFactor(), wxIMAGE_QUALITY_HIGH);
+}
+
+// The benchmarks below shrink the test image stored in an external RGBA
+// buffer either directly or after copying it into a wxImage.
+static const wxImageView& GetTestImageView()
+{
+    static wxVector<unsigned char> s_buf;
+    static wxImageView s_view;
+    if ( !s_view.IsOk() )
+    {
+        const wxImage& image = GetTestImage();
+        const int width = image.GetWidth();
+        const int height = image.GetHeight();
+        if ( !width || !height )
+            return s_view;
+
+        s_buf.resize(4*size_t(width)*height);
+        const unsigned char* src = image.GetData();
+        unsigned char* dst = &s_buf[0];
+        for ( int n = 0; n < width*height; n++ )
+        {
+            *dst++ = *src++;
+            *dst++ = *src++;
+            *dst++ = *src++;
+            *dst++ = wxIMAGE_ALPHA_OPAQUE;
+        }
+
+        s_view = wxImageView(&s_buf[0], width, height, wxIMAGE_FORMAT_RGBA);
+    }
+
+    const double factor = GetShrinkFactor();
+    Bench::SetWorkAmount(factor*factor*s_view.GetWidth()*s_view.GetHeight() / 1e6,
+                         "MP");
+
+    return s_view;
+}
+
+BENCHMARK_FUNC(ShrinkViewCopy)
+{
+    const wxImageView& view = GetTestImageView();
+    const double factor = GetShrinkFactor();
+
+    return wxImage(view).Scale(factor*view.GetWidth(),
+                               factor*view.GetHeight()).IsOk();
+}
+
+BENCHMARK_FUNC(ShrinkView)
+{
+    const wxImageView& view = GetTestImageView();
+    const double factor = GetShrinkFactor();
+
+    return view.Scale(factor*view.GetWidth(),
+                      factor*view.GetHeight()).IsOk();
+}
+
+// Convert the test image to premultiplied ARGB format used by Cairo.
+BENCHMARK_FUNC(CopyToPremultiplied)
+{
+    static wxImage s_image;
+    static wxVector<wxUint32> s_buf;
+
+    if ( !s_image.IsOk() )
+    {
+        s_image = GetTestImage().Copy();
+        if ( !s_image.IsOk() )
+            return false;
+
+        if ( !s_image.HasAlpha() )
+            s_image.InitAlpha();
+    }
+
+    const wxImage& image = s_image;
+    SetTestImageWorkAmount();
+
+    s_buf.resize(image.GetWidth()*size_t(image.GetHeight()));
+    return image.CopyToBuffer(reinterpret_cast<unsigned char*>(&s_buf[0]),
+                              wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED);
+}
+
+BENCHMARK_FUNC(Rotate90)
+{
+    SetTestImageWorkAmount();
+
+    return GetTestImage().Rotate90().IsOk();
+}
+
+BENCHMARK_FUNC(Rotate180)
+{
+    SetTestImageWorkAmount();
+
+    return GetTestImage().Rotate180().IsOk();
+}
+
+BENCHMARK_FUNC(Mirror)
+{
+    SetTestImageWorkAmount();
+
+    return GetTestImage().Mirror().IsOk();
+}
+
+// The arbitrary rotation benchmarks use the numeric parameter as the angle in
+// degrees.
+static bool RotateTestImage(bool interpolating)
+{
+    const wxImage& image = GetTestImage();
+    SetTestImageWorkAmount();
+
+    const double angle = wxDegToRad(Bench::GetNumericParameter(30));
+    const wxPoint centre(image.GetWidth() / 2, image.GetHeight() / 2);
+
+    return image.Rotate(angle, centre, interpolating).IsOk();
+}
+
+BENCHMARK_FUNC(Rotate)
+{
+    return RotateTestImage(false);
+}
+
+BENCHMARK_FUNC(RotateInterpolating)
+{
+    return RotateTestImage(true);
+}
+
+// The blur benchmarks use the numeric parameter as the blur radius or standard
+// deviation, as appropriate.
+BENCHMARK_FUNC(Blur)
 {
     const wxImage& image = GetTestImage();
-    const double factor = Bench::GetNumericParameter(50) / 100.;
-    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
-                       wxIMAGE_QUALITY_HIGH).IsOk();
+    SetTestImageWorkAmount();
+    return image.Blur(Bench::GetNumericParameter(5)).IsOk();
+}
+
+BENCHMARK_FUNC(GaussianBlur)
+{
+    const wxImage& image = GetTestImage();
+    SetTestImageWorkAmount();
+    return image.GaussianBlur(Bench::GetNumericParameter(5)).IsOk();
+}
+
+// The quantization benchmarks use the numeric parameter as the number of
+// colours to use.
+static bool QuantizeTestImage(int flags)
+{
+    const wxImage& image = GetTestImage();
+    SetTestImageWorkAmount();
+
+    wxImage quantized;
+    return wxQuantize::Quantize(image, quantized, nullptr,
+                                Bench::GetNumericParameter(236), nullptr,
+                                wxQUANTIZE_FILL_DESTINATION_IMAGE | flags);
+}
+
+BENCHMARK_FUNC(Quantize)
+{
+    return QuantizeTestImage(0);
+}
+
+BENCHMARK_FUNC(QuantizeNoDither)
+{
+    return QuantizeTestImage(wxQUANTIZE_NO_DITHER);
+}
+
+BENCHMARK_FUNC(QuantizeOrderedDither)
+{
+    return QuantizeTestImage(wxQUANTIZE_ORDERED_DITHER);
+}
+
+// The benchmarks below use the numeric parameter as the number of threads to
+// use for processing the image (by default, as many as there are CPUs) and so
+// can be run with different values of it to check how they scale.
+static bool InitParallel()
+{
+    wxImage::SetParallelism(Bench::GetNumericParameter(0));
+
+    return GetTestImage().IsOk();
+}
+
+static void DoneParallel()
+{
+    wxImage::SetParallelism(1);
+}
+
+static const wxImage& GetBigTestImage()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        const wxImage& image = GetTestImage();
+        s_image = image.Scale(8*image.GetWidth(), 8*image.GetHeight(),
+                              wxIMAGE_QUALITY_NEAREST);
+    }
+
+    return s_image;
 }
+
+static void SetBigTestImageWorkAmount()
+{
+    const wxImage& image = GetBigTestImage();
+    Bench::SetWorkAmount(image.GetWidth()*double(image.GetHeight()) / 1e6, "MP");
+}
+
+BENCHMARK_FUNC_WITH_INIT(ParallelShrinkBicubic, InitParallel, DoneParallel)
+{
+    const wxImage& image = GetBigTestImage();
+    SetBigTestImageWorkAmount();
+    return image.Scale(image.GetWidth() / 3, image.GetHeight() / 3,
+                       wxIMAGE_QUALITY_BICUBIC).IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ParallelBlur, InitParallel, DoneParallel)
+{
+    SetBigTestImageWorkAmount();
+    return GetBigTestImage().Blur(5).IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ParallelGreyscale, InitParallel, DoneParallel)
+{
+    SetBigTestImageWorkAmount();
+    return GetBigTestImage().ConvertToGreyscale().IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ParallelChangeLightness, InitParallel, DoneParallel)
+{
+    SetBigTestImageWorkAmount();
+    return GetBigTestImage().ChangeLightness(150).IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ParallelRotateHue, InitParallel, DoneParallel)
+{
+    wxImage image = GetBigTestImage();
+    SetBigTestImageWorkAmount();
+    image.RotateHue(0.25);
+    return image.IsOk();
+}
+
+// The benchmarks below load the same set of images either one by one or using
+// wxImageBatchLoader, which uses the numeric parameter as the number of
+// threads (by default, as many as there are CPUs).
+static const wxVector<wxString>& GetBatchFiles()
+{
+    static wxVector<wxString> s_files;
+    if ( s_files.empty() )
+    {
+        if ( !wxImage::FindHandler(wxBITMAP_TYPE_JPEG) )
+            wxImage::AddHandler(new wxJPEGHandler);
+        if ( !wxImage::FindHandler(wxBITMAP_TYPE_PNG) )
+            wxImage::AddHandler(new wxPNGHandler);
+
+        for ( int n = 0; n < 8; n++ )
+        {
+            s_files.push_back("horse.bmp");
+            s_files.push_back("horse.jpg");
+            s_files.push_back("horse.png");
+        }
+    }
+
+    Bench::SetWorkAmount(s_files.size(), "images");
+
+    return s_files;
+}
+
+BENCHMARK_FUNC(LoadSerial)
+{
+    const wxVector<wxString>& files = GetBatchFiles();
+
+    for ( size_t n = 0; n < files.size(); n++ )
+    {
+        wxImage image;
+        if ( !image.LoadFile(files[n]) )
+            return false;
+    }
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+BENCHMARK_FUNC(LoadBatch)
+{
+    const wxVector<wxString>& files = GetBatchFiles();
+
+    wxImageBatchLoader loader(Bench::GetNumericParameter(0));
+    for ( size_t n = 0; n < files.size(); n++ )
+        loader.AddFile(files[n]);
+
+    if ( !loader.Start() )
+        return false;
+
+    wxImageBatchResult result;
+    while ( loader.GetNext(result) )
+    {
+        if ( !result.image.IsOk() )
+            return false;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
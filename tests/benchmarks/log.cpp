@@ -10,6 +10,9 @@
 #include "bench.h"
 
 #include "wx/log.h"
+#include "wx/thread.h"
+
+#include <vector>
 
 // This class is used to check that the arguments of log functions are not
 // evaluated.
@@ -41,6 +44,41 @@ private:
     wxDECLARE_NO_COPY_CLASS(LogLevelSetter);
 };
 
+// Log target which simply throws away the log messages, to remove the actual
+// logging overhead from the benchmarks.
+class NulLog : public wxLog
+{
+public:
+    NulLog() = default;
+
+protected:
+    virtual void DoLogRecord(wxLogLevel,
+                             const wxString&,
+                             const wxLogRecordInfo&) override
+    {
+    }
+};
+
+// Temporarily change the active log target.
+class LogTargetSetter
+{
+public:
+    explicit LogTargetSetter(wxLog* log)
+        : m_logOld(wxLog::SetActiveTarget(log))
+    {
+    }
+
+    ~LogTargetSetter()
+    {
+        wxLog::SetActiveTarget(m_logOld);
+    }
+
+private:
+    wxLog* const m_logOld;
+
+    wxDECLARE_NO_COPY_CLASS(LogTargetSetter);
+};
+
 BENCHMARK_FUNC(LogDebugDisabled)
 {
     LogLevelSetter level(wxLOG_Info);
@@ -68,41 +106,105 @@ BENCHMARK_FUNC(LogTraceActive)
         wxLog::AddTraceMask("logbench");
     }
 
-    // Remove the actual logging overhead by simply throwing away the log
-    // messages.
-    class NulLog : public wxLog
+    NulLog nulLog;
+    LogTargetSetter setTarget(&nulLog);
+
+    wxLogTrace("logbench", "Trace message");
+
+    return true;
+}
+
+BENCHMARK_FUNC(LogTraceInactive)
+{
+    wxLogTrace("bloordyblop", "Trace message");
+
+    return true;
+}
+
+#if wxUSE_THREADS
+
+// Multi-threaded benchmarks: the numeric parameter specifies the number of
+// threads, each of which logs the same number of messages.
+
+namespace
+{
+
+// Log target formatting the messages as usual but not outputting them.
+class NulTextLog : public wxLog
+{
+public:
+    NulTextLog() = default;
+
+protected:
+    virtual void DoLogText(const wxString&) override
     {
-    public:
-        NulLog()
-            : m_logOld(wxLog::SetActiveTarget(this))
-        {
-        }
+    }
+};
 
-        virtual ~NulLog()
-        {
-            wxLog::SetActiveTarget(m_logOld);
-        }
+class LoggingThread : public wxThread
+{
+public:
+    LoggingThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < 1000; n++ )
+            wxLogMessage("Message %d from a background thread", n);
+
+        return nullptr;
+    }
+};
 
-    protected:
-        virtual void DoLogRecord(wxLogLevel,
-                                 const wxString&,
-                                 const wxLogRecordInfo&)
+void LogFromThreads()
+{
+    std::vector<wxThread*> threads;
+    for ( long n = Bench::GetNumericParameter(4); n > 0; n-- )
+    {
+        wxThread* const thread = new LoggingThread;
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
         {
+            delete thread;
+            break;
         }
 
-        wxLog* m_logOld;
-    };
+        threads.push_back(thread);
+    }
 
-    NulLog nulLog;
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+}
 
-    wxLogTrace("logbench", "Trace message");
+} // anonymous namespace
+
+// Messages from the background threads are buffered until the main thread
+// flushes them.
+BENCHMARK_FUNC(LogThreadsBuffered)
+{
+    NulTextLog nulLog;
+    LogTargetSetter setTarget(&nulLog);
+
+    LogFromThreads();
+
+    wxLog::FlushActive();
 
     return true;
 }
 
-BENCHMARK_FUNC(LogTraceInactive)
+// Messages are passed to the sink thread of wxLogAsync.
+BENCHMARK_FUNC(LogThreadsAsync)
 {
-    wxLogTrace("bloordyblop", "Trace message");
+    wxLogAsync logAsync(new NulTextLog);
+    LogTargetSetter setTarget(&logAsync);
+
+    LogFromThreads();
+
+    logAsync.Flush();
 
     return true;
 }
+
+#endif // wxUSE_THREADS
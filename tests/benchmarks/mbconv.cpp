@@ -42,6 +42,49 @@ bool ConvertToMB(const wxMBConv& conv)
     return conv.FromWChar(buf.data(), outlen, TEST_STRING) == outlen;
 }
 
+// big string, containing TEST_STRING repeated many times, used for measuring
+// the conversion throughput
+const std::wstring& GetBigString()
+{
+    static std::wstring s_str;
+    if ( s_str.empty() )
+    {
+        // Use 4M characters, which is 16MB with 32-bit wchar_t and 4MB when
+        // encoded in UTF-8.
+        const size_t BIG_STRING_LEN = 4*1024*1024;
+
+        s_str.reserve(BIG_STRING_LEN + wcslen(TEST_STRING));
+        while ( s_str.length() < BIG_STRING_LEN )
+            s_str += TEST_STRING;
+    }
+
+    return s_str;
+}
+
+// convert the big string to multibyte and back to wide
+bool ConvertBig(const wxMBConv& conv)
+{
+    const std::wstring& str = GetBigString();
+
+    const size_t mblen = conv.FromWChar(nullptr, 0, str.data(), str.length());
+    if ( mblen == wxCONV_FAILED )
+        return false;
+
+    wxCharBuffer buf(mblen);
+    if ( conv.FromWChar(buf.data(), mblen, str.data(), str.length()) != mblen )
+        return false;
+
+    wxWCharBuffer wbuf(str.length());
+    if ( conv.ToWChar(wbuf.data(), str.length(), buf.data(), mblen)
+            != str.length() )
+        return false;
+
+    // report the amount of multibyte data processed in both directions
+    Bench::SetWorkAmount(2*mblen / 1e9, "GB");
+
+    return true;
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC(UTF16InitWX)
@@ -76,3 +119,23 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+BENCHMARK_FUNC(UTF16BigWX)
+{
+    return ConvertBig(wxMBConvUTF16());
+}
+
+BENCHMARK_FUNC(UTF8BigWX)
+{
+    return ConvertBig(wxConvUTF8);
+}
+
+BENCHMARK_FUNC(UTF8BigPUA)
+{
+    return ConvertBig(wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA));
+}
+
+BENCHMARK_FUNC(UTF8BigSys)
+{
+    return ConvertBig(wxCSConv("UTF-8"));
+}
@@ -132,3 +132,33 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxString::Format() with run-time and compile-time checked format strings
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC(StringFormat)
+{
+    const wxString s = wxString::Format("Item %d of %d: %s (%.2f%%)",
+                                        17, 42, "processing", 40.48);
+    return !s.empty();
+}
+
+#ifdef wxHAS_COMPILE_TIME_FORMAT_CHECK
+
+BENCHMARK_FUNC(StringFormatLiteral)
+{
+    const wxString s = wxString::Format(wxFORMAT("Item %d of %d: %s (%.2f%%)"),
+                                        17, 42, "processing", 40.48);
+    return !s.empty();
+}
+
+BENCHMARK_FUNC(StringPrintfLiteralReuse)
+{
+    static wxString s;
+    s.Printf(wxFORMAT("Item %d of %d: %s (%.2f%%)"),
+             17, 42, "processing", 40.48);
+    return !s.empty();
+}
+
+#endif // wxHAS_COMPILE_TIME_FORMAT_CHECK
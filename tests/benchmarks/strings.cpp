@@ -10,6 +10,9 @@
 #include "wx/string.h"
 #include "wx/ffile.h"
 #include "wx/arrstr.h"
+#include "wx/base64.h"
+#include "wx/numformatter.h"
+#include "wx/tokenzr.h"
 
 #include "bench.h"
 #include "htmlparser/htmlpars.h"
@@ -59,6 +62,22 @@ const wxString& GetTestAsciiString()
     return testString;
 }
 
+const wxString& GetTestUTF8String()
+{
+    static wxString testString;
+    if ( testString.empty() )
+    {
+        long num = Bench::GetNumericParameter();
+        if ( !num )
+            num = 1;
+
+        for ( long n = 0; n < num; n++ )
+            testString += wxString::FromUTF8(utf8str);
+    }
+
+    return testString;
+}
+
 } // anonymous namespace
 
 // this is just a baseline
@@ -159,6 +178,78 @@ BENCHMARK_FUNC(FromUTF8UncheckedWithLen)
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// UTF-8 conversions of big strings
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Size of the strings used by the benchmarks below, in bytes.
+const size_t BIG_UTF8_SIZE = 8*1024*1024;
+
+const std::string& GetBigUTF8String(bool ascii)
+{
+    static std::string s_ascii, s_mixed;
+
+    std::string& s = ascii ? s_ascii : s_mixed;
+    if ( s.empty() )
+    {
+        const char* const str = ascii ? asciistr : utf8str;
+
+        s.reserve(BIG_UTF8_SIZE + strlen(str));
+        while ( s.length() < BIG_UTF8_SIZE )
+            s += str;
+    }
+
+    return s;
+}
+
+bool DoFromUTF8Big(bool ascii)
+{
+    const std::string& utf8 = GetBigUTF8String(ascii);
+
+    Bench::SetWorkAmount(utf8.length() / 1e9, "GB");
+
+    const wxString s = wxString::FromUTF8(utf8.c_str(), utf8.length());
+    return !s.empty();
+}
+
+bool DoToUTF8Big(bool ascii)
+{
+    static wxString s_ascii, s_mixed;
+
+    wxString& s = ascii ? s_ascii : s_mixed;
+    if ( s.empty() )
+        s = wxString::FromUTF8(GetBigUTF8String(ascii));
+
+    Bench::SetWorkAmount(GetBigUTF8String(ascii).length() / 1e9, "GB");
+
+    return s.utf8_str().length() == GetBigUTF8String(ascii).length();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(FromUTF8BigASCII)
+{
+    return DoFromUTF8Big(true);
+}
+
+BENCHMARK_FUNC(FromUTF8BigMixed)
+{
+    return DoFromUTF8Big(false);
+}
+
+BENCHMARK_FUNC(ToUTF8BigASCII)
+{
+    return DoToUTF8Big(true);
+}
+
+BENCHMARK_FUNC(ToUTF8BigMixed)
+{
+    return DoToUTF8Big(false);
+}
+
 // ----------------------------------------------------------------------------
 // FromAscii() benchmarks
 // ----------------------------------------------------------------------------
@@ -219,6 +310,77 @@ BENCHMARK_FUNC(ForStringIndex)
     return true;
 }
 
+BENCHMARK_FUNC(ForStringIndexNonASCII)
+{
+    const wxString& s = GetTestUTF8String();
+    const size_t len = s.length();
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( s[n] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ForStringIndexReverse)
+{
+    const wxString& s = GetTestAsciiString();
+    for ( size_t n = s.length(); n-- > 0; )
+    {
+        if ( s[n] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ForStringIndexReverseNonASCII)
+{
+    const wxString& s = GetTestUTF8String();
+    for ( size_t n = s.length(); n-- > 0; )
+    {
+        if ( s[n] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+// access the characters in a pseudo-random order
+BENCHMARK_FUNC(ForStringIndexRandom)
+{
+    const wxString& s = GetTestAsciiString();
+    const size_t len = s.length();
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( s[(n * 7919) % len] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(ForStringIndexRandomNonASCII)
+{
+    const wxString& s = GetTestUTF8String();
+    const size_t len = s.length();
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( s[(n * 7919) % len] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
+// length() of a freshly created string, which can't be cached
+BENCHMARK_FUNC(StringLength)
+{
+    const wxString s(GetTestUTF8String());
+    return s.length() != 0;
+}
+
 BENCHMARK_FUNC(ForStringIter)
 {
     const wxString& s = GetTestAsciiString();
@@ -245,6 +407,21 @@ BENCHMARK_FUNC(ForStringRIter)
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// wxString::Find()
+// ----------------------------------------------------------------------------
+
+BENCHMARK_FUNC(FindString)
+{
+    return GetTestAsciiString().Find("tenth line of a very long") != wxNOT_FOUND;
+}
+
+BENCHMARK_FUNC(FindCharNonASCII)
+{
+    // the index of the last character needs to be computed from its offset
+    return GetTestUTF8String().Find('9', true /* from end */) != wxNOT_FOUND;
+}
+
 // ----------------------------------------------------------------------------
 // wxString::Replace()
 // ----------------------------------------------------------------------------
@@ -293,6 +470,104 @@ BENCHMARK_FUNC(ReplaceShorter)
     return str.Replace("xx", "y") != 0;
 }
 
+// ----------------------------------------------------------------------------
+// string tokenizing
+// ----------------------------------------------------------------------------
+
+// CSV-like data with fields separated by commas
+static const wxString& GetTestCSVString()
+{
+    static wxString testString;
+    if ( testString.empty() )
+    {
+        for ( int n = 0; n < 1000; n++ )
+            testString += wxString::Format("%d,field %d,,%g\n", n, n, n/3.);
+    }
+
+    return testString;
+}
+
+BENCHMARK_FUNC(StringTokenizer)
+{
+    size_t len = 0;
+    wxStringTokenizer tkz(GetTestCSVString(), ",\n");
+    while ( tkz.HasMoreTokens() )
+        len += tkz.GetNextToken().length();
+
+    return len > 0;
+}
+
+BENCHMARK_FUNC(StringViewTokenizer)
+{
+    size_t len = 0;
+    wxStringViewTokenizer tkz(GetTestCSVString(), ",\n");
+    while ( tkz.HasMoreTokens() )
+        len += tkz.GetNextToken().size();
+
+    return len > 0;
+}
+
+BENCHMARK_FUNC(StringTokenize)
+{
+    return !wxStringTokenize(GetTestCSVString(), ",\n").empty();
+}
+
+BENCHMARK_FUNC(StringSplit)
+{
+    return !wxSplit(GetTestCSVString(), ',').empty();
+}
+
+// ----------------------------------------------------------------------------
+// base64
+// ----------------------------------------------------------------------------
+
+static const wxMemoryBuffer& GetBase64TestData()
+{
+    static wxMemoryBuffer s_data;
+    if ( s_data.IsEmpty() )
+    {
+        const size_t len = 1024*1024;
+        unsigned char* const p = static_cast<unsigned char*>(s_data.GetWriteBuf(len));
+        for ( size_t n = 0; n < len; n++ )
+            p[n] = static_cast<unsigned char>(n * 7 + (n >> 8));
+        s_data.SetDataLen(len);
+    }
+
+    return s_data;
+}
+
+static const wxCharBuffer& GetBase64TestString()
+{
+    static wxCharBuffer s_str;
+    if ( !s_str.length() )
+    {
+        const wxMemoryBuffer& data = GetBase64TestData();
+        const size_t len = wxBase64EncodedSize(data.GetDataLen());
+        s_str.extend(len);
+        wxBase64Encode(s_str.data(), len, data.GetData(), data.GetDataLen());
+    }
+
+    return s_str;
+}
+
+BENCHMARK_FUNC(Base64Encode1MB)
+{
+    const wxMemoryBuffer& data = GetBase64TestData();
+
+    static wxCharBuffer s_buf(wxBase64EncodedSize(data.GetDataLen()));
+    return wxBase64Encode(s_buf.data(), s_buf.length(),
+                          data.GetData(), data.GetDataLen()) == s_buf.length();
+}
+
+BENCHMARK_FUNC(Base64Decode1MB)
+{
+    const wxCharBuffer& str = GetBase64TestString();
+
+    static wxMemoryBuffer s_buf(wxBase64DecodedSize(str.length()));
+    return wxBase64Decode(s_buf.GetWriteBuf(s_buf.GetBufSize()), s_buf.GetBufSize(),
+                          str.data(), str.length()) == GetBase64TestData().GetDataLen();
+}
+
 // ----------------------------------------------------------------------------
 // string arrays
 // ----------------------------------------------------------------------------
@@ -329,6 +604,54 @@ BENCHMARK_FUNC(ArrStrSort)
     return !a.empty();
 }
 
+BENCHMARK_FUNC(SortedArrStrAdd)
+{
+    wxSortedArrayString a;
+    for (int i = 0; i < 1000; ++i)
+        a.Add(wxString::Format("%d", (i * 7919) % 1000));
+    return a.size() == 1000;
+}
+
+BENCHMARK_FUNC(SortedArrStrFromArray)
+{
+    wxArrayString unsorted;
+    unsorted.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+        unsorted.push_back(wxString::Format("%d", (i * 7919) % 1000));
+
+    wxSortedArrayString a(std::move(unsorted));
+    return a.size() == 1000;
+}
+
+BENCHMARK_FUNC(SortedArrStrAddAll)
+{
+    wxSortedArrayString a, b;
+    for (int i = 0; i < 500; ++i)
+    {
+        a.Add(wxString::Format("%d", 2*i));
+        b.Add(wxString::Format("%d", 2*i + 1));
+    }
+
+    for ( const auto& s : b )
+        a.Add(s);
+
+    return a.size() == 1000;
+}
+
+BENCHMARK_FUNC(SortedArrStrMerge)
+{
+    wxSortedArrayString a, b;
+    for (int i = 0; i < 500; ++i)
+    {
+        a.Add(wxString::Format("%d", 2*i));
+        b.Add(wxString::Format("%d", 2*i + 1));
+    }
+
+    a.Merge(std::move(b));
+
+    return a.size() == 1000;
+}
+
 BENCHMARK_FUNC(VectorStrPushBack)
 {
     std::vector<wxString> v;
@@ -361,6 +684,49 @@ BENCHMARK_FUNC(VectorStrSort)
     return !v.empty();
 }
 
+// ----------------------------------------------------------------------------
+// repeated strings and atoms
+// ----------------------------------------------------------------------------
+
+static const char* const statusWords[] =
+{
+    "pending", "running", "done", "failed", "cancelled", "unknown"
+};
+
+BENCHMARK_FUNC(VectorStrRepeated)
+{
+    std::vector<wxString> v;
+    v.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(wxString(statusWords[i % WXSIZEOF(statusWords)]));
+
+    const wxString done("done");
+    size_t count = 0;
+    for (size_t n = 0; n < v.size(); ++n)
+    {
+        if ( v[n] == done )
+            count++;
+    }
+    return count != 0;
+}
+
+BENCHMARK_FUNC(VectorAtomRepeated)
+{
+    std::vector<wxStringAtom> v;
+    v.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(wxStringAtom(statusWords[i % WXSIZEOF(statusWords)]));
+
+    const wxStringAtom done("done");
+    size_t count = 0;
+    for (size_t n = 0; n < v.size(); ++n)
+    {
+        if ( v[n] == done )
+            count++;
+    }
+    return count != 0;
+}
+
 // ----------------------------------------------------------------------------
 // string case conversion
 // ----------------------------------------------------------------------------
@@ -421,6 +787,14 @@ BENCHMARK_FUNC(StringCmpNoCase)
     return s.CmpNoCase(s) == 0;
 }
 
+BENCHMARK_FUNC(StringCmpNoCaseUpper)
+{
+    const wxString& s = GetTestAsciiString();
+    static const wxString upper = s.Upper();
+
+    return s.CmpNoCase(upper) == 0;
+}
+
 // Also benchmark various native functions under MSW. Surprisingly/annoyingly
 // they sometimes have vastly better performance than alternatives, especially
 // for case-sensitive comparison (see #10375).
@@ -622,6 +996,87 @@ BENCHMARK_FUNC(StringFromCDouble)
     return true;
 }
 
+// Compare the shortest round trip representation with the traditional way of
+// achieving the same result by always using 17 significant digits.
+BENCHMARK_FUNC(StringFromCDoubleShortest)
+{
+    for ( const auto& data : toDoubleData )
+    {
+        if ( wxString::FromCDoubleShortest(data.value).empty() )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(StringFormatDoubleRoundTrip)
+{
+    for ( const auto& data : toDoubleData )
+    {
+        if ( wxString::Format("%.17g", data.value).empty() )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(StringToCLong)
+{
+    static const wxString strings[] =
+    {
+        "0", "1", "-17", "12345", "+42", "0x1F", "2147483647", "-987654321",
+    };
+
+    long l = 0;
+    for ( const auto& str : strings )
+    {
+        if ( !str.ToCLong(&l, 0) )
+            return false;
+    }
+
+    return l == -987654321;
+}
+
+BENCHMARK_FUNC(StringToLong)
+{
+    static const wxString strings[] =
+    {
+        "0", "1", "-17", "12345", "+42", "0x1F", "2147483647", "-987654321",
+    };
+
+    long l = 0;
+    for ( const auto& str : strings )
+    {
+        if ( !str.ToLong(&l, 0) )
+            return false;
+    }
+
+    return l == -987654321;
+}
+
+BENCHMARK_FUNC(NumFormatterLong)
+{
+    for ( long n = -1000; n < 1000; n += 37 )
+    {
+        if ( wxNumberFormatter::ToString(n * 1234567,
+                                         wxNumberFormatter::Style_None).empty() )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(StringFormatLong)
+{
+    for ( long n = -1000; n < 1000; n += 37 )
+    {
+        if ( wxString::Format("%ld", n * 1234567).empty() )
+            return false;
+    }
+
+    return true;
+}
+
 BENCHMARK_FUNC(Strtod)
 {
     double d = 0.;
@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/threadpool.cpp
+// Purpose:     wxThreadPool benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/threadpool.h"
+
+#include <atomic>
+#include <vector>
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Number of the trivial tasks executed by the benchmarks below, as they
+// measure the overhead of executing the tasks and not the tasks themselves.
+const int NUM_TASKS = 1000;
+
+int Fibonacci(wxThreadPool& pool, int n)
+{
+    // Don't create the tasks for the smallest subproblems, as real code
+    // would do too.
+    if ( n < 10 )
+        return n < 2 ? n : Fibonacci(pool, n - 1) + Fibonacci(pool, n - 2);
+
+    wxFuture<int> f = pool.Submit([&pool, n]() { return Fibonacci(pool, n - 1); });
+    const int n2 = Fibonacci(pool, n - 2);
+
+    return f.Get() + n2;
+}
+
+// Thread executing a single trivial task, used for comparison with the pool.
+class TaskThread : public wxThread
+{
+public:
+    explicit TaskThread(std::atomic<int>& count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_count++;
+
+        return nullptr;
+    }
+
+private:
+    std::atomic<int>& m_count;
+};
+
+} // anonymous namespace
+
+// All benchmarks use the global pool with as many threads as there are CPUs.
+BENCHMARK_FUNC(ThreadPoolSubmitGet)
+{
+    wxThreadPool& pool = wxThreadPool::Get();
+
+    std::vector<wxFuture<int>> futures;
+    futures.reserve(NUM_TASKS);
+    for ( int n = 0; n < NUM_TASKS; n++ )
+        futures.push_back(pool.Submit([n]() { return n; }));
+
+    int sum = 0;
+    for ( int n = 0; n < NUM_TASKS; n++ )
+        sum += futures[n].Get();
+
+    return sum == NUM_TASKS*(NUM_TASKS - 1)/2;
+}
+
+BENCHMARK_FUNC(ThreadPoolParallelFor)
+{
+    // Each ParallelFor() call is a fork/join of all the pool threads.
+    std::atomic<int> sum(0);
+    for ( int n = 0; n < NUM_TASKS / 10; n++ )
+    {
+        wxThreadPool::Get().ParallelFor(0, 64, [&sum](size_t i)
+            {
+                sum += static_cast<int>(i);
+            });
+    }
+
+    return sum == NUM_TASKS / 10 * 2016;
+}
+
+BENCHMARK_FUNC(ThreadPoolFibonacci)
+{
+    // Recursive fork/join creating many tasks from the pool threads.
+    wxThreadPool& pool = wxThreadPool::Get();
+
+    return pool.Submit([&pool]() { return Fibonacci(pool, 24); }).Get() == 46368;
+}
+
+BENCHMARK_FUNC(ThreadPerTask)
+{
+    // This is what the code not using the pool has to do.
+    std::atomic<int> count(0);
+    for ( int n = 0; n < NUM_TASKS / 10; n++ )
+    {
+        TaskThread thread(count);
+        if ( thread.Run() != wxTHREAD_NO_ERROR )
+            return false;
+
+        thread.Wait();
+    }
+
+    return count == NUM_TASKS / 10;
+}
+
+#endif // wxUSE_THREADS
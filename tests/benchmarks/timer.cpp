@@ -0,0 +1,85 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/timer.cpp
+// Purpose:     wxTimer-related benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/timer.h"
+
+#include <vector>
+
+#if wxUSE_TIMER
+
+namespace
+{
+
+// The numeric parameter specifies the number of timers, 100000 by default.
+std::vector<wxTimer*> gs_timers;
+
+bool InitTimers()
+{
+    const long count = Bench::GetNumericParameter(100000);
+    for ( long n = 0; n < count; n++ )
+        gs_timers.push_back(new wxTimer);
+
+    return true;
+}
+
+void DoneTimers()
+{
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        delete gs_timers[n];
+
+    gs_timers.clear();
+}
+
+// Start all timers with different intervals, long enough for them to never
+// expire during the benchmark.
+void StartTimers()
+{
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        gs_timers[n]->Start(1000000 + (n*7919) % 100000);
+}
+
+bool InitRunningTimers()
+{
+    InitTimers();
+    StartTimers();
+
+    return true;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(TimersStartStop, InitTimers, DoneTimers)
+{
+    StartTimers();
+
+    // Stop the timers in a different order from the one they were started in
+    // and expire in.
+    const size_t count = gs_timers.size();
+    for ( size_t n = 0; n < count; n++ )
+        gs_timers[(n*7) % count]->Stop();
+
+    for ( size_t n = 0; n < count; n++ )
+        gs_timers[n]->Stop();
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TimersRestart, InitRunningTimers, DoneTimers)
+{
+    // Restarting a running timer stops it and starts it again, which is what
+    // happens when timers are used for timeouts which are postponed.
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        gs_timers[n]->Start();
+
+    return true;
+}
+
+#endif // wxUSE_TIMER
@@ -13,7 +13,11 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/event.h"
+#include "wx/thread.h"
+
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // test events and their handlers
@@ -510,6 +514,447 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+// Helper for ManyBindings test: records the order in which it is called.
+class OrderRecorder
+{
+public:
+    OrderRecorder() = default;
+
+    void Init(std::vector<int>& called, int n)
+    {
+        m_called = &called;
+        m_n = n;
+    }
+
+    void OnEvent(MyEvent& e)
+    {
+        m_called->push_back(m_n);
+        e.Skip();
+    }
+
+private:
+    std::vector<int>* m_called = nullptr;
+    int m_n = 0;
+
+    wxDECLARE_NO_COPY_CLASS(OrderRecorder);
+};
+
+TEST_CASE("Event::ManyBindings", "[event][bind][unbind]")
+{
+    // Use enough handlers for the dynamic event table to be indexed by event
+    // type and id and check that they are still called in the right order,
+    // i.e. in the reverse order of binding them.
+    MyHandler handler;
+    std::vector<int> called;
+
+    const int NUM_RECORDERS = 30;
+    OrderRecorder recorders[NUM_RECORDERS];
+
+    // Bind the handlers for a single id, any id or a range of ids.
+    const auto bindRecorder = [&](int n)
+    {
+        switch ( n % 3 )
+        {
+            case 0:
+                handler.Bind(MyEventType, &OrderRecorder::OnEvent,
+                             &recorders[n], 100 + n % 5);
+                break;
+
+            case 1:
+                handler.Bind(MyEventType, &OrderRecorder::OnEvent,
+                             &recorders[n]);
+                break;
+
+            case 2:
+                handler.Bind(MyEventType, &OrderRecorder::OnEvent,
+                             &recorders[n], 100, 102);
+                break;
+        }
+    };
+
+    const auto unbindRecorder = [&](int n)
+    {
+        switch ( n % 3 )
+        {
+            case 0:
+                CHECK( handler.Unbind(MyEventType, &OrderRecorder::OnEvent,
+                                      &recorders[n], 100 + n % 5) );
+                break;
+
+            case 1:
+                CHECK( handler.Unbind(MyEventType, &OrderRecorder::OnEvent,
+                                      &recorders[n]) );
+                break;
+
+            case 2:
+                CHECK( handler.Unbind(MyEventType, &OrderRecorder::OnEvent,
+                                      &recorders[n], 100, 102) );
+                break;
+        }
+    };
+
+    for ( int n = 0; n < NUM_RECORDERS; n++ )
+    {
+        recorders[n].Init(called, n);
+        bindRecorder(n);
+
+        // Also bind some handlers for another event type which must not be
+        // called.
+        handler.Bind(wxEVT_IDLE, [](wxIdleEvent&) { FAIL("shouldn't be called"); });
+    }
+
+    MyEvent e;
+
+    // Handlers 3, 18 are bound to this id and all handlers with n % 3 == 1
+    // are called for any id.
+    e.SetId(103);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{28, 25, 22, 19, 18, 16, 13, 10, 7, 4, 3, 1} );
+
+    // Handlers 0, 15 are bound to this id and all handlers with n % 3 == 2
+    // are bound to the range containing it.
+    called.clear();
+    e.SetId(100);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{29, 28, 26, 25, 23, 22, 20, 19, 17, 16,
+                                      15, 14, 13, 11, 10, 8, 7, 5, 4, 2, 1, 0} );
+
+    // Check that unbinding handlers works and that rebinding them puts them
+    // in front of all the other ones.
+    unbindRecorder(3);
+    unbindRecorder(4);
+    unbindRecorder(28);
+    bindRecorder(4);
+    bindRecorder(3);
+
+    called.clear();
+    e.SetId(103);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{3, 4, 25, 22, 19, 18, 16, 13, 10, 7, 1} );
+
+    // Also check that handlers can be unbound while the event is being
+    // processed.
+    handler.Bind(MyEventType, [&](MyEvent& event)
+                 {
+                     unbindRecorder(25);
+                     unbindRecorder(18);
+                     event.Skip();
+                 });
+
+    called.clear();
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{3, 4, 22, 19, 16, 13, 10, 7, 1} );
+
+    // Finally check that nothing is called for an event without handlers.
+    called.clear();
+    MyEvent other;
+    other.SetEventType(wxNewEventType());
+    CHECK( !handler.ProcessEvent(other) );
+    CHECK( called.empty() );
+}
+
+TEST_CASE("Event::QueueEvent", "[event][queue]")
+{
+    REQUIRE( wxTheApp );
+
+    // Check that the events are processed in the order in which they were
+    // queued for the same handler and that all the events for the handler
+    // which got its pending events first are processed before the others.
+    std::vector<int> processed;
+
+    const auto bindRecorder = [&processed](wxEvtHandler& handler)
+    {
+        handler.Bind(wxEVT_THREAD, [&processed](wxThreadEvent& e)
+                     {
+                         processed.push_back(e.GetInt());
+                     });
+    };
+
+    const auto queueEvent = [](wxEvtHandler& handler, int n)
+    {
+        wxThreadEvent* const event = new wxThreadEvent();
+        event->SetInt(n);
+        handler.QueueEvent(event);
+    };
+
+    wxEvtHandler handler1,
+                 handler2;
+    bindRecorder(handler1);
+    bindRecorder(handler2);
+
+    queueEvent(handler1, 1);
+    queueEvent(handler2, 2);
+    queueEvent(handler1, 3);
+    queueEvent(handler2, 4);
+    queueEvent(handler1, 5);
+
+    CHECK( wxTheApp->HasPendingEvents() );
+
+    // Pending events of a destroyed handler must be just discarded.
+    {
+        wxEvtHandler handlerTemp;
+        bindRecorder(handlerTemp);
+        queueEvent(handlerTemp, 6);
+    }
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( processed == std::vector<int>{1, 3, 5, 2, 4} );
+    CHECK( !wxTheApp->HasPendingEvents() );
+
+    // Deleting the pending events must work too.
+    processed.clear();
+    queueEvent(handler1, 7);
+    queueEvent(handler2, 8);
+    handler1.DeletePendingEvents();
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( processed == std::vector<int>{8} );
+    CHECK( !wxTheApp->HasPendingEvents() );
+}
+
+TEST_CASE("Event::QueueEvents", "[event][queue]")
+{
+    REQUIRE( wxTheApp );
+
+    std::vector<int> processed;
+
+    wxEvtHandler handler;
+    handler.Bind(wxEVT_THREAD, [&processed](wxThreadEvent& e)
+                 {
+                     processed.push_back(e.GetInt());
+                 });
+
+    wxVector<wxEvent*> events;
+    for ( int n = 0; n < 3; n++ )
+    {
+        wxThreadEvent* const event = new wxThreadEvent();
+        event->SetInt(n);
+        events.push_back(event);
+    }
+
+    handler.QueueEvents(events);
+
+    // An empty batch is allowed too.
+    handler.QueueEvents(wxVector<wxEvent*>());
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( processed == std::vector<int>{0, 1, 2} );
+    CHECK( !wxTheApp->HasPendingEvents() );
+}
+
+TEST_CASE("Event::QueueOrReplaceEvent", "[event][queue]")
+{
+    REQUIRE( wxTheApp );
+
+    std::vector<int> processed;
+
+    wxEvtHandler handler;
+    handler.Bind(wxEVT_THREAD, [&processed](wxThreadEvent& e)
+                 {
+                     processed.push_back(e.GetId()*100 + e.GetInt());
+                 });
+
+    const auto queueEvent = [&handler](int id, int n, bool replace)
+    {
+        wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, id);
+        event->SetInt(n);
+
+        if ( replace )
+            handler.QueueOrReplaceEvent(event);
+        else
+            handler.QueueEvent(event);
+    };
+
+    // The replacing event takes the place of the event it replaces, but
+    // doesn't replace the events queued with QueueEvent().
+    queueEvent(1, 1, true);
+    queueEvent(2, 1, true);
+    queueEvent(1, 2, false);
+    queueEvent(1, 3, true);
+    queueEvent(2, 2, true);
+    queueEvent(1, 4, true);
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( processed == std::vector<int>{104, 202, 102} );
+
+    // Once the event is processed, the next one is queued again.
+    processed.clear();
+    queueEvent(1, 5, true);
+    queueEvent(1, 6, true);
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( processed == std::vector<int>{106} );
+    CHECK( !wxTheApp->HasPendingEvents() );
+
+    // Check that deleting the pending events works for them too.
+    processed.clear();
+    queueEvent(1, 7, true);
+    handler.DeletePendingEvents();
+    queueEvent(1, 8, true);
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( processed == std::vector<int>{108} );
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Thread queuing the given number of events with its id to a handler.
+class QueuingThread : public wxThread
+{
+public:
+    QueuingThread(wxEvtHandler& handler, int id, int count, bool replace = false)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_id(id),
+          m_count(count),
+          m_replace(replace)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < m_count; n++ )
+        {
+            wxThreadEvent* const event = new wxThreadEvent(wxEVT_THREAD, m_id);
+            event->SetInt(n);
+
+            if ( m_replace )
+                m_handler.QueueOrReplaceEvent(event);
+            else
+                m_handler.QueueEvent(event);
+        }
+
+        return nullptr;
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const int m_id;
+    const int m_count;
+    const bool m_replace;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::QueueEventFromThreads", "[event][queue]")
+{
+    REQUIRE( wxTheApp );
+
+    const int NUM_THREADS = 4;
+    const int NUM_EVENTS = 1000;
+
+    // Use a separate handler for each thread, in addition to a common one, to
+    // check that the set of handlers with pending events is updated correctly
+    // when it's modified from several threads.
+    wxEvtHandler handlerCommon;
+    wxEvtHandler handlers[NUM_THREADS];
+
+    int next[NUM_THREADS] = { 0 };
+    int nextCommon[NUM_THREADS] = { 0 };
+    const auto bindRecorder = [](wxEvtHandler& handler, int* nextForThread)
+    {
+        handler.Bind(wxEVT_THREAD, [nextForThread](wxThreadEvent& e)
+                     {
+                         // Events from the same thread must be processed in
+                         // the order in which they were queued.
+                         CHECK( e.GetInt() == nextForThread[e.GetId()]++ );
+                     });
+    };
+
+    bindRecorder(handlerCommon, nextCommon);
+
+    std::vector<wxThread*> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        bindRecorder(handlers[n], next);
+
+        threads.push_back(new QueuingThread(handlerCommon, n, NUM_EVENTS));
+        threads.push_back(new QueuingThread(handlers[n], n, NUM_EVENTS));
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+        REQUIRE( threads[n]->Run() == wxTHREAD_NO_ERROR );
+
+    // Process the events while they're being queued too.
+    for ( int n = 0; n < 10; n++ )
+    {
+        wxTheApp->ProcessPendingEvents();
+        wxThread::Yield();
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    wxTheApp->ProcessPendingEvents();
+    CHECK( !wxTheApp->HasPendingEvents() );
+
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        CHECK( next[n] == NUM_EVENTS );
+        CHECK( nextCommon[n] == NUM_EVENTS );
+    }
+}
+
+TEST_CASE("Event::QueueOrReplaceEventFromThreads", "[event][queue]")
+{
+    REQUIRE( wxTheApp );
+
+    const int NUM_THREADS = 4;
+    const int NUM_EVENTS = 1000;
+
+    // The events from each thread must be processed in order, even if some of
+    // them are replaced, and the last one must be always processed.
+    int last[NUM_THREADS];
+    for ( int n = 0; n < NUM_THREADS; n++ )
+        last[n] = -1;
+
+    wxEvtHandler handler;
+    handler.Bind(wxEVT_THREAD, [&last](wxThreadEvent& e)
+                 {
+                     CHECK( e.GetInt() > last[e.GetId()] );
+                     last[e.GetId()] = e.GetInt();
+                 });
+
+    std::vector<wxThread*> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.push_back(new QueuingThread(handler, n, NUM_EVENTS, true));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    for ( int n = 0; n < 10; n++ )
+    {
+        wxTheApp->ProcessPendingEvents();
+        wxThread::Yield();
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    wxTheApp->ProcessPendingEvents();
+    CHECK( !wxTheApp->HasPendingEvents() );
+
+    for ( int n = 0; n < NUM_THREADS; n++ )
+        CHECK( last[n] == NUM_EVENTS - 1 );
+}
+
+#endif // wxUSE_THREADS
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
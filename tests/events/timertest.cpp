@@ -18,6 +18,9 @@
 
 #include <time.h>
 
+#include <memory>
+#include <vector>
+
 #include "wx/evtloop.h"
 #include "wx/timer.h"
 
@@ -65,10 +68,12 @@ private:
     CPPUNIT_TEST_SUITE( TimerEventTestCase );
         CPPUNIT_TEST( OneShot );
         CPPUNIT_TEST( Multiple );
+        CPPUNIT_TEST( Order );
     CPPUNIT_TEST_SUITE_END();
 
     void OneShot();
     void Multiple();
+    void Order();
 
     wxDECLARE_NO_COPY_CLASS(TimerEventTestCase);
 };
@@ -137,3 +142,67 @@ void TimerEventTestCase::Multiple()
     // more than one
     CPPUNIT_ASSERT( numTicks > 1 );
 }
+
+void TimerEventTestCase::Order()
+{
+    class OrderHandler : public wxEvtHandler
+    {
+    public:
+        OrderHandler()
+        {
+            Bind(wxEVT_TIMER, &OrderHandler::OnTimer, this);
+        }
+
+        std::vector<int> m_ids;
+
+    private:
+        void OnTimer(wxTimerEvent& event)
+        {
+            m_ids.push_back(event.GetId());
+        }
+    };
+
+    wxEventLoop loop;
+
+    OrderHandler handler;
+
+    // Start the timers in an order different from the order of their
+    // expiration, with some of them expiring at the same time.
+    const int NUM_TIMERS = 20;
+    std::vector< std::unique_ptr<wxTimer> > timers;
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        const int id = (n*7) % NUM_TIMERS;
+        timers.push_back(std::unique_ptr<wxTimer>(new wxTimer(&handler, id)));
+        timers.back()->StartOnce(100 + (id / 2)*20);
+    }
+
+    // Stopping or restarting some timers must remove them from their old
+    // positions.
+    timers[3]->Stop();
+    timers[10]->Stop();
+    timers[5]->StartOnce(800);
+
+    const int idStopped1 = timers[3]->GetId(),
+              idStopped2 = timers[10]->GetId(),
+              idLast = timers[5]->GetId();
+
+    const time_t tEnd = time(nullptr) + 5;
+    while ( handler.m_ids.size() < NUM_TIMERS - 2 && time(nullptr) < tEnd )
+    {
+        loop.Dispatch();
+    }
+
+    const std::vector<int>& ids = handler.m_ids;
+    CPPUNIT_ASSERT_EQUAL( NUM_TIMERS - 2, (int)ids.size() );
+    CPPUNIT_ASSERT_EQUAL( idLast, ids.back() );
+
+    for ( size_t n = 0; n < ids.size(); n++ )
+    {
+        CPPUNIT_ASSERT( ids[n] != idStopped1 );
+        CPPUNIT_ASSERT( ids[n] != idStopped2 );
+
+        if ( n > 0 && ids[n] != idLast )
+            CPPUNIT_ASSERT( ids[n - 1] / 2 <= ids[n] / 2 );
+    }
+}
@@ -27,12 +27,15 @@
 #include "wx/palette.h"
 #include "wx/url.h"
 #include "wx/log.h"
+#include "wx/math.h"
 #include "wx/mstream.h"
 #include "wx/zstream.h"
 #include "wx/wfstream.h"
 #include "wx/clipbrd.h"
 #include "wx/dataobj.h"
 #include "wx/utils.h"
+#include "wx/scopeguard.h"
+#include "wx/quantize.h"
 
 // Check if we can use wxDIB::ConvertToBitmap(), which only exists for MSW and
 // which assumes the target is little-endian (matching the file format)
@@ -1158,6 +1161,622 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::SaveTIFF", "[image]")
 }
 #endif // wxUSE_LIBTIFF
 
+static void CheckLoadMaxSize(const wxString& file)
+{
+    INFO("Loading " << file);
+
+    const wxImage full(file);
+    REQUIRE( full.GetSize() == wxSize(200, 200) );
+
+    const auto loadWithMax = [&](int maxWidth, int maxHeight)
+    {
+        wxImage image;
+        image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, maxWidth);
+        image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, maxHeight);
+        REQUIRE( image.LoadFile(file) );
+
+        return image;
+    };
+
+    // Image is scaled to fit into the limits exactly, using the most
+    // constraining one.
+    wxImage image = loadWithMax(150, 0);
+    CHECK( image.GetSize() == wxSize(150, 150) );
+    CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == 200 );
+    CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) == 200 );
+
+    CHECK( loadWithMax(0, 37).GetSize() == wxSize(37, 37) );
+    CHECK( loadWithMax(90, 60).GetSize() == wxSize(60, 60) );
+    CHECK( loadWithMax(25, 1000).GetSize() == wxSize(25, 25) );
+
+    // Nothing is done if the image already fits.
+    image = loadWithMax(200, 300);
+    CHECK( image.GetSize() == wxSize(200, 200) );
+    CHECK( !image.HasOption(wxIMAGE_OPTION_ORIGINAL_WIDTH) );
+
+    // The result is the same as scaling the image after loading it, except
+    // for JPEG, where it's decoded at a smaller size first.
+    if ( file.EndsWith(".png") )
+    {
+        CHECK_THAT( loadWithMax(80, 0),
+                    RGBSameAs(full.Scale(80, 80, wxIMAGE_QUALITY_HIGH)) );
+    }
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadMaxSize", "[image]")
+{
+    // Use both JPEG, which scales the image while decoding it, and PNG, for
+    // which it's scaled after loading it.
+    CheckLoadMaxSize("horse.jpg");
+    CheckLoadMaxSize("horse.png");
+}
+
+// Read the image from the given stream using wxImageRowReader, numRows at a
+// time, and check that the result is the same as the expected image.
+static void
+CheckRowReader(wxInputStream& stream, const wxImage& expected, int numRows)
+{
+    INFO("Reading " << numRows << " rows at a time");
+
+    REQUIRE( stream.SeekI(0) == 0 );
+
+    std::unique_ptr<wxImageRowReader> reader(wxImage::CreateRowReader(stream));
+    REQUIRE( reader );
+
+    CHECK( reader->GetWidth() == expected.GetWidth() );
+    REQUIRE( reader->GetHeight() == expected.GetHeight() );
+
+    wxImage image(expected.GetWidth(), expected.GetHeight());
+    if ( reader->HasAlpha() )
+        image.SetAlpha();
+
+    while ( !reader->IsDone() )
+    {
+        const int row = reader->GetCurrentRow();
+        const wxImage rows = reader->ReadImage(numRows);
+        REQUIRE( rows.IsOk() );
+
+        CHECK( rows.GetHeight() == wxMin(numRows, expected.GetHeight() - row) );
+        CHECK( reader->GetCurrentRow() == row + rows.GetHeight() );
+
+        image.Paste(rows, 0, row, wxIMAGE_ALPHA_BLEND_OVER);
+    }
+
+    CHECK( reader->IsOk() );
+    CHECK( reader->ReadRows(image.GetData(), nullptr, 1) == 0 );
+
+    // The reader may return alpha values for the images which turn out to
+    // not have any non-opaque pixels after being fully loaded.
+    if ( !expected.HasAlpha() && image.HasAlpha() )
+    {
+        wxImage expectedWithAlpha = expected.Copy();
+        expectedWithAlpha.InitAlpha();
+        CHECK_THAT( image, RGBASameAs(expectedWithAlpha) );
+    }
+    else
+    {
+        CHECK_THAT( image, RGBASameAs(expected) );
+    }
+}
+
+static void CheckRowReader(wxInputStream& stream)
+{
+    wxImage expected;
+    REQUIRE( expected.LoadFile(stream) );
+
+    CheckRowReader(stream, expected, 1);
+    CheckRowReader(stream, expected, 17);
+    CheckRowReader(stream, expected, expected.GetHeight() + 1);
+}
+
+static void CheckRowReader(const wxString& filename)
+{
+    INFO("File " << filename);
+
+    wxFileInputStream stream(filename);
+    REQUIRE( stream.IsOk() );
+
+    CheckRowReader(stream);
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::RowReader", "[image]")
+{
+    CheckRowReader("horse.png");
+    CheckRowReader("horse.jpg");
+
+    // Interlaced PNG with palette and transparency.
+    CheckRowReader("image/toucan.png");
+
+    // PNG with alpha.
+    CheckRowReader("image/paste_input_overlay_transparent_border_semitransparent_circle.png");
+
+#if wxUSE_LIBTIFF
+    CheckRowReader("horse.tif");
+
+    wxImage alphaImage("horse.png");
+    REQUIRE( alphaImage.IsOk() );
+    SetAlpha(&alphaImage);
+
+    for ( int samplesPerPixel : { 4, 2 } )
+    {
+        INFO("TIFF with " << samplesPerPixel << " samples per pixel");
+
+        alphaImage.SetOption(wxIMAGE_OPTION_TIFF_SAMPLESPERPIXEL, samplesPerPixel);
+
+        wxMemoryOutputStream memOut;
+        REQUIRE( alphaImage.SaveFile(memOut, wxBITMAP_TYPE_TIFF) );
+
+        wxMemoryInputStream memIn(memOut);
+        CheckRowReader(memIn);
+    }
+#endif // wxUSE_LIBTIFF
+
+    // Formats not supporting incremental reading.
+    {
+        wxFileInputStream stream("horse.bmp");
+        REQUIRE( stream.IsOk() );
+        CHECK( !wxImage::CreateRowReader(stream) );
+    }
+
+    // Truncated images.
+    for ( const char* name : { "horse.png", "horse.jpg" } )
+    {
+        INFO("Truncated " << name);
+
+        wxFileInputStream fileIn(name);
+        REQUIRE( fileIn.IsOk() );
+
+        wxMemoryOutputStream memOut;
+        fileIn.Read(memOut);
+
+        wxVector<char> data(memOut.GetSize());
+        memOut.CopyTo(&data[0], data.size());
+
+        wxMemoryInputStream memIn(&data[0], data.size() / 2);
+
+        wxLogNull noLog;
+        std::unique_ptr<wxImageRowReader> reader(wxImage::CreateRowReader(memIn));
+        REQUIRE( reader );
+
+        wxImage image(reader->GetWidth(), reader->GetHeight());
+        while ( reader->ReadRows(image.GetData(), nullptr, 10) )
+            ;
+
+        // libjpeg silently pads truncated images, so we can't detect errors
+        // for it.
+        if ( wxString(name).EndsWith(".png") )
+            CHECK( !reader->IsOk() );
+
+        CHECK( reader->IsDone() );
+    }
+}
+
+#if wxUSE_THREADS
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::BatchLoader", "[image]")
+{
+    const char* const files[] =
+    {
+        "horse.bmp",
+        "horse.jpg",
+        "horse.png",
+        "image/toucan.png",
+        "no-such-file.png",
+    };
+
+    // Use a tiny limit to check that the loader still makes progress, even
+    // if it can't have more than one image loaded at any time.
+    for ( size_t maxBytes : { 0, 1 } )
+    {
+        INFO("Memory limit " << maxBytes);
+
+        wxImageBatchLoader loader(2);
+        loader.SetMemoryLimit(maxBytes);
+
+        for ( size_t n = 0; n < WXSIZEOF(files); n++ )
+            CHECK( loader.AddFile(files[n]) == n );
+
+        REQUIRE( loader.Start() );
+
+        // Images can also be added after starting the loader.
+        CHECK( loader.AddStream(new wxFileInputStream("horse.gif")) ==
+                WXSIZEOF(files) );
+
+        CHECK( loader.GetPendingCount() == WXSIZEOF(files) + 1 );
+
+        wxVector<bool> seen(WXSIZEOF(files) + 1, false);
+
+        wxLogNull noLog;
+
+        wxImageBatchResult result;
+        while ( loader.GetNext(result) )
+        {
+            REQUIRE( result.index < seen.size() );
+            CHECK( !seen[result.index] );
+            seen[result.index] = true;
+
+            if ( result.index == WXSIZEOF(files) )
+            {
+                CHECK( result.filename.empty() );
+                CHECK_THAT( result.image, RGBSameAs(wxImage("horse.gif")) );
+                continue;
+            }
+
+            CHECK( result.filename == files[result.index] );
+
+            const wxImage expected(files[result.index]);
+            if ( expected.IsOk() )
+                CHECK_THAT( result.image, RGBASameAs(expected) );
+            else
+                CHECK( !result.image.IsOk() );
+        }
+
+        CHECK( loader.GetPendingCount() == 0 );
+        for ( size_t n = 0; n < seen.size(); n++ )
+            CHECK( seen[n] );
+
+        // Check that it doesn't block when there is nothing left to load.
+        CHECK( !loader.GetNext(result, 0) );
+    }
+
+    // Destroying the loader before retrieving all images must work too.
+    {
+        wxImageBatchLoader loader;
+        for ( int n = 0; n < 10; n++ )
+            loader.AddFile("horse.png");
+        REQUIRE( loader.Start() );
+
+        wxImageBatchResult result;
+        CHECK( loader.GetNext(result) );
+    }
+}
+
+#endif // wxUSE_THREADS
+
+// Store the pixels of the image in the given format, with some padding after
+// each row.
+static wxVector<unsigned char>
+MakeViewBuffer(const wxImage& image, wxImagePixelFormat format, int stride)
+{
+    wxVector<unsigned char> buf(stride*image.GetHeight(), 0xcd);
+    for ( int y = 0; y < image.GetHeight(); y++ )
+    {
+        unsigned char* p = &buf[stride*y];
+        for ( int x = 0; x < image.GetWidth(); x++ )
+        {
+            const unsigned char r = image.GetRed(x, y),
+                                g = image.GetGreen(x, y),
+                                b = image.GetBlue(x, y);
+            switch ( format )
+            {
+                case wxIMAGE_FORMAT_RGB:
+                    *p++ = r;
+                    *p++ = g;
+                    *p++ = b;
+                    break;
+
+                case wxIMAGE_FORMAT_RGBA:
+                    *p++ = r;
+                    *p++ = g;
+                    *p++ = b;
+                    *p++ = image.GetAlpha(x, y);
+                    break;
+
+                case wxIMAGE_FORMAT_BGRA:
+                    *p++ = b;
+                    *p++ = g;
+                    *p++ = r;
+                    *p++ = image.GetAlpha(x, y);
+                    break;
+
+                case wxIMAGE_FORMAT_GRAY:
+                    *p++ = r;
+                    break;
+
+                case wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED:
+                    {
+                        const unsigned a = image.GetAlpha(x, y);
+                        const wxUint32 argb = a << 24 |
+                                              (r*a/255) << 16 |
+                                              (g*a/255) << 8 |
+                                              (b*a/255);
+                        memcpy(p, &argb, 4);
+                        p += 4;
+                    }
+                    break;
+            }
+        }
+    }
+
+    return buf;
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImageView", "[image]")
+{
+    wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    image.InitAlpha();
+    unsigned char* alpha = image.GetAlpha();
+    for ( int n = 0; n < image.GetWidth()*image.GetHeight(); n++ )
+        alpha[n] = static_cast<unsigned char>(n*7);
+
+    const wxImage grey = image.ConvertToGreyscale();
+
+    const wxImagePixelFormat formats[] =
+    {
+        wxIMAGE_FORMAT_RGB,
+        wxIMAGE_FORMAT_RGBA,
+        wxIMAGE_FORMAT_BGRA,
+        wxIMAGE_FORMAT_GRAY,
+        wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED,
+    };
+
+    for ( wxImagePixelFormat format : formats )
+    {
+        INFO("Format " << format);
+
+        // This is the image that the view should be equivalent to.
+        wxImage expected;
+        switch ( format )
+        {
+            case wxIMAGE_FORMAT_RGB:
+                expected = image.Copy();
+                expected.ClearAlpha();
+                break;
+
+            case wxIMAGE_FORMAT_RGBA:
+            case wxIMAGE_FORMAT_BGRA:
+                expected = image;
+                break;
+
+            case wxIMAGE_FORMAT_GRAY:
+                expected = grey.Copy();
+                expected.ClearAlpha();
+                break;
+
+            case wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED:
+                // Premultiplying loses precision for transparent pixels.
+                expected = image.Copy();
+                for ( int y = 0; y < expected.GetHeight(); y++ )
+                {
+                    for ( int x = 0; x < expected.GetWidth(); x++ )
+                    {
+                        const unsigned a = expected.GetAlpha(x, y);
+                        unsigned char rgb[3] = { expected.GetRed(x, y),
+                                                 expected.GetGreen(x, y),
+                                                 expected.GetBlue(x, y) };
+                        for ( unsigned char& c : rgb )
+                            c = a ? (c*a/255)*255/a : 0;
+
+                        expected.SetRGB(x, y, rgb[0], rgb[1], rgb[2]);
+                    }
+                }
+                break;
+        }
+
+        // Use padding which is not a multiple of 4 when possible.
+        const int bpp = wxImageView::GetBytesPerPixel(format);
+        const int padding = format == wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED ? 8 : 5;
+        const int stride = bpp*image.GetWidth() + padding;
+        const wxVector<unsigned char>
+            buf = MakeViewBuffer(format == wxIMAGE_FORMAT_GRAY ? grey : image,
+                                 format, stride);
+
+        const wxImageView view(&buf[0], image.GetWidth(), image.GetHeight(),
+                               format, stride);
+        REQUIRE( view.IsOk() );
+        CHECK( view.HasAlpha() == expected.HasAlpha() );
+        CHECK( view.GetRow(1) == &buf[stride] );
+
+        CHECK_THAT( wxImage(view), RGBASameAs(expected) );
+
+        CHECK_THAT( view.Mirror(), RGBASameAs(expected.Mirror()) );
+        CHECK_THAT( view.Mirror(false), RGBASameAs(expected.Mirror(false)) );
+        CHECK_THAT( view.Rotate90(), RGBASameAs(expected.Rotate90()) );
+        CHECK_THAT( view.Rotate90(false), RGBASameAs(expected.Rotate90(false)) );
+        CHECK_THAT( view.Rotate180(), RGBASameAs(expected.Rotate180()) );
+
+        const wxRect rect(10, 20, 37, 41);
+        const wxImageView subview = view.GetSubView(rect);
+        CHECK( subview.GetData() == view.GetRow(20) + 10*bpp );
+        CHECK( subview.GetStride() == stride );
+        CHECK_THAT( wxImage(subview), RGBASameAs(expected.GetSubImage(rect)) );
+
+        const wxImageResizeQuality qualities[] =
+        {
+            wxIMAGE_QUALITY_NORMAL,
+            wxIMAGE_QUALITY_BILINEAR,
+            wxIMAGE_QUALITY_BICUBIC,
+            wxIMAGE_QUALITY_BOX_AVERAGE,
+            wxIMAGE_QUALITY_HIGH,
+            wxIMAGE_QUALITY_NEAREST,
+        };
+
+        for ( wxImageResizeQuality quality : qualities )
+        {
+            INFO("Quality " << quality);
+
+            // Avoid sizes dividing the original one evenly, as Scale() uses
+            // a different algorithm for them with wxIMAGE_QUALITY_NEAREST.
+            CHECK_THAT( view.Scale(57, 31, quality),
+                        RGBASameAs(expected.Scale(57, 31, quality)) );
+            CHECK_THAT( view.Scale(301, 397, quality),
+                        RGBASameAs(expected.Scale(301, 397, quality)) );
+        }
+    }
+}
+
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::CopyToBuffer", "[image]")
+{
+    wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    const wxImagePixelFormat formats[] =
+    {
+        wxIMAGE_FORMAT_RGB,
+        wxIMAGE_FORMAT_RGBA,
+        wxIMAGE_FORMAT_BGRA,
+        wxIMAGE_FORMAT_ARGB32_PREMULTIPLIED,
+    };
+
+    // Check both without and with alpha.
+    for ( int n = 0; n < 2; n++ )
+    {
+        if ( n )
+        {
+            image.InitAlpha();
+            unsigned char* alpha = image.GetAlpha();
+            for ( int i = 0; i < image.GetWidth()*image.GetHeight(); i++ )
+                alpha[i] = static_cast<unsigned char>(i*3);
+        }
+
+        // Images without alpha are copied as opaque ones.
+        wxImage withAlpha = image.Copy();
+        if ( !withAlpha.HasAlpha() )
+            withAlpha.InitAlpha();
+
+        for ( wxImagePixelFormat format : formats )
+        {
+            INFO("Format " << format << " with" << (n ? "" : "out") << " alpha");
+
+            const int stride =
+                wxImageView::GetBytesPerPixel(format)*image.GetWidth() + 8;
+
+            wxVector<unsigned char> buf(stride*image.GetHeight(), 0xcd);
+            REQUIRE( image.CopyToBuffer(&buf[0], format, stride) );
+            CHECK( buf == MakeViewBuffer(withAlpha, format, stride) );
+        }
+    }
+
+    const wxImage grey = image.ConvertToGreyscale();
+    wxVector<unsigned char> buf(image.GetWidth()*image.GetHeight());
+    REQUIRE( image.CopyToBuffer(&buf[0], wxIMAGE_FORMAT_GRAY) );
+    CHECK( buf == MakeViewBuffer(grey, wxIMAGE_FORMAT_GRAY, image.GetWidth()) );
+
+    // Check that invalid arguments are detected.
+    WX_ASSERT_FAILS_WITH_ASSERT( image.CopyToBuffer(&buf[0], wxIMAGE_FORMAT_GRAY, 1) );
+}
+
+TEST_CASE("wxImage::Rotate90", "[image]")
+{
+    // Use the size which is not a multiple of the tile size used internally.
+    const int w = 75,
+              h = 43;
+
+    wxImage image(w, h, false);
+    image.SetAlpha();
+    for ( int y = 0; y < h; y++ )
+    {
+        for ( int x = 0; x < w; x++ )
+        {
+            image.SetRGB(x, y, x, y, x ^ y);
+            image.SetAlpha(x, y, x + y);
+        }
+    }
+
+    const auto checkPixel = [&](const wxImage& result, int x, int y,
+                                int xSrc, int ySrc)
+    {
+        INFO("Pixel (" << x << ", " << y << ")");
+        CHECK( result.GetRed(x, y) == image.GetRed(xSrc, ySrc) );
+        CHECK( result.GetGreen(x, y) == image.GetGreen(xSrc, ySrc) );
+        CHECK( result.GetBlue(x, y) == image.GetBlue(xSrc, ySrc) );
+        CHECK( result.GetAlpha(x, y) == image.GetAlpha(xSrc, ySrc) );
+    };
+
+    const wxImage cw = image.Rotate90(true);
+    REQUIRE( cw.GetSize() == wxSize(h, w) );
+    REQUIRE( cw.HasAlpha() );
+
+    const wxImage ccw = image.Rotate90(false);
+    REQUIRE( ccw.GetSize() == wxSize(h, w) );
+
+    const wxImage r180 = image.Rotate180();
+    REQUIRE( r180.GetSize() == wxSize(w, h) );
+
+    const wxImage mirrorH = image.Mirror(true);
+    const wxImage mirrorV = image.Mirror(false);
+
+    for ( int y = 0; y < h; y++ )
+    {
+        for ( int x = 0; x < w; x++ )
+        {
+            checkPixel(cw, h - 1 - y, x, x, y);
+            checkPixel(ccw, y, w - 1 - x, x, y);
+            checkPixel(r180, w - 1 - x, h - 1 - y, x, y);
+            checkPixel(mirrorH, w - 1 - x, y, x, y);
+            checkPixel(mirrorV, x, h - 1 - y, x, y);
+        }
+    }
+
+    CHECK_THAT( cw.Rotate90(false), RGBASameAs(image) );
+    CHECK_THAT( cw.Rotate90(true), RGBASameAs(r180) );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::Rotate", "[image]")
+{
+    const wxImage image("horse.png");
+    REQUIRE( image.IsOk() );
+
+    const int w = image.GetWidth();
+    const int h = image.GetHeight();
+    const wxPoint centre(w / 2, h / 2);
+
+    for ( bool interpolating : { false, true } )
+    {
+        INFO("Interpolating: " << interpolating);
+
+        wxPoint offset;
+        wxImage rotated = image.Rotate(0, centre, interpolating, &offset);
+        CHECK( offset == wxPoint(0, 0) );
+        CHECK_THAT( rotated.GetSubImage(wxRect(0, 0, w, h)),
+                    RGBSameAs(image) );
+
+        // Rotating by right angle must give the same results as Rotate90(),
+        // notice that positive angles correspond to counterclockwise rotation.
+        rotated = image.Rotate(M_PI / 2, centre, interpolating);
+        CHECK_THAT( rotated.GetSubImage(wxRect(0, 1, h, w)),
+                    RGBSameAs(image.Rotate90(false)) );
+
+        rotated = image.Rotate(-M_PI / 2, centre, interpolating);
+        CHECK_THAT( rotated.GetSubImage(wxRect(1, 0, h, w)),
+                    RGBSameAs(image.Rotate90(true)) );
+    }
+
+    // Interpolating a solid colour must give the same colour everywhere
+    // inside the image and transparent background outside of it.
+    wxImage solid(64, 48);
+    solid.SetRGB(wxRect(0, 0, 64, 48), 10, 200, 30);
+    solid.InitAlpha();
+
+    const wxImage rotated = solid.Rotate(0.5, wxPoint(10, 20), true);
+    REQUIRE( rotated.HasAlpha() );
+
+    int numInside = 0;
+    for ( int y = 0; y < rotated.GetHeight(); y++ )
+    {
+        for ( int x = 0; x < rotated.GetWidth(); x++ )
+        {
+            const unsigned char alpha = rotated.GetAlpha(x, y);
+            if ( alpha == wxIMAGE_ALPHA_TRANSPARENT )
+                continue;
+
+            INFO("Pixel (" << x << ", " << y << ")");
+            CHECK( alpha == wxIMAGE_ALPHA_OPAQUE );
+            CHECK( rotated.GetRed(x, y) == 10 );
+            CHECK( rotated.GetGreen(x, y) == 200 );
+            CHECK( rotated.GetBlue(x, y) == 30 );
+
+            numInside++;
+        }
+    }
+
+    // The number of pixels inside must be close to the image area.
+    CHECK( numInside == Approx(64*48).epsilon(0.05) );
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::ReadCorruptedTGA", "[image]")
 {
     static unsigned char corruptTGA[18+1+3] =
@@ -2146,6 +2765,99 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::ScaleCompare", "[image]")
                                "image/cross_nearest_neighb_256x256.png");
 }
 
+TEST_CASE("wxImage::GaussianBlur", "[image]")
+{
+    // Blurring a uniform image must not change it, in particular rounding
+    // errors must not accumulate over the successive passes.
+    wxImage uniform(50, 40);
+    uniform.SetRGB(wxRect(0, 0, 50, 40), 17, 128, 255);
+    uniform.InitAlpha();
+    memset(uniform.GetAlpha(), 99, 50*40);
+
+    CHECK_THAT( uniform.GaussianBlur(2.5), RGBASameAs(uniform) );
+    CHECK_THAT( uniform.Blur(3), RGBASameAs(uniform) );
+
+    // Radius greater than the image size must work too.
+    CHECK_THAT( uniform.GaussianBlur(100), RGBASameAs(uniform) );
+    CHECK_THAT( uniform.Blur(100), RGBASameAs(uniform) );
+
+    // Zero standard deviation is allowed and doesn't do anything.
+    wxImage image(31, 31);
+    image.SetRGB(15, 15, 255, 255, 255);
+    CHECK_THAT( image.GaussianBlur(0), RGBSameAs(image) );
+
+    // Blurring a single point must spread it symmetrically, with the value
+    // decreasing away from the centre.
+    const wxImage blurred = image.GaussianBlur(3);
+    CHECK_THAT( blurred.Mirror(true), RGBSameAs(blurred) );
+    CHECK_THAT( blurred.Mirror(false), RGBSameAs(blurred) );
+
+    CHECK( blurred.GetRed(15, 15) > 0 );
+    CHECK( blurred.GetRed(15, 15) < 255 );
+    for ( int x = 15; x < 30; x++ )
+    {
+        INFO("x=" << x);
+        CHECK( blurred.GetRed(x, 15) >= blurred.GetRed(x + 1, 15) );
+        CHECK( blurred.GetRed(x, 15) >= blurred.GetRed(x, 16) );
+    }
+
+    CHECK( blurred.GetRed(0, 0) == 0 );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::Parallelism", "[image]")
+{
+    wxImage original;
+    REQUIRE(original.LoadFile("horse.png"));
+
+    // Use an image big enough for the parallel processing to be really used
+    // and also check that the alpha channel is processed correctly.
+    const wxImage imageNoAlpha = original.Scale(700, 600, wxIMAGE_QUALITY_NEAREST);
+    wxImage image = imageNoAlpha.Copy();
+    image.InitAlpha();
+    unsigned char* const alpha = image.GetAlpha();
+    for ( int n = 0; n < image.GetWidth()*image.GetHeight(); n++ )
+        alpha[n] = n % 256;
+
+    const auto processImage = [&](const wxImage& img)
+    {
+        wxImageArray results;
+        results.push_back(img.Scale(1000, 900, wxIMAGE_QUALITY_NEAREST));
+        results.push_back(img.Scale(300, 200, wxIMAGE_QUALITY_BOX_AVERAGE));
+        results.push_back(img.Scale(1000, 900, wxIMAGE_QUALITY_BOX_AVERAGE));
+        results.push_back(img.Scale(300, 200, wxIMAGE_QUALITY_BILINEAR));
+        results.push_back(img.Scale(1000, 900, wxIMAGE_QUALITY_BILINEAR));
+        results.push_back(img.Scale(300, 200, wxIMAGE_QUALITY_BICUBIC));
+        results.push_back(img.Scale(1000, 900, wxIMAGE_QUALITY_BICUBIC));
+        results.push_back(img.Blur(7));
+        results.push_back(img.GaussianBlur(3.5));
+        results.push_back(img.ConvertToGreyscale());
+        results.push_back(img.ChangeLightness(150));
+
+        wxImage rotated = img.Copy();
+        rotated.RotateHue(0.5);
+        results.push_back(rotated);
+
+        return results;
+    };
+
+    REQUIRE( wxImage::GetParallelism() == 1 );
+    const wxImageArray expected = processImage(image);
+    const wxImageArray expectedNoAlpha = processImage(imageNoAlpha);
+
+    wxImage::SetParallelism(4);
+    wxON_BLOCK_EXIT1(wxImage::SetParallelism, 1);
+    CHECK( wxImage::GetParallelism() == 4 );
+
+    const wxImageArray actual = processImage(image);
+    const wxImageArray actualNoAlpha = processImage(imageNoAlpha);
+    for ( size_t n = 0; n < expected.size(); n++ )
+    {
+        INFO("Operation #" << n);
+        CHECK_THAT( actual[n], RGBASameAs(expected[n]) );
+        CHECK_THAT( actualNoAlpha[n], RGBASameAs(expectedNoAlpha[n]) );
+    }
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::CreateBitmapFromCursor", "[image]")
 {
 #if !defined __WXOSX_IPHONE__ && !defined __WXDFB__ && !defined __WXX11__
@@ -3048,6 +3760,88 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::ChangeColours", "[image]")
     CHECK_THAT(test, RGBSimilarToFile("image/toucan_mono_255_255_255.png"));
 }
 
+// Check that quantizing the image using the given flags results in an image
+// using the palette colours which is still similar to the original one.
+static void CheckQuantize(const wxImage& image, int flags)
+{
+    INFO("Quantize flags " << flags);
+
+    const int numColours = 16;
+
+    wxImage quantized;
+    unsigned char* indices = nullptr;
+    REQUIRE( wxQuantize::Quantize(image, quantized, numColours, &indices,
+                                  wxQUANTIZE_FILL_DESTINATION_IMAGE |
+                                  wxQUANTIZE_RETURN_8BIT_DATA |
+                                  flags) );
+    REQUIRE( indices );
+    std::unique_ptr<unsigned char[]> indicesOwner(indices);
+
+    REQUIRE( quantized.GetSize() == image.GetSize() );
+
+#if wxUSE_PALETTE
+    REQUIRE( quantized.HasPalette() );
+    const wxPalette& palette = quantized.GetPalette();
+#endif // wxUSE_PALETTE
+
+    const unsigned char* data = quantized.GetData();
+    const unsigned char* orig = image.GetData();
+    const int numPixels = image.GetWidth()*image.GetHeight();
+
+    long totalDiff = 0;
+    for ( int n = 0; n < numPixels; n++, data += 3, orig += 3 )
+    {
+        REQUIRE( indices[n] < numColours );
+
+#if wxUSE_PALETTE
+        unsigned char r, g, b;
+        REQUIRE( palette.GetRGB(indices[n], &r, &g, &b) );
+        CHECK( wxColour(r, g, b) == wxColour(data[0], data[1], data[2]) );
+#endif // wxUSE_PALETTE
+
+        totalDiff += abs(data[0] - orig[0]) +
+                     abs(data[1] - orig[1]) +
+                     abs(data[2] - orig[2]);
+    }
+
+    // The exact value depends on the dithering method, but all of them should
+    // result in a reasonably small average difference.
+    CHECK( totalDiff / (3*numPixels) < 16 );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxQuantize", "[image]")
+{
+    wxImage image;
+    REQUIRE( image.LoadFile("horse.png") );
+
+    CheckQuantize(image, 0);
+    CheckQuantize(image, wxQUANTIZE_NO_DITHER);
+    CheckQuantize(image, wxQUANTIZE_ORDERED_DITHER);
+
+    // Image with few colours exactly representable in the internal histogram
+    // must not be changed when not using dithering or when using the error
+    // diffusion dithering, as there is no error to diffuse in this case.
+    wxImage simple(32, 32);
+    unsigned char* data = simple.GetData();
+    for ( int n = 0; n < 32*32; n++, data += 3 )
+    {
+        data[0] = n % 2 ? 4 : 252;
+        data[1] = n % 3 ? 2 : 130;
+        data[2] = n % 5 ? 124 : 4;
+    }
+
+    for ( int flags : { 0, wxQUANTIZE_NO_DITHER } )
+    {
+        INFO("Quantize flags " << flags);
+
+        wxImage quantized;
+        REQUIRE( wxQuantize::Quantize(simple, quantized, 16, nullptr,
+                                      wxQUANTIZE_FILL_DESTINATION_IMAGE |
+                                      flags) );
+        CHECK_THAT( quantized, RGBSameAs(simple) );
+    }
+}
+
 TEST_CASE("wxImage::Clear", "[image]")
 {
     wxImage image(2, 2);
@@ -20,6 +20,14 @@
 
 #include "wx/scopeguard.h"
 
+#if wxUSE_THREADS
+    #include "wx/crt.h"
+    #include "wx/thread.h"
+
+    #include <algorithm>
+    #include <vector>
+#endif // wxUSE_THREADS
+
 #if wxUSE_LOG
 
 #ifdef __WINDOWS__
@@ -51,6 +59,13 @@ TEST_CASE_METHOD(LogTestCase, "wxLog::Functions", "[log]")
 #else
     CHECK( m_log->GetLog(wxLOG_Debug) == "" );
 #endif
+
+    // Format strings checked at compile-time can be used too.
+    wxLogWarning(wxFORMAT("Warning %s %d"), "number", 42);
+    CHECK( m_log->GetLog(wxLOG_Warning) == "Warning number 42" );
+
+    wxLogSysError(17, wxFORMAT("Error %d"), 18);
+    CHECK( m_log->GetLog(wxLOG_Error).StartsWith("Error 18 (") );
 }
 
 TEST_CASE_METHOD(LogTestCase, "wxLogNull()", "[log]")
@@ -188,6 +203,137 @@ TEST_CASE_METHOD(LogTestCase, "wxLog::NoWarnings", "[log]")
     CHECK( m_log->GetLog(wxLOG_Error) == "If" );
 }
 
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Log target remembering all the messages logged to it in the order in which
+// it received them.
+class AllMessagesLog : public wxLog
+{
+public:
+    AllMessagesLog() : m_flushed(0) { }
+
+    const wxArrayString& GetMessages() const { return m_messages; }
+
+    bool WasUsedFrom(wxThreadIdType tid) const
+    {
+        return std::find(m_tids.begin(), m_tids.end(), tid) != m_tids.end();
+    }
+
+    int GetFlushCount() const { return m_flushed; }
+
+    virtual void Flush() override
+    {
+        m_flushed++;
+    }
+
+protected:
+    virtual void DoLogRecord(wxLogLevel WXUNUSED(level),
+                             const wxString& msg,
+                             const wxLogRecordInfo& WXUNUSED(info)) override
+    {
+        m_messages.push_back(msg);
+
+        const wxThreadIdType tid = wxThread::GetCurrentId();
+        if ( !WasUsedFrom(tid) )
+            m_tids.push_back(tid);
+    }
+
+private:
+    wxArrayString m_messages;
+    std::vector<wxThreadIdType> m_tids;
+    int m_flushed;
+};
+
+class LoggingThread : public wxThread
+{
+public:
+    LoggingThread(int id, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_id(id),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < m_count; n++ )
+            wxLogMessage("%d %d", m_id, n);
+
+        // Wait until all our messages are output.
+        wxLog::FlushActive();
+
+        return nullptr;
+    }
+
+private:
+    const int m_id;
+    const int m_count;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxLogAsync", "[log]")
+{
+    AllMessagesLog* const target = new AllMessagesLog;
+
+    // Use a tiny buffer to test what happens when it becomes full.
+    wxLogAsync* const logAsync = new wxLogAsync(target, 4);
+    CHECK( logAsync->GetTarget() == target );
+
+    wxLog* const logOld = wxLog::SetActiveTarget(logAsync);
+    wxON_BLOCK_EXIT0([logOld]() { delete wxLog::SetActiveTarget(logOld); });
+
+    wxLogMessage("%d %d", 0, 0);
+    logAsync->Flush();
+
+    REQUIRE( target->GetMessages().size() == 1 );
+    CHECK( target->GetMessages()[0] == "0 0" );
+    CHECK( target->GetFlushCount() == 1 );
+    CHECK( !target->WasUsedFrom(wxThread::GetCurrentId()) );
+
+    // Flushing again when nothing was logged shouldn't do anything.
+    logAsync->Flush();
+    CHECK( target->GetFlushCount() == 1 );
+
+    const int NUM_THREADS = 4;
+    const int NUM_MESSAGES = 1000;
+
+    std::vector<wxThread*> threads;
+    for ( int n = 1; n <= NUM_THREADS; n++ )
+    {
+        threads.push_back(new LoggingThread(n, NUM_MESSAGES));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    // All messages from background threads must have been output, without
+    // waiting for the main thread to flush them, and the messages from the
+    // same thread must have been output in order.
+    const wxArrayString& messages = target->GetMessages();
+    REQUIRE( messages.size() == 1 + NUM_THREADS*NUM_MESSAGES );
+
+    int next[NUM_THREADS + 1] = { 0 };
+    for ( size_t n = 1; n < messages.size(); n++ )
+    {
+        int id, num;
+        REQUIRE( wxSscanf(messages[n], "%d %d", &id, &num) == 2 );
+        REQUIRE( id >= 1 );
+        REQUIRE( id <= NUM_THREADS );
+        CHECK( num == next[id]++ );
+    }
+}
+
+#endif // wxUSE_THREADS
+
 // The following two functions (v, macroCompilabilityTest) are not run by
 // any test, and their purpose is merely to guarantee that the wx(V)LogXXX
 // macros compile without 'dangling else' warnings.
@@ -1501,3 +1501,83 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     // just rejected as an invalid encoded chunk.
     CHECK( wxConvUTF7.cMB2WC("+\xc3").length() == 0 );
 }
+
+TEST_CASE("wxMBConv::UTF8ASCIIRuns", "[mbconv][utf8]")
+{
+    // Check that converting long runs of ASCII characters, which are handled
+    // in bulk, works correctly when they're interrupted by non-ASCII ones at
+    // any position, including near the end of the string.
+    wxMBConvUTF8 convPUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    const wxMBConv* const convs[] = { &wxConvUTF8, &convPUA };
+
+    for ( size_t len = 1; len < 70; len++ )
+    {
+        for ( size_t pos = 0; pos <= len; pos++ )
+        {
+            INFO("Length " << len << ", non-ASCII character at " << pos);
+
+            std::string utf8;
+            std::wstring wide;
+            for ( size_t n = 0; n < len; n++ )
+            {
+                if ( n == pos )
+                {
+                    utf8 += "\xd0\xa6";
+                    wide += L'\x426';
+                }
+                else
+                {
+                    const char ch = static_cast<char>('A' + n % 26);
+                    utf8 += ch;
+                    wide += ch;
+                }
+            }
+
+            for ( const wxMBConv* conv : convs )
+            {
+                CHECK( conv->ToWChar(nullptr, 0, utf8.data(), utf8.length())
+                        == wide.length() );
+
+                wxWCharBuffer wbuf(wide.length());
+                REQUIRE( conv->ToWChar(wbuf.data(), wide.length(),
+                                       utf8.data(), utf8.length())
+                            == wide.length() );
+                CHECK( std::wstring(wbuf.data(), wide.length()) == wide );
+
+                CHECK( conv->cMB2WC(utf8.c_str()).data() == wide );
+
+                CHECK( conv->FromWChar(nullptr, 0, wide.data(), wide.length())
+                        == utf8.length() );
+
+                wxCharBuffer buf(utf8.length());
+                REQUIRE( conv->FromWChar(buf.data(), utf8.length(),
+                                         wide.data(), wide.length())
+                            == utf8.length() );
+                CHECK( std::string(buf.data(), utf8.length()) == utf8 );
+
+                CHECK( conv->cWC2MB(wide.c_str()).data() == utf8 );
+            }
+
+            // Strict converter must fail if the output buffer is too small.
+            if ( wide.length() > 1 )
+            {
+                wxWCharBuffer wbuf(wide.length());
+                CHECK( wxConvUTF8.ToWChar(wbuf.data(), wide.length() - 1,
+                                          utf8.data(), utf8.length())
+                        == wxCONV_FAILED );
+
+                wxCharBuffer buf(utf8.length());
+                CHECK( wxConvUTF8.FromWChar(buf.data(), utf8.length() - 1,
+                                            wide.data(), wide.length())
+                        == wxCONV_FAILED );
+            }
+        }
+    }
+
+    // Invalid bytes after a long ASCII run must still be detected.
+    const std::string invalid = std::string(40, 'x') + "\xff" + "yz";
+    CHECK( wxConvUTF8.ToWChar(nullptr, 0, invalid.data(), invalid.length())
+            == wxCONV_FAILED );
+    CHECK( convPUA.ToWChar(nullptr, 0, invalid.data(), invalid.length())
+            == invalid.length() );
+}
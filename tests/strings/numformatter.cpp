@@ -94,6 +94,12 @@ TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::LongToString", "[numformat
     CHECK( wxNumberFormatter::ToString(  12345678L) ==  "12,345,678" );
     CHECK( wxNumberFormatter::ToString( -12345678L) == "-12,345,678" );
     CHECK( wxNumberFormatter::ToString( 123456789L) == "123,456,789" );
+
+    CHECK( wxNumberFormatter::ToString(0L) == "0" );
+    CHECK( wxNumberFormatter::ToString(LONG_MAX, wxNumberFormatter::Style_None)
+            == wxString::Format("%ld", LONG_MAX) );
+    CHECK( wxNumberFormatter::ToString(LONG_MIN, wxNumberFormatter::Style_None)
+            == wxString::Format("%ld", LONG_MIN) );
 }
 
 #ifdef wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
@@ -112,6 +118,10 @@ TEST_CASE_METHOD(NumFormatterTestCase, "NumFormatter::LongLongToString", "[numfo
     CHECK( wxNumberFormatter::ToString(wxLL(   1234567)) ==   "1,234,567" );
     CHECK( wxNumberFormatter::ToString(wxLL(  12345678)) ==  "12,345,678" );
     CHECK( wxNumberFormatter::ToString(wxLL( 123456789)) == "123,456,789" );
+
+    CHECK( wxNumberFormatter::ToString(static_cast<wxLongLong_t>(wxINT64_MIN),
+                                       wxNumberFormatter::Style_None)
+            == "-9223372036854775808" );
 }
 
 #endif // wxHAS_LONG_LONG_T_DIFFERENT_FROM_LONG
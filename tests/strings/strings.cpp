@@ -17,9 +17,12 @@
     #include "wx/wx.h"
 #endif // WX_PRECOMP
 
+#include "wx/math.h"
 #include "wx/private/localeset.h"
+#include "wx/variant.h"
 
 #include <errno.h>
+#include <limits>
 
 // ----------------------------------------------------------------------------
 // tests
@@ -338,6 +341,34 @@ TEST_CASE("StringReplace", "[wxString]")
     TEST_WXREPLACE( "life", 4, "fe", "ve", true, "live", 4 );
     TEST_WXREPLACE( "xx", 2, "x", "yy", true, "yyyy", 4 );
     TEST_WXREPLACE( "xxx", 3, "xx", "z", true, "zx", 2 );
+    TEST_WXREPLACE( "a-b-c-", 6, "-", "+", true, "a+b+c+", 6 );
+    TEST_WXREPLACE( "a--b--c", 7, "--", "++", true, "a++b++c", 7 );
+    TEST_WXREPLACE( "--a--b--", 8, "--", "+", true, "+a+b+", 5 );
+    TEST_WXREPLACE( "--a--b--", 8, "--", "", true, "ab", 2 );
+    TEST_WXREPLACE( "-a-b-", 5, "-", "+++", true, "+++a+++b+++", 11 );
+    TEST_WXREPLACE( "abc", 3, "x", "yy", true, "abc", 3 );
+    TEST_WXREPLACE( "abc", 3, "xx", "y", true, "abc", 3 );
+
+    // Non-ASCII characters must be handled correctly too.
+    {
+        wxString s = wxString::FromUTF8("\xc3\xa9t\xc3\xa9 \xc3\xa9t\xc3\xa9");
+        CHECK( s.Replace(wxString::FromUTF8("\xc3\xa9"), "e") == 4 );
+        CHECK( s == "ete ete" );
+        CHECK( s.Replace("e", wxString::FromUTF8("\xc3\xa8")) == 4 );
+        CHECK( s == wxString::FromUTF8("\xc3\xa8t\xc3\xa8 \xc3\xa8t\xc3\xa8") );
+        CHECK( s.length() == 7 );
+    }
+
+    // Replacing the string itself is weird, but should still work.
+    {
+        wxString s = "foo";
+        CHECK( s.Replace(s, "x") == 1 );
+        CHECK( s == "x" );
+
+        s = "bar";
+        CHECK( s.Replace("a", s) == 1 );
+        CHECK( s == "bbarr" );
+    }
 
     #undef TEST_WXREPLACE
     #undef TEST_NULLCHARREPLACE
@@ -392,6 +423,21 @@ TEST_CASE("StringCaseChanges", "[wxString]")
     CHECK( wxString("ABC").Capitalize() == "Abc" );
 
     CHECK( wxString().Capitalize() == "" );
+
+    // Check that mixing ASCII and non-ASCII characters works too.
+    // Notice that the case of non-ASCII characters is changed using the
+    // current locale, so don't hardcode the expected results for them.
+    const wxString mixed = wxString::FromUTF8("Abc \xc3\x89t\xc3\xa9 Xyz Iii");
+    wxString mixedUpper, mixedLower;
+    for ( wxString::const_iterator it = mixed.begin(); it != mixed.end(); ++it )
+    {
+        mixedUpper += (wxChar)wxToupper(*it);
+        mixedLower += (wxChar)wxTolower(*it);
+    }
+    CHECK( mixed.Upper() == mixedUpper );
+    CHECK( mixed.Lower() == mixedLower );
+    CHECK( wxString("[@Az`{]").Upper() == "[@AZ`{]" );
+    CHECK( wxString("[@Az`{]").Lower() == "[@az`{]" );
 }
 
 TEST_CASE("StringCompare", "[wxString]")
@@ -517,6 +563,21 @@ TEST_CASE("StringCompareNoCase", "[wxString]")
     CHECK( wxString("\n").CmpNoCase(" ") < 0 );
     CHECK( wxString("'").CmpNoCase("!") > 0);
     CHECK( wxString("!").Cmp("Z") < 0 );
+
+    // Check strings with long common prefixes and differing only in case of
+    // non-ASCII characters.
+    const wxString prefix(wxString::FromUTF8("x\xc3\xa9"), 10);
+    CHECK( (prefix + "A").CmpNoCase(prefix + "a") == 0 );
+    CHECK( (prefix + "a").CmpNoCase(prefix + "B") < 0 );
+    CHECK( (prefix + "b").CmpNoCase(prefix + "A") > 0 );
+    CHECK( (prefix + "a").CmpNoCase(prefix) > 0 );
+    CHECK( prefix.CmpNoCase(prefix + "a") < 0 );
+    CHECK( wxString::FromUTF8("\xc3\xa9T\xc3\xa9")
+            .CmpNoCase(wxString::FromUTF8("\xc3\xa9t\xc3\xa9")) == 0 );
+    CHECK( wxString::FromUTF8("\xc3\xa9t\xc3\xa9")
+            .CmpNoCase(wxString::FromUTF8("\xc3\xa8t\xc3\xa9")) > 0 );
+    CHECK( wxString::FromUTF8("\xc3\xa8t\xc3\xa9")
+            .CmpNoCase(wxString::FromUTF8("\xc3\xa9t\xc3\xa9")) < 0 );
 }
 
 TEST_CASE("StringContains", "[wxString]")
@@ -870,6 +931,16 @@ TEST_CASE("StringToDouble", "[wxString]")
     CHECK( wxString("NAN").ToCDouble(&d) );
     CHECK( std::isnan(d) );
 
+    // non-ASCII characters can't be part of a valid number
+    CHECK_FALSE( wxString::FromUTF8("1\xc2\xb2").ToCDouble(&d) );
+    CHECK_FALSE( wxString::FromUTF8("\xc2\xa0" "1").ToCDouble(&d) );
+
+    // long strings must work too
+    CHECK( (wxString(' ', 100) + "1.5").ToCDouble(&d) );
+    CHECK( d == 1.5 );
+    CHECK( (wxString('0', 100) + "17").ToCDouble(&d) );
+    CHECK( d == 17 );
+
 
     // test ToDouble() now:
     // NOTE: for the test to be reliable, we need to set the locale explicitly
@@ -974,6 +1045,45 @@ TEST_CASE("StringFromDouble", "[wxString]")
     }
 }
 
+TEST_CASE("StringFromCDoubleShortest", "[wxString]")
+{
+    CHECK( wxString::FromCDoubleShortest(0) == "0" );
+    CHECK( wxString::FromCDoubleShortest(1) == "1" );
+    CHECK( wxString::FromCDoubleShortest(-1.5) == "-1.5" );
+    CHECK( wxString::FromCDoubleShortest(0.1) == "0.1" );
+    CHECK( wxString::FromCDoubleShortest(0.1 + 0.2) == "0.30000000000000004" );
+    CHECK( wxString::FromCDoubleShortest(M_PI) == "3.141592653589793" );
+    CHECK( wxString::FromCDoubleShortest(1e22) == "1e+22" );
+
+    // check that all values round trip, including the extreme ones
+    const double values[] =
+    {
+        1.0/3, 2.0/3, 1e-300, 123456789.125, 5e-324,
+        std::numeric_limits<double>::min(),
+        std::numeric_limits<double>::max(),
+        -std::numeric_limits<double>::max(),
+    };
+
+    for ( const double value : values )
+    {
+        const wxString str = wxString::FromCDoubleShortest(value);
+        INFO( "Value was formatted as \"" << str << "\"" );
+
+        double d;
+        CHECK( str.ToCDouble(&d) );
+        CHECK( d == value );
+    }
+
+    // decimal separator must be the period independently of the locale
+    if ( !wxLocale::IsAvailable(wxLANGUAGE_FRENCH) )
+        return;
+
+    wxLocale locale;
+    CHECK( locale.Init(wxLANGUAGE_FRENCH, wxLOCALE_DONT_LOAD_DEFAULT) );
+
+    CHECK( wxString::FromCDoubleShortest(0.25) == "0.25" );
+}
+
 TEST_CASE("StringStringBuf", "[wxString]")
 {
     // check that buffer can be used to write into the string
@@ -1149,6 +1259,61 @@ TEST_CASE("StringIndexedAccess", "[wxString]")
     CHECK( (char)s[2] == 'r' );
 }
 
+TEST_CASE("StringIndexedAccessOrder", "[wxString]")
+{
+    // Build a string with a long ASCII prefix followed by a mix of ASCII and
+    // non-ASCII characters, as accessing the characters of such string in
+    // different orders exercises different code paths in UTF-8 build.
+    std::wstring expected(300, L'x');
+    for ( int n = 0; n < 200; n++ )
+        expected += n % 3 ? wchar_t(0x430 + n % 32) : wchar_t('a' + n % 26);
+
+    const auto checkAll = [&expected](const wxString& s)
+    {
+        REQUIRE( s.length() == expected.length() );
+
+        const size_t len = expected.length();
+        for ( size_t n = 0; n < len; n++ )
+        {
+            INFO("Forward at " << n);
+            REQUIRE( s[n] == expected[n] );
+        }
+
+        for ( size_t n = len; n-- > 0; )
+        {
+            INFO("Backward at " << n);
+            REQUIRE( s[n] == expected[n] );
+        }
+
+        for ( size_t n = 0; n < len; n++ )
+        {
+            const size_t pos = (n * 97) % len;
+            INFO("Random at " << pos);
+            REQUIRE( s[pos] == expected[pos] );
+        }
+    };
+
+    wxString s(expected);
+    checkAll(s);
+
+    // Modifying the string must invalidate any cached information about it.
+    s[10] = expected[10] = wchar_t(0x416);
+    checkAll(s);
+
+    s.insert(0, wxString(wchar_t(0x416)));
+    expected.insert(0, 1, wchar_t(0x416));
+    checkAll(s);
+
+    s.erase(0, 1);
+    expected.erase(0, 1);
+    s[10] = expected[10] = L'y';
+    checkAll(s);
+
+    s += wxString(wchar_t(0x417));
+    expected += wchar_t(0x417);
+    checkAll(s);
+}
+
 TEST_CASE("StringBeforeAndAfter", "[wxString]")
 {
     // Construct a string with 2 equal signs in it by concatenating its three
@@ -1403,3 +1568,72 @@ TEST_CASE("StringSupplementaryUniChar", "[wxString]")
          find_first_of, find_last_of, find_first_not_of, find_last_not_of
     */
 }
+
+TEST_CASE("StringAtom", "[wxString][atom]")
+{
+    const wxStringAtom empty;
+    CHECK( empty.IsEmpty() );
+    CHECK( empty.GetString().empty() );
+    CHECK( wxStringAtom(wxString()) == empty );
+
+    const wxStringAtom a1(wxString("status"));
+    const wxStringAtom a2(wxString("stat") + "us");
+    CHECK( !a1.IsEmpty() );
+    CHECK( a1 == a2 );
+    CHECK( &a1.GetString() == &a2.GetString() );
+    CHECK( std::hash<wxStringAtom>()(a1) == std::hash<wxStringAtom>()(a2) );
+
+    const wxStringAtom b(wxString::FromUTF8("st\xc3\xa4tus"));
+    CHECK( a1 != b );
+    CHECK( b.GetString() == wxString::FromUTF8("st\xc3\xa4tus") );
+
+    CHECK( a1 == "status" );
+    CHECK( "status" == a1 );
+    CHECK( a1 == L"status" );
+    CHECK( a1 != "state" );
+    CHECK( a1 == wxString("status") );
+    CHECK( wxString("status") == a1 );
+
+    const size_t count = wxStringAtom::GetCount();
+    CHECK( wxStringAtom(wxString("status")) == a1 );
+    CHECK( wxStringAtom::GetCount() == count );
+
+    // Atoms can be used wherever wxString is expected.
+    const wxString s = a1;
+    CHECK( s == "status" );
+    CHECK( wxString(a1).length() == 6 );
+
+    wxArrayString arr;
+    arr.Add(a1);
+    arr.Add(b);
+    REQUIRE( arr.size() == 2 );
+    CHECK( arr[0] == "status" );
+    CHECK( arr.Index(b) == 1 );
+
+    SECTION("Variant")
+    {
+        wxVariant v(a1);
+        CHECK( v.GetType() == "string" );
+        CHECK( v.GetString() == "status" );
+        CHECK( v == a2 );
+        CHECK( v == wxString("status") );
+        CHECK( v != b );
+        CHECK( v.GetStringAtom() == a1 );
+        CHECK( v == wxVariant("status") );
+        CHECK( wxVariant("status") == v );
+        CHECK( wxVariant("status").GetStringAtom() == a1 );
+
+        v = b;
+        CHECK( v.GetString() == b.GetString() );
+        CHECK( v.GetStringAtom() == b );
+
+        v = "plain";
+        CHECK( v.GetString() == "plain" );
+
+        v = a1;
+        wxVariant copy(v);
+        copy = wxString("other");
+        CHECK( v == a1 );
+        CHECK( copy.GetString() == "other" );
+    }
+}
@@ -307,3 +307,77 @@ void TokenizerTestCase::AssignObj()
         CPPUNIT_ASSERT_EQUAL( tkzSrc.GetString(), tkz.GetString() );
     }
 }
+
+TEST_CASE("wxStringViewTokenizer::Tokens", "[tokenizer]")
+{
+    // check that we get exactly the same tokens as from wxStringTokenizer
+    for ( size_t n = 0; n < WXSIZEOF(gs_testData); n++ )
+    {
+        const TokenizerTestData& ttd = gs_testData[n];
+        INFO( Nth(n) );
+
+        const wxString s(ttd.str);
+        wxStringTokenizer tkz(s, ttd.delims, ttd.mode);
+        wxStringViewTokenizer tkzView(s, ttd.delims, ttd.mode);
+
+        CHECK( tkzView.GetMode() == tkz.GetMode() );
+        CHECK( tkzView.CountTokens() == ttd.count );
+
+        while ( tkz.HasMoreTokens() )
+        {
+            REQUIRE( tkzView.HasMoreTokens() );
+            CHECK( tkzView.GetNextToken() == tkz.GetNextToken() );
+            CHECK( tkzView.GetLastDelimiter() == tkz.GetLastDelimiter() );
+            CHECK( tkzView.GetString().ToString() == tkz.GetString() );
+        }
+
+        CHECK_FALSE( tkzView.HasMoreTokens() );
+        CHECK( tkzView.GetNextToken().empty() );
+    }
+}
+
+TEST_CASE("wxStringViewTokenizer::NonASCII", "[tokenizer]")
+{
+    const wxString s = wxString::FromUTF8("\xc3\xa9t\xc3\xa9\xe2\x80\xa2hiver"
+                                          "\xe2\x80\xa2\xe2\x80\xa2" "a,b");
+    const wxString delims = wxString::FromUTF8("\xe2\x80\xa2,");
+
+    wxStringViewTokenizer tkz(s, delims, wxTOKEN_RET_EMPTY_ALL);
+    CHECK( tkz.CountTokens() == 5 );
+
+    CHECK( tkz.GetNextToken() == wxString::FromUTF8("\xc3\xa9t\xc3\xa9") );
+    CHECK( tkz.GetLastDelimiter() == wxChar(0x2022) );
+    CHECK( tkz.GetNextToken() == "hiver" );
+    CHECK( tkz.GetNextToken().empty() );
+    CHECK( tkz.GetNextToken() == "a" );
+    CHECK( tkz.GetLastDelimiter() == ',' );
+    CHECK( tkz.GetNextToken() == "b" );
+    CHECK( tkz.GetLastDelimiter() == '\0' );
+    CHECK_FALSE( tkz.HasMoreTokens() );
+
+    // delimiters must not be found inside other characters
+    wxStringViewTokenizer tkz2(s, wxString::FromUTF8("\xc3\xa0"));
+    CHECK( tkz2.GetNextToken() == s );
+    CHECK_FALSE( tkz2.HasMoreTokens() );
+}
+
+TEST_CASE("wxStringViewTokenizer::Nested", "[tokenizer]")
+{
+    const wxString s("name=value\nfoo = bar baz\n\n");
+
+    wxStringViewTokenizer lines(s, "\n", wxTOKEN_STRTOK);
+    REQUIRE( lines.CountTokens() == 2 );
+
+    wxStringViewTokenizer first(lines.GetNextToken(), "=");
+    CHECK( first.GetNextToken() == "name" );
+    CHECK( first.GetNextToken() == "value" );
+    CHECK_FALSE( first.HasMoreTokens() );
+
+    wxStringViewTokenizer second(lines.GetNextToken(), " =", wxTOKEN_STRTOK);
+    CHECK( second.CountTokens() == 3 );
+    CHECK( second.GetNextToken() == "foo" );
+    CHECK( second.GetNextToken() == "bar" );
+    CHECK( second.GetString() == "baz" );
+
+    CHECK_FALSE( lines.HasMoreTokens() );
+}
@@ -292,3 +292,76 @@ TEST_CASE("PrintfError", "[wxString][Format][vararg][error]")
     const int invalidChar = 0x1780;
     REQUIRE_NOTHROW( CallPrintfV("%c", invalidChar) );
 }
+
+#ifdef wxHAS_COMPILE_TIME_FORMAT_CHECK
+
+TEST_CASE("FormatLiteral", "[wxString][Format][vararg]")
+{
+    CHECK( wxString::Format(wxFORMAT("%s %d"), "foo", 42) == "foo 42" );
+    CHECK( wxString::Format(wxFORMAT("100%%")) == "100%" );
+    CHECK( wxString::Format(wxFORMAT("[%*d]"), 4, 7) == "[   7]" );
+    CHECK( wxString::Format(wxFORMAT("%zu %lld %.1f"), sizeof(int), 2LL, 0.5)
+                == wxString::Format("%zu %lld %.1f", sizeof(int), 2LL, 0.5) );
+    CHECK( wxString::Format(wxFORMAT("%c%c"), 'x', wxUniChar(0x263A))
+                == wxString::FromUTF8("x\xe2\x98\xba") );
+    CHECK( wxString::Format(wxFORMAT("%s=%s"), wxString("key"), std::string("value"))
+                == "key=value" );
+
+    wxString s;
+    CHECK( s.Printf(wxFORMAT("%2$s, %1$s"), "world", "hello") == 12 );
+    CHECK( s == "hello, world" );
+
+    // Extra arguments are allowed, just as with the run-time checks.
+    CHECK( wxString::Format(wxFORMAT("%d"), 1, 2) == "1" );
+
+    // The string can also be passed to the functions which don't check it at
+    // compile-time.
+    wxChar buf[64];
+    CHECK( wxSnprintf(buf, WXSIZEOF(buf), wxFORMAT("%d-%s"), 5, "x") == 3 );
+    CHECK( wxString(buf) == "5-x" );
+
+    auto bad = wxFORMAT("%2$d");
+    CHECK_FALSE( bad.IsOk() );
+}
+
+namespace
+{
+
+// Compare the types found by the compile-time parser with those found by the
+// run-time one.
+template <typename F>
+void CheckArgTypes(const wxFormatLiteral<F>& literal, unsigned numArgs)
+{
+    const wxFormatString fmtLiteral(literal);
+    const wxFormatString fmtRuntime(literal.GetString());
+
+    INFO( "Format string \"" << wxString(literal.GetString()) << "\"" );
+
+    CHECK( literal.IsOk() );
+    CHECK( literal.GetArgCount() == numArgs );
+    for ( unsigned n = 1; n <= numArgs + 1; n++ )
+    {
+        INFO( "Argument #" << n );
+        CHECK( fmtLiteral.GetArgumentType(n) == fmtRuntime.GetArgumentType(n) );
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("FormatLiteral::Parse", "[wxString][Format][vararg]")
+{
+    CheckArgTypes(wxFORMAT("no arguments"), 0);
+    CheckArgTypes(wxFORMAT("%% %d %%"), 1);
+    CheckArgTypes(wxFORMAT("%d %i %o %u %x %X"), 6);
+    CheckArgTypes(wxFORMAT("%hd %ld %lld %Ld %qd %zu %Zu"), 7);
+    CheckArgTypes(wxFORMAT("%e %E %f %g %G %Lf %lf"), 7);
+    CheckArgTypes(wxFORMAT("%c %hc %lc %s %hs %ls %p"), 7);
+    CheckArgTypes(wxFORMAT("%n %hn %ln"), 3);
+    CheckArgTypes(wxFORMAT("%-08.3e|%+ #x|%'d"), 3);
+    CheckArgTypes(wxFORMAT("%*d %.*f %*.*s"), 7);
+    CheckArgTypes(wxFORMAT("%3$s %1$d %2$f %1$d"), 3);
+    CheckArgTypes(wxFORMAT("%10$d%9$d%8$d%7$d%6$d%5$d%4$d%3$d%2$d%1$d"), 10);
+    CheckArgTypes(wxFORMAT("invalid %y specifier %d"), 1);
+}
+
+#endif // wxHAS_COMPILE_TIME_FORMAT_CHECK
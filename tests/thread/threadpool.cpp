@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     wxThreadPool unit test
+// Author:      wxWidgets team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/threadpool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class CountingTask : public wxTask
+{
+public:
+    explicit CountingTask(std::atomic<int>& count) : m_count(count) { }
+
+    virtual void Run() override { m_count++; }
+
+private:
+    std::atomic<int>& m_count;
+};
+
+// Compute Fibonacci numbers using recursive fork/join, which is a good test
+// for the tasks waiting for their subtasks from the pool threads.
+int Fibonacci(wxThreadPool& pool, int n)
+{
+    if ( n < 2 )
+        return n;
+
+    wxFuture<int> f = pool.Submit([&pool, n]() { return Fibonacci(pool, n - 1); });
+    const int n2 = Fibonacci(pool, n - 2);
+
+    return f.Get() + n2;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("ThreadPool::Post", "[thread][threadpool]")
+{
+    std::atomic<int> count(0);
+
+    {
+        wxThreadPool pool(2);
+        CHECK( pool.GetThreadCount() == 2 );
+
+        for ( int n = 0; n < 100; n++ )
+            pool.Post(new CountingTask(count));
+
+        // The pool destructor waits until all the tasks complete.
+    }
+
+    CHECK( count == 100 );
+}
+
+TEST_CASE("ThreadPool::Submit", "[thread][threadpool]")
+{
+    wxThreadPool pool(3);
+
+    std::vector<wxFuture<int>> futures;
+    for ( int n = 0; n < 50; n++ )
+        futures.push_back(pool.Submit([n]() { return n*n; }));
+
+    for ( int n = 0; n < 50; n++ )
+        CHECK( futures[n].Get() == n*n );
+
+    std::atomic<bool> done(false);
+    wxFuture<void> f = pool.Submit([&done]() { done = true; });
+    CHECK( f.IsValid() );
+    f.Wait();
+    CHECK( f.IsReady() );
+    CHECK( done );
+
+    CHECK( !wxFuture<int>().IsValid() );
+
+    // The result type doesn't need to be default-constructible.
+    struct Result
+    {
+        explicit Result(int value_) : value(value_) { }
+
+        int value;
+    };
+
+    CHECK( pool.Submit([]() { return Result(17); }).Get().value == 17 );
+}
+
+#if wxUSE_EXCEPTIONS
+
+TEST_CASE("ThreadPool::Exception", "[thread][threadpool]")
+{
+    wxThreadPool pool(2);
+
+    wxFuture<int> f = pool.Submit([]() -> int
+        {
+            throw std::runtime_error("task failed");
+        });
+
+    CHECK_THROWS_AS( f.Get(), std::runtime_error );
+    CHECK( !f.IsCancelled() );
+
+    CHECK_THROWS_AS
+    (
+        pool.ParallelFor(0, 100, [](size_t n)
+            {
+                if ( n == 42 )
+                    throw std::runtime_error("iteration failed");
+            }),
+        std::runtime_error
+    );
+}
+
+#endif // wxUSE_EXCEPTIONS
+
+TEST_CASE("ThreadPool::Cancel", "[thread][threadpool]")
+{
+    wxThreadPool pool(1);
+
+    // Block the only pool thread until the token is cancelled to ensure that
+    // the second task doesn't start before it.
+    wxMutex mutex;
+    wxCondition condition(mutex);
+    bool started = false,
+         cancelled = false;
+
+    wxCancellationToken token;
+    wxFuture<void> blocker = pool.Submit([&]()
+        {
+            wxMutexLocker lock(mutex);
+            started = true;
+            condition.Broadcast();
+
+            while ( !cancelled )
+                condition.Wait();
+        });
+
+    std::atomic<bool> executed(false);
+    wxFuture<int> f = pool.Submit([&executed]() { executed = true; return 1; },
+                                  token);
+
+    {
+        wxMutexLocker lock(mutex);
+        while ( !started )
+            condition.Wait();
+
+        token.Cancel();
+        CHECK( token.IsCancelled() );
+
+        cancelled = true;
+        condition.Broadcast();
+    }
+
+    CHECK( f.IsCancelled() );
+    CHECK( !executed );
+    CHECK( !blocker.IsCancelled() );
+
+    // Using a not cancelled token doesn't change anything.
+    wxCancellationToken token2;
+    CHECK( pool.Submit([]() { return 2; }, token2).Get() == 2 );
+}
+
+TEST_CASE("ThreadPool::ParallelFor", "[thread][threadpool]")
+{
+    wxThreadPool pool(4);
+
+    const size_t count = 10000;
+    std::vector<int> v(count, 0);
+
+    SECTION("Default grain")
+    {
+        pool.ParallelFor(0, count, [&v](size_t n) { v[n] += static_cast<int>(n); });
+    }
+
+    SECTION("Explicit grain")
+    {
+        pool.ParallelFor(0, count, [&v](size_t n) { v[n] += static_cast<int>(n); },
+                         333);
+    }
+
+    SECTION("Small range")
+    {
+        v.resize(3);
+        pool.ParallelFor(0, 3, [&v](size_t n) { v[n] += static_cast<int>(n); });
+    }
+
+    for ( size_t n = 0; n < v.size(); n++ )
+    {
+        if ( v[n] != static_cast<int>(n) )
+        {
+            FAIL_CHECK( "Element " << n << " has wrong value " << v[n] );
+            break;
+        }
+    }
+
+    // Empty range is allowed and does nothing.
+    pool.ParallelFor(10, 10, [](size_t) { FAIL_CHECK( "Unexpected call" ); });
+}
+
+TEST_CASE("ThreadPool::Nested", "[thread][threadpool]")
+{
+    wxThreadPool pool(2);
+
+    CHECK( Fibonacci(pool, 16) == 987 );
+
+    // Nested ParallelFor() calls from the pool threads must work too.
+    std::atomic<int> sum(0);
+    pool.ParallelFor(0, 10, [&pool, &sum](size_t)
+        {
+            pool.ParallelFor(0, 10, [&sum](size_t m) { sum += static_cast<int>(m); });
+        });
+
+    CHECK( sum == 450 );
+}
+
+TEST_CASE("ThreadPool::Then", "[thread][threadpool]")
+{
+    wxThreadPool pool(2);
+
+    const wxThreadIdType mainId = wxThread::GetCurrentId();
+
+    int result = 0;
+    bool calledInMain = false;
+    pool.Submit([]() { return 17; }).Then([&](const wxFuture<int>& f)
+        {
+            result = f.Get();
+            calledInMain = wxThread::GetCurrentId() == mainId;
+        });
+
+    wxEvtHandler handler;
+    bool handlerCalled = false;
+    pool.Submit([]() { }).Then(&handler, [&](const wxFuture<void>&)
+        {
+            handlerCalled = true;
+        });
+
+    // The continuations are queued for the main thread, so wait until both
+    // tasks complete and process them.
+    for ( int n = 0; n < 1000 && (!result || !handlerCalled); n++ )
+    {
+        wxMilliSleep(1);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    CHECK( result == 17 );
+    CHECK( calledInMain );
+    CHECK( handlerCalled );
+}
+
+TEST_CASE("ThreadPool::Global", "[thread][threadpool]")
+{
+    wxThreadPool& pool = wxThreadPool::Get();
+    CHECK( &pool == &wxThreadPool::Get() );
+    CHECK( pool.GetThreadCount() > 0 );
+
+    CHECK( pool.Submit([]() { return 3; }).Get() == 3 );
+}